@@ -5,6 +5,13 @@
  */
 
 #import "AppDelegate.h"
+#import "AFNetworking.h"
+#import "ECNetworkWarmUp.h"
+#import "ECTableViewUtilities.h"
+#import "ECImagePreviews.h"
+#import "ECImageCompactor.h"
+#import "ECCellContent.h"
+#import "Masonry.h"
 
 @interface AppDelegate ()
 
@@ -15,10 +22,72 @@
 
 - (BOOL)application:(UIApplication *)application didFinishLaunchingWithOptions:(NSDictionary *)launchOptions {
     // Override point for customization after application launch.
+    
+    // Collect the latency of the image requests per host only, each image is a path of its own. The API requests are set in ECNetworkWarmUp.
+    [AFImageDownloader defaultInstance].sessionManager.metricsCollector = [AFNetworkMetricsCollector sharedCollector];
+    [AFImageDownloader defaultInstance].sessionManager.recordsMetricsPerEndpoint = NO;
+    
+    // Record the tiny preview of each downloaded image, shown as the placeholder on the later views.
+    [AFImageDownloader defaultInstance].imageCache = [[ECPreviewImageCache alloc] init];
+    [ECImagePreviews sharedPreviews];
+    
+    // Re-encode the cached originals at the size of the thumbnails while the network is idle, the list shows 60 x 60 and the related attractions 100 x 120.
+    [ECImageCompactor sharedCompactor].displaySize = CGSizeMake(120, 120);
+    [ECImageCompactor sharedCompactor].enabled = YES;
+    
+    // The styled cells are laid out by frames, without the constraints.
+    [ECTableViewCell Set_Layout_Mode:kECCellLayoutManual];
+    
+    // Open the connections while the first view is loading.
+    [[ECNetworkWarmUp sharedInstance] warm_Up];
+    
+#ifdef DEBUG
+    [[AFNetworkMetricsCollector sharedCollector] startPeriodicDumpWithInterval:60 handler:nil];
+    
+    // Launched with the argument -ECBenchmark YES, the measurements are logged once the first view is shown.
+    if ([[NSUserDefaults standardUserDefaults] boolForKey:@"ECBenchmark"])
+        [self performSelector:@selector(_run_Benchmarks) withObject:nil afterDelay:1];
+    
+    // Launched with the argument -ECImageStandInServer http://127.0.0.1:8765, the image limits are checked and the uploads measured against Harness/ECImageStandInServer.py.
+    NSString *standInServer = [[NSUserDefaults standardUserDefaults] stringForKey:@"ECImageStandInServer"];
+    
+    if (0 < standInServer.length)
+    {
+        [AFImageDownloader checkImageLimitsWithServer:[NSURL URLWithString:standInServer] completion:^(NSString *report) {
+            NSLog(@"[Image] Stand-in server:\n%@", report);
+        }];
+        
+        [AFHTTPSessionManager benchmarkUploadsToServer:[NSURL URLWithString:standInServer] megabytes:8 throttledBytesPerSecond:2 * 1024 * 1024 completion:^(NSString *report) {
+            NSLog(@"[Benchmark] Upload:\n%@", report);
+        }];
+    }
+#endif
+    
     return YES;
 }
 
 
+#ifdef DEBUG
+/**
+ * \brief	Log the DEBUG measurements of the request building and the layout, each run on the thread of the code it measures.
+ */
+- (void)_run_Benchmarks
+{
+    NSLog(@"[Benchmark] Request: %@", [AFHTTPRequestSerializer benchmarkRequestsWithIterations:10000]);
+    NSLog(@"[Benchmark] Query string: %@", [AFHTTPRequestSerializer benchmarkQueryStringsWithIterations:200]);
+    NSLog(@"[Benchmark] Cell layout:\n%@", [ECTableViewCell benchmark_Layout_Iterations:50 width:[UIScreen mainScreen].bounds.size.width]);
+    NSLog(@"[Benchmark] Constraint template: %@", [MASConstraintTemplate benchmarkWithIterations:500]);
+    
+    // The cell contents are built and rendered on a background queue in the list
+    CGFloat scale = [UIScreen mainScreen].scale;
+    
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        NSLog(@"[Benchmark] Cell content:\n%@", [ECCellContent benchmark_Widths:@[@320, @375, @414] iterations:200 scale:scale]);
+    });
+}
+#endif
+
+
 - (void)applicationWillResignActive:(UIApplication *)application {
     // Sent when the application is about to move from active to inactive state. This can occur for certain types of temporary interruptions (such as an incoming phone call or SMS message) or when the user quits the application and it begins the transition to the background state.
     // Use this method to pause ongoing tasks, disable timers, and invalidate graphics rendering callbacks. Games should use this method to pause the game.
@@ -28,6 +97,11 @@
 - (void)applicationDidEnterBackground:(UIApplication *)application {
     // Use this method to release shared resources, save user data, invalidate timers, and store enough application state information to restore your application to its current state in case it is terminated later.
     // If your application supports background execution, this method is called instead of applicationWillTerminate: when the user quits.
+    
+#ifdef DEBUG
+    NSLog(@"[Image] %lu failed requests avoided by the negative cache", (unsigned long)[AFImageDownloader defaultInstance].avoidedRequestCount);
+    NSLog(@"[Image] %@", [[ECImageCompactor sharedCompactor] report]);
+#endif
 }
 
 
@@ -0,0 +1,94 @@
+/**
+ * \file 	ECCollation.c
+ * \brief	Binary sort keys of the collation, so sorting is memcmp only.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECCollation.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Private Functions
+
+static int _is_Surrogate(uint16_t unit)
+{
+    return 0xD800 == (unit & 0xF800);
+}
+
+static int _compare_Items(const void *a, const void *b)
+{
+    const ECCollationItem *x = (const ECCollationItem*)a;
+    const ECCollationItem *y = (const ECCollationItem*)b;
+    int result = ECCollationCompare(x->key, x->length, y->key, y->length);
+
+    if (0 != result)
+        return result;
+
+    return (x->index < y->index) ? -1 : (x->index > y->index);
+}
+
+// Public Functions
+
+void ECCollationTableReset(ECCollationTable *table)
+{
+    memset(table->ranks, 0, sizeof(table->ranks));
+}
+
+void ECCollationTableSetRank(ECCollationTable *table, uint16_t unit, uint16_t rank)
+{
+    if (_is_Surrogate(unit))
+        return;
+
+    table->ranks[unit] = (rank > ECCOLLATION_MAX_RANK) ? ECCOLLATION_MAX_RANK : rank;
+}
+
+size_t ECCollationKeyLength(size_t count)
+{
+    return 4 * count + 2;
+}
+
+size_t ECCollationKey(const ECCollationTable *table, const uint16_t *chars, size_t count, uint8_t *out)
+{
+    uint8_t *p = out;
+    size_t i;
+
+    // Primary level, the ranks
+    for (i = 0; i < count; i++)
+    {
+        uint16_t rank = table->ranks[chars[i]];
+
+        if (0 == rank)
+            rank = ECCOLLATION_UNRANKED;
+
+        *p++ = (uint8_t)(rank >> 8);
+        *p++ = (uint8_t)rank;
+    }
+
+    // The separator is lower than any rank, so a prefix sorts first
+    *p++ = 0;
+    *p++ = 0;
+
+    // Last level, the units
+    for (i = 0; i < count; i++)
+    {
+        *p++ = (uint8_t)(chars[i] >> 8);
+        *p++ = (uint8_t)chars[i];
+    }
+
+    return (size_t)(p - out);
+}
+
+int ECCollationCompare(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength)
+{
+    int result = memcmp(a, b, (aLength < bLength) ? aLength : bLength);
+
+    if (0 != result)
+        return result;
+
+    return (aLength < bLength) ? -1 : (aLength > bLength);
+}
+
+void ECCollationSort(ECCollationItem *items, size_t count)
+{
+    qsort(items, count, sizeof(ECCollationItem), _compare_Items);
+}
@@ -0,0 +1,77 @@
+/**
+ * \file 	ECCollation.h
+ * \brief	Binary sort keys of the collation, so sorting is memcmp only. Plain C, no
+ *          Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECCollation_h
+#define ECCollation_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECCOLLATION_UNRANKED    0xFFFE      // The rank of the characters out of the table, after all ranked ones
+#define ECCOLLATION_MAX_RANK    0xFFFD
+
+/**
+ *  The collation order of the UTF-16 units, e.g. by the stroke count or by Zhuyin. The ranks are set
+ *  by the caller from the system collator, the characters of the same rank are equal at the primary level.
+ */
+typedef struct ECCollationTable
+{
+    uint16_t ranks[65536];      // 0 if not ranked
+} ECCollationTable;
+
+/**
+ *  A sort key and the index of its object.
+ */
+typedef struct ECCollationItem
+{
+    const uint8_t *key;
+    uint32_t length;
+    uint32_t index;
+} ECCollationItem;
+
+/**
+ * \brief	Clear all ranks.
+ */
+void ECCollationTableReset(ECCollationTable *table);
+
+/**
+ * \brief	Set the rank of the unit, 1 ~ ECCOLLATION_MAX_RANK. The surrogates are not ranked.
+ */
+void ECCollationTableSetRank(ECCollationTable *table, uint16_t unit, uint16_t rank);
+
+/**
+ * \brief	The length of the key of a string of count units.
+ */
+size_t ECCollationKeyLength(size_t count);
+
+/**
+ * \brief	Build the sort key of the UTF-16 string: the big-endian ranks of the units, a zero separator,
+ *          then the units themselves, so the strings of the same ranks are still ordered.
+ * \param   out         The buffer of ECCollationKeyLength(count) bytes.
+ * \return	The length of the key.
+ */
+size_t ECCollationKey(const ECCollationTable *table, const uint16_t *chars, size_t count, uint8_t *out);
+
+/**
+ * \brief	Compare two keys by memcmp, the shorter one first if one is the prefix of the other.
+ */
+int ECCollationCompare(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength);
+
+/**
+ * \brief	Sort the items by their keys, the equal keys keep the order of their indexes.
+ */
+void ECCollationSort(ECCollationItem *items, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECCollation_h */
@@ -0,0 +1,51 @@
+/**
+ * \file 	ECCollator.h
+ * \brief	Traditional Chinese collation with the precomputed sort keys.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The orders of the Traditional Chinese collation.
+ */
+typedef NS_ENUM(NSInteger, ECCollationOrder)
+{
+    ECCollationOrderStroke = 0,     // By the stroke count
+    ECCollationOrderZhuyin,         // By the Zhuyin (Bopomofo) reading
+    ECCollationOrderCount
+};
+
+/**
+ *  Rank the distinct characters of a set of strings once by the system collator, then build the
+ *  binary sort keys of the strings from the ranks (ECCollation). Sorting the strings is memcmp of
+ *  the keys, instead of a full collation per comparison. The characters out of the set sort last.
+ */
+@interface ECCollator : NSObject
+
+@property (nonatomic, assign, readonly) ECCollationOrder order;
+
+/**
+ * \brief	Create the collator of the characters of the strings.
+ */
+- (instancetype)init_With_Order: (ECCollationOrder) order strings: (NSArray<NSString*>*) strings;
+
+/**
+ * \brief	Get the sort key of the string, compare the keys by ECCollationCompare.
+ */
+- (NSData*)sort_Key_For_String: (NSString*) string;
+
+/**
+ * \brief	Get the title of the section index of the string: the first character for the stroke
+ *          order, the first Zhuyin symbol for the Zhuyin order, "#" for the others.
+ */
+- (NSString*)index_Title_For_String: (NSString*) string;
+
+/**
+ * \brief	Sort the objects by their keys, the equal keys keep the order of the objects.
+ * \param   keys        The sort key of each object, in the same order.
+ * \return	The sorted objects.
+ */
++ (NSArray*)sort_Objects: (NSArray*) objects keys: (NSArray<NSData*>*) keys;
+
+@end
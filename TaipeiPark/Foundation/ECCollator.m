@@ -0,0 +1,190 @@
+/**
+ * \file 	ECCollator.m
+ * \brief	Traditional Chinese collation with the precomputed sort keys.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECCollator.h"
+#import "ECCollation.h"
+
+// Most strings are converted on the stack
+#define STACK_CHARACTER_COUNT 128
+
+static NSString * const kLocaleIdentifiers[ECCollationOrderCount] = {
+    @"zh_Hant_TW@collation=stroke",
+    @"zh_Hant_TW@collation=zhuyin"
+};
+
+// The pinyin prefixes of the first Zhuyin symbol, the longer ones first
+static NSString * const kZhuyinInitials[][2] = {
+    {@"zh", @"ㄓ"}, {@"ch", @"ㄔ"}, {@"sh", @"ㄕ"},
+    {@"b", @"ㄅ"}, {@"p", @"ㄆ"}, {@"m", @"ㄇ"}, {@"f", @"ㄈ"},
+    {@"d", @"ㄉ"}, {@"t", @"ㄊ"}, {@"n", @"ㄋ"}, {@"l", @"ㄌ"},
+    {@"g", @"ㄍ"}, {@"k", @"ㄎ"}, {@"h", @"ㄏ"},
+    {@"j", @"ㄐ"}, {@"q", @"ㄑ"}, {@"x", @"ㄒ"},
+    {@"r", @"ㄖ"}, {@"z", @"ㄗ"}, {@"c", @"ㄘ"}, {@"s", @"ㄙ"},
+    {@"yu", @"ㄩ"}, {@"y", @"ㄧ"}, {@"w", @"ㄨ"}, {@"er", @"ㄦ"},
+    {@"ang", @"ㄤ"}, {@"ai", @"ㄞ"}, {@"ao", @"ㄠ"}, {@"an", @"ㄢ"}, {@"a", @"ㄚ"},
+    {@"eng", @"ㄥ"}, {@"ei", @"ㄟ"}, {@"en", @"ㄣ"}, {@"e", @"ㄜ"},
+    {@"ou", @"ㄡ"}, {@"o", @"ㄛ"}
+};
+
+@implementation ECCollator
+{
+    ECCollationTable *_table;
+    NSLocale *_locale;
+}
+
+- (instancetype)init_With_Order: (ECCollationOrder) order strings: (NSArray<NSString*>*) strings
+{
+    if (self = [super init])
+    {
+        _order = (order < ECCollationOrderCount) ? order : ECCollationOrderStroke;
+        _locale = [NSLocale localeWithLocaleIdentifier:kLocaleIdentifiers[_order]];
+        _table = calloc(1, sizeof(ECCollationTable));
+        
+        if (NULL == _table)
+            return nil;
+        
+        // The distinct characters of the strings
+        NSMutableArray *characters = [[NSMutableArray alloc] init];
+        uint8_t *seen = calloc(65536 / 8, 1);
+        
+        if (NULL == seen)
+            return nil;
+        
+        for (NSString *string in strings)
+        {
+            CFStringInlineBuffer buffer;
+            CFIndex length = CFStringGetLength((CFStringRef)string);
+            
+            CFStringInitInlineBuffer((CFStringRef)string, &buffer, CFRangeMake(0, length));
+            
+            for (CFIndex i = 0; i < length; i++)
+            {
+                unichar c = CFStringGetCharacterFromInlineBuffer(&buffer, i);
+                
+                if (CFStringIsSurrogateHighCharacter(c) || CFStringIsSurrogateLowCharacter(c) || 0 != (seen[c >> 3] & (1 << (c & 7))))
+                    continue;
+                
+                seen[c >> 3] |= 1 << (c & 7);
+                [characters addObject:[NSString stringWithCharacters:&c length:1]];
+            }
+        }
+        
+        free(seen);
+        
+        // A few thousand collations of single characters, instead of n log n of the whole strings
+        NSLocale *locale = _locale;
+        NSComparator comparator = ^NSComparisonResult(NSString *a, NSString *b) {
+            return [a compare:b options:0 range:NSMakeRange(0, a.length) locale:locale];
+        };
+        
+        [characters sortUsingComparator:comparator];
+        
+        NSString *previous = nil;
+        uint16_t rank = 0;
+        
+        for (NSString *character in characters)
+        {
+            if (nil == previous || NSOrderedSame != comparator(previous, character))
+                rank++;
+            
+            ECCollationTableSetRank(_table, [character characterAtIndex:0], rank);
+            previous = character;
+        }
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_table);
+}
+
+- (NSData*)sort_Key_For_String: (NSString*) string
+{
+    NSUInteger length = string.length;
+    unichar stackBuffer[STACK_CHARACTER_COUNT];
+    unichar *characters = (length <= STACK_CHARACTER_COUNT) ? stackBuffer : malloc(length * sizeof(unichar));
+    
+    if (NULL == characters)
+        return nil;
+    
+    [string getCharacters:characters range:NSMakeRange(0, length)];
+    
+    NSMutableData *key = [[NSMutableData alloc] initWithLength:ECCollationKeyLength(length)];
+    
+    ECCollationKey(_table, characters, length, key.mutableBytes);
+    
+    if (characters != stackBuffer)
+        free(characters);
+    
+    return key;
+}
+
+- (NSString*)index_Title_For_String: (NSString*) string
+{
+    if (0 == string.length)
+        return @"#";
+    
+    NSString *first = [string substringWithRange:[string rangeOfComposedCharacterSequenceAtIndex:0]];
+    unichar c = [first characterAtIndex:0];
+    
+    if (('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'))
+        return first.uppercaseString;
+    
+    // CJK unified ideographs, the extension A and the compatibility ideographs
+    if (!((0x3400 <= c && c <= 0x9FFF) || (0xF900 <= c && c <= 0xFAFF) || CFStringIsSurrogateHighCharacter(c)))
+        return @"#";
+    
+    if (ECCollationOrderStroke == self.order)
+        return first;
+    
+    NSMutableString *latin = [first mutableCopy];
+    
+    CFStringTransform((CFMutableStringRef)latin, NULL, kCFStringTransformMandarinLatin, false);
+    CFStringTransform((CFMutableStringRef)latin, NULL, kCFStringTransformStripCombiningMarks, false);
+    
+    NSString *pinyin = latin.lowercaseString;
+    
+    for (NSUInteger i = 0; i < sizeof(kZhuyinInitials) / sizeof(kZhuyinInitials[0]); i++)
+    {
+        if ([pinyin hasPrefix:kZhuyinInitials[i][0]])
+            return kZhuyinInitials[i][1];
+    }
+    
+    return @"#";
+}
+
++ (NSArray*)sort_Objects: (NSArray*) objects keys: (NSArray<NSData*>*) keys
+{
+    NSUInteger count = MIN(objects.count, keys.count);
+    ECCollationItem *items = malloc(MAX(count, 1) * sizeof(ECCollationItem));
+    
+    if (NULL == items)
+        return objects;
+    
+    for (NSUInteger i = 0; i < count; i++)
+    {
+        NSData *key = [keys objectAtIndex:i];
+        
+        items[i].key = key.bytes;
+        items[i].length = (uint32_t)key.length;
+        items[i].index = (uint32_t)i;
+    }
+    
+    ECCollationSort(items, count);
+    
+    NSMutableArray *sorted = [[NSMutableArray alloc] initWithCapacity:count];
+    
+    for (NSUInteger i = 0; i < count; i++)
+        [sorted addObject:[objects objectAtIndex:items[i].index]];
+    
+    free(items);
+    
+    return sorted;
+}
+
+@end
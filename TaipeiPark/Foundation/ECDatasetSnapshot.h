@@ -0,0 +1,57 @@
+/**
+ * \file 	ECDatasetSnapshot.h
+ * \brief	Keep the last park dataset downloaded from the API on the disk.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The snapshot of the park attractions, saved after each successful refresh. It is used at
+ *  launch before the API responds, e.g. to know which image hosts to warm up. The tiny previews
+ *  of the attraction images are kept beside it, in a binary plist.
+ */
+@interface ECDatasetSnapshot : NSObject
+
++ (ECDatasetSnapshot*)sharedSnapshot;
+
+/**
+ * \brief	Save the items of the API response. The file is written atomically.
+ * \param	items      The array of the attraction dictionaries.
+ * \return	YES if saved.
+ */
+- (BOOL)save_Items: (NSArray*) items;
+
+/**
+ * \brief	Load the saved items.
+ * \return	The array of the attraction dictionaries, nil if there is no snapshot.
+ */
+- (NSArray*)load_Items;
+
+/**
+ * \brief	Get the hosts of the attraction images, the most used first.
+ * \param	maxCount   The max count of the hosts.
+ * \return	The URLs with only the scheme and the host, empty if there is no snapshot.
+ */
+- (NSArray<NSURL*>*)image_Hosts_With_Max_Count: (NSUInteger) maxCount;
+
+/**
+ * \brief	The image URLs of the saved items, in their order.
+ */
+- (NSArray<NSString*>*)image_URLs;
+
+/**
+ * \brief	Save the tiny previews of the attraction images, the previews of the images no longer in the
+ *          saved items are dropped. The file is written atomically.
+ * \param	previews   The previews keyed by the image URLs.
+ * \return	YES if saved.
+ */
+- (BOOL)save_Image_Previews: (NSDictionary<NSString*, NSData*>*) previews;
+
+/**
+ * \brief	Load the saved previews of the attraction images.
+ * \return	The previews keyed by the image URLs, empty if there is none.
+ */
+- (NSDictionary<NSString*, NSData*>*)load_Image_Previews;
+
+@end
@@ -0,0 +1,175 @@
+/**
+ * \file 	ECDatasetSnapshot.m
+ * \brief	Keep the last park dataset downloaded from the API on the disk.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECDatasetSnapshot.h"
+
+static NSString * const kSnapshotFileName = @"ParkDataset.json";
+static NSString * const kPreviewsFileName = @"ParkImagePreviews.plist";
+
+@implementation ECDatasetSnapshot
+{
+    NSString *_path;
+    NSString *_previewsPath;
+    NSArray *_items;        // Cache of the loaded items
+}
+
++ (ECDatasetSnapshot*)sharedSnapshot
+{
+    static ECDatasetSnapshot *snapshot = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        snapshot = [[ECDatasetSnapshot alloc] init];
+    });
+    
+    return snapshot;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        NSString *dir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        
+        _path = [dir stringByAppendingPathComponent:kSnapshotFileName];
+        _previewsPath = [dir stringByAppendingPathComponent:kPreviewsFileName];
+    }
+    
+    return self;
+}
+
+- (BOOL)save_Items: (NSArray*) items
+{
+    if (![items isKindOfClass:[NSArray class]] || ![NSJSONSerialization isValidJSONObject:items])
+        return NO;
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:items options:0 error:nil];
+    
+    if (nil == data || ![data writeToFile:_path atomically:YES])
+        return NO;
+    
+    @synchronized (self)
+    {
+        _items = [items copy];
+    }
+    
+    return YES;
+}
+
+- (NSArray*)load_Items
+{
+    @synchronized (self)
+    {
+        if (nil != _items)
+            return _items;
+    }
+    
+    NSData *data = [NSData dataWithContentsOfFile:_path];
+    
+    if (nil == data)
+        return nil;
+    
+    NSArray *items = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    
+    if (![items isKindOfClass:[NSArray class]])
+        return nil;
+    
+    @synchronized (self)
+    {
+        _items = items;
+    }
+    
+    return items;
+}
+
+- (NSArray<NSString*>*)image_URLs
+{
+    NSMutableArray *images = [[NSMutableArray alloc] init];
+    
+    for (NSDictionary *dic in [self load_Items])
+    {
+        if (![dic isKindOfClass:[NSDictionary class]])
+            continue;
+        
+        NSString *image = [dic objectForKey:@"Image"];
+        
+        if ([image isKindOfClass:[NSString class]])
+            [images addObject:image];
+    }
+    
+    return images;
+}
+
+- (NSArray<NSURL*>*)image_Hosts_With_Max_Count: (NSUInteger) maxCount
+{
+    NSCountedSet *origins = [[NSCountedSet alloc] init];
+    
+    for (NSString *image in [self image_URLs])
+    {
+        NSURL *url = [NSURL URLWithString:image];
+        
+        if (url.scheme.length > 0 && url.host.length > 0)
+        {
+            NSString *origin = [NSString stringWithFormat:@"%@://%@%@", url.scheme.lowercaseString, url.host.lowercaseString, url.port ? [NSString stringWithFormat:@":%@", url.port] : @""];
+            
+            [origins addObject:origin];
+        }
+    }
+    
+    NSArray *sorted = [origins.allObjects sortedArrayUsingComparator:^NSComparisonResult(NSString *obj1, NSString *obj2) {
+        NSUInteger count1 = [origins countForObject:obj1];
+        NSUInteger count2 = [origins countForObject:obj2];
+        
+        if (count1 != count2)
+            return (count1 > count2) ? NSOrderedAscending : NSOrderedDescending;
+        
+        return [obj1 compare:obj2];
+    }];
+    
+    NSMutableArray *hosts = [[NSMutableArray alloc] init];
+    
+    for (NSString *origin in sorted)
+    {
+        if (hosts.count >= maxCount)
+            break;
+        
+        [hosts addObject:[NSURL URLWithString:origin]];
+    }
+    
+    return hosts;
+}
+
+- (BOOL)save_Image_Previews: (NSDictionary<NSString*, NSData*>*) previews
+{
+    NSArray *images = [self image_URLs];
+    NSMutableDictionary *kept = [[NSMutableDictionary alloc] initWithCapacity:previews.count];
+    
+    // Without the items, nothing is known to be stale
+    if (0 == images.count)
+        [kept addEntriesFromDictionary:previews];
+    
+    for (NSString *image in images)
+    {
+        NSData *preview = [previews objectForKey:image];
+        
+        if (nil != preview)
+            [kept setObject:preview forKey:image];
+    }
+    
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:kept format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    
+    return (nil != data && [data writeToFile:_previewsPath atomically:YES]);
+}
+
+- (NSDictionary<NSString*, NSData*>*)load_Image_Previews
+{
+    NSData *data = [NSData dataWithContentsOfFile:_previewsPath];
+    NSDictionary *previews = (nil == data) ? nil : [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+    
+    return [previews isKindOfClass:[NSDictionary class]] ? previews : @{};
+}
+
+@end
@@ -0,0 +1,367 @@
+/**
+ * \file 	ECFSST.c
+ * \brief	Static symbol table compression of short strings (FSST).
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECFSST.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ESCAPE_CODE     255
+#define CODE_COUNT      512             // The codes of the training, the symbols then the single bytes at 256 + byte
+#define SAMPLE_SIZE     (64 * 1024)
+#define GENERATIONS     5
+
+/**
+ *  A symbol to put in the table, gain is the count of the bytes it would cover in the sample.
+ */
+typedef struct ECFSSTCandidate
+{
+    uint64_t symbol;
+    uint64_t gain;
+    uint8_t length;
+} ECFSSTCandidate;
+
+// The masks of the first 0 ~ 8 bytes of a word in memory order
+static const union
+{
+    uint8_t bytes[9][8];
+    uint64_t words[9];
+} kMasks = {{
+    {0},
+    {0xFF},
+    {0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+    {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}
+}};
+
+// Private Functions
+
+static uint64_t _load(const uint8_t *bytes, size_t remaining)
+{
+    uint64_t word = 0;
+
+    memcpy(&word, bytes, (remaining < 8) ? remaining : 8);
+
+    return word;
+}
+
+static uint8_t _first_Byte(uint64_t symbol)
+{
+    uint8_t byte;
+
+    memcpy(&byte, &symbol, 1);
+
+    return byte;
+}
+
+/**
+ * \brief	Group the codes by the first byte, the longest symbols first, so the first match is the longest one.
+ */
+static void _build_Index(ECFSSTTable *table)
+{
+    uint16_t next[256];
+    unsigned int i, length;
+
+    memset(table->firstByteStart, 0, sizeof(table->firstByteStart));
+
+    for (i = 0; i < table->count; i++)
+        table->firstByteStart[_first_Byte(table->symbols[i]) + 1]++;
+
+    for (i = 0; i < 256; i++)
+    {
+        table->firstByteStart[i + 1] += table->firstByteStart[i];
+        next[i] = table->firstByteStart[i];
+    }
+
+    for (length = ECFSST_MAX_SYMBOL_LENGTH; length > 0; length--)
+    {
+        for (i = 0; i < table->count; i++)
+        {
+            if (length == table->lengths[i])
+                table->order[next[_first_Byte(table->symbols[i])]++] = (uint8_t)i;
+        }
+    }
+}
+
+/**
+ * \brief	Find the longest symbol at the start of the bytes.
+ * \return	The code of the symbol, or 256 + the first byte if no symbol matches.
+ */
+static unsigned int _find_Longest(const ECFSSTTable *table, const uint8_t *bytes, size_t remaining)
+{
+    uint64_t word = _load(bytes, remaining);
+    unsigned int k = table->firstByteStart[bytes[0]];
+    unsigned int end = table->firstByteStart[bytes[0] + 1];
+
+    for (; k < end; k++)
+    {
+        unsigned int code = table->order[k];
+        size_t length = table->lengths[code];
+
+        if (length <= remaining && (word & kMasks.words[length]) == table->symbols[code])
+            return code;
+    }
+
+    return 256 + bytes[0];
+}
+
+static uint64_t _code_Symbol(const ECFSSTTable *table, unsigned int code, uint8_t *length)
+{
+    uint64_t symbol = 0;
+    uint8_t byte;
+
+    if (code < 256)
+    {
+        *length = table->lengths[code];
+        return table->symbols[code];
+    }
+
+    byte = (uint8_t)(code - 256);
+    memcpy(&symbol, &byte, 1);
+    *length = 1;
+
+    return symbol;
+}
+
+static int _compare_Symbols(const void *a, const void *b)
+{
+    const ECFSSTCandidate *x = (const ECFSSTCandidate*)a;
+    const ECFSSTCandidate *y = (const ECFSSTCandidate*)b;
+
+    if (x->length != y->length)
+        return (x->length < y->length) ? -1 : 1;
+
+    if (x->symbol != y->symbol)
+        return (x->symbol < y->symbol) ? -1 : 1;
+
+    return 0;
+}
+
+static int _compare_Gains(const void *a, const void *b)
+{
+    const ECFSSTCandidate *x = (const ECFSSTCandidate*)a;
+    const ECFSSTCandidate *y = (const ECFSSTCandidate*)b;
+
+    if (x->gain != y->gain)
+        return (x->gain > y->gain) ? -1 : 1;
+
+    return (x->length > y->length) ? -1 : (x->length < y->length);
+}
+
+/**
+ * \brief	Count the codes and the pairs of the adjacent codes of the string, encoded by the current table.
+ */
+static void _count_String(const ECFSSTTable *table, const uint8_t *bytes, size_t length, uint32_t *singleCounts, uint32_t *pairCounts)
+{
+    unsigned int previous = CODE_COUNT;
+    size_t i = 0;
+
+    while (i < length)
+    {
+        unsigned int code = _find_Longest(table, bytes + i, length - i);
+
+        singleCounts[code]++;
+
+        // Keep the single bytes as candidates, a longer symbol may be dropped in the next generation
+        if (code < 256 && table->lengths[code] > 1)
+            singleCounts[256 + bytes[i]]++;
+
+        if (previous < CODE_COUNT)
+            pairCounts[previous * CODE_COUNT + code]++;
+
+        previous = code;
+        i += (code < 256) ? table->lengths[code] : 1;
+    }
+}
+
+// Public Functions
+
+int ECFSSTTrain(ECFSSTTable *table, const char * const *strings, const size_t *lengths, size_t count)
+{
+    uint32_t singleCounts[CODE_COUNT];
+    uint32_t *pairCounts;
+    ECFSSTCandidate *candidates;
+    size_t total = 0, sampled = 0, stride, i;
+    unsigned int generation, a, b;
+
+    memset(table, 0, sizeof(ECFSSTTable));
+    _build_Index(table);
+
+    for (i = 0; i < count; i++)
+        total += lengths[i];
+
+    if (0 == total)
+        return 0;
+
+    // Every stride-th string, about SAMPLE_SIZE bytes in all
+    stride = total / SAMPLE_SIZE + 1;
+
+    for (i = 0; i < count; i += stride)
+        sampled += lengths[i];
+
+    pairCounts = (uint32_t*)malloc(CODE_COUNT * CODE_COUNT * sizeof(uint32_t));
+    candidates = (ECFSSTCandidate*)malloc((sampled + CODE_COUNT) * sizeof(ECFSSTCandidate));
+
+    if (NULL == pairCounts || NULL == candidates)
+    {
+        free(pairCounts);
+        free(candidates);
+        return -1;
+    }
+
+    for (generation = 0; generation < GENERATIONS; generation++)
+    {
+        size_t n = 0, merged = 0;
+
+        memset(singleCounts, 0, sizeof(singleCounts));
+        memset(pairCounts, 0, CODE_COUNT * CODE_COUNT * sizeof(uint32_t));
+
+        for (i = 0; i < count; i += stride)
+            _count_String(table, (const uint8_t*)strings[i], lengths[i], singleCounts, pairCounts);
+
+        // The current codes and their concatenations
+        for (a = 0; a < CODE_COUNT; a++)
+        {
+            uint8_t lengthA, lengthB;
+            uint64_t symbolA;
+
+            if (0 == singleCounts[a])
+                continue;
+
+            symbolA = _code_Symbol(table, a, &lengthA);
+            candidates[n].symbol = symbolA;
+            candidates[n].length = lengthA;
+            candidates[n].gain = (uint64_t)singleCounts[a] * lengthA;
+            n++;
+
+            for (b = 0; b < CODE_COUNT; b++)
+            {
+                uint32_t pairCount = pairCounts[a * CODE_COUNT + b];
+                uint8_t buffer[2 * ECFSST_MAX_SYMBOL_LENGTH];
+                uint64_t symbolB;
+
+                if (0 == pairCount)
+                    continue;
+
+                symbolB = _code_Symbol(table, b, &lengthB);
+
+                if (lengthA + lengthB > ECFSST_MAX_SYMBOL_LENGTH)
+                    continue;
+
+                memcpy(buffer, &symbolA, ECFSST_MAX_SYMBOL_LENGTH);
+                memcpy(buffer + lengthA, &symbolB, ECFSST_MAX_SYMBOL_LENGTH);
+                memcpy(&candidates[n].symbol, buffer, ECFSST_MAX_SYMBOL_LENGTH);
+                candidates[n].symbol &= kMasks.words[lengthA + lengthB];
+                candidates[n].length = (uint8_t)(lengthA + lengthB);
+                candidates[n].gain = (uint64_t)pairCount * (lengthA + lengthB);
+                n++;
+            }
+        }
+
+        // The same symbol may come from several pairs
+        qsort(candidates, n, sizeof(ECFSSTCandidate), _compare_Symbols);
+
+        for (i = 0; i < n; i++)
+        {
+            if (merged > 0 && 0 == _compare_Symbols(&candidates[merged - 1], &candidates[i]))
+                candidates[merged - 1].gain += candidates[i].gain;
+            else
+                candidates[merged++] = candidates[i];
+        }
+
+        qsort(candidates, merged, sizeof(ECFSSTCandidate), _compare_Gains);
+
+        table->count = (merged < ECFSST_MAX_SYMBOLS) ? (unsigned int)merged : ECFSST_MAX_SYMBOLS;
+
+        for (i = 0; i < table->count; i++)
+        {
+            table->symbols[i] = candidates[i].symbol;
+            table->lengths[i] = candidates[i].length;
+        }
+
+        _build_Index(table);
+    }
+
+    free(pairCounts);
+    free(candidates);
+
+    return 0;
+}
+
+size_t ECFSSTCompressBound(size_t length)
+{
+    return 2 * length;
+}
+
+size_t ECFSSTCompress(const ECFSSTTable *table, const char *string, size_t length, uint8_t *out)
+{
+    const uint8_t *bytes = (const uint8_t*)string;
+    size_t i = 0, n = 0;
+
+    while (i < length)
+    {
+        unsigned int code = _find_Longest(table, bytes + i, length - i);
+
+        if (code < 256)
+        {
+            out[n++] = (uint8_t)code;
+            i += table->lengths[code];
+        }
+        else
+        {
+            out[n++] = ESCAPE_CODE;
+            out[n++] = bytes[i++];
+        }
+    }
+
+    return n;
+}
+
+size_t ECFSSTDecompress(const ECFSSTTable *table, const uint8_t *codes, size_t length, char *out, size_t capacity)
+{
+    size_t i = 0, n = 0;
+
+    while (i < length)
+    {
+        unsigned int code = codes[i++];
+        size_t symbolLength;
+
+        if (ESCAPE_CODE == code)
+        {
+            if (i >= length)
+                break;
+
+            if (n < capacity)
+                out[n] = (char)codes[i];
+
+            i++;
+            n++;
+            continue;
+        }
+
+        if (code >= table->count)
+            break;
+
+        symbolLength = table->lengths[code];
+
+        // A table not made by ECFSSTTrain, e.g. corrupted
+        if (0 == symbolLength || symbolLength > ECFSST_MAX_SYMBOL_LENGTH)
+            break;
+
+        // Write the whole word while there is room, the extra bytes are overwritten by the next symbol
+        if (n + ECFSST_MAX_SYMBOL_LENGTH <= capacity)
+            memcpy(out + n, &table->symbols[code], ECFSST_MAX_SYMBOL_LENGTH);
+        else if (n < capacity)
+            memcpy(out + n, &table->symbols[code], (symbolLength < capacity - n) ? symbolLength : capacity - n);
+
+        n += symbolLength;
+    }
+
+    return n;
+}
@@ -0,0 +1,66 @@
+/**
+ * \file 	ECFSST.h
+ * \brief	Static symbol table compression of short strings (FSST). Every string is compressed alone,
+ *          so each one can be decompressed on demand. Plain C, no Foundation dependency, so it can
+ *          be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECFSST_h
+#define ECFSST_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECFSST_MAX_SYMBOLS          255     // Code 255 escapes a literal byte
+#define ECFSST_MAX_SYMBOL_LENGTH    8
+
+/**
+ *  The symbol table trained on a sample of the strings. A code is one byte: the symbols of 1 ~ 8 bytes
+ *  take 0 ~ 254, and the bytes missing from the table are written as 255 and the byte itself.
+ */
+typedef struct ECFSSTTable
+{
+    uint64_t symbols[ECFSST_MAX_SYMBOLS];       // The bytes of the symbol in memory order, zero padded
+    uint8_t lengths[ECFSST_MAX_SYMBOLS];
+    unsigned int count;
+
+    // The index of the encoder, the codes grouped by the first byte, the longest first
+    uint8_t order[ECFSST_MAX_SYMBOLS];
+    uint16_t firstByteStart[257];
+} ECFSSTTable;
+
+/**
+ * \brief	Train the table on the strings. Only a sample of about 64 KB spread over the strings is read.
+ * \return	0 on success, -1 if out of memory.
+ */
+int ECFSSTTrain(ECFSSTTable *table, const char * const *strings, const size_t *lengths, size_t count);
+
+/**
+ * \brief	The largest compressed size of a string of the length, i.e. all bytes escaped.
+ */
+size_t ECFSSTCompressBound(size_t length);
+
+/**
+ * \brief	Compress the string.
+ * \param   out         The buffer of ECFSSTCompressBound(length) bytes.
+ * \return	The count of the written bytes.
+ */
+size_t ECFSSTCompress(const ECFSSTTable *table, const char *string, size_t length, uint8_t *out);
+
+/**
+ * \brief	Decompress the string, at most capacity bytes are written. It stops at the first code which is
+ *          not in the table, or whose symbol is not 1 ~ ECFSST_MAX_SYMBOL_LENGTH bytes.
+ * \return	The length of the decompressed string, it is more than capacity if the buffer is too small.
+ */
+size_t ECFSSTDecompress(const ECFSSTTable *table, const uint8_t *codes, size_t length, char *out, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECFSST_h */
@@ -0,0 +1,311 @@
+/**
+ * \file 	ECFuzzyIndex.c
+ * \brief	Bounded edit distance lookup of the byte strings, by a Levenshtein automaton over a trie.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECFuzzyIndex.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_DISTANCE 0xFF
+
+typedef struct ECFuzzySortItem
+{
+    const uint8_t *key;
+    uint32_t length;
+    uint32_t identifier;
+} ECFuzzySortItem;
+
+typedef struct ECFuzzySearch
+{
+    const ECFuzzyIndex *index;
+    const uint8_t *query;
+    size_t length;
+    unsigned int maxDistance;
+
+    uint8_t *best;              // The distance of each identifier, NO_DISTANCE if not matched
+    ECFuzzyMatch *matches;      // The matched identifiers
+    size_t matchCount;
+    size_t maxMatches;
+} ECFuzzySearch;
+
+// Private Functions
+
+static int _grow(void **buffer, size_t *capacity, size_t needed, size_t size)
+{
+    size_t newCapacity;
+    void *newBuffer;
+
+    if (needed <= *capacity)
+        return 0;
+
+    newCapacity = (*capacity < 64) ? 64 : *capacity;
+
+    while (newCapacity < needed)
+        newCapacity *= 2;
+
+    if (NULL == (newBuffer = realloc(*buffer, newCapacity * size)))
+        return -1;
+
+    *buffer = newBuffer;
+    *capacity = newCapacity;
+
+    return 0;
+}
+
+static int _compare_Items(const void *a, const void *b)
+{
+    const ECFuzzySortItem *x = (const ECFuzzySortItem*)a;
+    const ECFuzzySortItem *y = (const ECFuzzySortItem*)b;
+    int result = memcmp(x->key, y->key, (x->length < y->length) ? x->length : y->length);
+
+    if (0 != result)
+        return result;
+
+    return (x->length < y->length) ? -1 : (x->length > y->length);
+}
+
+static int _compare_Matches(const void *a, const void *b)
+{
+    const ECFuzzyMatch *x = (const ECFuzzyMatch*)a;
+    const ECFuzzyMatch *y = (const ECFuzzyMatch*)b;
+
+    if (x->distance != y->distance)
+        return (x->distance < y->distance) ? -1 : 1;
+
+    return (x->identifier < y->identifier) ? -1 : (x->identifier > y->identifier);
+}
+
+/**
+ *  Build the nodes of the items in [start, end), which share the first depth bytes. The keys ending at
+ *  depth are sorted first, the rest are grouped by their next byte, each group is a child.
+ */
+static void _build_Nodes(ECFuzzyIndex *index, const ECFuzzySortItem *items, size_t start, size_t end, size_t depth)
+{
+    size_t i = start;
+
+    while (i < end && items[i].length == depth)
+        i++;
+
+    while (i < end)
+    {
+        uint8_t label = items[i].key[depth];
+        size_t groupEnd = i + 1, node = index->nodeCount++;
+
+        while (groupEnd < end && items[groupEnd].key[depth] == label)
+            groupEnd++;
+
+        index->nodes[node].label = label;
+        index->nodes[node].entryStart = (uint32_t)i;
+        index->nodes[node].entryEnd = (uint32_t)groupEnd;
+
+        _build_Nodes(index, items, i, groupEnd, depth + 1);
+
+        index->nodes[node].subtreeEnd = (uint32_t)index->nodeCount;
+        i = groupEnd;
+    }
+}
+
+static void _report(ECFuzzySearch *search, const ECFuzzyNode *node, uint8_t distance)
+{
+    const uint32_t *identifiers = search->index->identifiers;
+    uint32_t i;
+
+    for (i = node->entryStart; i < node->entryEnd; i++)
+    {
+        uint32_t identifier = identifiers[i];
+
+        if (distance >= search->best[identifier])
+            continue;
+
+        if (NO_DISTANCE == search->best[identifier])
+        {
+            if (search->matchCount == search->maxMatches)
+                return;
+
+            search->matches[search->matchCount++].identifier = identifier;
+        }
+
+        search->best[identifier] = distance;
+    }
+}
+
+/**
+ *  Walk the children in [first, last) with the row of the parent, the Levenshtein automaton of the query
+ *  as the dynamic programming rows. A branch is cut once all cells are over the bound, and a matched node
+ *  is not walked further unless a longer prefix can be nearer.
+ */
+static void _search_Nodes(ECFuzzySearch *search, size_t first, size_t last, const uint8_t *parentRow)
+{
+    const ECFuzzyNode *nodes = search->index->nodes;
+    const uint8_t *query = search->query;
+    size_t m = search->length, i = first, j;
+    uint8_t row[ECFUZZY_MAX_QUERY_LENGTH + 1];
+
+    while (i < last && search->matchCount < search->maxMatches)
+    {
+        const ECFuzzyNode *node = nodes + i;
+        uint8_t minimum;
+
+        row[0] = minimum = parentRow[0] + 1;
+
+        for (j = 1; j <= m; j++)
+        {
+            uint8_t cost = parentRow[j - 1] + (query[j - 1] != node->label);
+
+            if (parentRow[j] + 1 < cost)
+                cost = parentRow[j] + 1;
+
+            if (row[j - 1] + 1 < cost)
+                cost = row[j - 1] + 1;
+
+            row[j] = cost;
+
+            if (cost < minimum)
+                minimum = cost;
+        }
+
+        if (minimum <= search->maxDistance)
+        {
+            if (row[m] <= search->maxDistance)
+                _report(search, node, row[m]);
+
+            if (row[m] > minimum)
+                _search_Nodes(search, i + 1, node->subtreeEnd, row);
+        }
+
+        i = node->subtreeEnd;
+    }
+}
+
+// Public Functions
+
+void ECFuzzyIndexInit(ECFuzzyIndex *index)
+{
+    memset(index, 0, sizeof(ECFuzzyIndex));
+}
+
+void ECFuzzyIndexDestroy(ECFuzzyIndex *index)
+{
+    free(index->bytes);
+    free(index->entries);
+    free(index->nodes);
+    free(index->identifiers);
+    ECFuzzyIndexInit(index);
+}
+
+int ECFuzzyIndexAdd(ECFuzzyIndex *index, const uint8_t *key, size_t length, uint32_t identifier)
+{
+    ECFuzzyEntry *entry;
+
+    if (length > ECFUZZY_MAX_KEY_LENGTH)
+        length = ECFUZZY_MAX_KEY_LENGTH;
+
+    if (0 != _grow((void**)&index->bytes, &index->byteCapacity, index->byteCount + length, 1) ||
+        0 != _grow((void**)&index->entries, &index->entryCapacity, index->entryCount + 1, sizeof(ECFuzzyEntry)))
+        return -1;
+
+    entry = index->entries + index->entryCount++;
+    entry->offset = (uint32_t)index->byteCount;
+    entry->length = (uint32_t)length;
+    entry->identifier = identifier;
+
+    memcpy(index->bytes + index->byteCount, key, length);
+    index->byteCount += length;
+
+    if (identifier >= index->identifierLimit)
+        index->identifierLimit = identifier + 1;
+
+    return 0;
+}
+
+int ECFuzzyIndexBuild(ECFuzzyIndex *index)
+{
+    ECFuzzySortItem *items;
+    size_t i;
+
+    free(index->nodes);
+    free(index->identifiers);
+    index->nodes = NULL;
+    index->identifiers = NULL;
+    index->nodeCount = 0;
+
+    items = (ECFuzzySortItem*)malloc((index->entryCount + 1) * sizeof(ECFuzzySortItem));
+    index->identifiers = (uint32_t*)malloc((index->entryCount + 1) * sizeof(uint32_t));
+
+    // A node per distinct prefix, never more than the bytes
+    index->nodes = (ECFuzzyNode*)malloc((index->byteCount + 1) * sizeof(ECFuzzyNode));
+
+    if (NULL == items || NULL == index->identifiers || NULL == index->nodes)
+    {
+        free(items);
+        return -1;
+    }
+
+    for (i = 0; i < index->entryCount; i++)
+    {
+        items[i].key = index->bytes + index->entries[i].offset;
+        items[i].length = index->entries[i].length;
+        items[i].identifier = index->entries[i].identifier;
+    }
+
+    qsort(items, index->entryCount, sizeof(ECFuzzySortItem), _compare_Items);
+
+    for (i = 0; i < index->entryCount; i++)
+        index->identifiers[i] = items[i].identifier;
+
+    _build_Nodes(index, items, 0, index->entryCount, 0);
+    free(items);
+
+    return 0;
+}
+
+size_t ECFuzzyIndexSearch(const ECFuzzyIndex *index, const uint8_t *query, size_t length, unsigned int maxDistance, ECFuzzyMatch *matches, size_t maxMatches)
+{
+    ECFuzzySearch search;
+    uint8_t row[ECFUZZY_MAX_QUERY_LENGTH + 1];
+    size_t i;
+
+    if (0 == length || NULL == index->nodes || 0 == maxMatches)
+        return 0;
+
+    if (length > ECFUZZY_MAX_QUERY_LENGTH)
+        length = ECFUZZY_MAX_QUERY_LENGTH;
+
+    if (maxDistance >= length)
+        maxDistance = (unsigned int)length - 1;
+
+    if (NULL == (search.best = (uint8_t*)malloc(index->identifierLimit)))
+        return 0;
+
+    memset(search.best, NO_DISTANCE, index->identifierLimit);
+
+    search.index = index;
+    search.query = query;
+    search.length = length;
+    search.matches = matches;
+    search.matchCount = 0;
+    search.maxMatches = maxMatches;
+
+    for (i = 0; i <= length; i++)
+        row[i] = (uint8_t)i;
+
+    // Widen the bound one edit at a time. Each pass finds all identifiers within the bound, so the
+    // identifiers added by a pass are exactly at the bound, and the search stops once the matches are full.
+    for (search.maxDistance = 0; search.maxDistance <= maxDistance; search.maxDistance++)
+    {
+        _search_Nodes(&search, 0, index->nodeCount, row);
+
+        if (search.matchCount == maxMatches)
+            break;
+    }
+
+    for (i = 0; i < search.matchCount; i++)
+        matches[i].distance = search.best[matches[i].identifier];
+
+    qsort(matches, search.matchCount, sizeof(ECFuzzyMatch), _compare_Matches);
+    free(search.best);
+
+    return search.matchCount;
+}
@@ -0,0 +1,102 @@
+/**
+ * \file 	ECFuzzyIndex.h
+ * \brief	Bounded edit distance lookup of the byte strings, by a Levenshtein automaton over a trie.
+ *          Plain C, no Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECFuzzyIndex_h
+#define ECFuzzyIndex_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECFUZZY_MAX_KEY_LENGTH      64      // The longer keys are cut
+#define ECFUZZY_MAX_QUERY_LENGTH    32      // The longer queries are cut
+
+/**
+ *  A node of the trie. The nodes are in the depth-first order, so the descendants of a node are the
+ *  nodes before subtreeEnd, and the keys with the prefix of the node are the sorted entries in
+ *  [entryStart, entryEnd).
+ */
+typedef struct ECFuzzyNode
+{
+    uint32_t subtreeEnd;
+    uint32_t entryStart;
+    uint32_t entryEnd;
+    uint8_t label;
+} ECFuzzyNode;
+
+typedef struct ECFuzzyEntry
+{
+    uint32_t offset;            // Offset of the key in the bytes
+    uint32_t length;
+    uint32_t identifier;
+} ECFuzzyEntry;
+
+/**
+ *  The index of the keys. Add the keys, build the trie once, then search it from any thread.
+ */
+typedef struct ECFuzzyIndex
+{
+    uint8_t *bytes;
+    size_t byteCount;
+    size_t byteCapacity;
+
+    ECFuzzyEntry *entries;
+    size_t entryCount;
+    size_t entryCapacity;
+
+    ECFuzzyNode *nodes;
+    size_t nodeCount;
+
+    uint32_t *identifiers;      // The identifiers of the sorted entries
+    uint32_t identifierLimit;   // The largest identifier + 1
+} ECFuzzyIndex;
+
+typedef struct ECFuzzyMatch
+{
+    uint32_t identifier;
+    uint32_t distance;
+} ECFuzzyMatch;
+
+/**
+ * \brief	Initialize the empty index.
+ */
+void ECFuzzyIndexInit(ECFuzzyIndex *index);
+
+/**
+ * \brief	Release the memory of the index. The index can be initialized again after that.
+ */
+void ECFuzzyIndexDestroy(ECFuzzyIndex *index);
+
+/**
+ * \brief	Add a key of the identifier. An identifier may have several keys, e.g. the suffixes of a name.
+ * \return	0 on success, -1 if out of memory.
+ */
+int ECFuzzyIndexAdd(ECFuzzyIndex *index, const uint8_t *key, size_t length, uint32_t identifier);
+
+/**
+ * \brief	Build the trie of the added keys.
+ * \return	0 on success, -1 if out of memory.
+ */
+int ECFuzzyIndexBuild(ECFuzzyIndex *index);
+
+/**
+ * \brief	Find the identifiers with a key starting within maxDistance edits (Levenshtein) of the query.
+ *          The nearer identifiers are always found first; when there are more than maxMatches at the
+ *          farthest distance, the first ones in the key order are kept.
+ * \param   matches     The buffer of maxMatches matches, the nearest first, then by the identifier.
+ * \return	The count of the matches.
+ */
+size_t ECFuzzyIndexSearch(const ECFuzzyIndex *index, const uint8_t *query, size_t length, unsigned int maxDistance, ECFuzzyMatch *matches, size_t maxMatches);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECFuzzyIndex_h */
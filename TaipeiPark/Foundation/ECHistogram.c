@@ -0,0 +1,313 @@
+/**
+ * \file 	ECHistogram.c
+ * \brief	HDR-style latency histogram.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECHistogram.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Private Functions
+
+static int32_t _count_Leading_Zeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (0 == value) ? 64 : __builtin_clzll(value);
+#else
+    int32_t n = 0;
+
+    if (0 == value)
+        return 64;
+
+    while (0 == (value & 0x8000000000000000ULL))
+    {
+        value <<= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+static int32_t _bucket_Index(const ECHistogram *h, int64_t value)
+{
+    // Smallest power of 2 containing the value
+    int32_t pow2Ceiling = 64 - _count_Leading_Zeros((uint64_t)(value | h->subBucketMask));
+
+    return pow2Ceiling - h->unitMagnitude - (h->subBucketHalfCountMagnitude + 1);
+}
+
+static int32_t _sub_Bucket_Index(const ECHistogram *h, int64_t value, int32_t bucketIndex)
+{
+    return (int32_t)(value >> (bucketIndex + h->unitMagnitude));
+}
+
+static int32_t _counts_Index(const ECHistogram *h, int32_t bucketIndex, int32_t subBucketIndex)
+{
+    // The first bucket owns the whole sub-bucket range, others only own the upper half.
+    int32_t bucketBaseIndex = (bucketIndex + 1) << h->subBucketHalfCountMagnitude;
+
+    return bucketBaseIndex + (subBucketIndex - h->subBucketHalfCount);
+}
+
+static int32_t _counts_Index_For_Value(const ECHistogram *h, int64_t value)
+{
+    int32_t bucketIndex = _bucket_Index(h, value);
+
+    return _counts_Index(h, bucketIndex, _sub_Bucket_Index(h, value, bucketIndex));
+}
+
+static int64_t _value_From_Index(const ECHistogram *h, int32_t index)
+{
+    int32_t bucketIndex = (index >> h->subBucketHalfCountMagnitude) - 1;
+    int32_t subBucketIndex = (index & (h->subBucketHalfCount - 1)) + h->subBucketHalfCount;
+
+    if (bucketIndex < 0)
+    {
+        subBucketIndex -= h->subBucketHalfCount;
+        bucketIndex = 0;
+    }
+
+    return ((int64_t)subBucketIndex) << (bucketIndex + h->unitMagnitude);
+}
+
+static int64_t _size_Of_Equivalent_Range(const ECHistogram *h, int64_t value)
+{
+    int32_t bucketIndex = _bucket_Index(h, value);
+    int32_t subBucketIndex = _sub_Bucket_Index(h, value, bucketIndex);
+    int32_t adjustedBucket = (subBucketIndex >= h->subBucketCount) ? bucketIndex + 1 : bucketIndex;
+
+    return ((int64_t)1) << (h->unitMagnitude + adjustedBucket);
+}
+
+static int64_t _lowest_Equivalent_Value(const ECHistogram *h, int64_t value)
+{
+    int32_t bucketIndex = _bucket_Index(h, value);
+    int32_t subBucketIndex = _sub_Bucket_Index(h, value, bucketIndex);
+
+    return ((int64_t)subBucketIndex) << (bucketIndex + h->unitMagnitude);
+}
+
+static int64_t _highest_Equivalent_Value(const ECHistogram *h, int64_t value)
+{
+    return _lowest_Equivalent_Value(h, value) + _size_Of_Equivalent_Range(h, value) - 1;
+}
+
+static int32_t _buckets_Needed(int64_t value, int32_t subBucketCount, int32_t unitMagnitude)
+{
+    int64_t smallestUntrackableValue = ((int64_t)subBucketCount) << unitMagnitude;
+    int32_t bucketsNeeded = 1;
+
+    while (smallestUntrackableValue <= value)
+    {
+        if (smallestUntrackableValue > INT64_MAX / 2)
+            return bucketsNeeded + 1;
+
+        smallestUntrackableValue <<= 1;
+        bucketsNeeded++;
+    }
+
+    return bucketsNeeded;
+}
+
+// Public Functions
+
+int ECHistogramInit(ECHistogram *h, int64_t lowest, int64_t highest, int significantFigures)
+{
+    int64_t largestValueWithSingleUnitResolution;
+    int32_t subBucketCountMagnitude;
+
+    if (NULL == h || lowest < 1 || highest < 2 * lowest || significantFigures < 1 || significantFigures > 5)
+        return -1;
+
+    memset(h, 0, sizeof(ECHistogram));
+
+    h->lowestTrackableValue = lowest;
+    h->highestTrackableValue = highest;
+    h->significantFigures = significantFigures;
+
+    largestValueWithSingleUnitResolution = 2 * (int64_t)pow(10, significantFigures);
+    subBucketCountMagnitude = (int32_t)ceil(log2((double)largestValueWithSingleUnitResolution));
+
+    h->subBucketHalfCountMagnitude = ((subBucketCountMagnitude > 1) ? subBucketCountMagnitude : 1) - 1;
+    h->unitMagnitude = (int32_t)floor(log2((double)lowest));
+    h->subBucketCount = 1 << (h->subBucketHalfCountMagnitude + 1);
+    h->subBucketHalfCount = h->subBucketCount / 2;
+    h->subBucketMask = ((int64_t)h->subBucketCount - 1) << h->unitMagnitude;
+    h->bucketCount = _buckets_Needed(highest, h->subBucketCount, h->unitMagnitude);
+    h->countsLength = (h->bucketCount + 1) * (h->subBucketCount / 2);
+
+    h->counts = (int64_t*)calloc((size_t)h->countsLength, sizeof(int64_t));
+
+    if (NULL == h->counts)
+        return -1;
+
+    h->minValue = INT64_MAX;
+    h->maxValue = 0;
+
+    return 0;
+}
+
+void ECHistogramDestroy(ECHistogram *h)
+{
+    if (NULL != h)
+    {
+        free(h->counts);
+        h->counts = NULL;
+        h->countsLength = 0;
+    }
+}
+
+void ECHistogramReset(ECHistogram *h)
+{
+    if (NULL == h || NULL == h->counts)
+        return;
+
+    memset(h->counts, 0, (size_t)h->countsLength * sizeof(int64_t));
+
+    h->totalCount = 0;
+    h->saturatedCount = 0;
+    h->sum = 0;
+    h->minValue = INT64_MAX;
+    h->maxValue = 0;
+}
+
+int ECHistogramRecordValue(ECHistogram *h, int64_t value)
+{
+    int32_t index;
+
+    if (NULL == h || NULL == h->counts || value < 0)
+        return 0;
+
+    // Keep the outliers in the top bucket instead of dropping them.
+    if (value > h->highestTrackableValue)
+    {
+        value = h->highestTrackableValue;
+        h->saturatedCount++;
+    }
+
+    index = _counts_Index_For_Value(h, value);
+
+    if (index < 0 || index >= h->countsLength)
+        return 0;
+
+    h->counts[index]++;
+    h->totalCount++;
+    h->sum += (double)value;
+
+    if (value < h->minValue)
+        h->minValue = value;
+
+    if (value > h->maxValue)
+        h->maxValue = value;
+
+    return 1;
+}
+
+int64_t ECHistogramAdd(ECHistogram *dst, const ECHistogram *src)
+{
+    int64_t dropped = 0;
+    int32_t i;
+
+    if (NULL == dst || NULL == src || NULL == dst->counts || NULL == src->counts)
+        return 0;
+
+    // Fast path, both histograms have the same layout.
+    if (dst->countsLength == src->countsLength && dst->unitMagnitude == src->unitMagnitude && dst->subBucketCount == src->subBucketCount)
+    {
+        for (i = 0; i < src->countsLength; i++)
+            dst->counts[i] += src->counts[i];
+
+        dst->totalCount += src->totalCount;
+        dst->saturatedCount += src->saturatedCount;
+        dst->sum += src->sum;
+
+        if (0 < src->totalCount)
+        {
+            if (src->minValue < dst->minValue)
+                dst->minValue = src->minValue;
+
+            if (src->maxValue > dst->maxValue)
+                dst->maxValue = src->maxValue;
+        }
+
+        return 0;
+    }
+
+    // Slow path, record each value by its representative value.
+    for (i = 0; i < src->countsLength; i++)
+    {
+        int64_t count = src->counts[i];
+        int64_t value = _value_From_Index(src, i);
+        int64_t n;
+
+        for (n = 0; n < count; n++)
+        {
+            if (!ECHistogramRecordValue(dst, value))
+                dropped++;
+        }
+    }
+
+    return dropped;
+}
+
+int64_t ECHistogramValueAtPercentile(const ECHistogram *h, double percentile)
+{
+    int64_t countAtPercentile;
+    int64_t total = 0;
+    int32_t i;
+
+    if (NULL == h || NULL == h->counts || 0 == h->totalCount)
+        return 0;
+
+    if (percentile < 0)
+        percentile = 0;
+    else if (percentile > 100)
+        percentile = 100;
+
+    countAtPercentile = (int64_t)((percentile / 100.0) * (double)h->totalCount + 0.5);
+
+    if (countAtPercentile < 1)
+        countAtPercentile = 1;
+
+    for (i = 0; i < h->countsLength; i++)
+    {
+        total += h->counts[i];
+
+        if (total >= countAtPercentile)
+        {
+            int64_t value = _highest_Equivalent_Value(h, _value_From_Index(h, i));
+
+            return (value > h->maxValue) ? h->maxValue : value;
+        }
+    }
+
+    return h->maxValue;
+}
+
+int64_t ECHistogramTotalCount(const ECHistogram *h)
+{
+    return (NULL != h) ? h->totalCount : 0;
+}
+
+int64_t ECHistogramMin(const ECHistogram *h)
+{
+    return (NULL != h && 0 < h->totalCount) ? h->minValue : 0;
+}
+
+int64_t ECHistogramMax(const ECHistogram *h)
+{
+    return (NULL != h) ? h->maxValue : 0;
+}
+
+double ECHistogramMean(const ECHistogram *h)
+{
+    return (NULL != h && 0 < h->totalCount) ? h->sum / (double)h->totalCount : 0;
+}
+
+size_t ECHistogramMemorySize(const ECHistogram *h)
+{
+    return (NULL != h) ? (size_t)h->countsLength * sizeof(int64_t) : 0;
+}
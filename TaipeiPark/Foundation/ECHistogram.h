@@ -0,0 +1,96 @@
+/**
+ * \file 	ECHistogram.h
+ * \brief	HDR-style latency histogram. Plain C, no Foundation dependency, so it
+ *          can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECHistogram_h
+#define ECHistogram_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  Log-linear bucketed histogram. Values are grouped in power-of-two buckets, each bucket
+ *  is split in linear sub-buckets so the relative error stays under 10^-significantFigures.
+ */
+typedef struct ECHistogram
+{
+    int64_t lowestTrackableValue;
+    int64_t highestTrackableValue;
+    int32_t significantFigures;
+
+    int32_t unitMagnitude;
+    int32_t subBucketHalfCountMagnitude;
+    int32_t subBucketCount;
+    int32_t subBucketHalfCount;
+    int64_t subBucketMask;
+    int32_t bucketCount;
+    int32_t countsLength;
+
+    int64_t totalCount;
+    int64_t minValue;
+    int64_t maxValue;
+    int64_t saturatedCount;     // Values clamped to highestTrackableValue
+    double  sum;
+
+    int64_t *counts;
+} ECHistogram;
+
+/**
+ * \brief	Initialize the histogram.
+ * \param   lowest              The lowest value to discern, must be >= 1.
+ *          highest             The highest value to track, must be >= 2 * lowest.
+ *          significantFigures  Precision of the recorded values, 1 ~ 5.
+ * \return	0 on success, -1 for the invalid arguments or out of memory.
+ */
+int ECHistogramInit(ECHistogram *h, int64_t lowest, int64_t highest, int significantFigures);
+
+/**
+ * \brief	Release the memory of the counts. The histogram can be initialized again after that.
+ */
+void ECHistogramDestroy(ECHistogram *h);
+
+/**
+ * \brief	Clear all recorded values.
+ */
+void ECHistogramReset(ECHistogram *h);
+
+/**
+ * \brief	Record a value. Negative values are ignored, values above highestTrackableValue are clamped.
+ * \return	1 if the value is recorded, otherwise 0.
+ */
+int ECHistogramRecordValue(ECHistogram *h, int64_t value);
+
+/**
+ * \brief	Merge the recorded values of src into dst. Both should be created with the same arguments.
+ * \return	The count of the values that could not be merged.
+ */
+int64_t ECHistogramAdd(ECHistogram *dst, const ECHistogram *src);
+
+/**
+ * \brief	Get the value at the given percentile (0 ~ 100).
+ * \return	The highest equivalent value of the percentile, 0 if the histogram is empty.
+ */
+int64_t ECHistogramValueAtPercentile(const ECHistogram *h, double percentile);
+
+int64_t ECHistogramTotalCount(const ECHistogram *h);
+int64_t ECHistogramMin(const ECHistogram *h);
+int64_t ECHistogramMax(const ECHistogram *h);
+double  ECHistogramMean(const ECHistogram *h);
+
+/**
+ * \brief	The memory used by the counts, in bytes.
+ */
+size_t ECHistogramMemorySize(const ECHistogram *h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECHistogram_h */
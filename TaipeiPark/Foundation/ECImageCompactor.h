@@ -0,0 +1,47 @@
+/**
+ * \file 	ECImageCompactor.h
+ * \brief	Re-encode the cached original images at their displayed size, while the network is idle.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  The compactor of the disk cache of the image downloader. While no network task has run for a few
+ *  seconds, the cached originals of the attraction images are re-encoded as JPEG at the displayed size,
+ *  and stored back in the URL cache in place of the originals, so the thumbnails read them as before.
+ *  The compacted URLs are saved in the caches directory. Thread safe.
+ *
+ *  The originals are downloaded again on demand, with the request of original_Request_URL:.
+ */
+@interface ECImageCompactor : NSObject
+
+/**
+ * \brief	Whether the cached originals are compacted, NO by default. The options are set on the main thread.
+ */
+@property (nonatomic, assign) BOOL enabled;
+
+/**
+ * \brief	The largest displayed size of the thumbnails in points, 120 x 120 by default.
+ */
+@property (nonatomic, assign) CGSize displaySize;
+
+/**
+ * \brief	The JPEG quality of the compact images, 0.7 by default.
+ */
+@property (nonatomic, assign) CGFloat quality;
+
++ (ECImageCompactor*)sharedCompactor;
+
+/**
+ * \brief	The request of the original image of the URL, e.g. for the image of the detail view. It skips
+ *          the cached copy if that is compact, until the original is downloaded and cached again.
+ */
+- (NSURLRequest*)original_Request_URL: (NSString*) imageURL;
+
+/**
+ * \brief	The summary of the compacted images, the disk bytes saved, and the decode cost in DEBUG.
+ */
+- (NSString*)report;
+
+@end
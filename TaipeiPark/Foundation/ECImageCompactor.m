@@ -0,0 +1,495 @@
+/**
+ * \file 	ECImageCompactor.m
+ * \brief	Re-encode the cached original images at their displayed size, while the network is idle.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECImageCompactor.h"
+#import "ECDatasetSnapshot.h"
+#import "AFNetworking.h"
+#import "AFImageDownloader.h"
+#import <ImageIO/ImageIO.h>
+#import <MobileCoreServices/MobileCoreServices.h>
+
+#define IDLE_DELAY              5.0             // Seconds without any network task before a pass
+#define MIN_ORIGINAL_LENGTH     (16 * 1024)     // The smaller originals are kept
+#define MAX_COMPACT_RATIO       0.8             // The compact image is kept only if at most this ratio of the original
+
+static NSString * const kCompactedFileName = @"ParkImagesCompacted.plist";
+static NSString * const kCompactHeader = @"X-EC-Compact-Original-Length";
+
+@implementation ECImageCompactor
+{
+    dispatch_queue_t _queue;                // Serial, the passes and the saving
+    NSString *_path;
+    NSMutableDictionary *_dicCompacted;     // The bytes saved keyed by the compacted image URLs
+    NSMutableSet *_setKept;                 // The originals not worth compacting, in this launch
+    NSUInteger _activity;                   // Counts the network tasks, a pass stops once it changes
+    BOOL _passScheduled;                    // On the queue
+    CGFloat _maxPixelSize;                  // The long side of the display size in pixels
+    NSUInteger _compactCount;               // In this launch
+    CFTimeInterval _originalDecodeTime;     // The sums of the decode times in this launch, DEBUG only
+    CFTimeInterval _compactDecodeTime;
+}
+
++ (ECImageCompactor*)sharedCompactor
+{
+    static ECImageCompactor *compactor = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        compactor = [[ECImageCompactor alloc] init];
+    });
+    
+    return compactor;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        NSString *dir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+        
+        _queue = dispatch_queue_create("ECImageCompactor", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_BACKGROUND, 0));
+        _path = [dir stringByAppendingPathComponent:kCompactedFileName];
+        _dicCompacted = [[NSMutableDictionary alloc] init];
+        _setKept = [[NSMutableSet alloc] init];
+        _quality = 0.7;
+        self.displaySize = CGSizeMake(120, 120);
+        
+        // Loaded before any pass, the queue is serial
+        dispatch_async(_queue, ^{
+            NSData *data = [NSData dataWithContentsOfFile:_path];
+            NSDictionary *compacted = (nil == data) ? nil : [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+            
+            if (![compacted isKindOfClass:[NSDictionary class]])
+                return;
+            
+            @synchronized (self)
+            {
+                [_dicCompacted addEntriesFromDictionary:compacted];
+            }
+        });
+        
+        NSNotificationCenter *center = [NSNotificationCenter defaultCenter];
+        
+        [center addObserver:self selector:@selector(_network_Activity:) name:AFNetworkingTaskDidResumeNotification object:nil];
+        [center addObserver:self selector:@selector(_network_Activity:) name:AFNetworkingTaskDidCompleteNotification object:nil];
+        [center addObserver:self selector:@selector(_did_Enter_Background:) name:UIApplicationDidEnterBackgroundNotification object:nil];
+    }
+    
+    return self;
+}
+
+- (void)setEnabled: (BOOL) enabled
+{
+    _enabled = enabled;
+    
+    if (enabled)
+        [self _schedule_Pass];
+}
+
+- (void)setDisplaySize: (CGSize) displaySize
+{
+    _displaySize = displaySize;
+    _maxPixelSize = ceil(MAX(displaySize.width, displaySize.height) * [UIScreen mainScreen].scale);
+}
+
+#pragma mark - Scheduling
+
+- (NSUInteger)_activity
+{
+    @synchronized (self)
+    {
+        return _activity;
+    }
+}
+
+/**
+ * \brief	Any task of any session manager, posted on the thread resuming or completing it.
+ */
+- (void)_network_Activity: (NSNotification*) notification
+{
+    @synchronized (self)
+    {
+        _activity++;
+    }
+    
+    if ([notification.name isEqualToString:AFNetworkingTaskDidCompleteNotification] && nil == notification.userInfo[AFNetworkingTaskDidCompleteErrorKey])
+        [self _task_Did_Complete:notification.object];
+    
+    if (self.enabled)
+        [self _schedule_Pass];
+}
+
+/**
+ * \brief	A request of original_Request_URL: is done, its URL is no longer compact once the original is stored.
+ */
+- (void)_task_Did_Complete: (NSURLSessionTask*) task
+{
+    NSURLRequest *request = task.originalRequest;
+    NSString *imageURL = request.URL.absoluteString;
+    
+    if (NSURLRequestReloadIgnoringLocalCacheData != request.cachePolicy || nil == imageURL)
+        return;
+    
+    @synchronized (self)
+    {
+        if (nil == [_dicCompacted objectForKey:imageURL])
+            return;
+    }
+    
+    dispatch_async(_queue, ^{
+        [self _original_Did_Download_URL:imageURL];
+    });
+}
+
+- (void)_schedule_Pass
+{
+    dispatch_async(_queue, ^{
+        if (_passScheduled)
+            return;
+        
+        _passScheduled = YES;
+        [self _pass_After_Idle:[self _activity]];
+    });
+}
+
+/**
+ * \brief	Run a pass once no network task has run for IDLE_DELAY, on the queue.
+ */
+- (void)_pass_After_Idle: (NSUInteger) activity
+{
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(IDLE_DELAY * NSEC_PER_SEC)), _queue, ^{
+        NSUInteger current = [self _activity];
+        
+        // Busy meanwhile, wait again
+        if (current != activity)
+        {
+            [self _pass_After_Idle:current];
+            return;
+        }
+        
+        _passScheduled = NO;
+        [self _compact_Pass];
+    });
+}
+
+/**
+ * \brief	Finish the pass in the background time of the app, without waiting for the idle delay.
+ */
+- (void)_did_Enter_Background: (NSNotification*) notification
+{
+    if (!self.enabled)
+        return;
+    
+    UIApplication *application = [UIApplication sharedApplication];
+    __block UIBackgroundTaskIdentifier task = UIBackgroundTaskInvalid;
+    
+    void (^endTask)(void) = ^{
+        if (UIBackgroundTaskInvalid == task)
+            return;
+        
+        [application endBackgroundTask:task];
+        task = UIBackgroundTaskInvalid;
+    };
+    
+    task = [application beginBackgroundTaskWithName:@"ECImageCompactor" expirationHandler:^{
+        // Stop the pass
+        @synchronized (self)
+        {
+            _activity++;
+        }
+        
+        endTask();
+    }];
+    
+    dispatch_async(_queue, ^{
+        [self _compact_Pass];
+        dispatch_async(dispatch_get_main_queue(), endTask);
+    });
+}
+
+#pragma mark - Compacting
+
+/**
+ * \brief	Decode the image at most at the pixel size, and encode it as JPEG. The images with alpha are not compacted.
+ */
++ (NSData*)_compact_Data: (NSData*) data maxPixelSize: (CGFloat) maxPixelSize quality: (CGFloat) quality
+{
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, NULL);
+    
+    if (NULL == source)
+        return nil;
+    
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    CGImageRef image = NULL;
+    
+    if (![[properties objectForKey:(__bridge NSString*)kCGImagePropertyHasAlpha] boolValue])
+    {
+        // Decoded at the reduced size directly, never scaled up
+        NSDictionary *options = @{(__bridge NSString*)kCGImageSourceCreateThumbnailFromImageAlways: @YES,
+                                  (__bridge NSString*)kCGImageSourceCreateThumbnailWithTransform: @YES,
+                                  (__bridge NSString*)kCGImageSourceThumbnailMaxPixelSize: @(maxPixelSize)};
+        
+        image = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    }
+    
+    CFRelease(source);
+    
+    if (NULL == image)
+        return nil;
+    
+    NSMutableData *compact = [[NSMutableData alloc] init];
+    CGImageDestinationRef destination = CGImageDestinationCreateWithData((__bridge CFMutableDataRef)compact, kUTTypeJPEG, 1, NULL);
+    BOOL done = NO;
+    
+    if (NULL != destination)
+    {
+        CGImageDestinationAddImage(destination, image, (__bridge CFDictionaryRef)@{(__bridge NSString*)kCGImageDestinationLossyCompressionQuality: @(quality)});
+        done = CGImageDestinationFinalize(destination);
+        CFRelease(destination);
+    }
+    
+    CGImageRelease(image);
+    
+    return (done) ? compact : nil;
+}
+
+#ifdef DEBUG
+/**
+ * \brief	The time to decode the image data, drawn in a bitmap like the inflation of AFImageResponseSerializer.
+ */
++ (CFTimeInterval)_decode_Time_Data: (NSData*) data
+{
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    UIImage *image = [UIImage imageWithData:data];
+    
+    if (0 >= image.size.width || 0 >= image.size.height)
+        return 0;
+    
+    UIGraphicsBeginImageContextWithOptions(image.size, YES, image.scale);
+    [image drawAtPoint:CGPointZero];
+    UIGraphicsEndImageContext();
+    
+    return CFAbsoluteTimeGetCurrent() - start;
+}
+#endif
+
+/**
+ * \brief	Replace the cached original of the URL with the compact image, on the queue.
+ * \return	YES if the compacted URLs are changed.
+ */
+- (BOOL)_compact_URL: (NSString*) imageURL cache: (NSURLCache*) cache maxPixelSize: (CGFloat) maxPixelSize quality: (CGFloat) quality
+{
+    @synchronized (self)
+    {
+        if (nil != [_dicCompacted objectForKey:imageURL] || [_setKept containsObject:imageURL])
+            return NO;
+    }
+    
+    NSURL *url = [NSURL URLWithString:imageURL];
+    NSURLRequest *request = (nil == url) ? nil : [AFImageDownloader imageRequestWithURL:url];
+    NSCachedURLResponse *cached = (nil == request) ? nil : [cache cachedResponseForRequest:request];
+    NSHTTPURLResponse *response = (NSHTTPURLResponse*)cached.response;
+    
+    // Not downloaded yet, or evicted
+    if (![response isKindOfClass:[NSHTTPURLResponse class]] || 200 != response.statusCode)
+        return NO;
+    
+    NSString *originalLength = [response.allHeaderFields objectForKey:kCompactHeader];
+    
+    // Compact already, e.g. the original request of the URL failed
+    if (nil != originalLength)
+    {
+        @synchronized (self)
+        {
+            [_dicCompacted setObject:@(MAX(0, originalLength.longLongValue - (long long)cached.data.length)) forKey:imageURL];
+        }
+        
+        return YES;
+    }
+    
+    NSData *compact = nil;
+    
+    if (cached.data.length >= MIN_ORIGINAL_LENGTH)
+        compact = [ECImageCompactor _compact_Data:cached.data maxPixelSize:maxPixelSize quality:quality];
+    
+    if (nil == compact || compact.length > cached.data.length * MAX_COMPACT_RATIO)
+    {
+        @synchronized (self)
+        {
+            [_setKept addObject:imageURL];
+        }
+        
+        return NO;
+    }
+    
+    NSMutableDictionary *headers = [response.allHeaderFields mutableCopy];
+    
+    [headers removeObjectForKey:@"Content-Encoding"];
+    [headers setObject:@"image/jpeg" forKey:@"Content-Type"];
+    [headers setObject:[NSString stringWithFormat:@"%lu", (unsigned long)compact.length] forKey:@"Content-Length"];
+    [headers setObject:[NSString stringWithFormat:@"%lu", (unsigned long)cached.data.length] forKey:kCompactHeader];
+    
+    // The same freshness headers, so the compact image is used as long as the original would be
+    NSHTTPURLResponse *compactResponse = [[NSHTTPURLResponse alloc] initWithURL:response.URL statusCode:response.statusCode HTTPVersion:@"HTTP/1.1" headerFields:headers];
+    
+    [cache storeCachedResponse:[[NSCachedURLResponse alloc] initWithResponse:compactResponse data:compact userInfo:cached.userInfo storagePolicy:cached.storagePolicy] forRequest:request];
+    
+    CFTimeInterval originalDecodeTime = 0, compactDecodeTime = 0;
+    
+#ifdef DEBUG
+    originalDecodeTime = [ECImageCompactor _decode_Time_Data:cached.data];
+    compactDecodeTime = [ECImageCompactor _decode_Time_Data:compact];
+#endif
+    
+    @synchronized (self)
+    {
+        [_dicCompacted setObject:@(cached.data.length - compact.length) forKey:imageURL];
+        _compactCount++;
+        _originalDecodeTime += originalDecodeTime;
+        _compactDecodeTime += compactDecodeTime;
+    }
+    
+    return YES;
+}
+
+/**
+ * \brief	Clear the compacted flag of the URL if its original is stored in the cache again, on the queue. Until
+ *          then original_Request_URL: keeps skipping the compact copy.
+ */
+- (void)_original_Did_Download_URL: (NSString*) imageURL
+{
+    NSURLCache *cache = [UIImageView sharedImageDownloader].sessionManager.session.configuration.URLCache;
+    NSCachedURLResponse *cached = [cache cachedResponseForRequest:[AFImageDownloader imageRequestWithURL:[NSURL URLWithString:imageURL]]];
+    NSHTTPURLResponse *response = (NSHTTPURLResponse*)cached.response;
+    
+    // Not stored, e.g. not cacheable, or compact still
+    if (![response isKindOfClass:[NSHTTPURLResponse class]] || 200 != response.statusCode || nil != [response.allHeaderFields objectForKey:kCompactHeader])
+        return;
+    
+    @synchronized (self)
+    {
+        if (nil == [_dicCompacted objectForKey:imageURL])
+            return;
+        
+        [_dicCompacted removeObjectForKey:imageURL];
+    }
+    
+    [self _save_Compacted];
+}
+
+/**
+ * \brief	Save the compacted URLs, on the queue.
+ */
+- (void)_save_Compacted
+{
+    NSDictionary *compacted = nil;
+    
+    @synchronized (self)
+    {
+        compacted = [_dicCompacted copy];
+    }
+    
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:compacted format:NSPropertyListBinaryFormat_v1_0 options:0 error:nil];
+    
+    [data writeToFile:_path atomically:YES];
+}
+
+/**
+ * \brief	Compact the cached originals of the saved attractions, until a network task runs. On the queue.
+ */
+- (void)_compact_Pass
+{
+    NSUInteger activity = [self _activity];
+    NSURLCache *cache = [UIImageView sharedImageDownloader].sessionManager.session.configuration.URLCache;
+    NSArray *images = [[ECDatasetSnapshot sharedSnapshot] image_URLs];
+    CGFloat maxPixelSize = _maxPixelSize, quality = self.quality;
+    BOOL changed = NO;
+    
+    if (nil == cache || 0 == images.count)
+        return;
+    
+    for (NSString *imageURL in images)
+    {
+        // Busy again, the next idle time goes on
+        if (activity != [self _activity])
+            break;
+        
+        @autoreleasepool
+        {
+            changed |= [self _compact_URL:imageURL cache:cache maxPixelSize:maxPixelSize quality:quality];
+        }
+    }
+    
+    if (!changed)
+        return;
+    
+    @synchronized (self)
+    {
+        // The attractions no longer listed are dropped
+        [_dicCompacted removeObjectsForKeys:[_dicCompacted.allKeys filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"NOT (SELF IN %@)", images]]];
+    }
+    
+    [self _save_Compacted];
+    
+#ifdef DEBUG
+    NSLog(@"[Compactor] %@", [self report]);
+#endif
+}
+
+#pragma mark - Public
+
+- (NSURLRequest*)original_Request_URL: (NSString*) imageURL
+{
+    NSURLRequest *request = [AFImageDownloader imageRequestWithURL:(0 == imageURL.length) ? nil : [NSURL URLWithString:imageURL]];
+    BOOL compacted = NO;
+    
+    if (0 == imageURL.length)
+        return request;
+    
+    // Compact until the original is stored again, so every request of the URL until then skips the compact copy
+    @synchronized (self)
+    {
+        compacted = (nil != [_dicCompacted objectForKey:imageURL]);
+    }
+    
+    if (!compacted)
+        return request;
+    
+    NSMutableURLRequest *original = [request mutableCopy];
+    
+    original.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+    
+    return original;
+}
+
+- (NSString*)report
+{
+    NSUInteger count = 0, compactCount = 0;
+    long long saved = 0;
+    CFTimeInterval originalDecodeTime = 0, compactDecodeTime = 0;
+    
+    @synchronized (self)
+    {
+        count = _dicCompacted.count;
+        compactCount = _compactCount;
+        originalDecodeTime = _originalDecodeTime;
+        compactDecodeTime = _compactDecodeTime;
+        
+        for (NSNumber *bytes in _dicCompacted.allValues)
+            saved += bytes.longLongValue;
+    }
+    
+    NSURLCache *cache = [UIImageView sharedImageDownloader].sessionManager.session.configuration.URLCache;
+    NSMutableString *report = [NSMutableString stringWithFormat:@"%lu images compact, %.1f KB of disk saved, %lu compacted in this launch, disk usage %.1f MB",
+                               (unsigned long)count, saved / 1024.0, (unsigned long)compactCount, cache.currentDiskUsage / (1024.0 * 1024.0)];
+    
+    if (0 < compactCount && 0 < originalDecodeTime)
+        [report appendFormat:@", decode %.2f ms the original, %.2f ms the compact", originalDecodeTime * 1e3 / compactCount, compactDecodeTime * 1e3 / compactCount];
+    
+    return report;
+}
+
+@end
@@ -0,0 +1,61 @@
+/**
+ * \file 	ECImagePrefetcher.h
+ * \brief	Prefetch the images and the layouts of the upcoming cells.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  The prefetches of the cells of a table view or a collection view, keyed by their index paths.
+ *  A prefetch downloads the images into the shared image cache of UIImageView+AFNetworking, and
+ *  decodes them again at the cell size if given, cached with the identifier of the size. The layout
+ *  work runs on a low priority queue. Cancelling a prefetch withdraws its download receipts and its
+ *  layout work not started yet.
+ *
+ *  The ready rate is the displayed cells whose images and layouts were all ready. Used on the main thread only.
+ */
+@interface ECImagePrefetcher : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger displayCount;
+@property (nonatomic, assign, readonly) NSUInteger readyCount;
+
+/**
+ * \brief	The additional identifier of the images decoded at the size in the image cache.
+ */
++ (NSString*)identifier_For_Size: (CGSize) size;
+
+/**
+ * \brief	The cached image of the URL, the one decoded at the size first. Thread safe.
+ * \param   size        The size of the image in the cell, CGSizeZero for the original image only.
+ */
++ (UIImage*)cached_Image_URL: (NSString*) imageURL size: (CGSize) size;
+
+/**
+ * \brief	Prefetch the cell of the key. A key already prefetched is kept.
+ * \param   size        The size of the images in the cell, CGSizeZero to keep the original size.
+ *          layout      The work run on a low priority queue, e.g. to measure the cell, can be nil.
+ */
+- (void)prefetch_Key: (id<NSCopying>) key imageURLs: (NSArray<NSString*>*) imageURLs size: (CGSize) size layout: (dispatch_block_t) layout;
+
+/**
+ * \brief	Cancel the prefetch of the key.
+ */
+- (void)cancel_Key: (id<NSCopying>) key;
+
+/**
+ * \brief	Cancel all prefetches, e.g. the items are reloaded.
+ */
+- (void)cancel_All;
+
+/**
+ * \brief	Record a displayed cell, and whether its images and layout were ready. Its prefetch is done.
+ */
+- (void)did_Display_Key: (id<NSCopying>) key ready: (BOOL) ready;
+
+/**
+ * \brief	The summary of the ready rate.
+ */
+- (NSString*)report;
+
+@end
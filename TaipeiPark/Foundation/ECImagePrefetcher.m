@@ -0,0 +1,172 @@
+/**
+ * \file 	ECImagePrefetcher.m
+ * \brief	Prefetch the images and the layouts of the upcoming cells.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECImagePrefetcher.h"
+#import "AFImageDownloader.h"
+
+// ECImagePrefetch
+
+@interface ECImagePrefetch : NSObject
+
+@property (nonatomic, strong) NSMutableArray<AFImageDownloadReceipt*> *receipts;
+@property (nonatomic, strong) dispatch_block_t layout;
+
+@end
+
+@implementation ECImagePrefetch
+
+@end
+
+
+// ECImagePrefetcher
+
+@implementation ECImagePrefetcher
+{
+    NSMutableDictionary *_dicPrefetches;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _dicPrefetches = [[NSMutableDictionary alloc] init];
+    }
+    
+    return self;
+}
+
++ (NSString*)identifier_For_Size: (CGSize) size
+{
+    return [NSString stringWithFormat:@"%.0fx%.0f@%.0f", size.width, size.height, [UIScreen mainScreen].scale];
+}
+
++ (UIImage*)cached_Image_URL: (NSString*) imageURL size: (CGSize) size
+{
+    if (0 == imageURL.length)
+        return nil;
+    
+    id<AFImageRequestCache> cache = [UIImageView sharedImageDownloader].imageCache;
+    NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:imageURL]];
+    UIImage *image = nil;
+    
+    if (0 < size.width && 0 < size.height)
+        image = [cache imageforRequest:request withAdditionalIdentifier:[self identifier_For_Size:size]];
+    
+    return image ?: [cache imageforRequest:request withAdditionalIdentifier:nil];
+}
+
+/**
+ * \brief	Decode the image again at its aspect fit size in the size, at the scale of the screen.
+ */
++ (UIImage*)_decode_Image: (UIImage*) image size: (CGSize) size scale: (CGFloat) scale
+{
+    CGFloat ratio = MIN(size.width / image.size.width, size.height / image.size.height);
+    
+    // Never scaled up, the original is as good
+    if (0 >= image.size.width || 0 >= image.size.height || 1 <= ratio * scale / image.scale)
+        return image;
+    
+    CGSize fit = CGSizeMake(ceil(image.size.width * ratio), ceil(image.size.height * ratio));
+    
+    UIGraphicsBeginImageContextWithOptions(fit, NO, scale);
+    [image drawInRect:CGRectMake(0, 0, fit.width, fit.height)];
+    UIImage *decoded = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    return decoded;
+}
+
+- (void)prefetch_Key: (id<NSCopying>) key imageURLs: (NSArray<NSString*>*) imageURLs size: (CGSize) size layout: (dispatch_block_t) layout
+{
+    if (nil == key || nil != [_dicPrefetches objectForKey:key])
+        return;
+    
+    ECImagePrefetch *prefetch = [[ECImagePrefetch alloc] init];
+    AFImageDownloader *downloader = [UIImageView sharedImageDownloader];
+    BOOL decodes = (0 < size.width && 0 < size.height);
+    NSString *identifier = (decodes) ? [ECImagePrefetcher identifier_For_Size:size] : nil;
+    CGFloat scale = [UIScreen mainScreen].scale;
+    
+    prefetch.receipts = [[NSMutableArray alloc] initWithCapacity:imageURLs.count];
+    
+    for (NSString *imageURL in imageURLs)
+    {
+        if (nil != [ECImagePrefetcher cached_Image_URL:imageURL size:size])
+            continue;
+        
+        NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:imageURL]];
+        
+        AFImageDownloadReceipt *receipt = [downloader enqueueImageForURLRequest:request withReceiptID:[NSUUID UUID] success:^(NSURLRequest *urlRequest, NSHTTPURLResponse *response, UIImage *image) {
+            if (!decodes)
+                return;
+            
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+                UIImage *decoded = [ECImagePrefetcher _decode_Image:image size:size scale:scale];
+                
+                if (decoded != image)
+                    [downloader.imageCache addImage:decoded forRequest:request withAdditionalIdentifier:identifier];
+            });
+        } failure:nil];
+        
+        [prefetch.receipts addObject:receipt];
+    }
+    
+    if (nil != layout)
+    {
+        prefetch.layout = dispatch_block_create(0, layout);
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), prefetch.layout);
+    }
+    
+    [_dicPrefetches setObject:prefetch forKey:key];
+}
+
+- (void)cancel_Key: (id<NSCopying>) key
+{
+    ECImagePrefetch *prefetch = (nil == key) ? nil : [_dicPrefetches objectForKey:key];
+    
+    if (nil == prefetch)
+        return;
+    
+    AFImageDownloader *downloader = [UIImageView sharedImageDownloader];
+    
+    for (AFImageDownloadReceipt *receipt in prefetch.receipts)
+        [downloader cancelTaskForImageDownloadReceipt:receipt];
+    
+    if (nil != prefetch.layout)
+        dispatch_block_cancel(prefetch.layout);
+    
+    [_dicPrefetches removeObjectForKey:key];
+}
+
+- (void)cancel_All
+{
+    for (id<NSCopying> key in [_dicPrefetches allKeys])
+        [self cancel_Key:key];
+}
+
+- (void)did_Display_Key: (id<NSCopying>) key ready: (BOOL) ready
+{
+    // The cell requests its images itself now, the receipts are left to finish
+    if (nil != key)
+        [_dicPrefetches removeObjectForKey:key];
+    
+    _displayCount++;
+    
+    if (ready)
+        _readyCount++;
+    
+#ifdef DEBUG
+    if (0 == _displayCount % 100)
+        NSLog(@"[Prefetch] %@", [self report]);
+#endif
+}
+
+- (NSString*)report
+{
+    return [NSString stringWithFormat:@"%lu of %lu cells ready when displayed (%.0f%%)", (unsigned long)_readyCount, (unsigned long)_displayCount, (0 < _displayCount) ? 100.0 * _readyCount / _displayCount : 0.0];
+}
+
+@end
@@ -0,0 +1,302 @@
+/**
+ * \file 	ECImagePreview.c
+ * \brief	The tiny previews of the images, a few DCT components of the colors in a few dozen bytes.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECImagePreview.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#define SRGB_LEVELS     4096        // The levels of the linear to sRGB table
+
+static float _toLinear[256];
+static uint8_t _toSRGB[SRGB_LEVELS];
+static pthread_once_t _tablesOnce = PTHREAD_ONCE_INIT;
+
+// Private Functions
+
+static float _srgb_To_Linear(float value)
+{
+    return (value <= 0.04045f) ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float _linear_To_SRGB(float value)
+{
+    return (value <= 0.0031308f) ? value * 12.92f : 1.055f * powf(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static void _init_Tables(void)
+{
+    int i;
+
+    for (i = 0; i < 256; i++)
+        _toLinear[i] = _srgb_To_Linear(i / 255.0f);
+
+    for (i = 0; i < SRGB_LEVELS; i++)
+        _toSRGB[i] = (uint8_t)(_linear_To_SRGB(i / (float)(SRGB_LEVELS - 1)) * 255.0f + 0.5f);
+}
+
+static inline uint8_t _to_SRGB_Byte(float value)
+{
+    if (value <= 0)
+        return _toSRGB[0];
+
+    if (value >= 1)
+        return _toSRGB[SRGB_LEVELS - 1];
+
+    return _toSRGB[(int)(value * (SRGB_LEVELS - 1) + 0.5f)];
+}
+
+/**
+ *  The DCT-II basis of the axis, basis[i * length + x] = cos(pi * i * (x + 0.5) / length).
+ */
+static void _fill_Basis(float *basis, unsigned components, size_t length)
+{
+    unsigned i;
+    size_t x;
+
+    for (i = 0; i < components; i++)
+    {
+        for (x = 0; x < length; x++)
+            basis[i * length + x] = cosf((float)M_PI * i * (x + 0.5f) / length);
+    }
+}
+
+static int _read_Header(const uint8_t *preview, size_t length, unsigned *componentsX, unsigned *componentsY)
+{
+    if (NULL == preview || length < ECPREVIEW_HEADER_LENGTH)
+        return -1;
+
+    *componentsX = (preview[0] & 0x0F) + 1;
+    *componentsY = (preview[0] >> 4) + 1;
+
+    if (*componentsX > ECPREVIEW_MAX_COMPONENTS || *componentsY > ECPREVIEW_MAX_COMPONENTS ||
+        length < ECImagePreviewLength(*componentsX, *componentsY))
+        return -1;
+
+    return 0;
+}
+
+// Public Functions
+
+size_t ECImagePreviewLength(unsigned componentsX, unsigned componentsY)
+{
+    return ECPREVIEW_HEADER_LENGTH + (componentsX * componentsY - 1) * 3;
+}
+
+size_t ECImagePreviewEncode(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, float aspect,
+                            unsigned componentsX, unsigned componentsY, uint8_t *out, size_t capacity)
+{
+    float basisX[ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_SIDE], basisY[ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_SIDE];
+    float components[3][ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_COMPONENTS];
+    float *planes, *rows, maxAC = 0, scale;
+    size_t length, count = width * height, x, y;
+    unsigned c, i, j, n;
+    int aspectByte, maxByte;
+
+    if (NULL == pixels || NULL == out || 0 == width || 0 == height || width > ECPREVIEW_MAX_SIDE || height > ECPREVIEW_MAX_SIDE ||
+        0 == componentsX || 0 == componentsY || componentsX > ECPREVIEW_MAX_COMPONENTS || componentsY > ECPREVIEW_MAX_COMPONENTS)
+        return 0;
+
+    // A side of n pixels has n DCT bases only, the higher ones alias to the lower ones, e.g. a 13:1 image drawn at 32 x 2
+    componentsX = (componentsX > width) ? (unsigned)width : componentsX;
+    componentsY = (componentsY > height) ? (unsigned)height : componentsY;
+    length = ECImagePreviewLength(componentsX, componentsY);
+    n = componentsX * componentsY;
+
+    if (capacity < length)
+        return 0;
+
+    pthread_once(&_tablesOnce, _init_Tables);
+
+    // The linear planes of the channels, then the rows transformed along x: rows[c][i][y]
+    if (NULL == (planes = (float*)malloc((3 * count + 3 * componentsX * height) * sizeof(float))))
+        return 0;
+
+    rows = planes + 3 * count;
+
+    for (y = 0; y < height; y++)
+    {
+        const uint8_t *pixel = pixels + y * bytesPerRow;
+
+        for (x = 0; x < width; x++, pixel += 4)
+        {
+            planes[y * width + x] = _toLinear[pixel[0]];
+            planes[count + y * width + x] = _toLinear[pixel[1]];
+            planes[2 * count + y * width + x] = _toLinear[pixel[2]];
+        }
+    }
+
+    _fill_Basis(basisX, componentsX, width);
+    _fill_Basis(basisY, componentsY, height);
+
+    for (c = 0; c < 3; c++)
+    {
+        const float *plane = planes + c * count;
+        float *row = rows + c * componentsX * height;
+
+        for (i = 0; i < componentsX; i++)
+        {
+            const float *basis = basisX + i * width;
+
+            for (y = 0; y < height; y++)
+            {
+                const float *line = plane + y * width;
+                float sum = 0;
+
+                for (x = 0; x < width; x++)
+                    sum += line[x] * basis[x];
+
+                row[i * height + y] = sum;
+            }
+        }
+
+        for (j = 0; j < componentsY; j++)
+        {
+            const float *basis = basisY + j * height;
+
+            for (i = 0; i < componentsX; i++)
+            {
+                const float *line = row + i * height;
+                float sum = 0;
+
+                for (y = 0; y < height; y++)
+                    sum += line[y] * basis[y];
+
+                scale = ((0 == i) ? 1.0f : 2.0f) * ((0 == j) ? 1.0f : 2.0f) / count;
+                components[c][j * componentsX + i] = sum * scale;
+            }
+        }
+    }
+
+    free(planes);
+
+    for (i = 1; i < n; i++)
+    {
+        for (c = 0; c < 3; c++)
+        {
+            if (fabsf(components[c][i]) > maxAC)
+                maxAC = fabsf(components[c][i]);
+        }
+    }
+
+    if (aspect <= 0)
+        aspect = (float)width / height;
+
+    aspectByte = (int)lroundf(log2f(aspect) * 32) + 128;
+    maxByte = (int)ceilf(maxAC * 256) - 1;
+
+    out[0] = (uint8_t)((componentsX - 1) | (componentsY - 1) << 4);
+    out[1] = (uint8_t)((aspectByte < 0) ? 0 : ((aspectByte > 255) ? 255 : aspectByte));
+    out[2] = (uint8_t)((maxByte < 0) ? 0 : ((maxByte > 255) ? 255 : maxByte));
+
+    for (c = 0; c < 3; c++)
+        out[3 + c] = (uint8_t)(_linear_To_SRGB(components[c][0]) * 255.0f + 0.5f);
+
+    maxAC = (out[2] + 1) / 256.0f;
+
+    for (i = 1; i < n; i++)
+    {
+        for (c = 0; c < 3; c++)
+        {
+            int value = (int)lroundf(components[c][i] / maxAC * 127);
+
+            out[ECPREVIEW_HEADER_LENGTH + (i - 1) * 3 + c] = (uint8_t)(((value < -127) ? -127 : ((value > 127) ? 127 : value)) + 128);
+        }
+    }
+
+    return length;
+}
+
+int ECImagePreviewInfo(const uint8_t *preview, size_t length, float *aspect, uint8_t *rgb)
+{
+    unsigned componentsX, componentsY;
+
+    if (0 != _read_Header(preview, length, &componentsX, &componentsY))
+        return -1;
+
+    if (NULL != aspect)
+        *aspect = exp2f((preview[1] - 128) / 32.0f);
+
+    if (NULL != rgb)
+        memcpy(rgb, preview + 3, 3);
+
+    return 0;
+}
+
+int ECImagePreviewDecode(const uint8_t *preview, size_t length, uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow)
+{
+    float basisX[ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_SIDE], basisY[ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_SIDE];
+    float components[3][ECPREVIEW_MAX_COMPONENTS * ECPREVIEW_MAX_COMPONENTS];
+    float rowComponents[3][ECPREVIEW_MAX_COMPONENTS], line[3][ECPREVIEW_MAX_SIDE], maxAC;
+    unsigned componentsX, componentsY, usedX, usedY, c, i, j, n;
+    size_t x, y;
+
+    if (0 != _read_Header(preview, length, &componentsX, &componentsY) || NULL == pixels ||
+        0 == width || 0 == height || width > ECPREVIEW_MAX_SIDE || height > ECPREVIEW_MAX_SIDE)
+        return -1;
+
+    pthread_once(&_tablesOnce, _init_Tables);
+
+    n = componentsX * componentsY;
+    maxAC = (preview[2] + 1) / 256.0f;
+
+    for (c = 0; c < 3; c++)
+    {
+        components[c][0] = _toLinear[preview[3 + c]];
+
+        for (i = 1; i < n; i++)
+            components[c][i] = (preview[ECPREVIEW_HEADER_LENGTH + (i - 1) * 3 + c] - 128) / 127.0f * maxAC;
+    }
+
+    // The components above the sides of the pixels are dropped, as the encoder does
+    usedX = (componentsX > width) ? (unsigned)width : componentsX;
+    usedY = (componentsY > height) ? (unsigned)height : componentsY;
+
+    _fill_Basis(basisX, usedX, width);
+    _fill_Basis(basisY, usedY, height);
+
+    for (y = 0; y < height; y++)
+    {
+        uint8_t *pixel = pixels + y * bytesPerRow;
+
+        // The components of this row along x, then the row is the sum of the x bases
+        for (c = 0; c < 3; c++)
+        {
+            for (i = 0; i < usedX; i++)
+            {
+                float sum = 0;
+
+                for (j = 0; j < usedY; j++)
+                    sum += components[c][j * componentsX + i] * basisY[j * height + y];
+
+                rowComponents[c][i] = sum;
+            }
+
+            for (x = 0; x < width; x++)
+                line[c][x] = 0;
+
+            for (i = 0; i < usedX; i++)
+            {
+                const float *basis = basisX + i * width;
+                float value = rowComponents[c][i];
+
+                for (x = 0; x < width; x++)
+                    line[c][x] += value * basis[x];
+            }
+        }
+
+        for (x = 0; x < width; x++, pixel += 4)
+        {
+            pixel[0] = _to_SRGB_Byte(line[0][x]);
+            pixel[1] = _to_SRGB_Byte(line[1][x]);
+            pixel[2] = _to_SRGB_Byte(line[2][x]);
+            pixel[3] = 255;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ * \file 	ECImagePreview.h
+ * \brief	The tiny previews of the images, a few DCT components of the colors in a few dozen bytes.
+ *          Plain C, no Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECImagePreview_h
+#define ECImagePreview_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECPREVIEW_MAX_COMPONENTS    8       // Per axis
+#define ECPREVIEW_MAX_SIDE          64      // The max width and height of the encoded pixels
+#define ECPREVIEW_HEADER_LENGTH     6
+
+/**
+ *  The preview is BlurHash-like: the image is transformed by the DCT in the linear color space, and only the
+ *  lowest componentsX * componentsY components are kept, the average color first.
+ *
+ *  byte 0          (componentsX - 1) | (componentsY - 1) << 4
+ *  byte 1          The aspect ratio of the image, round(log2(width / height) * 32) + 128
+ *  byte 2          The max magnitude of the AC components, (byte + 1) / 256
+ *  byte 3 ~ 5      The average color, sRGB
+ *  byte 6 ~        The AC components, 3 bytes each, the magnitudes quantized to -127 ~ 127 plus 128
+ *
+ *  The loops run over the contiguous float rows, so they are vectorized by the compiler.
+ */
+
+/**
+ * \brief	Get the length of the preview of the components.
+ */
+size_t ECImagePreviewLength(unsigned componentsX, unsigned componentsY);
+
+/**
+ * \brief	Encode the preview of the pixels, e.g. the image drawn in a 32 x 32 bitmap.
+ * \param   pixels          The RGBA or RGBX pixels, 8 bits per channel, the alpha is ignored.
+ *          width, height   At most ECPREVIEW_MAX_SIDE each.
+ *          aspect          The width / height of the original image, 0 to use width / height.
+ *          componentsX     1 ~ ECPREVIEW_MAX_COMPONENTS, e.g. 4 for a landscape image, at most width are kept.
+ *          componentsY     1 ~ ECPREVIEW_MAX_COMPONENTS, at most height are kept.
+ *          out             The buffer of ECImagePreviewLength() bytes of the kept components.
+ * \return	The length of the preview, 0 if the arguments are invalid or out of memory.
+ */
+size_t ECImagePreviewEncode(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, float aspect,
+                            unsigned componentsX, unsigned componentsY, uint8_t *out, size_t capacity);
+
+/**
+ * \brief	Get the aspect ratio and the average color of the preview, without decoding it.
+ * \param   aspect      The width / height of the original image, can be NULL.
+ *          rgb         The 3 bytes of the average color in sRGB, can be NULL.
+ * \return	0 on success, -1 if the preview is invalid.
+ */
+int ECImagePreviewInfo(const uint8_t *preview, size_t length, float *aspect, uint8_t *rgb);
+
+/**
+ * \brief	Decode the preview to the pixels, e.g. a 16 x 12 bitmap scaled up as the placeholder. The components
+ *          above the width or the height are dropped.
+ * \param   pixels      The RGBA pixels, 8 bits per channel, the alpha is 255.
+ *          width, height   At most ECPREVIEW_MAX_SIDE each.
+ * \return	0 on success, -1 if the preview or the arguments are invalid.
+ */
+int ECImagePreviewDecode(const uint8_t *preview, size_t length, uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECImagePreview_h */
@@ -0,0 +1,47 @@
+/**
+ * \file 	ECImagePreviews.h
+ * \brief	The tiny previews of the downloaded images, shown as the placeholders before the images.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <UIKit/UIKit.h>
+#import "AFAutoPurgingImageCache.h"
+
+/**
+ *  The previews of the image URLs, encoded by ECImagePreview when an image is first decoded. They are
+ *  saved beside the dataset snapshot, so the later views start from a blurred preview of each image
+ *  instead of the same default icon. Thread safe.
+ */
+@interface ECImagePreviews : NSObject
+
++ (ECImagePreviews*)sharedPreviews;
+
+/**
+ * \brief	Encode the preview of the decoded image on a low priority queue, if the URL has none yet.
+ *          The previews are saved a moment after the last one is recorded.
+ */
+- (void)record_Image: (UIImage*) image URL: (NSString*) imageURL;
+
+/**
+ * \brief	Get the placeholder of the image URL, the preview decoded to a tiny image.
+ * \param   image       The placeholder if the URL has no preview, e.g. the default icon.
+ */
+- (UIImage*)placeholder_For_URL: (NSString*) imageURL default_Image: (UIImage*) image;
+
+#ifdef DEBUG
+/**
+ * \brief	Measure the encoding of a 32 x 32 bitmap and the decoding of a placeholder.
+ * \return	The summary of the cost per image.
+ */
++ (NSString*)benchmark_Iterations: (NSUInteger) iterations;
+#endif
+
+@end
+
+/**
+ *  The image cache recording the preview of each downloaded image, set as the image cache of the
+ *  image downloader. Only the original images are recorded, not the ones added with an identifier.
+ */
+@interface ECPreviewImageCache : AFAutoPurgingImageCache
+
+@end
@@ -0,0 +1,272 @@
+/**
+ * \file 	ECImagePreviews.m
+ * \brief	The tiny previews of the downloaded images, shown as the placeholders before the images.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECImagePreviews.h"
+#import "ECImagePreview.h"
+#import "ECDatasetSnapshot.h"
+
+#define ENCODE_SIDE         32      // The long side of the bitmap the image is drawn in to be encoded
+#define PLACEHOLDER_SIDE    16      // The long side of the decoded placeholder, scaled up by the views
+#define SAVE_DELAY          2.0     // Seconds, the previews recorded meanwhile are saved together
+
+@implementation ECImagePreviews
+{
+    dispatch_queue_t _queue;            // Serial, the loading, the encoding and the saving
+    NSMutableDictionary *_dicPreviews;  // The preview data keyed by the image URLs
+    NSCache *_placeholders;             // The decoded placeholders keyed by the image URLs
+    BOOL _saveScheduled;
+}
+
++ (ECImagePreviews*)sharedPreviews
+{
+    static ECImagePreviews *previews = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        previews = [[ECImagePreviews alloc] init];
+    });
+    
+    return previews;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _queue = dispatch_queue_create("ECImagePreviews", dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, QOS_CLASS_UTILITY, 0));
+        _dicPreviews = [[NSMutableDictionary alloc] init];
+        _placeholders = [[NSCache alloc] init];
+        _placeholders.countLimit = 200;
+        
+        // Loaded before any recording, the queue is serial
+        dispatch_async(_queue, ^{
+            NSDictionary *previews = [[ECDatasetSnapshot sharedSnapshot] load_Image_Previews];
+            
+            @synchronized (self)
+            {
+                [_dicPreviews addEntriesFromDictionary:previews];
+            }
+        });
+    }
+    
+    return self;
+}
+
+#pragma mark - Encode and Decode
+
+/**
+ * \brief	Draw the image in a bitmap of at most ENCODE_SIDE, and encode it with 4 x 3 components, 39 bytes.
+ */
++ (NSData*)_preview_Of_Image: (UIImage*) image
+{
+    CGImageRef cgImage = image.CGImage;
+    size_t imageWidth = CGImageGetWidth(cgImage), imageHeight = CGImageGetHeight(cgImage);
+    
+    if (NULL == cgImage || 0 == imageWidth || 0 == imageHeight)
+        return nil;
+    
+    CGFloat aspect = (CGFloat)imageWidth / imageHeight;
+    size_t width = (aspect >= 1) ? ENCODE_SIDE : MAX(1, (size_t)lround(ENCODE_SIDE * aspect));
+    size_t height = (aspect >= 1) ? MAX(1, (size_t)lround(ENCODE_SIDE / aspect)) : ENCODE_SIDE;
+    uint8_t pixels[ENCODE_SIDE * ENCODE_SIDE * 4], preview[64];
+    
+    // The transparent parts are on white, like the cell background
+    memset(pixels, 0xFF, sizeof(pixels));
+    
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, width, height, 8, width * 4, colorSpace, kCGImageAlphaNoneSkipLast | kCGBitmapByteOrder32Big);
+    
+    CGColorSpaceRelease(colorSpace);
+    
+    if (NULL == context)
+        return nil;
+    
+    CGContextSetInterpolationQuality(context, kCGInterpolationMedium);
+    CGContextDrawImage(context, CGRectMake(0, 0, width, height), cgImage);
+    CGContextRelease(context);
+    
+    size_t length = ECImagePreviewEncode(pixels, width, height, width * 4, aspect, (aspect >= 1) ? 4 : 3, (aspect >= 1) ? 3 : 4, preview, sizeof(preview));
+    
+    return (0 < length) ? [NSData dataWithBytes:preview length:length] : nil;
+}
+
+/**
+ * \brief	Decode the preview to an image of at most PLACEHOLDER_SIDE, in the aspect ratio of the original image.
+ */
++ (UIImage*)_placeholder_Of_Preview: (NSData*) preview
+{
+    float aspect = 1;
+    
+    if (0 != ECImagePreviewInfo(preview.bytes, preview.length, &aspect, NULL))
+        return nil;
+    
+    size_t width = (aspect >= 1) ? PLACEHOLDER_SIDE : MAX(1, (size_t)lroundf(PLACEHOLDER_SIDE * aspect));
+    size_t height = (aspect >= 1) ? MAX(1, (size_t)lroundf(PLACEHOLDER_SIDE / aspect)) : PLACEHOLDER_SIDE;
+    uint8_t pixels[PLACEHOLDER_SIDE * PLACEHOLDER_SIDE * 4];
+    
+    if (0 != ECImagePreviewDecode(preview.bytes, preview.length, pixels, width, height, width * 4))
+        return nil;
+    
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceRGB();
+    CGContextRef context = CGBitmapContextCreate(pixels, width, height, 8, width * 4, colorSpace, kCGImageAlphaNoneSkipLast | kCGBitmapByteOrder32Big);
+    CGImageRef cgImage = (NULL == context) ? NULL : CGBitmapContextCreateImage(context);
+    UIImage *placeholder = (NULL == cgImage) ? nil : [UIImage imageWithCGImage:cgImage];
+    
+    CGImageRelease(cgImage);
+    CGContextRelease(context);
+    CGColorSpaceRelease(colorSpace);
+    
+    return placeholder;
+}
+
+#pragma mark - Previews
+
+- (BOOL)_has_Preview: (NSString*) imageURL
+{
+    @synchronized (self)
+    {
+        return (nil != [_dicPreviews objectForKey:imageURL]);
+    }
+}
+
+- (void)record_Image: (UIImage*) image URL: (NSString*) imageURL
+{
+    if (nil == image || 0 == imageURL.length || [self _has_Preview:imageURL])
+        return;
+    
+    dispatch_async(_queue, ^{
+        // Recorded meanwhile, e.g. the same URL downloaded twice
+        if ([self _has_Preview:imageURL])
+            return;
+        
+        NSData *preview = [ECImagePreviews _preview_Of_Image:image];
+        
+        if (nil == preview)
+            return;
+        
+        @synchronized (self)
+        {
+            [_dicPreviews setObject:preview forKey:imageURL];
+        }
+        
+        [self _schedule_Save];
+    });
+}
+
+/**
+ * \brief	Save the previews a moment later, on the queue.
+ */
+- (void)_schedule_Save
+{
+    if (_saveScheduled)
+        return;
+    
+    _saveScheduled = YES;
+    
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(SAVE_DELAY * NSEC_PER_SEC)), _queue, ^{
+        NSDictionary *previews = nil;
+        
+        _saveScheduled = NO;
+        
+        @synchronized (self)
+        {
+            previews = [_dicPreviews copy];
+        }
+        
+        [[ECDatasetSnapshot sharedSnapshot] save_Image_Previews:previews];
+    });
+}
+
+- (UIImage*)placeholder_For_URL: (NSString*) imageURL default_Image: (UIImage*) image
+{
+    if (0 == imageURL.length)
+        return image;
+    
+    UIImage *placeholder = [_placeholders objectForKey:imageURL];
+    
+    if (nil != placeholder)
+        return placeholder;
+    
+    NSData *preview = nil;
+    
+    @synchronized (self)
+    {
+        preview = [_dicPreviews objectForKey:imageURL];
+    }
+    
+    if (nil == preview || nil == (placeholder = [ECImagePreviews _placeholder_Of_Preview:preview]))
+        return image;
+    
+    [_placeholders setObject:placeholder forKey:imageURL];
+    
+    return placeholder;
+}
+
+#ifdef DEBUG
++ (NSString*)benchmark_Iterations: (NSUInteger) iterations
+{
+    uint8_t pixels[ENCODE_SIDE * ENCODE_SIDE * 4], preview[64], placeholder[PLACEHOLDER_SIDE * PLACEHOLDER_SIDE * 4];
+    size_t length = 0;
+    
+    for (NSUInteger i = 0; i < ENCODE_SIDE * ENCODE_SIDE; i++)
+    {
+        pixels[i * 4] = (uint8_t)(i % ENCODE_SIDE * 8);
+        pixels[i * 4 + 1] = (uint8_t)(i / ENCODE_SIDE * 8);
+        pixels[i * 4 + 2] = 128;
+        pixels[i * 4 + 3] = 255;
+    }
+    
+    // A decoded sample image, like the inflated images of the downloader
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(640, 480), YES, 1);
+    [[UIColor colorWithRed:0.3 green:0.6 blue:0.4 alpha:1] setFill];
+    UIRectFill(CGRectMake(0, 0, 640, 480));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    
+    for (NSUInteger i = 0; i < iterations; i++)
+        length = ECImagePreviewEncode(pixels, ENCODE_SIDE, ENCODE_SIDE * 3 / 4, ENCODE_SIDE * 4, 0, 4, 3, preview, sizeof(preview));
+    
+    CFAbsoluteTime encodeTime = CFAbsoluteTimeGetCurrent() - start;
+    
+    start = CFAbsoluteTimeGetCurrent();
+    
+    for (NSUInteger i = 0; i < iterations; i++)
+        ECImagePreviewDecode(preview, length, placeholder, PLACEHOLDER_SIDE, PLACEHOLDER_SIDE * 3 / 4, PLACEHOLDER_SIDE * 4);
+    
+    CFAbsoluteTime decodeTime = CFAbsoluteTimeGetCurrent() - start;
+    
+    start = CFAbsoluteTimeGetCurrent();
+    
+    for (NSUInteger i = 0; i < iterations; i++)
+        [self _preview_Of_Image:image];
+    
+    CFAbsoluteTime imageTime = CFAbsoluteTimeGetCurrent() - start;
+    
+    iterations = MAX(1, iterations);
+    
+    return [NSString stringWithFormat:@"%lu bytes: encode %.1f us, decode %.1f us, draw and encode 640x480 %.1f us per image", (unsigned long)length, encodeTime * 1e6 / iterations, decodeTime * 1e6 / iterations, imageTime * 1e6 / iterations];
+}
+#endif
+
+@end
+
+
+// ECPreviewImageCache
+
+@implementation ECPreviewImageCache
+
+- (void)addImage: (UIImage*) image forRequest: (NSURLRequest*) request withAdditionalIdentifier: (NSString*) identifier
+{
+    [super addImage:image forRequest:request withAdditionalIdentifier:identifier];
+    
+    // The sized copies of ECImagePrefetcher have an identifier
+    if (nil == identifier)
+        [[ECImagePreviews sharedPreviews] record_Image:image URL:request.URL.absoluteString];
+}
+
+@end
@@ -0,0 +1,838 @@
+/**
+ * \file 	ECJSONParser.c
+ * \brief	Event based JSON parser.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECJSONParser.h"
+#include "ECJSONStructuralIndex.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ECJSONParser
+{
+    const char *cur;
+    const char *end;
+    const char *start;
+    unsigned int options;
+    const ECJSONCallbacks *callbacks;
+    void *context;
+    int depth;
+    
+    // Scratch buffer for the strings with escapes
+    char *scratch;
+    size_t scratchCapacity;
+} ECJSONParser;
+
+#define CALLBACK(p, name, ...) (((p)->callbacks->name && (p)->callbacks->name((p)->context, ##__VA_ARGS__)) ? ECJSONParseErrorCanceled : ECJSONParseOK)
+
+static ECJSONParseStatus _parse_Value(ECJSONParser *p);
+
+// Private Functions
+
+static void _skip_Whitespace(ECJSONParser *p)
+{
+    while (p->cur < p->end && (' ' == *p->cur || '\n' == *p->cur || '\r' == *p->cur || '\t' == *p->cur))
+        p->cur++;
+}
+
+static int _match_Literal(ECJSONParser *p, const char *literal, size_t length)
+{
+    if ((size_t)(p->end - p->cur) < length || 0 != memcmp(p->cur, literal, length))
+        return 0;
+    
+    p->cur += length;
+    
+    return 1;
+}
+
+static int _reserve_Scratch(ECJSONParser *p, size_t length)
+{
+    char *scratch;
+    size_t capacity;
+    
+    if (length <= p->scratchCapacity)
+        return 1;
+    
+    capacity = (p->scratchCapacity > 0) ? p->scratchCapacity * 2 : 256;
+    
+    while (capacity < length)
+        capacity *= 2;
+    
+    scratch = (char*)realloc(p->scratch, capacity);
+    
+    if (NULL == scratch)
+        return 0;
+    
+    p->scratch = scratch;
+    p->scratchCapacity = capacity;
+    
+    return 1;
+}
+
+static int _hex_Value(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    
+    return -1;
+}
+
+static int _parse_Hex4(const char *s, uint32_t *value)
+{
+    uint32_t v = 0;
+    int i;
+    
+    for (i = 0; i < 4; i++)
+    {
+        int h = _hex_Value(s[i]);
+        
+        if (h < 0)
+            return 0;
+        
+        v = (v << 4) | (uint32_t)h;
+    }
+    
+    *value = v;
+    
+    return 1;
+}
+
+static size_t _encode_UTF8(uint32_t codePoint, char *out)
+{
+    if (codePoint < 0x80)
+    {
+        out[0] = (char)codePoint;
+        return 1;
+    }
+    
+    if (codePoint < 0x800)
+    {
+        out[0] = (char)(0xC0 | (codePoint >> 6));
+        out[1] = (char)(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    
+    if (codePoint < 0x10000)
+    {
+        out[0] = (char)(0xE0 | (codePoint >> 12));
+        out[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    
+    out[0] = (char)(0xF0 | (codePoint >> 18));
+    out[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+/**
+ * \brief	Parse a string, the cursor is on the opening quote. The strings without escapes are
+ *          returned in place, the others are unescaped into the scratch buffer.
+ */
+static ECJSONParseStatus _parse_String(ECJSONParser *p, const char **bytes, size_t *length)
+{
+    const char *s = ++p->cur;
+    size_t outLength = 0;
+    
+    // Fast path, scan to the closing quote
+    while (p->cur < p->end)
+    {
+        unsigned char c = (unsigned char)*p->cur;
+        
+        if ('"' == c)
+        {
+            *bytes = s;
+            *length = (size_t)(p->cur - s);
+            p->cur++;
+            
+            return ECJSONParseOK;
+        }
+        
+        if ('\\' == c)
+            break;
+        
+        if (c < 0x20)
+            return ECJSONParseErrorInvalidString;
+        
+        p->cur++;
+    }
+    
+    if (p->cur >= p->end)
+        return ECJSONParseErrorSyntax;
+    
+    // Slow path, find the closing quote first, an escaped string never grows when unescaped
+    {
+        const char *q = p->cur;
+        
+        while (q < p->end && '"' != *q)
+            q += ('\\' == *q) ? 2 : 1;
+        
+        if (q >= p->end)
+            return ECJSONParseErrorSyntax;
+        
+        if (!_reserve_Scratch(p, (size_t)(q - s)))
+            return ECJSONParseErrorOutOfMemory;
+    }
+    
+    outLength = (size_t)(p->cur - s);
+    memcpy(p->scratch, s, outLength);
+    
+    while (p->cur < p->end)
+    {
+        unsigned char c = (unsigned char)*p->cur;
+        
+        if ('"' == c)
+        {
+            *bytes = p->scratch;
+            *length = outLength;
+            p->cur++;
+            
+            return ECJSONParseOK;
+        }
+        
+        if (c < 0x20)
+            return ECJSONParseErrorInvalidString;
+        
+        if ('\\' != c)
+        {
+            p->scratch[outLength++] = (char)c;
+            p->cur++;
+            continue;
+        }
+        
+        if (p->cur + 1 >= p->end)
+            return ECJSONParseErrorSyntax;
+        
+        switch (p->cur[1])
+        {
+            case '"':   p->scratch[outLength++] = '"';  break;
+            case '\\':  p->scratch[outLength++] = '\\'; break;
+            case '/':   p->scratch[outLength++] = '/';  break;
+            case 'b':   p->scratch[outLength++] = '\b'; break;
+            case 'f':   p->scratch[outLength++] = '\f'; break;
+            case 'n':   p->scratch[outLength++] = '\n'; break;
+            case 'r':   p->scratch[outLength++] = '\r'; break;
+            case 't':   p->scratch[outLength++] = '\t'; break;
+            case 'u':
+            {
+                uint32_t codePoint;
+                
+                if (p->end - p->cur < 6 || !_parse_Hex4(p->cur + 2, &codePoint))
+                    return ECJSONParseErrorInvalidString;
+                
+                p->cur += 6;
+                
+                // Surrogate pair, the low surrogate must follow
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                {
+                    uint32_t low;
+                    
+                    if (p->end - p->cur < 6 || '\\' != p->cur[0] || 'u' != p->cur[1] || !_parse_Hex4(p->cur + 2, &low) || low < 0xDC00 || low > 0xDFFF)
+                        return ECJSONParseErrorInvalidString;
+                    
+                    p->cur += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF)
+                {
+                    return ECJSONParseErrorInvalidString;
+                }
+                
+                // "\uXXXX" is 6 bytes, the UTF-8 is at most 3 bytes, or 4 bytes for 12 bytes of pair
+                outLength += _encode_UTF8(codePoint, p->scratch + outLength);
+                continue;
+            }
+            default:
+                return ECJSONParseErrorInvalidString;
+        }
+        
+        p->cur += 2;
+    }
+    
+    return ECJSONParseErrorSyntax;
+}
+
+static ECJSONParseStatus _parse_Number(ECJSONParser *p)
+{
+    const char *s = p->cur;
+    int negative = 0;
+    int isInteger = 1;
+    int overflow = 0;
+    uint64_t magnitude = 0;
+    
+    if (p->cur < p->end && '-' == *p->cur)
+    {
+        negative = 1;
+        p->cur++;
+    }
+    
+    if (p->cur >= p->end || *p->cur < '0' || *p->cur > '9')
+        return ECJSONParseErrorSyntax;
+    
+    if ('0' == *p->cur)
+    {
+        p->cur++;
+    }
+    else
+    {
+        while (p->cur < p->end && *p->cur >= '0' && *p->cur <= '9')
+        {
+            uint64_t digit = (uint64_t)(*p->cur - '0');
+            
+            if (magnitude > (UINT64_MAX - digit) / 10)
+                overflow = 1;
+            else
+                magnitude = magnitude * 10 + digit;
+            
+            p->cur++;
+        }
+    }
+    
+    if (p->cur < p->end && '.' == *p->cur)
+    {
+        isInteger = 0;
+        p->cur++;
+        
+        if (p->cur >= p->end || *p->cur < '0' || *p->cur > '9')
+            return ECJSONParseErrorSyntax;
+        
+        while (p->cur < p->end && *p->cur >= '0' && *p->cur <= '9')
+            p->cur++;
+    }
+    
+    if (p->cur < p->end && ('e' == *p->cur || 'E' == *p->cur))
+    {
+        isInteger = 0;
+        p->cur++;
+        
+        if (p->cur < p->end && ('+' == *p->cur || '-' == *p->cur))
+            p->cur++;
+        
+        if (p->cur >= p->end || *p->cur < '0' || *p->cur > '9')
+            return ECJSONParseErrorSyntax;
+        
+        while (p->cur < p->end && *p->cur >= '0' && *p->cur <= '9')
+            p->cur++;
+    }
+    
+    if (isInteger && !overflow && magnitude <= (negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX))
+    {
+        int64_t integer = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+        
+        return CALLBACK(p, number, 1, integer, 0);
+    }
+    else
+    {
+        // strtod needs a terminated string
+        char stackBuffer[64];
+        char *text = stackBuffer;
+        size_t length = (size_t)(p->cur - s);
+        double real;
+        
+        if (length >= sizeof(stackBuffer))
+        {
+            text = (char*)malloc(length + 1);
+            
+            if (NULL == text)
+                return ECJSONParseErrorOutOfMemory;
+        }
+        
+        memcpy(text, s, length);
+        text[length] = '\0';
+        real = strtod(text, NULL);
+        
+        if (text != stackBuffer)
+            free(text);
+        
+        return CALLBACK(p, number, 0, 0, real);
+    }
+}
+
+static ECJSONParseStatus _parse_Object(ECJSONParser *p)
+{
+    ECJSONParseStatus status;
+    
+    p->cur++;
+    
+    if (ECJSONParseOK != (status = CALLBACK(p, beginObject)))
+        return status;
+    
+    _skip_Whitespace(p);
+    
+    if (p->cur < p->end && '}' == *p->cur)
+    {
+        p->cur++;
+        return CALLBACK(p, endObject);
+    }
+    
+    while (1)
+    {
+        const char *key;
+        size_t keyLength;
+        
+        _skip_Whitespace(p);
+        
+        if (p->cur >= p->end || '"' != *p->cur)
+            return ECJSONParseErrorSyntax;
+        
+        if (ECJSONParseOK != (status = _parse_String(p, &key, &keyLength)))
+            return status;
+        
+        _skip_Whitespace(p);
+        
+        if (p->cur >= p->end || ':' != *p->cur)
+            return ECJSONParseErrorSyntax;
+        
+        p->cur++;
+        _skip_Whitespace(p);
+        
+        // The null members are dropped before the key is reported
+        if ((p->options & ECJSONParseSkipNullMembers) && p->cur < p->end && 'n' == *p->cur)
+        {
+            if (!_match_Literal(p, "null", 4))
+                return ECJSONParseErrorSyntax;
+        }
+        else
+        {
+            if (ECJSONParseOK != (status = CALLBACK(p, key, key, keyLength)))
+                return status;
+            
+            if (ECJSONParseOK != (status = _parse_Value(p)))
+                return status;
+        }
+        
+        _skip_Whitespace(p);
+        
+        if (p->cur >= p->end)
+            return ECJSONParseErrorSyntax;
+        
+        if (',' == *p->cur)
+        {
+            p->cur++;
+            continue;
+        }
+        
+        if ('}' == *p->cur)
+        {
+            p->cur++;
+            return CALLBACK(p, endObject);
+        }
+        
+        return ECJSONParseErrorSyntax;
+    }
+}
+
+static ECJSONParseStatus _parse_Array(ECJSONParser *p)
+{
+    ECJSONParseStatus status;
+    
+    p->cur++;
+    
+    if (ECJSONParseOK != (status = CALLBACK(p, beginArray)))
+        return status;
+    
+    _skip_Whitespace(p);
+    
+    if (p->cur < p->end && ']' == *p->cur)
+    {
+        p->cur++;
+        return CALLBACK(p, endArray);
+    }
+    
+    while (1)
+    {
+        if (ECJSONParseOK != (status = _parse_Value(p)))
+            return status;
+        
+        _skip_Whitespace(p);
+        
+        if (p->cur >= p->end)
+            return ECJSONParseErrorSyntax;
+        
+        if (',' == *p->cur)
+        {
+            p->cur++;
+            continue;
+        }
+        
+        if (']' == *p->cur)
+        {
+            p->cur++;
+            return CALLBACK(p, endArray);
+        }
+        
+        return ECJSONParseErrorSyntax;
+    }
+}
+
+static ECJSONParseStatus _parse_Value(ECJSONParser *p)
+{
+    ECJSONParseStatus status;
+    
+    _skip_Whitespace(p);
+    
+    if (p->cur >= p->end)
+        return ECJSONParseErrorSyntax;
+    
+    switch (*p->cur)
+    {
+        case '{':
+        case '[':
+            if (++p->depth > ECJSON_MAX_DEPTH)
+                return ECJSONParseErrorTooDeep;
+            
+            status = ('{' == *p->cur) ? _parse_Object(p) : _parse_Array(p);
+            p->depth--;
+            
+            return status;
+        case '"':
+        {
+            const char *bytes;
+            size_t length;
+            
+            if (ECJSONParseOK != (status = _parse_String(p, &bytes, &length)))
+                return status;
+            
+            return CALLBACK(p, string, bytes, length);
+        }
+        case 't':
+            return _match_Literal(p, "true", 4) ? CALLBACK(p, boolean, 1) : ECJSONParseErrorSyntax;
+        case 'f':
+            return _match_Literal(p, "false", 5) ? CALLBACK(p, boolean, 0) : ECJSONParseErrorSyntax;
+        case 'n':
+            return _match_Literal(p, "null", 4) ? CALLBACK(p, null) : ECJSONParseErrorSyntax;
+        default:
+            return _parse_Number(p);
+    }
+}
+
+/**
+ * \brief	Check the byte after a number or a literal, it must end the value.
+ */
+static int _is_Value_End(ECJSONParser *p)
+{
+    if (p->cur >= p->end)
+        return 1;
+    
+    switch (*p->cur)
+    {
+        case ' ': case '\t': case '\n': case '\r':
+        case ',': case ':': case '[': case ']': case '{': case '}': case '"':
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * \brief	Parse the string of the token, the next token is its closing quote. The strings without
+ *          escapes are returned without scanning the bytes again.
+ */
+static ECJSONParseStatus _parse_Indexed_String(ECJSONParser *p, const uint32_t *positions, size_t count, size_t *i, const char **bytes, size_t *length)
+{
+    const char *s = p->start + positions[*i] + 1;
+    const char *e;
+    ECJSONParseStatus status;
+    
+    if (*i + 1 >= count)
+        return ECJSONParseErrorSyntax;
+    
+    e = p->start + positions[*i + 1];
+    *i += 2;
+    
+    // The control characters are rejected by the index already
+    if (NULL == memchr(s, '\\', (size_t)(e - s)))
+    {
+        *bytes = s;
+        *length = (size_t)(e - s);
+        p->cur = e + 1;
+        
+        return ECJSONParseOK;
+    }
+    
+    p->cur = s - 1;
+    
+    if (ECJSONParseOK != (status = _parse_String(p, bytes, length)))
+        return status;
+    
+    return (p->cur == e + 1) ? ECJSONParseOK : ECJSONParseErrorSyntax;
+}
+
+/**
+ * \brief	Parse the tokens of the structural index. The containers are tracked on a stack instead of
+ *          the recursion, and the bytes between the tokens are never visited.
+ */
+static ECJSONParseStatus _parse_Indexed(ECJSONParser *p, const uint32_t *positions, size_t count, size_t *cursor)
+{
+    char containers[ECJSON_MAX_DEPTH];
+    int depth = 0;
+    size_t i = 0;
+    ECJSONParseStatus status;
+    const char *bytes;
+    size_t length;
+    char c;
+    
+Value:
+    if (i >= count)
+    {
+        p->cur = p->end;
+        return ECJSONParseErrorSyntax;
+    }
+    
+    p->cur = p->start + positions[i];
+    c = *p->cur;
+    
+    switch (c)
+    {
+        case '{':
+        case '[':
+            if (depth >= ECJSON_MAX_DEPTH)
+                return ECJSONParseErrorTooDeep;
+            
+            if (ECJSONParseOK != (status = ('{' == c) ? CALLBACK(p, beginObject) : CALLBACK(p, beginArray)))
+                return status;
+            
+            i++;
+            
+            // Empty container
+            if (i < count && (('{' == c) ? '}' : ']') == p->start[positions[i]])
+            {
+                p->cur = p->start + positions[i++] + 1;
+                
+                if (ECJSONParseOK != (status = ('{' == c) ? CALLBACK(p, endObject) : CALLBACK(p, endArray)))
+                    return status;
+                
+                goto Next;
+            }
+            
+            containers[depth++] = c;
+            
+            if ('{' == c)
+                goto Key;
+            
+            goto Value;
+        case '"':
+            if (ECJSONParseOK != (status = _parse_Indexed_String(p, positions, count, &i, &bytes, &length)))
+                return status;
+            
+            if (ECJSONParseOK != (status = CALLBACK(p, string, bytes, length)))
+                return status;
+            
+            goto Next;
+        case 't':
+            status = _match_Literal(p, "true", 4) ? ECJSONParseOK : ECJSONParseErrorSyntax;
+            break;
+        case 'f':
+            status = _match_Literal(p, "false", 5) ? ECJSONParseOK : ECJSONParseErrorSyntax;
+            break;
+        case 'n':
+            status = _match_Literal(p, "null", 4) ? ECJSONParseOK : ECJSONParseErrorSyntax;
+            break;
+        default:
+            // The number is reported by _parse_Number, check the end of it afterwards
+            if (ECJSONParseOK != (status = _parse_Number(p)))
+                return status;
+            
+            i++;
+            
+            if (!_is_Value_End(p))
+                return ECJSONParseErrorSyntax;
+            
+            goto Next;
+    }
+    
+    if (ECJSONParseOK != status || !_is_Value_End(p))
+        return ECJSONParseErrorSyntax;
+    
+    i++;
+    
+    if ('n' == c)
+        status = CALLBACK(p, null);
+    else
+        status = CALLBACK(p, boolean, 't' == c);
+    
+    if (ECJSONParseOK != status)
+        return status;
+    
+    goto Next;
+    
+Key:
+    if (i >= count || '"' != p->start[positions[i]])
+    {
+        p->cur = (i < count) ? p->start + positions[i] : p->end;
+        return ECJSONParseErrorSyntax;
+    }
+    
+    if (ECJSONParseOK != (status = _parse_Indexed_String(p, positions, count, &i, &bytes, &length)))
+        return status;
+    
+    if (i >= count || ':' != p->start[positions[i]])
+    {
+        p->cur = (i < count) ? p->start + positions[i] : p->end;
+        return ECJSONParseErrorSyntax;
+    }
+    
+    i++;
+    
+    // The null members are dropped before the key is reported
+    if ((p->options & ECJSONParseSkipNullMembers) && i < count && 'n' == p->start[positions[i]])
+    {
+        p->cur = p->start + positions[i];
+        
+        if (!_match_Literal(p, "null", 4) || !_is_Value_End(p))
+            return ECJSONParseErrorSyntax;
+        
+        i++;
+        goto Next;
+    }
+    
+    if (ECJSONParseOK != (status = CALLBACK(p, key, bytes, length)))
+        return status;
+    
+    goto Value;
+    
+Next:
+    if (0 == depth)
+    {
+        *cursor = i;
+        return ECJSONParseOK;
+    }
+    
+    if (i >= count)
+    {
+        p->cur = p->end;
+        return ECJSONParseErrorSyntax;
+    }
+    
+    p->cur = p->start + positions[i];
+    c = *p->cur;
+    
+    if (',' == c)
+    {
+        i++;
+        
+        if ('{' == containers[depth - 1])
+            goto Key;
+        
+        goto Value;
+    }
+    
+    if (('}' == c && '{' == containers[depth - 1]) || (']' == c && '[' == containers[depth - 1]))
+    {
+        i++;
+        p->cur++;
+        depth--;
+        
+        if (ECJSONParseOK != (status = ('}' == c) ? CALLBACK(p, endObject) : CALLBACK(p, endArray)))
+            return status;
+        
+        goto Next;
+    }
+    
+    return ECJSONParseErrorSyntax;
+}
+
+// Public Functions
+
+ECJSONParseStatus ECJSONParse(const char *bytes, size_t length, unsigned int options, const ECJSONCallbacks *callbacks, void *context, size_t *errorOffset)
+{
+    ECJSONParser p;
+    ECJSONParseStatus status;
+    
+    if (NULL == bytes || NULL == callbacks)
+        return ECJSONParseErrorSyntax;
+    
+    memset(&p, 0, sizeof(ECJSONParser));
+    
+    p.cur = p.start = bytes;
+    p.end = bytes + length;
+    p.options = options;
+    p.callbacks = callbacks;
+    p.context = context;
+    
+    // Skip the UTF-8 BOM
+    if (length >= 3 && 0 == memcmp(bytes, "\xEF\xBB\xBF", 3))
+        p.cur += 3;
+    
+    _skip_Whitespace(&p);
+    
+    if (!(options & ECJSONParseAllowFragments) && (p.cur >= p.end || ('{' != *p.cur && '[' != *p.cur)))
+    {
+        status = ECJSONParseErrorFragment;
+    }
+    else
+    {
+        status = _parse_Value(&p);
+        
+        if (ECJSONParseOK == status)
+        {
+            _skip_Whitespace(&p);
+            
+            if (p.cur != p.end)
+                status = ECJSONParseErrorSyntax;
+        }
+    }
+    
+    if (ECJSONParseOK != status && NULL != errorOffset)
+        *errorOffset = (size_t)(p.cur - p.start);
+    
+    free(p.scratch);
+    
+    return status;
+}
+
+ECJSONParseStatus ECJSONParseWithIndex(const char *bytes, size_t length, const ECJSONStructuralIndex *index, unsigned int options, const ECJSONCallbacks *callbacks, void *context, size_t *errorOffset)
+{
+    ECJSONParser p;
+    ECJSONParseStatus status;
+    size_t cursor = 0;
+    
+    if (NULL == bytes || NULL == index || NULL == callbacks)
+        return ECJSONParseErrorSyntax;
+    
+    memset(&p, 0, sizeof(ECJSONParser));
+    
+    p.cur = p.start = bytes;
+    p.end = bytes + length;
+    p.options = options;
+    p.callbacks = callbacks;
+    p.context = context;
+    
+    if (0 == index->count)
+    {
+        p.cur = p.end;
+        status = (options & ECJSONParseAllowFragments) ? ECJSONParseErrorSyntax : ECJSONParseErrorFragment;
+    }
+    else if (!(options & ECJSONParseAllowFragments) && '{' != bytes[index->positions[0]] && '[' != bytes[index->positions[0]])
+    {
+        p.cur = bytes + index->positions[0];
+        status = ECJSONParseErrorFragment;
+    }
+    else
+    {
+        status = _parse_Indexed(&p, index->positions, index->count, &cursor);
+        
+        // Trailing values
+        if (ECJSONParseOK == status && cursor != index->count)
+        {
+            p.cur = bytes + index->positions[cursor];
+            status = ECJSONParseErrorSyntax;
+        }
+    }
+    
+    if (ECJSONParseOK != status && NULL != errorOffset)
+        *errorOffset = (size_t)(p.cur - p.start);
+    
+    free(p.scratch);
+    
+    return status;
+}
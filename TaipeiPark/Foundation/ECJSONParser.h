@@ -0,0 +1,82 @@
+/**
+ * \file 	ECJSONParser.h
+ * \brief	Event based JSON parser. Plain C, no Foundation dependency, so it can be built and
+ *          tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECJSONParser_h
+#define ECJSONParser_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The options of the parser.
+ */
+enum
+{
+    /// Allow a top-level value which is not an object or an array.
+    ECJSONParseAllowFragments   = 1 << 0,
+    
+    /// Do not report the object members whose value is null, neither the key nor the value.
+    ECJSONParseSkipNullMembers  = 1 << 1,
+};
+
+/**
+ *  The callbacks of the parser. Each callback returns 0 to continue, other values stop the parsing.
+ *  The string bytes are UTF-8, not terminated, and only valid during the call. Any callback may be NULL.
+ */
+typedef struct ECJSONCallbacks
+{
+    int (*beginObject)(void *context);
+    int (*endObject)(void *context);
+    int (*beginArray)(void *context);
+    int (*endArray)(void *context);
+    int (*key)(void *context, const char *bytes, size_t length);
+    int (*string)(void *context, const char *bytes, size_t length);
+    
+    /// isInteger is 1 if the number has no fraction nor exponent and fits in int64_t, then integer is set, otherwise real is set.
+    int (*number)(void *context, int isInteger, int64_t integer, double real);
+    int (*boolean)(void *context, int value);
+    int (*null)(void *context);
+} ECJSONCallbacks;
+
+/**
+ *  The result of the parsing.
+ */
+typedef enum ECJSONParseStatus
+{
+    ECJSONParseOK = 0,
+    ECJSONParseErrorSyntax,             // Unexpected character or end of the input
+    ECJSONParseErrorTooDeep,            // Nested more than ECJSON_MAX_DEPTH
+    ECJSONParseErrorInvalidString,      // Control character or invalid escape in a string
+    ECJSONParseErrorFragment,           // Top-level value is not a container
+    ECJSONParseErrorCanceled,           // A callback returned a non-zero value
+    ECJSONParseErrorOutOfMemory,
+    ECJSONParseErrorInvalidUTF8         // Malformed UTF-8 sequence, only checked by ECJSONStructuralIndexBuild
+} ECJSONParseStatus;
+
+#define ECJSON_MAX_DEPTH 512
+
+/**
+ * \brief	Parse the UTF-8 JSON text and report the values through the callbacks, in document order.
+ * \param   bytes       The JSON text.
+ *          length      The length of the text.
+ *          options     ECJSONParseAllowFragments, ECJSONParseSkipNullMembers.
+ *          callbacks   The callbacks.
+ *          context     Passed to the callbacks.
+ *          errorOffset Set to the offset of the error if not NULL.
+ * \return	ECJSONParseOK on success, otherwise the error.
+ */
+ECJSONParseStatus ECJSONParse(const char *bytes, size_t length, unsigned int options, const ECJSONCallbacks *callbacks, void *context, size_t *errorOffset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECJSONParser_h */
@@ -0,0 +1,581 @@
+/**
+ * \file 	ECJSONStructuralIndex.c
+ * \brief	Vectorized first stage of the JSON parsing, find the structural characters and validate
+ *          the UTF-8.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECJSONStructuralIndex.h"
+#include "ECUTF8.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EC_JSON_X86 1
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+#if defined(__aarch64__)
+#define EC_JSON_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EC_INLINE static inline __attribute__((always_inline))
+#define EC_TARGET(name) __attribute__((target(name)))
+#else
+#define EC_INLINE static inline
+#define EC_TARGET(name)
+#endif
+
+#define BLOCK_SIZE 64
+#define VALIDATION_CHUNK 4096     // The UTF-8 is validated by chunks, the vector validators need long runs
+
+/**
+ *  The classes of the 64 bytes of a block, one bit per byte.
+ */
+typedef struct ECJSONBlockMasks
+{
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t whitespace;
+    uint64_t op;                // { } [ ] : ,
+    uint64_t control;           // < 0x20
+    uint64_t nonASCII;
+} ECJSONBlockMasks;
+
+/**
+ *  The state carried from a block to the next one.
+ */
+typedef struct ECJSONScanState
+{
+    uint64_t prevEndsOddBackslash;      // 1 if the block ends with an odd count of backslashes
+    uint64_t prevInString;              // All ones if the block ends in a string
+    uint64_t prevScalar;                // 1 if the last byte of the block is in a number or a literal
+
+    size_t validated;                   // The UTF-8 is validated up to this offset, it may be some blocks ahead
+    ECUTF8Kernel utf8Kernel;
+} ECJSONScanState;
+
+// Private Functions
+
+static int _count_Trailing_Zeros(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(value);
+#else
+    int n = 0;
+
+    while (0 == (value & 1))
+    {
+        value >>= 1;
+        n++;
+    }
+
+    return n;
+#endif
+}
+
+/**
+ * \brief	Bit i of the result is the parity of the bits 0 ~ i, i.e. whether the byte is after an odd count of quotes.
+ */
+EC_INLINE uint64_t _prefix_Xor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+/**
+ * \brief	Find the characters escaped by a backslash, i.e. the ends of the odd-length backslash runs.
+ */
+EC_INLINE uint64_t _find_Escaped(uint64_t backslash, uint64_t *prevEndsOddBackslash)
+{
+    const uint64_t evenBits = 0x5555555555555555ULL;
+    const uint64_t oddBits = ~evenBits;
+    uint64_t startEdges = backslash & ~(backslash << 1);
+
+    // A run continued from the previous block starts on the other parity
+    uint64_t evenStartMask = evenBits ^ *prevEndsOddBackslash;
+    uint64_t evenStarts = startEdges & evenStartMask;
+    uint64_t oddStarts = startEdges & ~evenStartMask;
+    uint64_t evenCarries = backslash + evenStarts;
+    uint64_t oddCarries = backslash + oddStarts;
+    uint64_t endsOddBackslash = (oddCarries < backslash) ? 1 : 0;
+
+    oddCarries |= *prevEndsOddBackslash;
+    *prevEndsOddBackslash = endsOddBackslash;
+
+    return ((evenCarries & ~backslash) & oddBits) | ((oddCarries & ~backslash) & evenBits);
+}
+
+/**
+ * \brief	Validate the UTF-8 of a chunk ahead, starting at a leading byte. The chunk ends before the
+ *          last leading byte, so no sequence crosses it.
+ * \param   validated   Set to the end of the chunk.
+ * \return	The offset of the first malformed sequence, or SIZE_MAX if the chunk is valid.
+ */
+static size_t _validate_UTF8(const uint8_t *bytes, size_t from, size_t length, ECUTF8Kernel kernel, size_t *validated)
+{
+    size_t to = (from + VALIDATION_CHUNK < length) ? from + VALIDATION_CHUNK : length;
+    size_t offset;
+    int k;
+
+    // A stray continuation after 3 is caught at the start of the next chunk
+    for (k = 0; k < 3 && to < length && 0x80 == (bytes[to] & 0xC0); k++)
+        to--;
+
+    if (!ECUTF8Validate((const char*)bytes + from, to - from, kernel, &offset))
+        return from + offset;
+
+    *validated = to;
+
+    return SIZE_MAX;
+}
+
+static int _reserve_Positions(ECJSONStructuralIndex *index, size_t count)
+{
+    uint32_t *positions;
+    size_t capacity;
+
+    if (count <= index->capacity)
+        return 1;
+
+    capacity = (index->capacity > 0) ? index->capacity * 2 : 1024;
+
+    while (capacity < count)
+        capacity *= 2;
+
+    positions = (uint32_t*)realloc(index->positions, capacity * sizeof(uint32_t));
+
+    if (NULL == positions)
+        return 0;
+
+    index->positions = positions;
+    index->capacity = capacity;
+
+    return 1;
+}
+
+/**
+ * \brief	Find the structurals of a classified block and append their positions to the index.
+ */
+EC_INLINE ECJSONParseStatus _process_Block(ECJSONStructuralIndex *index, ECJSONScanState *state, const ECJSONBlockMasks *masks, const uint8_t *bytes, size_t length, size_t base, size_t *errorOffset)
+{
+    uint64_t escaped = _find_Escaped(masks->backslash, &state->prevEndsOddBackslash);
+    uint64_t quote = masks->quote & ~escaped;
+
+    // The opening quotes are in the strings, the closing quotes are not
+    uint64_t inString = _prefix_Xor(quote) ^ state->prevInString;
+    uint64_t scalar, structurals;
+
+    state->prevInString = (uint64_t)((int64_t)inString >> 63);
+
+    if (0 != (masks->control & inString))
+    {
+        *errorOffset = base + (size_t)_count_Trailing_Zeros(masks->control & inString);
+        return ECJSONParseErrorInvalidString;
+    }
+
+    // The sequences are validated on the text, so they can cross the blocks
+    if (0 != masks->nonASCII && state->validated < base + BLOCK_SIZE)
+    {
+        size_t from = (state->validated > base) ? state->validated : base;
+        size_t invalid = _validate_UTF8(bytes, from, length, state->utf8Kernel, &state->validated);
+
+        if (SIZE_MAX != invalid)
+        {
+            *errorOffset = invalid;
+            return ECJSONParseErrorInvalidUTF8;
+        }
+    }
+
+    // A value other than a string or a container starts at the first byte of a run of the other characters
+    scalar = ~(masks->op | masks->whitespace | quote) & ~inString;
+    structurals = (masks->op & ~inString) | quote | (scalar & ~((scalar << 1) | state->prevScalar));
+    state->prevScalar = scalar >> 63;
+
+    if (0 == structurals)
+        return ECJSONParseOK;
+
+    if (!_reserve_Positions(index, index->count + BLOCK_SIZE))
+        return ECJSONParseErrorOutOfMemory;
+
+    {
+        uint32_t *out = index->positions + index->count;
+
+        while (0 != structurals)
+        {
+            *out++ = (uint32_t)(base + (size_t)_count_Trailing_Zeros(structurals));
+            structurals &= structurals - 1;
+        }
+
+        index->count = (size_t)(out - index->positions);
+    }
+
+    return ECJSONParseOK;
+}
+
+// Classifiers
+
+typedef void (*ECJSONClassifier)(const uint8_t *block, ECJSONBlockMasks *masks);
+
+static void _classify_Scalar(const uint8_t *block, ECJSONBlockMasks *masks)
+{
+    int i;
+
+    memset(masks, 0, sizeof(ECJSONBlockMasks));
+
+    for (i = 0; i < BLOCK_SIZE; i++)
+    {
+        uint8_t c = block[i];
+        uint64_t bit = 1ULL << i;
+
+        if ('"' == c)
+            masks->quote |= bit;
+        else if ('\\' == c)
+            masks->backslash |= bit;
+        else if (' ' == c || '\t' == c || '\n' == c || '\r' == c)
+            masks->whitespace |= bit;
+        else if ('{' == c || '}' == c || '[' == c || ']' == c || ':' == c || ',' == c)
+            masks->op |= bit;
+
+        if (c < 0x20)
+            masks->control |= bit;
+
+        if (c >= 0x80)
+            masks->nonASCII |= bit;
+    }
+}
+
+#if EC_JSON_X86
+
+EC_INLINE uint64_t _movemask_SSE2(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    return (uint64_t)(uint16_t)_mm_movemask_epi8(a) | ((uint64_t)(uint16_t)_mm_movemask_epi8(b) << 16) | ((uint64_t)(uint16_t)_mm_movemask_epi8(c) << 32) | ((uint64_t)(uint16_t)_mm_movemask_epi8(d) << 48);
+}
+
+EC_INLINE void _classify_SSE2(const uint8_t *block, ECJSONBlockMasks *masks)
+{
+    __m128i v[4], quote[4], backslash[4], whitespace[4], op[4], control[4];
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*)(block + 16 * i));
+
+        // '[' | 0x20 is '{' and ']' | 0x20 is '}'
+        __m128i folded = _mm_or_si128(x, _mm_set1_epi8(0x20));
+
+        v[i] = x;
+        quote[i] = _mm_cmpeq_epi8(x, _mm_set1_epi8('"'));
+        backslash[i] = _mm_cmpeq_epi8(x, _mm_set1_epi8('\\'));
+        whitespace[i] = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\t'))), _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(x, _mm_set1_epi8('\r'))));
+        op[i] = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, _mm_set1_epi8('{')), _mm_cmpeq_epi8(folded, _mm_set1_epi8('}'))), _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(':')), _mm_cmpeq_epi8(x, _mm_set1_epi8(','))));
+        control[i] = _mm_cmpeq_epi8(_mm_max_epu8(x, _mm_set1_epi8(0x1F)), _mm_set1_epi8(0x1F));
+    }
+
+    masks->quote = _movemask_SSE2(quote[0], quote[1], quote[2], quote[3]);
+    masks->backslash = _movemask_SSE2(backslash[0], backslash[1], backslash[2], backslash[3]);
+    masks->whitespace = _movemask_SSE2(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+    masks->op = _movemask_SSE2(op[0], op[1], op[2], op[3]);
+    masks->control = _movemask_SSE2(control[0], control[1], control[2], control[3]);
+    masks->nonASCII = _movemask_SSE2(v[0], v[1], v[2], v[3]);
+}
+
+EC_INLINE EC_TARGET("avx2") uint64_t _movemask_AVX2(__m256i lo, __m256i hi)
+{
+    return (uint64_t)(uint32_t)_mm256_movemask_epi8(lo) | ((uint64_t)(uint32_t)_mm256_movemask_epi8(hi) << 32);
+}
+
+EC_INLINE EC_TARGET("avx2") void _classify_AVX2(const uint8_t *block, ECJSONBlockMasks *masks)
+{
+    __m256i v[2], quote[2], backslash[2], whitespace[2], op[2], control[2];
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(block + 32 * i));
+        __m256i folded = _mm256_or_si256(x, _mm256_set1_epi8(0x20));
+
+        v[i] = x;
+        quote[i] = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"'));
+        backslash[i] = _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'));
+        whitespace[i] = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(' ')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\t'))), _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8('\r'))));
+        op[i] = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(folded, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(folded, _mm256_set1_epi8('}'))), _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(x, _mm256_set1_epi8(','))));
+        control[i] = _mm256_cmpeq_epi8(_mm256_max_epu8(x, _mm256_set1_epi8(0x1F)), _mm256_set1_epi8(0x1F));
+    }
+
+    masks->quote = _movemask_AVX2(quote[0], quote[1]);
+    masks->backslash = _movemask_AVX2(backslash[0], backslash[1]);
+    masks->whitespace = _movemask_AVX2(whitespace[0], whitespace[1]);
+    masks->op = _movemask_AVX2(op[0], op[1]);
+    masks->control = _movemask_AVX2(control[0], control[1]);
+    masks->nonASCII = _movemask_AVX2(v[0], v[1]);
+}
+
+static int _cpu_Has_AVX2(void)
+{
+    unsigned int eax, ebx, ecx, edx, xcr0Low, xcr0High;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+        return 0;
+
+    // The OS must save the YMM registers
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+
+    if (6 != (xcr0Low & 6) || __get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return 0 != (ebx & bit_AVX2);
+}
+
+#endif /* EC_JSON_X86 */
+
+#if EC_JSON_NEON
+
+EC_INLINE uint64_t _movemask_NEON(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d)
+{
+    static const uint8_t weights[16] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
+    const uint8x16_t bits = vld1q_u8(weights);
+
+    // Each pairwise add halves the lanes, four bytes of 16 bits remain after three rounds
+    uint8x16_t sum0 = vpaddq_u8(vandq_u8(a, bits), vandq_u8(b, bits));
+    uint8x16_t sum1 = vpaddq_u8(vandq_u8(c, bits), vandq_u8(d, bits));
+
+    sum0 = vpaddq_u8(sum0, sum1);
+    sum0 = vpaddq_u8(sum0, sum0);
+
+    return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+
+EC_INLINE void _classify_NEON(const uint8_t *block, ECJSONBlockMasks *masks)
+{
+    uint8x16_t v[4], quote[4], backslash[4], whitespace[4], op[4], control[4], nonASCII[4];
+    int i;
+
+    for (i = 0; i < 4; i++)
+    {
+        uint8x16_t x = vld1q_u8(block + 16 * i);
+        uint8x16_t folded = vorrq_u8(x, vdupq_n_u8(0x20));
+
+        v[i] = x;
+        quote[i] = vceqq_u8(x, vdupq_n_u8('"'));
+        backslash[i] = vceqq_u8(x, vdupq_n_u8('\\'));
+        whitespace[i] = vorrq_u8(vorrq_u8(vceqq_u8(x, vdupq_n_u8(' ')), vceqq_u8(x, vdupq_n_u8('\t'))), vorrq_u8(vceqq_u8(x, vdupq_n_u8('\n')), vceqq_u8(x, vdupq_n_u8('\r'))));
+        op[i] = vorrq_u8(vorrq_u8(vceqq_u8(folded, vdupq_n_u8('{')), vceqq_u8(folded, vdupq_n_u8('}'))), vorrq_u8(vceqq_u8(x, vdupq_n_u8(':')), vceqq_u8(x, vdupq_n_u8(','))));
+        control[i] = vcltq_u8(x, vdupq_n_u8(0x20));
+        nonASCII[i] = vcgeq_u8(x, vdupq_n_u8(0x80));
+    }
+
+    masks->quote = _movemask_NEON(quote[0], quote[1], quote[2], quote[3]);
+    masks->backslash = _movemask_NEON(backslash[0], backslash[1], backslash[2], backslash[3]);
+    masks->whitespace = _movemask_NEON(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+    masks->op = _movemask_NEON(op[0], op[1], op[2], op[3]);
+    masks->control = _movemask_NEON(control[0], control[1], control[2], control[3]);
+    masks->nonASCII = _movemask_NEON(nonASCII[0], nonASCII[1], nonASCII[2], nonASCII[3]);
+}
+
+#endif /* EC_JSON_NEON */
+
+// Scan
+
+/**
+ * \brief	Scan the text block by block, the classifier is inlined in each kernel.
+ */
+EC_INLINE ECJSONParseStatus _scan(ECJSONStructuralIndex *index, const uint8_t *bytes, size_t start, size_t length, ECJSONClassifier classify, ECUTF8Kernel utf8Kernel, size_t *errorOffset)
+{
+    ECJSONScanState state;
+    ECJSONBlockMasks masks;
+    ECJSONParseStatus status;
+    uint8_t tail[BLOCK_SIZE];
+    size_t base = start;
+
+    memset(&state, 0, sizeof(ECJSONScanState));
+    state.utf8Kernel = utf8Kernel;
+
+    for (; base + BLOCK_SIZE <= length; base += BLOCK_SIZE)
+    {
+        classify(bytes + base, &masks);
+
+        if (ECJSONParseOK != (status = _process_Block(index, &state, &masks, bytes, length, base, errorOffset)))
+            return status;
+    }
+
+    // The last partial block is padded with spaces
+    if (base < length)
+    {
+        memset(tail, ' ', BLOCK_SIZE);
+        memcpy(tail, bytes + base, length - base);
+        classify(tail, &masks);
+
+        if (ECJSONParseOK != (status = _process_Block(index, &state, &masks, bytes, length, base, errorOffset)))
+        {
+            if (*errorOffset > length)
+                *errorOffset = length;
+
+            return status;
+        }
+    }
+
+    if (0 != state.prevInString)
+    {
+        *errorOffset = length;
+        return ECJSONParseErrorSyntax;
+    }
+
+    return ECJSONParseOK;
+}
+
+static ECJSONParseStatus _scan_Scalar(ECJSONStructuralIndex *index, const uint8_t *bytes, size_t start, size_t length, size_t *errorOffset)
+{
+    return _scan(index, bytes, start, length, _classify_Scalar, ECUTF8KernelScalar, errorOffset);
+}
+
+#if EC_JSON_X86
+
+static ECJSONParseStatus _scan_SSE2(ECJSONStructuralIndex *index, const uint8_t *bytes, size_t start, size_t length, size_t *errorOffset)
+{
+    return _scan(index, bytes, start, length, _classify_SSE2, ECUTF8KernelSSSE3, errorOffset);
+}
+
+static EC_TARGET("avx2") ECJSONParseStatus _scan_AVX2(ECJSONStructuralIndex *index, const uint8_t *bytes, size_t start, size_t length, size_t *errorOffset)
+{
+    return _scan(index, bytes, start, length, _classify_AVX2, ECUTF8KernelAVX2, errorOffset);
+}
+
+#endif
+
+#if EC_JSON_NEON
+
+static ECJSONParseStatus _scan_NEON(ECJSONStructuralIndex *index, const uint8_t *bytes, size_t start, size_t length, size_t *errorOffset)
+{
+    return _scan(index, bytes, start, length, _classify_NEON, ECUTF8KernelNEON, errorOffset);
+}
+
+#endif
+
+// Public Functions
+
+ECJSONKernel ECJSONBestKernel(void)
+{
+    static ECJSONKernel best = ECJSONKernelAuto;
+
+    // Racing threads compute the same value
+    if (ECJSONKernelAuto == best)
+    {
+#if EC_JSON_X86
+        best = _cpu_Has_AVX2() ? ECJSONKernelAVX2 : ECJSONKernelSSE2;
+#elif EC_JSON_NEON
+        best = ECJSONKernelNEON;
+#else
+        best = ECJSONKernelScalar;
+#endif
+    }
+
+    return best;
+}
+
+int ECJSONKernelIsSupported(ECJSONKernel kernel)
+{
+    switch (kernel)
+    {
+        case ECJSONKernelAuto:
+        case ECJSONKernelScalar:
+            return 1;
+#if EC_JSON_X86
+        case ECJSONKernelSSE2:
+            return 1;
+        case ECJSONKernelAVX2:
+            return ECJSONKernelAVX2 == ECJSONBestKernel();
+#endif
+#if EC_JSON_NEON
+        case ECJSONKernelNEON:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+const char* ECJSONKernelName(ECJSONKernel kernel)
+{
+    switch (kernel)
+    {
+        case ECJSONKernelAuto:      return "auto";
+        case ECJSONKernelScalar:    return "scalar";
+        case ECJSONKernelSSE2:      return "sse2";
+        case ECJSONKernelAVX2:      return "avx2";
+        case ECJSONKernelNEON:      return "neon";
+    }
+
+    return "unknown";
+}
+
+ECJSONParseStatus ECJSONStructuralIndexBuild(ECJSONStructuralIndex *index, const char *bytes, size_t length, ECJSONKernel kernel, size_t *errorOffset)
+{
+    ECJSONParseStatus status;
+    size_t offset = 0;
+    size_t start = 0;
+
+    if (NULL == index || NULL == bytes || length > UINT32_MAX)
+        return ECJSONParseErrorSyntax;
+
+    if (ECJSONKernelAuto == kernel || !ECJSONKernelIsSupported(kernel))
+        kernel = ECJSONBestKernel();
+
+    index->count = 0;
+    index->kernel = kernel;
+
+    // Most structurals are a few bytes apart in the feeds
+    if (!_reserve_Positions(index, length / 8 + BLOCK_SIZE))
+        return ECJSONParseErrorOutOfMemory;
+
+    // Skip the UTF-8 BOM
+    if (length >= 3 && 0 == memcmp(bytes, "\xEF\xBB\xBF", 3))
+        start = 3;
+
+    switch (kernel)
+    {
+#if EC_JSON_X86
+        case ECJSONKernelSSE2:
+            status = _scan_SSE2(index, (const uint8_t*)bytes, start, length, &offset);
+            break;
+        case ECJSONKernelAVX2:
+            status = _scan_AVX2(index, (const uint8_t*)bytes, start, length, &offset);
+            break;
+#endif
+#if EC_JSON_NEON
+        case ECJSONKernelNEON:
+            status = _scan_NEON(index, (const uint8_t*)bytes, start, length, &offset);
+            break;
+#endif
+        default:
+            status = _scan_Scalar(index, (const uint8_t*)bytes, start, length, &offset);
+            break;
+    }
+
+    if (ECJSONParseOK != status && NULL != errorOffset)
+        *errorOffset = offset;
+
+    return status;
+}
+
+void ECJSONStructuralIndexDestroy(ECJSONStructuralIndex *index)
+{
+    if (NULL != index)
+    {
+        free(index->positions);
+        index->positions = NULL;
+        index->count = 0;
+        index->capacity = 0;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * \file 	ECJSONStructuralIndex.h
+ * \brief	Vectorized first stage of the JSON parsing, find the structural characters and validate
+ *          the UTF-8. Plain C, no Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECJSONStructuralIndex_h
+#define ECJSONStructuralIndex_h
+
+#include "ECJSONParser.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The implementations of the scan. ECJSONKernelAuto picks the best one supported by the CPU at runtime.
+ */
+typedef enum ECJSONKernel
+{
+    ECJSONKernelAuto = 0,
+    ECJSONKernelScalar,
+    ECJSONKernelSSE2,           // x86
+    ECJSONKernelAVX2,           // x86 with AVX2, checked by CPUID
+    ECJSONKernelNEON            // arm64
+} ECJSONKernel;
+
+/**
+ *  The positions of the structural characters of a JSON text, in order: the brackets, the braces,
+ *  the colons and the commas out of the strings, the opening and the closing quotes of the strings,
+ *  and the first character of the other values (numbers, true, false, null). The positions are
+ *  32 bits, so the text is limited to 4 GB.
+ */
+typedef struct ECJSONStructuralIndex
+{
+    uint32_t *positions;
+    size_t count;
+    size_t capacity;
+    ECJSONKernel kernel;        // The kernel used by the last build
+} ECJSONStructuralIndex;
+
+/**
+ * \brief	Get the best kernel supported by this CPU.
+ */
+ECJSONKernel ECJSONBestKernel(void);
+
+/**
+ * \brief	Check whether the kernel is built in and supported by this CPU.
+ */
+int ECJSONKernelIsSupported(ECJSONKernel kernel);
+
+/**
+ * \brief	A short name of the kernel, e.g. "avx2".
+ */
+const char* ECJSONKernelName(ECJSONKernel kernel);
+
+/**
+ * \brief	Build the index of the UTF-8 JSON text. The index can be reused, its memory is kept between builds.
+ * \param   kernel      The kernel to use, ECJSONKernelAuto or an unsupported kernel picks the best one.
+ *          errorOffset Set to the offset of the error if not NULL.
+ * \return	ECJSONParseOK on success. ECJSONParseErrorInvalidUTF8 for a malformed UTF-8 sequence,
+ *          ECJSONParseErrorInvalidString for a control character in a string, ECJSONParseErrorSyntax
+ *          for an unclosed string.
+ */
+ECJSONParseStatus ECJSONStructuralIndexBuild(ECJSONStructuralIndex *index, const char *bytes, size_t length, ECJSONKernel kernel, size_t *errorOffset);
+
+/**
+ * \brief	Release the memory of the index.
+ */
+void ECJSONStructuralIndexDestroy(ECJSONStructuralIndex *index);
+
+/**
+ * \brief	Second stage, parse the text by walking its index, and report the values like ECJSONParse.
+ *          The strings without escapes are reported without scanning their bytes again.
+ * \param   index       The index built from the same text.
+ *          The others are the same as ECJSONParse.
+ * \return	ECJSONParseOK on success, otherwise the error.
+ */
+ECJSONParseStatus ECJSONParseWithIndex(const char *bytes, size_t length, const ECJSONStructuralIndex *index, unsigned int options, const ECJSONCallbacks *callbacks, void *context, size_t *errorOffset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECJSONStructuralIndex_h */
@@ -0,0 +1,628 @@
+/**
+ * \file 	ECNeighborIndex.c
+ * \brief	The top-k similar documents of each document, by the TF-IDF of the texts and the groups.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECNeighborIndex.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EC_NEIGHBOR_X86 1
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+#if defined(__aarch64__)
+#define EC_NEIGHBOR_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EC_INLINE static inline __attribute__((always_inline))
+#define EC_TARGET(name) __attribute__((target(name)))
+#else
+#define EC_INLINE static inline
+#define EC_TARGET(name)
+#endif
+
+#define BLOCK_ROWS  4               // The rows computed in one pass over the vectors
+
+enum
+{
+    STATE_EMPTY = 0,
+    STATE_CLEAN,
+    STATE_DIRTY,                    // Set, the neighbors are computed by the next update
+    STATE_RECOMPUTE,                // A neighbor is removed or farther, the neighbors are computed by the next update
+    STATE_REMOVED
+};
+
+/**
+ *  The dot products of BLOCK_ROWS rows and a vector, the vector is loaded once for all rows.
+ */
+typedef void (*ECDotFunction)(const float *const *rows, const float *vector, float *dots);
+
+// Private Functions
+
+static int _is_Alive(uint8_t state)
+{
+    return STATE_CLEAN == state || STATE_DIRTY == state || STATE_RECOMPUTE == state;
+}
+
+static int _is_Han(uint16_t c)
+{
+    // CJK unified ideographs, the extension A and the compatibility ideographs
+    return (0x3400 <= c && c <= 0x9FFF) || (0xF900 <= c && c <= 0xFAFF);
+}
+
+static int _is_Word_Character(uint16_t c)
+{
+    return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+static uint32_t _hash_Unit(uint32_t hash, uint16_t unit)
+{
+    // FNV-1a of the two bytes
+    hash = (hash ^ (unit & 0xFF)) * 16777619u;
+    return (hash ^ (unit >> 8)) * 16777619u;
+}
+
+static void _add_Term(uint8_t *counts, uint32_t hash)
+{
+    uint8_t *count = counts + (hash & (ECNEIGHBOR_DIMENSION - 1));
+
+    if (*count < 255)
+        (*count)++;
+}
+
+static void _dot_Scalar(const float *const *rows, const float *vector, float *dots)
+{
+    float s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+    {
+        float x = vector[d];
+
+        s0 += rows[0][d] * x;
+        s1 += rows[1][d] * x;
+        s2 += rows[2][d] * x;
+        s3 += rows[3][d] * x;
+    }
+
+    dots[0] = s0;
+    dots[1] = s1;
+    dots[2] = s2;
+    dots[3] = s3;
+}
+
+#if EC_NEIGHBOR_X86
+
+static int _cpu_Has_AVX2_FMA(void)
+{
+    unsigned int eax, ebx, ecx, edx, xcr0Low, xcr0High;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !(ecx & bit_FMA))
+        return 0;
+
+    // The OS must save the YMM registers
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+
+    if (6 != (xcr0Low & 6) || __get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return 0 != (ebx & bit_AVX2);
+}
+
+EC_INLINE EC_TARGET("avx2,fma") float _sum_AVX2(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+
+    return _mm_cvtss_f32(s);
+}
+
+static EC_TARGET("avx2,fma") void _dot_AVX2(const float *const *rows, const float *vector, float *dots)
+{
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps(), s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d += 8)
+    {
+        __m256 x = _mm256_loadu_ps(vector + d);
+
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[0] + d), x, s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[1] + d), x, s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[2] + d), x, s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(rows[3] + d), x, s3);
+    }
+
+    dots[0] = _sum_AVX2(s0);
+    dots[1] = _sum_AVX2(s1);
+    dots[2] = _sum_AVX2(s2);
+    dots[3] = _sum_AVX2(s3);
+}
+
+#endif
+
+#if EC_NEIGHBOR_NEON
+
+static void _dot_NEON(const float *const *rows, const float *vector, float *dots)
+{
+    float32x4_t s0 = vdupq_n_f32(0), s1 = vdupq_n_f32(0), s2 = vdupq_n_f32(0), s3 = vdupq_n_f32(0);
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d += 4)
+    {
+        float32x4_t x = vld1q_f32(vector + d);
+
+        s0 = vfmaq_f32(s0, vld1q_f32(rows[0] + d), x);
+        s1 = vfmaq_f32(s1, vld1q_f32(rows[1] + d), x);
+        s2 = vfmaq_f32(s2, vld1q_f32(rows[2] + d), x);
+        s3 = vfmaq_f32(s3, vld1q_f32(rows[3] + d), x);
+    }
+
+    dots[0] = vaddvq_f32(s0);
+    dots[1] = vaddvq_f32(s1);
+    dots[2] = vaddvq_f32(s2);
+    dots[3] = vaddvq_f32(s3);
+}
+
+#endif
+
+static ECDotFunction _dot_Function(ECNeighborKernel kernel)
+{
+    if (!ECNeighborKernelIsSupported(kernel) || ECNeighborKernelAuto == kernel)
+        kernel = ECNeighborBestKernel();
+
+    switch (kernel)
+    {
+#if EC_NEIGHBOR_X86
+        case ECNeighborKernelAVX2:
+            return _dot_AVX2;
+#endif
+#if EC_NEIGHBOR_NEON
+        case ECNeighborKernelNEON:
+            return _dot_NEON;
+#endif
+        default:
+            return _dot_Scalar;
+    }
+}
+
+static int _grow(ECNeighborIndex *index, size_t needed)
+{
+    size_t capacity = (index->capacity < 64) ? 64 : index->capacity, old = index->capacity;
+    void *p;
+
+    if (needed <= index->capacity)
+        return 0;
+
+    while (capacity < needed)
+        capacity *= 2;
+
+#define GROW(field, size) \
+    if (NULL == (p = realloc(index->field, capacity * (size)))) \
+        return -1; \
+    index->field = p;
+
+    GROW(states, sizeof(uint8_t));
+    GROW(terms, ECNEIGHBOR_DIMENSION);
+    GROW(vectors, ECNEIGHBOR_DIMENSION * sizeof(float));
+    GROW(groups, sizeof(uint32_t));
+    GROW(neighbors, index->neighborCount * sizeof(ECNeighbor));
+    GROW(neighborLengths, sizeof(uint32_t));
+
+#undef GROW
+
+    memset(index->states + old, STATE_EMPTY, capacity - old);
+    memset(index->neighborLengths + old, 0, (capacity - old) * sizeof(uint32_t));
+    index->capacity = capacity;
+
+    return 0;
+}
+
+static void _count_Terms(ECNeighborIndex *index, uint32_t identifier, int delta)
+{
+    const uint8_t *terms = index->terms + (size_t)identifier * ECNEIGHBOR_DIMENSION;
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+    {
+        if (0 != terms[d])
+            index->documentFrequency[d] += delta;
+    }
+}
+
+static void _compute_IDF(ECNeighborIndex *index)
+{
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+        index->idf[d] = logf((1.0f + index->documentCount) / (1.0f + index->documentFrequency[d])) + 1.0f;
+
+    index->idfDocumentCount = index->documentCount;
+}
+
+/**
+ *  The unit vector of the sublinear term frequencies weighted by the IDF.
+ */
+static void _compute_Vector(ECNeighborIndex *index, uint32_t identifier)
+{
+    const uint8_t *terms = index->terms + (size_t)identifier * ECNEIGHBOR_DIMENSION;
+    float *vector = index->vectors + (size_t)identifier * ECNEIGHBOR_DIMENSION;
+    float norm = 0;
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+    {
+        vector[d] = (0 == terms[d]) ? 0 : (1.0f + logf(terms[d])) * index->idf[d];
+        norm += vector[d] * vector[d];
+    }
+
+    if (norm > 0)
+    {
+        norm = 1.0f / sqrtf(norm);
+
+        for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+            vector[d] *= norm;
+    }
+}
+
+static int _is_Better(float score, uint32_t identifier, const ECNeighbor *neighbor)
+{
+    return score > neighbor->score || (score == neighbor->score && identifier < neighbor->identifier);
+}
+
+static void _insert_Neighbor(ECNeighbor *list, uint32_t *length, size_t k, uint32_t identifier, float score)
+{
+    size_t i = *length;
+
+    if (i == k)
+    {
+        if (!_is_Better(score, identifier, &list[k - 1]))
+            return;
+
+        i = k - 1;
+    }
+    else
+    {
+        (*length)++;
+    }
+
+    while (i > 0 && _is_Better(score, identifier, &list[i - 1]))
+    {
+        list[i] = list[i - 1];
+        i--;
+    }
+
+    list[i].identifier = identifier;
+    list[i].score = score;
+}
+
+static size_t _find_Neighbor(const ECNeighbor *list, uint32_t length, uint32_t identifier)
+{
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        if (list[i].identifier == identifier)
+            return i;
+    }
+
+    return (size_t)-1;
+}
+
+static void _remove_Neighbor(ECNeighbor *list, uint32_t *length, size_t position)
+{
+    memmove(list + position, list + position + 1, (*length - position - 1) * sizeof(ECNeighbor));
+    (*length)--;
+}
+
+/**
+ *  Patch the neighbors of a clean document with its new score to a changed one. The neighbors are
+ *  computed again if a kept neighbor gets farther, another document may be nearer than it now.
+ */
+static void _patch_Neighbors(ECNeighborIndex *index, uint32_t identifier, uint32_t changed, float score)
+{
+    size_t k = index->neighborCount;
+    ECNeighbor *list = index->neighbors + (size_t)identifier * k;
+    uint32_t *length = index->neighborLengths + identifier;
+    size_t position = _find_Neighbor(list, *length, changed);
+
+    if ((size_t)-1 != position)
+    {
+        if (score < list[position].score && *length == k)
+        {
+            index->states[identifier] = STATE_RECOMPUTE;
+            return;
+        }
+
+        _remove_Neighbor(list, length, position);
+    }
+
+    _insert_Neighbor(list, length, k, changed, score);
+}
+
+/**
+ *  Compute the neighbors of the rows against all documents, BLOCK_ROWS rows per pass. With patch, the
+ *  scores are also patched into the neighbors of the clean documents, the scores are symmetric.
+ */
+static void _compute_Rows(ECNeighborIndex *index, const uint32_t *rows, size_t rowCount, int patch)
+{
+    ECDotFunction dot = _dot_Function(index->kernel);
+    size_t k = index->neighborCount, b, r, i;
+    float keep = 1.0f - index->groupWeight;
+
+    for (b = 0; b < rowCount; b += BLOCK_ROWS)
+    {
+        size_t n = (rowCount - b < BLOCK_ROWS) ? rowCount - b : BLOCK_ROWS;
+        const float *block[BLOCK_ROWS];
+        float dots[BLOCK_ROWS];
+
+        // The last block repeats its first row
+        for (r = 0; r < BLOCK_ROWS; r++)
+            block[r] = index->vectors + (size_t)rows[b + ((r < n) ? r : 0)] * ECNEIGHBOR_DIMENSION;
+
+        for (r = 0; r < n; r++)
+            index->neighborLengths[rows[b + r]] = 0;
+
+        for (i = 0; i < index->capacity; i++)
+        {
+            uint8_t state = index->states[i];
+
+            if (!_is_Alive(state))
+                continue;
+
+            dot(block, index->vectors + i * ECNEIGHBOR_DIMENSION, dots);
+
+            for (r = 0; r < n; r++)
+            {
+                uint32_t row = rows[b + r];
+                float score;
+
+                if (row == i)
+                    continue;
+
+                score = keep * dots[r] + ((index->groups[row] == index->groups[i]) ? index->groupWeight : 0);
+
+                _insert_Neighbor(index->neighbors + (size_t)row * k, index->neighborLengths + row, k, (uint32_t)i, score);
+
+                if (patch && STATE_CLEAN == index->states[i])
+                    _patch_Neighbors(index, (uint32_t)i, row, score);
+            }
+        }
+    }
+}
+
+static size_t _collect_Rows(const ECNeighborIndex *index, uint8_t state, uint32_t *rows)
+{
+    size_t i, n = 0;
+
+    for (i = 0; i < index->capacity; i++)
+    {
+        if (state == index->states[i])
+            rows[n++] = (uint32_t)i;
+    }
+
+    return n;
+}
+
+// Public Functions
+
+ECNeighborKernel ECNeighborBestKernel(void)
+{
+    static ECNeighborKernel best = ECNeighborKernelAuto;
+
+    // Racing threads compute the same value
+    if (ECNeighborKernelAuto == best)
+    {
+#if EC_NEIGHBOR_X86
+        best = _cpu_Has_AVX2_FMA() ? ECNeighborKernelAVX2 : ECNeighborKernelScalar;
+#elif EC_NEIGHBOR_NEON
+        best = ECNeighborKernelNEON;
+#else
+        best = ECNeighborKernelScalar;
+#endif
+    }
+
+    return best;
+}
+
+int ECNeighborKernelIsSupported(ECNeighborKernel kernel)
+{
+    switch (kernel)
+    {
+        case ECNeighborKernelAuto:
+        case ECNeighborKernelScalar:
+            return 1;
+#if EC_NEIGHBOR_X86
+        case ECNeighborKernelAVX2:
+            return ECNeighborKernelAVX2 == ECNeighborBestKernel();
+#endif
+#if EC_NEIGHBOR_NEON
+        case ECNeighborKernelNEON:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+void ECNeighborTerms(const uint16_t *chars, size_t count, uint8_t *counts)
+{
+    size_t i = 0;
+
+    while (i < count)
+    {
+        uint16_t c = chars[i];
+
+        if (_is_Han(c))
+        {
+            if (i + 1 < count && _is_Han(chars[i + 1]))
+                _add_Term(counts, _hash_Unit(_hash_Unit(2166136261u, c), chars[i + 1]));
+
+            i++;
+        }
+        else if (_is_Word_Character(c))
+        {
+            uint32_t hash = 2166136261u;
+
+            for (; i < count && _is_Word_Character(chars[i]); i++)
+                hash = _hash_Unit(hash, ('A' <= chars[i] && chars[i] <= 'Z') ? chars[i] + ('a' - 'A') : chars[i]);
+
+            _add_Term(counts, hash);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ECNeighborIndexInit(ECNeighborIndex *index, size_t neighborCount, float groupWeight, ECNeighborKernel kernel)
+{
+    memset(index, 0, sizeof(ECNeighborIndex));
+
+    index->kernel = kernel;
+    index->neighborCount = (0 == neighborCount) ? 1 : ((neighborCount > ECNEIGHBOR_MAX_NEIGHBORS) ? ECNEIGHBOR_MAX_NEIGHBORS : neighborCount);
+    index->groupWeight = (groupWeight < 0) ? 0 : ((groupWeight > 1) ? 1 : groupWeight);
+}
+
+void ECNeighborIndexDestroy(ECNeighborIndex *index)
+{
+    free(index->states);
+    free(index->terms);
+    free(index->vectors);
+    free(index->groups);
+    free(index->neighbors);
+    free(index->neighborLengths);
+
+    ECNeighborIndexInit(index, index->neighborCount, index->groupWeight, index->kernel);
+}
+
+int ECNeighborIndexSet(ECNeighborIndex *index, uint32_t identifier, const uint8_t *terms, uint32_t group)
+{
+    if (0 != _grow(index, (size_t)identifier + 1))
+        return -1;
+
+    if (_is_Alive(index->states[identifier]))
+        _count_Terms(index, identifier, -1);
+    else
+        index->documentCount++;
+
+    memcpy(index->terms + (size_t)identifier * ECNEIGHBOR_DIMENSION, terms, ECNEIGHBOR_DIMENSION);
+    _count_Terms(index, identifier, 1);
+
+    index->groups[identifier] = group;
+    index->states[identifier] = STATE_DIRTY;
+
+    return 0;
+}
+
+void ECNeighborIndexRemove(ECNeighborIndex *index, uint32_t identifier)
+{
+    if (identifier >= index->capacity || !_is_Alive(index->states[identifier]))
+        return;
+
+    _count_Terms(index, identifier, -1);
+
+    index->documentCount--;
+    index->states[identifier] = STATE_REMOVED;
+}
+
+size_t ECNeighborIndexUpdate(ECNeighborIndex *index)
+{
+    size_t k = index->neighborCount, dirtyCount, recomputeCount, i;
+    size_t drift = (index->documentCount > index->idfDocumentCount) ? index->documentCount - index->idfDocumentCount : index->idfDocumentCount - index->documentCount;
+    uint32_t *rows;
+
+    if (0 == index->capacity)
+        return 0;
+
+    if (NULL == (rows = (uint32_t*)malloc(index->capacity * sizeof(uint32_t))))
+        return 0;
+
+    // All neighbors are computed again with the new IDF
+    if (0 == index->idfDocumentCount || 4 * drift > index->idfDocumentCount)
+    {
+        _compute_IDF(index);
+
+        for (i = 0; i < index->capacity; i++)
+        {
+            if (_is_Alive(index->states[i]))
+                index->states[i] = STATE_DIRTY;
+        }
+    }
+
+    // The documents with a removed neighbor, the list is short of one
+    for (i = 0; i < index->capacity; i++)
+    {
+        size_t j;
+
+        if (STATE_REMOVED != index->states[i])
+            continue;
+
+        for (j = 0; j < index->capacity; j++)
+        {
+            ECNeighbor *list = index->neighbors + j * k;
+            size_t position;
+
+            if (STATE_CLEAN != index->states[j] || (size_t)-1 == (position = _find_Neighbor(list, index->neighborLengths[j], (uint32_t)i)))
+                continue;
+
+            if (index->neighborLengths[j] == k)
+                index->states[j] = STATE_RECOMPUTE;
+            else
+                _remove_Neighbor(list, index->neighborLengths + j, position);
+        }
+
+        index->states[i] = STATE_EMPTY;
+        index->neighborLengths[i] = 0;
+    }
+
+    dirtyCount = _collect_Rows(index, STATE_DIRTY, rows);
+
+    for (i = 0; i < dirtyCount; i++)
+        _compute_Vector(index, rows[i]);
+
+    _compute_Rows(index, rows, dirtyCount, 1);
+
+    for (i = 0; i < dirtyCount; i++)
+        index->states[rows[i]] = STATE_CLEAN;
+
+    // The scores among the others are not changed, so no patch
+    recomputeCount = _collect_Rows(index, STATE_RECOMPUTE, rows);
+
+    _compute_Rows(index, rows, recomputeCount, 0);
+
+    for (i = 0; i < recomputeCount; i++)
+        index->states[rows[i]] = STATE_CLEAN;
+
+    free(rows);
+
+    return dirtyCount + recomputeCount;
+}
+
+size_t ECNeighborIndexNeighbors(const ECNeighborIndex *index, uint32_t identifier, ECNeighbor *out, size_t maxCount)
+{
+    size_t count;
+
+    if (identifier >= index->capacity || !_is_Alive(index->states[identifier]))
+        return 0;
+
+    count = index->neighborLengths[identifier];
+
+    if (count > maxCount)
+        count = maxCount;
+
+    memcpy(out, index->neighbors + (size_t)identifier * index->neighborCount, count * sizeof(ECNeighbor));
+
+    return count;
+}
@@ -0,0 +1,126 @@
+/**
+ * \file 	ECNeighborIndex.h
+ * \brief	The top-k similar documents of each document, by the TF-IDF of the texts and the groups.
+ *          Plain C, no Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECNeighborIndex_h
+#define ECNeighborIndex_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ECNEIGHBOR_DIMENSION        1024    // The hashed terms, a power of 2
+#define ECNEIGHBOR_MAX_NEIGHBORS    32
+
+/**
+ *  The implementations of the dot products. ECNeighborKernelAuto picks the best one supported by the CPU at runtime.
+ */
+typedef enum ECNeighborKernel
+{
+    ECNeighborKernelAuto = 0,
+    ECNeighborKernelScalar,
+    ECNeighborKernelAVX2,           // x86, AVX2 and FMA checked by CPUID
+    ECNeighborKernelNEON            // arm64
+} ECNeighborKernel;
+
+typedef struct ECNeighbor
+{
+    uint32_t identifier;
+    float score;
+} ECNeighbor;
+
+/**
+ *  The documents are identified by small integers, the slots of the arrays. Each document has the
+ *  counts of its hashed terms and a group, e.g. the park of an attraction. The score of two documents
+ *  is (1 - groupWeight) * cos(tf-idf vectors) + groupWeight if they are in the same group.
+ *
+ *  ECNeighborIndexSet and ECNeighborIndexRemove only mark the documents, ECNeighborIndexUpdate then
+ *  computes the neighbors of the changed documents, and patches the neighbors of the others with their
+ *  scores to the changed ones. The IDF is kept until the count of the documents changes by a quarter,
+ *  then all neighbors are computed again. Not thread safe, update it on one thread and publish a copy.
+ */
+typedef struct ECNeighborIndex
+{
+    ECNeighborKernel kernel;
+    size_t neighborCount;           // k
+    float groupWeight;
+
+    size_t capacity;                // The slots
+    uint8_t *states;
+    uint8_t *terms;                 // The term counts per slot, saturated at 255
+    float *vectors;                 // The unit tf-idf vectors per slot
+    uint32_t *groups;
+    ECNeighbor *neighbors;          // neighborCount per slot, the best first
+    uint32_t *neighborLengths;
+
+    uint32_t documentFrequency[ECNEIGHBOR_DIMENSION];
+    float idf[ECNEIGHBOR_DIMENSION];
+    size_t documentCount;
+    size_t idfDocumentCount;        // The count of the documents when the IDF was computed
+} ECNeighborIndex;
+
+/**
+ * \brief	Get the best kernel supported by this CPU.
+ */
+ECNeighborKernel ECNeighborBestKernel(void);
+
+/**
+ * \brief	Check whether the kernel is built in and supported by this CPU.
+ */
+int ECNeighborKernelIsSupported(ECNeighborKernel kernel);
+
+/**
+ * \brief	Count the hashed terms of the UTF-16 text: the pairs of the adjacent Han characters and
+ *          the ASCII words, case insensitive.
+ * \param   counts      The ECNEIGHBOR_DIMENSION counts to add to, saturated at 255.
+ */
+void ECNeighborTerms(const uint16_t *chars, size_t count, uint8_t *counts);
+
+/**
+ * \brief	Initialize the empty index.
+ * \param   neighborCount   The neighbors kept per document, at most ECNEIGHBOR_MAX_NEIGHBORS.
+ *          groupWeight     The weight of the same group, 0 ~ 1.
+ *          kernel          The kernel to use, ECNeighborKernelAuto or an unsupported kernel picks the best one.
+ */
+void ECNeighborIndexInit(ECNeighborIndex *index, size_t neighborCount, float groupWeight, ECNeighborKernel kernel);
+
+/**
+ * \brief	Release the memory of the index. The index can be initialized again after that.
+ */
+void ECNeighborIndexDestroy(ECNeighborIndex *index);
+
+/**
+ * \brief	Add or replace the document of the identifier.
+ * \param   terms       The ECNEIGHBOR_DIMENSION term counts of ECNeighborTerms.
+ * \return	0 on success, -1 if out of memory.
+ */
+int ECNeighborIndexSet(ECNeighborIndex *index, uint32_t identifier, const uint8_t *terms, uint32_t group);
+
+/**
+ * \brief	Remove the document of the identifier.
+ */
+void ECNeighborIndexRemove(ECNeighborIndex *index, uint32_t identifier);
+
+/**
+ * \brief	Compute the neighbors after the documents are set or removed.
+ * \return	The count of the documents whose neighbors are computed from scratch.
+ */
+size_t ECNeighborIndexUpdate(ECNeighborIndex *index);
+
+/**
+ * \brief	Get the neighbors of the document, the best first.
+ * \return	The count of the written neighbors.
+ */
+size_t ECNeighborIndexNeighbors(const ECNeighborIndex *index, uint32_t identifier, ECNeighbor *out, size_t maxCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECNeighborIndex_h */
@@ -0,0 +1,44 @@
+/**
+ * \file 	ECNetworkWarmUp.h
+ * \brief	Open the connections of the API and the image hosts at launch.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class AFHTTPSessionManager;
+
+/// The URL of the park attractions API.
+extern NSString * const kECParkAPIURL;
+
+/**
+ *  Warm up the DNS lookup and the connections before the first request, so the refresh and
+ *  the first thumbnails do not pay the handshakes. The API requests must use apiManager, the
+ *  warmed connections only live in the pool of the session which opened them.
+ */
+@interface ECNetworkWarmUp : NSObject
+
++ (ECNetworkWarmUp*)sharedInstance;
+
+/// The session manager shared by the API requests.
+@property (nonatomic, strong, readonly) AFHTTPSessionManager *apiManager;
+
+/// The URLs warmed up with apiManager, default is the host of kECParkAPIURL.
+@property (nonatomic, copy) NSArray<NSURL*> *aryAPIURLs;
+
+/// The max count of image hosts read from the dataset snapshot, default is 2.
+@property (nonatomic, assign) NSUInteger maxImageHosts;
+
+/// Warm up only on every other launch and log the time to first byte of the first request
+/// to each host, so cold and warm launches can be compared. Default is the value of the
+/// user default "ECNetworkWarmUpMeasurement", e.g. set by the launch argument
+/// "-ECNetworkWarmUpMeasurement YES". Must be set before warm_Up.
+@property (nonatomic, assign) BOOL measurementMode;
+
+/**
+ * \brief	Start to warm up the API host and the image hosts of the dataset snapshot. The
+ *          snapshot is read on a background queue, it returns immediately.
+ */
+- (void)warm_Up;
+
+@end
@@ -0,0 +1,128 @@
+/**
+ * \file 	ECNetworkWarmUp.m
+ * \brief	Open the connections of the API and the image hosts at launch.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECNetworkWarmUp.h"
+#import "ECDatasetSnapshot.h"
+#import "ECParkAttraction.h"
+#import "AFNetworking.h"
+
+NSString * const kECParkAPIURL = @"http://data.taipei/opendata/datalist/apiAccess";
+
+static NSString * const kMeasurementModeKey = @"ECNetworkWarmUpMeasurement";
+static NSString * const kMeasurementLaunchCountKey = @"ECNetworkWarmUpLaunchCount";
+
+@implementation ECNetworkWarmUp
+{
+    BOOL _warmed;                   // Whether the warm-up is performed in this launch
+    NSMutableSet *_setMeasuredHosts;
+}
+
++ (ECNetworkWarmUp*)sharedInstance
+{
+    static ECNetworkWarmUp *instance = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        instance = [[ECNetworkWarmUp alloc] init];
+    });
+    
+    return instance;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _apiManager = [AFHTTPSessionManager manager];
+        _apiManager.metricsCollector = [AFNetworkMetricsCollector sharedCollector];
+        
+        // Decode the attractions straight from the response, the other fields of the feed are skipped
+        ECSchemaResponseSerializer *serializer = [ECSchemaResponseSerializer serializer_With_Record_Class:[ECParkAttraction class]];
+        
+        serializer.usesStructuralIndex = YES;
+        _apiManager.responseSerializer = serializer;
+        
+        _aryAPIURLs = @[[NSURL URLWithString:kECParkAPIURL]];
+        _maxImageHosts = 2;
+        _measurementMode = [[NSUserDefaults standardUserDefaults] boolForKey:kMeasurementModeKey];
+        _setMeasuredHosts = [[NSMutableSet alloc] init];
+    }
+    
+    return self;
+}
+
+- (void)warm_Up
+{
+    _warmed = YES;
+    
+    if (self.measurementMode)
+    {
+        NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+        NSInteger launchCount = [defaults integerForKey:kMeasurementLaunchCountKey];
+        
+        [defaults setInteger:launchCount + 1 forKey:kMeasurementLaunchCountKey];
+        
+        // Alternate the cold and the warm launches
+        _warmed = (0 == launchCount % 2);
+        
+        [self _measure_Session_Manager:self.apiManager];
+        [self _measure_Session_Manager:[AFImageDownloader defaultInstance].sessionManager];
+        
+        NSLog(@"[WarmUp] measurement mode, %@ launch", _warmed ? @"warm" : @"cold");
+    }
+    
+    if (!_warmed)
+        return;
+    
+    [self.apiManager preconnectToURLs:self.aryAPIURLs completion:nil];
+    
+    // Reading the snapshot should not delay the launch
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSArray *hosts = [[ECDatasetSnapshot sharedSnapshot] image_Hosts_With_Max_Count:self.maxImageHosts];
+        
+        if (hosts.count > 0)
+        {
+            [[AFImageDownloader defaultInstance].sessionManager preconnectToURLs:hosts completion:nil];
+        }
+    });
+}
+
+#pragma mark - Private Functions
+
+/**
+ * \brief	Log the time to first byte of the first request to each host of the session manager.
+ */
+- (void)_measure_Session_Manager: (AFURLSessionManager*) manager
+{
+    if (nil == [NSURLSessionTaskMetrics class])
+        return;
+    
+    __weak typeof(self) weakSelf = self;
+    
+    [manager setTaskDidFinishCollectingMetricsBlock:^(NSURLSession *session, NSURLSessionTask *task, NSURLSessionTaskMetrics *metrics) {
+        __strong typeof(weakSelf) strongSelf = weakSelf;
+        NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+        NSString *host = task.originalRequest.URL.host;
+        
+        // The warm-up requests are not measured
+        if (nil == strongSelf || nil == transaction || nil == host || [task.originalRequest.HTTPMethod isEqualToString:@"HEAD"])
+            return;
+        
+        @synchronized (strongSelf->_setMeasuredHosts)
+        {
+            if ([strongSelf->_setMeasuredHosts containsObject:host])
+                return;
+            
+            [strongSelf->_setMeasuredHosts addObject:host];
+        }
+        
+        NSTimeInterval ttfb = [transaction.responseStartDate timeIntervalSinceDate:transaction.fetchStartDate];
+        
+        NSLog(@"[WarmUp] %@ launch, first request to %@: ttfb %.1f ms, %@ connection", strongSelf->_warmed ? @"warm" : @"cold", host, ttfb * 1000.0, transaction.isReusedConnection ? @"reused" : @"new");
+    }];
+}
+
+@end
@@ -0,0 +1,44 @@
+/**
+ * \file 	ECParkAttraction.h
+ * \brief	The park attraction of the API.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+#import "ECSchemaResponseSerializer.h"
+
+/**
+ *  A record of `result.results` in the park API response. Only the fields shown by the app are decoded.
+ *  The long texts shown only by the cells (introduction, openTime) are kept as UTF-8 bytes, and
+ *  materialized to NSString on the first access. The introductions of a response are compressed
+ *  together in an ECTextStore instead, and decompressed on each access.
+ */
+@interface ECParkAttraction : NSObject <ECSchemaRecord>
+
+@property (nonatomic, copy, readonly) NSString *name;
+@property (nonatomic, copy, readonly) NSString *parkName;
+@property (nonatomic, copy, readonly) NSString *image;
+@property (nonatomic, copy, readonly) NSString *introduction;
+@property (nonatomic, copy, readonly) NSString *openTime;
+
+/**
+ * \brief	Create the attraction from the dictionary with the API keys, e.g. the saved snapshot.
+ */
+- (instancetype)init_With_Dictionary: (NSDictionary*) dic;
+
+/**
+ * \brief	The key of the attraction across the refreshes, the park name and the name.
+ */
+- (NSString*)attraction_Key;
+
+/**
+ * \brief	The dictionary with the API keys of all fields.
+ */
+- (NSDictionary*)dictionary_Representation;
+
+/**
+ * \brief	The dictionary with the API keys of the fields used by the warm-up, the lazy texts are left out.
+ */
+- (NSDictionary*)snapshot_Representation;
+
+@end
@@ -0,0 +1,177 @@
+/**
+ * \file 	ECParkAttraction.m
+ * \brief	The park attraction of the API.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECParkAttraction.h"
+#import "ECTextStore.h"
+
+// Order of the fields in the schema
+enum
+{
+    kFieldName = 0,
+    kFieldParkName,
+    kFieldImage,
+    kFieldIntroduction,
+    kFieldOpenTime,
+    kFieldCount
+};
+
+static const char * const kSchemaPath[] = {"result", "results"};
+
+static const ECSchemaField kSchemaFields[kFieldCount] = {
+    {"Name", ECSchemaFieldString, "", 0, 0},
+    {"ParkName", ECSchemaFieldString, "", 0, 0},
+    {"Image", ECSchemaFieldString, "", 0, 0},
+    {"Introduction", ECSchemaFieldString, "", 0, 0},
+    {"OpenTime", ECSchemaFieldString, "", 0, 0},
+};
+
+static const ECSchema kSchema = {kSchemaPath, 2, kSchemaFields, kFieldCount};
+
+/**
+ * \brief	Keep the UTF-8 bytes of the value to materialize later.
+ */
+static NSData* _value_Bytes(const ECSchemaValue *value)
+{
+    if (NULL == value->string || 0 == value->length)
+        return nil;
+    
+    return [NSData dataWithBytes:value->string length:value->length];
+}
+
+@interface ECParkAttraction ()
+{
+    // The UTF-8 bytes of the lazy texts, released once materialized or compressed
+    NSData *_introductionBytes;
+    NSData *_openTimeBytes;
+    
+    // The introductions of a response are compressed together, see records_Did_Decode:
+    ECTextStore *_introductionStore;
+    NSUInteger _introductionIndex;
+}
+
+@end
+
+@implementation ECParkAttraction
+
+@synthesize introduction = _introduction;
+@synthesize openTime = _openTime;
+
++ (const ECSchema*)record_Schema
+{
+    return &kSchema;
+}
+
+- (instancetype)init_With_Values: (const ECSchemaValue*) values
+{
+    if (self = [super init])
+    {
+        _name = ECSchemaValueString(&values[kFieldName]) ?: @"";
+        _parkName = ECSchemaValueString(&values[kFieldParkName]) ?: @"";
+        _image = ECSchemaValueString(&values[kFieldImage]) ?: @"";
+        _introductionBytes = _value_Bytes(&values[kFieldIntroduction]);
+        _openTimeBytes = _value_Bytes(&values[kFieldOpenTime]);
+    }
+    
+    return self;
+}
+
++ (void)records_Did_Decode: (NSArray*) records
+{
+    NSMutableArray *texts = [[NSMutableArray alloc] initWithCapacity:records.count];
+    
+    for (ECParkAttraction *attraction in records)
+        [texts addObject:attraction->_introductionBytes ?: [NSNull null]];
+    
+    ECTextStore *store = [[ECTextStore alloc] init_With_Texts:texts];
+    
+    // Keep the bytes if the store cannot be created
+    if (nil == store)
+        return;
+    
+    [records enumerateObjectsUsingBlock:^(ECParkAttraction *attraction, NSUInteger idx, BOOL *stop) {
+        @synchronized (attraction)
+        {
+            if (nil == attraction->_introduction)
+            {
+                attraction->_introductionStore = store;
+                attraction->_introductionIndex = idx;
+            }
+            
+            attraction->_introductionBytes = nil;
+        }
+    }];
+    
+#ifdef DEBUG
+    NSLog(@"[Attraction] %lu introductions, %lu KB as NSString, %lu KB compressed", (unsigned long)store.count, (unsigned long)(store.originalSize / 1024), (unsigned long)(store.compressedSize / 1024));
+#endif
+}
+
+- (instancetype)init_With_Dictionary: (NSDictionary*) dic
+{
+    if (self = [super init])
+    {
+        _name = [dic stringForKey:@"Name" default:@""];
+        _parkName = [dic stringForKey:@"ParkName" default:@""];
+        _image = [dic stringForKey:@"Image" default:@""];
+        _introduction = [dic stringForKey:@"Introduction" default:@""];
+        _openTime = [dic stringForKey:@"OpenTime" default:@""];
+    }
+    
+    return self;
+}
+
+#pragma mark - Lazy texts
+
+- (NSString*)introduction
+{
+    @synchronized (self)
+    {
+        // Decompressed on each access, the string is not kept
+        if (nil == _introduction && nil != _introductionStore)
+            return [_introductionStore string_At_Index:_introductionIndex] ?: @"";
+        
+        if (nil == _introduction)
+        {
+            _introduction = [NSString stringFromUTF8Bytes:_introductionBytes.bytes length:_introductionBytes.length] ?: @"";
+            _introductionBytes = nil;
+        }
+        
+        return _introduction;
+    }
+}
+
+- (NSString*)openTime
+{
+    @synchronized (self)
+    {
+        if (nil == _openTime)
+        {
+            _openTime = [NSString stringFromUTF8Bytes:_openTimeBytes.bytes length:_openTimeBytes.length] ?: @"";
+            _openTimeBytes = nil;
+        }
+        
+        return _openTime;
+    }
+}
+
+#pragma mark - Representation
+
+- (NSString*)attraction_Key
+{
+    return [NSString stringWithFormat:@"%@\n%@", self.parkName, self.name];
+}
+
+- (NSDictionary*)dictionary_Representation
+{
+    return @{@"Name": self.name, @"ParkName": self.parkName, @"Image": self.image, @"Introduction": self.introduction, @"OpenTime": self.openTime};
+}
+
+- (NSDictionary*)snapshot_Representation
+{
+    return @{@"Name": self.name, @"ParkName": self.parkName, @"Image": self.image};
+}
+
+@end
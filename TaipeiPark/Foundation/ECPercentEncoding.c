@@ -0,0 +1,93 @@
+/**
+ * \file 	ECPercentEncoding.c
+ * \brief	Table-driven percent-encoding of UTF-8 bytes.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECPercentEncoding.h"
+#include <string.h>
+
+// Bit N of an entry is set when the byte is kept as is in the set N.
+#define KEEP_QUERY      (1 << ECPercentEncodingSetQuery)
+#define KEEP_COMPONENT  (1 << ECPercentEncodingSetComponent)
+#define KEEP_ALL        (KEEP_QUERY | KEEP_COMPONENT)
+
+static const uint8_t kKeepTable[256] =
+{
+    // 0x00 ~ 0x2F: "-" and "." are unreserved, "/" is kept in the query
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, KEEP_ALL, KEEP_ALL, KEEP_QUERY,
+    
+    // 0x30 ~ 0x3F: DIGIT, "?" is kept in the query
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, 0, 0, 0, 0, 0, KEEP_QUERY,
+    
+    // 0x40 ~ 0x5F: ALPHA, "_"
+    0, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, 0, 0, 0, 0, KEEP_ALL,
+    
+    // 0x60 ~ 0x7F: alpha, "~"
+    0, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL, KEEP_ALL,
+    KEEP_ALL, KEEP_ALL, KEEP_ALL, 0, 0, 0, KEEP_ALL, 0,
+    
+    // 0x80 ~ 0xFF: the bytes of the multi-byte sequences are always escaped
+};
+
+static const char kHexDigits[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
+
+size_t ECPercentEncodedLength(const uint8_t *src, size_t length, ECPercentEncodingSet set)
+{
+    const uint8_t mask = (uint8_t)(1 << set);
+    size_t escaped = 0;
+    size_t i;
+    
+    if (NULL == src || set >= ECPercentEncodingSetCount)
+        return 0;
+    
+    for (i = 0; i < length; i++)
+        escaped += !(kKeepTable[src[i]] & mask);
+    
+    return length + 2 * escaped;
+}
+
+size_t ECPercentEncode(const uint8_t *src, size_t length, char *dst, ECPercentEncodingSet set)
+{
+    const uint8_t mask = (uint8_t)(1 << set);
+    char *out = dst;
+    size_t i = 0;
+    
+    if (NULL == src || NULL == dst || set >= ECPercentEncodingSetCount)
+        return 0;
+    
+    while (i < length)
+    {
+        size_t start = i;
+        
+        // Copy the run of kept bytes at once
+        while (i < length && (kKeepTable[src[i]] & mask))
+            i++;
+        
+        if (i > start)
+        {
+            memcpy(out, src + start, i - start);
+            out += i - start;
+        }
+        
+        // Escape the run of the other bytes
+        while (i < length && !(kKeepTable[src[i]] & mask))
+        {
+            out[0] = '%';
+            out[1] = kHexDigits[src[i] >> 4];
+            out[2] = kHexDigits[src[i] & 0x0F];
+            out += 3;
+            i++;
+        }
+    }
+    
+    return (size_t)(out - dst);
+}
@@ -0,0 +1,52 @@
+/**
+ * \file 	ECPercentEncoding.h
+ * \brief	Table-driven percent-encoding of UTF-8 bytes. Plain C, no Foundation dependency.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECPercentEncoding_h
+#define ECPercentEncoding_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The set of the bytes kept as is, all the other bytes are percent-escaped.
+ */
+typedef enum ECPercentEncodingSet
+{
+    /// RFC 3986 query key or value: ALPHA, DIGIT, "-", ".", "_", "~", "/" and "?" (RFC 3986 - Section 3.4).
+    ECPercentEncodingSetQuery = 0,
+    
+    /// Strict component: only ALPHA, DIGIT, "-", ".", "_" and "~".
+    ECPercentEncodingSetComponent,
+    
+    ECPercentEncodingSetCount
+} ECPercentEncodingSet;
+
+/**
+ * \brief	Get the length of the encoded bytes, without encoding.
+ * \param   src     The UTF-8 bytes.
+ *          length  The count of the bytes.
+ *          set     The bytes kept as is.
+ * \return	The length of the output, between length and 3 * length.
+ */
+size_t ECPercentEncodedLength(const uint8_t *src, size_t length, ECPercentEncodingSet set);
+
+/**
+ * \brief	Percent-escape the bytes. Runs of kept bytes are copied at once, so pure ASCII
+ *          identifiers cost about a memcpy.
+ * \param   dst     The output, must have ECPercentEncodedLength() bytes available. Not terminated.
+ * \return	The count of the written bytes.
+ */
+size_t ECPercentEncode(const uint8_t *src, size_t length, char *dst, ECPercentEncodingSet set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECPercentEncoding_h */
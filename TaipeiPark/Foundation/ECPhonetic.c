@@ -0,0 +1,234 @@
+/**
+ * \file 	ECPhonetic.c
+ * \brief	Phonetic keys of the Mandarin texts, typed in pinyin or in Zhuyin.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECPhonetic.h"
+#include <string.h>
+
+#define MAX_SYLLABLE_LENGTH 6           // e.g. "zhuang"
+
+// The Zhuyin symbols in the Unicode order
+enum
+{
+    kB = 1, kP, kM, kF, kD, kT, kN, kL, kG, kK, kH, kJ, kQ, kX, kZH, kCH, kSH, kR, kZ, kC, kS,
+    kA, kO, kE, kEH, kAI, kEI, kAO, kOU, kAN, kEN, kANG, kENG, kER, kI, kU, kYU
+};
+
+typedef struct ECPhoneticSpelling
+{
+    const char *pinyin;
+    uint8_t symbol;
+} ECPhoneticSpelling;
+
+// The two letters initials first
+static const ECPhoneticSpelling kInitials[] = {
+    {"zh", kZH}, {"ch", kCH}, {"sh", kSH},
+    {"b", kB}, {"p", kP}, {"m", kM}, {"f", kF}, {"d", kD}, {"t", kT}, {"n", kN}, {"l", kL},
+    {"g", kG}, {"k", kK}, {"h", kH}, {"j", kJ}, {"q", kQ}, {"x", kX},
+    {"r", kR}, {"z", kZ}, {"c", kC}, {"s", kS}
+};
+
+static const ECPhoneticSpelling kRhymes[] = {
+    {"a", kA}, {"o", kO}, {"e", kE}, {"ai", kAI}, {"ei", kEI}, {"ao", kAO}, {"ou", kOU},
+    {"an", kAN}, {"en", kEN}, {"ang", kANG}, {"eng", kENG}, {"er", kER}
+};
+
+// The rhymes after ㄧ, ㄨ or ㄩ, e.g. "ie", "in" and "ing"
+static const ECPhoneticSpelling kMedialRhymes[] = {
+    {"a", kA}, {"o", kO}, {"e", kEH}, {"ai", kAI}, {"ei", kEI}, {"ao", kAO}, {"ou", kOU},
+    {"an", kAN}, {"en", kEN}, {"n", kEN}, {"ang", kANG}, {"eng", kENG}, {"ng", kENG}
+};
+
+// Private Functions
+
+static uint8_t _find_Spelling(const ECPhoneticSpelling *spellings, size_t count, const char *pinyin)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (0 == strcmp(spellings[i].pinyin, pinyin))
+            return spellings[i].symbol;
+    }
+
+    return 0;
+}
+
+static int _is_Letter(uint16_t c)
+{
+    return ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z');
+}
+
+static char _lowercase(uint16_t c)
+{
+    return (char)(('A' <= c && c <= 'Z') ? c + ('a' - 'A') : c);
+}
+
+// Public Functions
+
+size_t ECPhoneticSyllable(const char *syllable, size_t length, uint8_t *out)
+{
+    char final[MAX_SYLLABLE_LENGTH + 2];
+    const char *rest;
+    size_t start = 0, n = 0, i;
+    uint8_t initial = 0, symbol;
+
+    if (0 == length || length > MAX_SYLLABLE_LENGTH)
+        return 0;
+
+    for (i = 0; i < sizeof(kInitials) / sizeof(kInitials[0]); i++)
+    {
+        size_t initialLength = strlen(kInitials[i].pinyin);
+
+        if (initialLength <= length && 0 == memcmp(syllable, kInitials[i].pinyin, initialLength))
+        {
+            initial = kInitials[i].symbol;
+            start = initialLength;
+            break;
+        }
+    }
+
+    memcpy(final, syllable + start, length - start);
+    final[length - start] = '\0';
+
+    // The spellings of the syllables without an initial
+    if (0 == initial && 'y' == final[0])
+    {
+        if ('u' == final[1])                        // yu, yue, yuan, yun
+            memmove(final, final + 1, strlen(final)), final[0] = 'v';
+        else if (0 == strcmp(final, "yong"))
+            strcpy(final, "iong");
+        else if ('i' == final[1])                   // yi, yin, ying
+            memmove(final, final + 1, strlen(final));
+        else                                        // ya, ye, yao, you, yan, yang
+            final[0] = 'i';
+    }
+    else if (0 == initial && 'w' == final[0])
+    {
+        if ('u' == final[1])                        // wu
+            memmove(final, final + 1, strlen(final));
+        else                                        // wa, wo, wai, wei, wan, wen, wang, weng
+            final[0] = 'u';
+    }
+
+    // The ü written as u after j, q, x, and the typed "lue", "nue"
+    if ((kJ == initial || kQ == initial || kX == initial) && 'u' == final[0])
+        final[0] = 'v';
+    else if ((kN == initial || kL == initial) && 0 == strcmp(final, "ue"))
+        final[0] = 'v';
+
+    // The contracted finals
+    if (0 == strcmp(final, "iu"))
+        strcpy(final, "iou");
+    else if (0 == strcmp(final, "ui"))
+        strcpy(final, "uei");
+    else if (0 == strcmp(final, "un"))
+        strcpy(final, "uen");
+
+    if (0 != initial)
+        out[n++] = initial;
+
+    // The vowel of zhi, chi, shi, ri, zi, ci, si is not written in Zhuyin
+    if (kZH <= initial && initial <= kS && (0 == strcmp(final, "i") || '\0' == final[0]))
+        return n;
+
+    if ('\0' == final[0])
+        return 0;
+
+    if (0 == strcmp(final, "ong") || 0 == strcmp(final, "iong"))
+    {
+        out[n++] = ('o' == final[0]) ? kU : kYU;
+        out[n++] = kENG;
+        return n;
+    }
+
+    // The medial
+    rest = final + 1;
+
+    if ('i' == final[0])
+        out[n++] = kI;
+    else if ('u' == final[0])
+        out[n++] = kU;
+    else if ('v' == final[0])
+        out[n++] = kYU;
+    else
+        rest = final;
+
+    if (rest == final)
+        symbol = _find_Spelling(kRhymes, sizeof(kRhymes) / sizeof(kRhymes[0]), rest);
+    else if ('\0' == *rest)
+        return n;
+    else
+        symbol = _find_Spelling(kMedialRhymes, sizeof(kMedialRhymes) / sizeof(kMedialRhymes[0]), rest);
+
+    if (0 == symbol)
+        return 0;
+
+    out[n++] = symbol;
+
+    return n;
+}
+
+size_t ECPhoneticKeyBound(size_t count)
+{
+    // A syllable never has more symbols than letters
+    return count;
+}
+
+size_t ECPhoneticKey(const uint16_t *chars, size_t count, uint8_t *out)
+{
+    size_t i = 0, n = 0;
+
+    while (i < count)
+    {
+        uint16_t c = chars[i];
+
+        if (_is_Letter(c))
+        {
+            char syllable[MAX_SYLLABLE_LENGTH];
+            size_t end = i, length, k, written = 0;
+
+            while (end < count && _is_Letter(chars[end]))
+                end++;
+
+            // The longest syllable at each position, or the letter itself
+            while (i < end)
+            {
+                length = (end - i < MAX_SYLLABLE_LENGTH) ? end - i : MAX_SYLLABLE_LENGTH;
+
+                for (k = 0; k < length; k++)
+                    syllable[k] = _lowercase(chars[i + k]);
+
+                for (; length > 0; length--)
+                {
+                    if (0 != (written = ECPhoneticSyllable(syllable, length, out + n)))
+                        break;
+                }
+
+                if (length > 0)
+                {
+                    n += written;
+                    i += length;
+                }
+                else
+                {
+                    out[n++] = (uint8_t)syllable[0];
+                    i++;
+                }
+            }
+
+            continue;
+        }
+
+        if ('0' <= c && c <= '9')
+            out[n++] = (uint8_t)c;
+        else if (ECPHONETIC_FIRST_SYMBOL <= c && c <= ECPHONETIC_LAST_SYMBOL)
+            out[n++] = (uint8_t)(c - ECPHONETIC_FIRST_SYMBOL + 1);
+
+        i++;
+    }
+
+    return n;
+}
@@ -0,0 +1,51 @@
+/**
+ * \file 	ECPhonetic.h
+ * \brief	Phonetic keys of the Mandarin texts, typed in pinyin or in Zhuyin. Plain C, no Foundation
+ *          dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECPhonetic_h
+#define ECPhonetic_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  A phonetic key is a byte string of the Zhuyin symbols, without the tones: ㄅ ~ ㄩ (U+3105 ~ U+3129)
+ *  are 1 ~ 37. The pinyin is converted to the same symbols, so "daan", "da an" and "ㄉㄚˋㄢ" have the
+ *  same key. The digits and the letters out of any syllable are kept as lowercase ASCII.
+ */
+#define ECPHONETIC_FIRST_SYMBOL     0x3105
+#define ECPHONETIC_LAST_SYMBOL      0x3129
+
+/**
+ * \brief	Convert a toneless pinyin syllable, e.g. "zhuang", "lv" or "yue".
+ * \param   out         The buffer of 4 bytes.
+ * \return	The count of the written symbols, 0 if it is not a syllable.
+ */
+size_t ECPhoneticSyllable(const char *syllable, size_t length, uint8_t *out);
+
+/**
+ * \brief	The largest length of the key of a text of count units.
+ */
+size_t ECPhoneticKeyBound(size_t count);
+
+/**
+ * \brief	Build the key of the UTF-16 text. The runs of the ASCII letters are split into the longest
+ *          pinyin syllables, the Zhuyin symbols are kept, the tone marks, the spaces and the other
+ *          characters are skipped. The Han characters should be converted to pinyin before.
+ * \param   out         The buffer of ECPhoneticKeyBound(count) bytes.
+ * \return	The length of the key.
+ */
+size_t ECPhoneticKey(const uint16_t *chars, size_t count, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECPhonetic_h */
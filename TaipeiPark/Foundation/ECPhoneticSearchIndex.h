@@ -0,0 +1,31 @@
+/**
+ * \file 	ECPhoneticSearchIndex.h
+ * \brief	Search the names by their readings, typed in Chinese, pinyin or Zhuyin, with typos.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The secondary index of a set of names. Each name is converted to the phonetic key of its reading
+ *  (ECPhonetic), and the key from each word is added to a trie (ECFuzzyIndex), so a query matches the
+ *  start of any word within a few edits. The index is immutable, it can be searched from any thread.
+ */
+@interface ECPhoneticSearchIndex : NSObject
+
+/// The count of the names
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * \brief	Build the index of the names, it takes a while, call it off the main thread.
+ */
+- (instancetype)init_With_Strings: (NSArray<NSString*>*) strings;
+
+/**
+ * \brief	Search the names. The allowed edits grow with the length of the query: none for a syllable,
+ *          one for a few syllables, two for the longer ones.
+ * \return	The indexes of the matched names, the nearest first.
+ */
+- (NSArray<NSNumber*>*)search: (NSString*) text maxResults: (NSUInteger) maxResults;
+
+@end
@@ -0,0 +1,146 @@
+/**
+ * \file 	ECPhoneticSearchIndex.m
+ * \brief	Search the names by their readings, typed in Chinese, pinyin or Zhuyin, with typos.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECPhoneticSearchIndex.h"
+#import "ECPhonetic.h"
+#import "ECFuzzyIndex.h"
+
+// Most strings are converted on the stack
+#define STACK_CHARACTER_COUNT 128
+
+@implementation ECPhoneticSearchIndex
+{
+    ECFuzzyIndex _index;
+}
+
+- (instancetype)init_With_Strings: (NSArray<NSString*>*) strings
+{
+    if (self = [super init])
+    {
+        ECFuzzyIndexInit(&_index);
+        
+        [strings enumerateObjectsUsingBlock:^(NSString *string, NSUInteger idx, BOOL *stop) {
+            NSArray *words = [[self _reading_Of_String:string] componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+            NSMutableData *key = [[NSMutableData alloc] init];
+            NSMutableArray *starts = [[NSMutableArray alloc] initWithCapacity:words.count];
+            
+            for (NSString *word in words)
+            {
+                NSData *wordKey = [self _key_For_Text:word];
+                
+                if (0 == wordKey.length)
+                    continue;
+                
+                [starts addObject:@(key.length)];
+                [key appendData:wordKey];
+            }
+            
+            // The key from each word, so the query matches any word of the name
+            for (NSNumber *start in starts)
+            {
+                NSUInteger offset = start.unsignedIntegerValue;
+                
+                ECFuzzyIndexAdd(&self->_index, (const uint8_t*)key.bytes + offset, key.length - offset, (uint32_t)idx);
+            }
+        }];
+        
+        if (0 != ECFuzzyIndexBuild(&_index))
+            return nil;
+        
+        _count = strings.count;
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    ECFuzzyIndexDestroy(&_index);
+}
+
+- (NSArray<NSNumber*>*)search: (NSString*) text maxResults: (NSUInteger) maxResults
+{
+    NSData *key = [self _key_For_Text:[self _reading_Of_String:text]];
+    
+    if (0 == key.length || 0 == maxResults)
+        return @[];
+    
+    unsigned int maxDistance = (key.length <= 3) ? 0 : ((key.length <= 8) ? 1 : 2);
+    ECFuzzyMatch *matches = malloc(maxResults * sizeof(ECFuzzyMatch));
+    
+    if (NULL == matches)
+        return @[];
+    
+    size_t count = ECFuzzyIndexSearch(&_index, key.bytes, key.length, maxDistance, matches, maxResults);
+    NSMutableArray *results = [[NSMutableArray alloc] initWithCapacity:count];
+    
+    for (size_t i = 0; i < count; i++)
+        [results addObject:@(matches[i].identifier)];
+    
+    free(matches);
+    
+    return results;
+}
+
+#pragma mark - Private Functions
+
+/**
+ * \brief	Convert the Chinese characters to the toneless pinyin, one word per character, with ü as v.
+ *          The other texts are kept without their marks.
+ */
+- (NSString*)_reading_Of_String: (NSString*) string
+{
+    __block BOOL hasHan = NO;
+    
+    [string enumerateSubstringsInRange:NSMakeRange(0, string.length) options:NSStringEnumerationByComposedCharacterSequences usingBlock:^(NSString *substring, NSRange substringRange, NSRange enclosingRange, BOOL *stop) {
+        unichar c = [substring characterAtIndex:0];
+        
+        // CJK unified ideographs, the extension A and the compatibility ideographs
+        if ((0x3400 <= c && c <= 0x9FFF) || (0xF900 <= c && c <= 0xFAFF) || CFStringIsSurrogateHighCharacter(c))
+            *stop = hasHan = YES;
+    }];
+    
+    if (!hasHan && [string canBeConvertedToEncoding:NSASCIIStringEncoding])
+        return string;
+    
+    NSMutableString *latin = [string mutableCopy];
+    
+    if (hasHan)
+        CFStringTransform((CFMutableStringRef)latin, NULL, kCFStringTransformMandarinLatin, false);
+    
+    // The ü of lü and nü is typed as v, stripping the marks first would leave lu and nu
+    CFStringNormalize((CFMutableStringRef)latin, kCFStringNormalizationFormD);
+    
+    [latin replaceOccurrencesOfString:@"u\u0308" withString:@"v" options:NSLiteralSearch range:NSMakeRange(0, latin.length)];
+    [latin replaceOccurrencesOfString:@"U\u0308" withString:@"V" options:NSLiteralSearch range:NSMakeRange(0, latin.length)];
+    
+    CFStringTransform((CFMutableStringRef)latin, NULL, kCFStringTransformStripCombiningMarks, false);
+    
+    return latin;
+}
+
+- (NSData*)_key_For_Text: (NSString*) text
+{
+    NSUInteger length = text.length;
+    unichar stackBuffer[STACK_CHARACTER_COUNT];
+    unichar *characters = (length <= STACK_CHARACTER_COUNT) ? stackBuffer : malloc(length * sizeof(unichar));
+    
+    if (NULL == characters)
+        return nil;
+    
+    [text getCharacters:characters range:NSMakeRange(0, length)];
+    
+    NSMutableData *key = [[NSMutableData alloc] initWithLength:ECPhoneticKeyBound(length)];
+    
+    key.length = ECPhoneticKey(characters, length, key.mutableBytes);
+    
+    if (characters != stackBuffer)
+        free(characters);
+    
+    return key;
+}
+
+@end
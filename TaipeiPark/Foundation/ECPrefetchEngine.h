@@ -0,0 +1,68 @@
+/**
+ * \file 	ECPrefetchEngine.h
+ * \brief	Warm up the likely next detail screens before they are opened.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  The signals of a prediction, the stronger signal wins when a key is predicted again.
+ */
+typedef NS_ENUM(NSInteger, ECPrefetchSignal)
+{
+    ECPrefetchSignalDwell = 0,      // The row rests on the screen, or the scroll is slowing down to it
+    ECPrefetchSignalHighlight       // The row is touched down and highlighted
+};
+
+/**
+ *  The predictions of the screens the user may open next. A prediction downloads its images into
+ *  the shared image cache of UIImageView+AFNetworking at low priority, and warms its models on a low
+ *  priority queue. A prediction is cancelled when the signal is withdrawn, or evicted by the newer ones;
+ *  the queued downloads are withdrawn then, the running ones are left to the cache. When a screen is
+ *  opened, its prediction is a hit and its downloads go on at the default priority.
+ *
+ *  The hit rate is the opened screens which were predicted, the wasted bytes are the downloads of the
+ *  cancelled predictions. Used on the main thread only.
+ */
+@interface ECPrefetchEngine : NSObject
+
++ (ECPrefetchEngine*)sharedEngine;
+
+/// The max count of the live predictions, the oldest dwell ones are evicted first, default is 6.
+@property (nonatomic, assign) NSUInteger maxPredictions;
+
+/// Called on a low priority queue with the object of each new prediction, e.g. to build its row models.
+@property (nonatomic, copy) void (^modelWarmer)(id object);
+
+@property (nonatomic, assign, readonly) NSUInteger openCount;
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+@property (nonatomic, assign, readonly) unsigned long long usedBytes;
+@property (nonatomic, assign, readonly) unsigned long long wastedBytes;
+
+/**
+ * \brief	Predict the screen of the key. The images are downloaded in the order, e.g. the hero image first.
+ */
+- (void)predict_Key: (NSString*) key object: (id) object imageURLs: (NSArray<NSURL*>*) imageURLs signal: (ECPrefetchSignal) signal;
+
+/**
+ * \brief	Cancel the prediction of the key.
+ */
+- (void)cancel_Key: (NSString*) key;
+
+/**
+ * \brief	Cancel the predictions of the signal except the keys, e.g. the rows scrolled out.
+ */
+- (void)cancel_Signal: (ECPrefetchSignal) signal exceptKeys: (NSSet<NSString*>*) keys;
+
+/**
+ * \brief	The screen of the key is opened. It is counted as a hit if predicted.
+ */
+- (void)did_Open_Key: (NSString*) key;
+
+/**
+ * \brief	The summary of the hit rate and the bytes.
+ */
+- (NSString*)report;
+
+@end
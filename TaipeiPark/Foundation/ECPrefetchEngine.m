@@ -0,0 +1,277 @@
+/**
+ * \file 	ECPrefetchEngine.m
+ * \brief	Warm up the likely next detail screens before they are opened.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECPrefetchEngine.h"
+#import "AFImageDownloader.h"
+
+// ECPrefetchPrediction
+
+@interface ECPrefetchPrediction : NSObject
+
+@property (nonatomic, assign) ECPrefetchSignal signal;
+@property (nonatomic, strong) NSMutableArray<AFImageDownloadReceipt*> *receipts;
+
+@end
+
+@implementation ECPrefetchPrediction
+
+@end
+
+
+// ECPrefetchEngine
+
+@implementation ECPrefetchEngine
+{
+    NSMutableDictionary *_dicPredictions;
+    NSMutableArray *_aryKeys;                   // The keys of the predictions, the oldest first
+    
+    // The tasks are counted once they are finished. A merged task is shared by the predictions of the
+    // same image, so each task is kept once, and used wins over wasted.
+    NSHashTable<NSURLSessionTask*> *_setUsedTasks;
+    NSHashTable<NSURLSessionTask*> *_setWastedTasks;
+    NSHashTable<NSURLSessionTask*> *_setCountedTasks;   // Weak, still held by the receipts of the other predictions
+}
+
++ (ECPrefetchEngine*)sharedEngine
+{
+    static ECPrefetchEngine *instance = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        instance = [[ECPrefetchEngine alloc] init];
+    });
+    
+    return instance;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _maxPredictions = 6;
+        
+        _dicPredictions = [[NSMutableDictionary alloc] init];
+        _aryKeys = [[NSMutableArray alloc] init];
+        _setUsedTasks = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality capacity:0];
+        _setWastedTasks = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality capacity:0];
+        _setCountedTasks = [[NSHashTable alloc] initWithOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality capacity:0];
+    }
+    
+    return self;
+}
+
+- (void)predict_Key: (NSString*) key object: (id) object imageURLs: (NSArray<NSURL*>*) imageURLs signal: (ECPrefetchSignal) signal
+{
+    if (nil == key)
+        return;
+    
+    ECPrefetchPrediction *prediction = [_dicPredictions objectForKey:key];
+    
+    // Already predicted, keep the stronger signal
+    if (nil != prediction)
+    {
+        prediction.signal = MAX(prediction.signal, signal);
+        
+        [_aryKeys removeObject:key];
+        [_aryKeys addObject:key];
+        return;
+    }
+    
+    prediction = [[ECPrefetchPrediction alloc] init];
+    prediction.signal = signal;
+    prediction.receipts = [[NSMutableArray alloc] initWithCapacity:imageURLs.count];
+    
+    AFImageDownloader *downloader = [UIImageView sharedImageDownloader];
+    
+    for (NSURL *url in imageURLs)
+    {
+        NSURLRequest *request = [NSURLRequest requestWithURL:url];
+        
+        // Already in the memory cache
+        if (nil != [downloader.imageCache imageforRequest:request withAdditionalIdentifier:nil])
+            continue;
+        
+        AFImageDownloadReceipt *receipt = [downloader enqueueImageForURLRequest:request withReceiptID:[NSUUID UUID] success:nil failure:nil];
+        
+        // A task merged with a visible image keeps its priority
+        [downloader getTaskForImageDownloadReceipt:receipt completion:^(NSURLSessionDataTask *task) {
+            if (NSURLSessionTaskStateSuspended == task.state)
+                task.priority = NSURLSessionTaskPriorityLow;
+        }];
+        
+        [prediction.receipts addObject:receipt];
+    }
+    
+    [_dicPredictions setObject:prediction forKey:key];
+    [_aryKeys addObject:key];
+    
+    if (nil != self.modelWarmer && nil != object)
+    {
+        void (^warmer)(id) = self.modelWarmer;
+        
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0), ^{
+            warmer(object);
+        });
+    }
+    
+    [self _evict_Predictions];
+}
+
+- (void)cancel_Key: (NSString*) key
+{
+    ECPrefetchPrediction *prediction = (nil == key) ? nil : [_dicPredictions objectForKey:key];
+    
+    if (nil == prediction)
+        return;
+    
+    AFImageDownloader *downloader = [UIImageView sharedImageDownloader];
+    
+    for (AFImageDownloadReceipt *receipt in prediction.receipts)
+    {
+        [downloader cancelTaskForImageDownloadReceipt:receipt];
+        [downloader getTaskForImageDownloadReceipt:receipt completion:^(NSURLSessionDataTask *task) {
+            [self _waste_Task:task];
+        }];
+    }
+    
+    [_dicPredictions removeObjectForKey:key];
+    [_aryKeys removeObject:key];
+}
+
+- (void)cancel_Signal: (ECPrefetchSignal) signal exceptKeys: (NSSet<NSString*>*) keys
+{
+    for (NSString *key in [_aryKeys copy])
+    {
+        ECPrefetchPrediction *prediction = [_dicPredictions objectForKey:key];
+        
+        if (signal == prediction.signal && ![keys containsObject:key])
+            [self cancel_Key:key];
+    }
+}
+
+- (void)did_Open_Key: (NSString*) key
+{
+    ECPrefetchPrediction *prediction = (nil == key) ? nil : [_dicPredictions objectForKey:key];
+    
+    _openCount++;
+    
+    if (nil != prediction)
+    {
+        _hitCount++;
+        
+        AFImageDownloader *downloader = [UIImageView sharedImageDownloader];
+        
+        // Needed now
+        for (AFImageDownloadReceipt *receipt in prediction.receipts)
+        {
+            [downloader getTaskForImageDownloadReceipt:receipt completion:^(NSURLSessionDataTask *task) {
+                [self _use_Task:task];
+            }];
+        }
+        
+        [_dicPredictions removeObjectForKey:key];
+        [_aryKeys removeObject:key];
+    }
+    
+#ifdef DEBUG
+    NSLog(@"[Prefetch] %@", [self report]);
+#endif
+}
+
+- (unsigned long long)usedBytes
+{
+    [self _count_Finished_Tasks];
+    
+    return _usedBytes;
+}
+
+- (unsigned long long)wastedBytes
+{
+    [self _count_Finished_Tasks];
+    
+    return _wastedBytes;
+}
+
+- (NSString*)report
+{
+    double rate = (0 == self.openCount) ? 0 : 100.0 * self.hitCount / self.openCount;
+    
+    return [NSString stringWithFormat:@"hit %lu/%lu (%.0f%%), used %llu KB, wasted %llu KB, %lu live", (unsigned long)self.hitCount, (unsigned long)self.openCount, rate, self.usedBytes / 1024, self.wastedBytes / 1024, (unsigned long)_dicPredictions.count];
+}
+
+#pragma mark - Private Functions
+
+/**
+ * \brief	Evict the oldest predictions over the limit, the dwell ones first.
+ */
+- (void)_evict_Predictions
+{
+    for (ECPrefetchSignal signal = ECPrefetchSignalDwell; signal <= ECPrefetchSignalHighlight && _aryKeys.count > self.maxPredictions; signal++)
+    {
+        for (NSString *key in [_aryKeys copy])
+        {
+            if (_aryKeys.count <= self.maxPredictions)
+                break;
+            
+            if (signal == ((ECPrefetchPrediction*)[_dicPredictions objectForKey:key]).signal)
+                [self cancel_Key:key];
+        }
+    }
+}
+
+/**
+ * \brief	Count the task of a cancelled prediction as wasted, unless another prediction used it.
+ */
+- (void)_waste_Task: (NSURLSessionTask*) task
+{
+    if (nil == task || [_setUsedTasks containsObject:task] || [_setCountedTasks containsObject:task])
+        return;
+    
+    [_setWastedTasks addObject:task];
+}
+
+/**
+ * \brief	Raise the task of an opened prediction to the default priority, and count it as used.
+ */
+- (void)_use_Task: (NSURLSessionTask*) task
+{
+    if (nil == task)
+        return;
+    
+    if (NSURLSessionTaskStateCompleted != task.state)
+        task.priority = NSURLSessionTaskPriorityDefault;
+    
+    if ([_setCountedTasks containsObject:task])
+        return;
+    
+    [_setWastedTasks removeObject:task];
+    [_setUsedTasks addObject:task];
+}
+
+- (void)_count_Finished_Tasks
+{
+    for (NSURLSessionTask *task in [_setUsedTasks allObjects])
+    {
+        if (NSURLSessionTaskStateCompleted != task.state)
+            continue;
+        
+        _usedBytes += task.countOfBytesReceived;
+        [_setUsedTasks removeObject:task];
+        [_setCountedTasks addObject:task];
+    }
+    
+    for (NSURLSessionTask *task in [_setWastedTasks allObjects])
+    {
+        if (NSURLSessionTaskStateCompleted != task.state)
+            continue;
+        
+        _wastedBytes += task.countOfBytesReceived;
+        [_setWastedTasks removeObject:task];
+        [_setCountedTasks addObject:task];
+    }
+}
+
+@end
@@ -0,0 +1,41 @@
+/**
+ * \file 	ECRelatedAttractions.h
+ * \brief	The precomputed related attractions of each attraction, across the parks.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+@class ECParkAttraction;
+
+/// Posted on the main thread after the related attractions are updated.
+extern NSString * const ECRelatedAttractionsDidUpdateNotification;
+
+/**
+ *  The top neighbors of each attraction by the TF-IDF similarity of the introductions, plus a bonus
+ *  for the same park (ECNeighborIndex). The index is kept between the refreshes, only the attractions
+ *  added, changed or removed by a refresh are computed again. The lists are built off the main thread
+ *  and published as a whole, the detail view only looks them up.
+ */
+@interface ECRelatedAttractions : NSObject
+
++ (ECRelatedAttractions*)sharedInstance;
+
+/// The max count of the related attractions of each attraction, default is 12. Set it before the first update.
+@property (nonatomic, assign) NSUInteger maxCount;
+
+/// The weight of the same park in the score, 0 ~ 1, default is 0.2. Set it before the first update.
+@property (nonatomic, assign) float parkWeight;
+
+/**
+ * \brief	Update the index with the attractions of a refresh, on a background queue. It returns immediately.
+ */
+- (void)update_With_Attractions: (NSArray<ECParkAttraction*>*) attractions;
+
+/**
+ * \brief	Get the related attractions, the most similar first.
+ * \return	nil if the attraction is not indexed yet.
+ */
+- (NSArray<ECParkAttraction*>*)related_Attractions_For: (ECParkAttraction*) attraction;
+
+@end
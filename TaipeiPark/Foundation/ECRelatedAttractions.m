@@ -0,0 +1,240 @@
+/**
+ * \file 	ECRelatedAttractions.m
+ * \brief	The precomputed related attractions of each attraction, across the parks.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECRelatedAttractions.h"
+#import "ECParkAttraction.h"
+#import "ECNeighborIndex.h"
+
+NSString * const ECRelatedAttractionsDidUpdateNotification = @"ECRelatedAttractionsDidUpdateNotification";
+
+// Most introductions fit in the buffer allocated once per update, the longer ones allocate their own
+#define SHARED_CHARACTER_COUNT 1024
+
+@implementation ECRelatedAttractions
+{
+    dispatch_queue_t _queue;
+    ECNeighborIndex _index;
+    BOOL _initialized;
+    
+    // Only used on the queue
+    NSMutableDictionary *_dicSlots;             // The slot of each attraction key
+    NSMutableDictionary *_dicGroups;            // The group of each park name
+    NSMutableIndexSet *_freeSlots;
+    uint32_t _slotCount;                        // The slots ever used
+    NSMutableDictionary *_dicAttractions;       // The attraction of each slot
+    
+    NSDictionary *_dicRelated;                  // The related attractions of each attraction key, published as a whole
+}
+
++ (ECRelatedAttractions*)sharedInstance
+{
+    static ECRelatedAttractions *instance = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        instance = [[ECRelatedAttractions alloc] init];
+    });
+    
+    return instance;
+}
+
+- (instancetype)init
+{
+    if (self = [super init])
+    {
+        _maxCount = 12;
+        _parkWeight = 0.2f;
+        
+        _queue = dispatch_queue_create("ECRelatedAttractions", DISPATCH_QUEUE_SERIAL);
+        dispatch_set_target_queue(_queue, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_LOW, 0));
+        
+        _dicSlots = [[NSMutableDictionary alloc] init];
+        _dicGroups = [[NSMutableDictionary alloc] init];
+        _freeSlots = [[NSMutableIndexSet alloc] init];
+        _dicAttractions = [[NSMutableDictionary alloc] init];
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    if (_initialized)
+        ECNeighborIndexDestroy(&_index);
+}
+
+- (void)update_With_Attractions: (NSArray<ECParkAttraction*>*) attractions
+{
+    NSArray *items = [attractions copy];
+    
+    dispatch_async(_queue, ^{
+        [self _update_With_Attractions:items];
+    });
+}
+
+- (NSArray<ECParkAttraction*>*)related_Attractions_For: (ECParkAttraction*) attraction
+{
+    NSDictionary *related = nil;
+    
+    @synchronized (self)
+    {
+        related = _dicRelated;
+    }
+    
+    return [related objectForKey:[attraction attraction_Key]];
+}
+
+#pragma mark - Private Functions
+
+- (void)_update_With_Attractions: (NSArray<ECParkAttraction*>*) attractions
+{
+    if (!_initialized)
+    {
+        ECNeighborIndexInit(&_index, self.maxCount, self.parkWeight, ECNeighborKernelAuto);
+        _initialized = YES;
+    }
+    
+    NSMutableDictionary *dicSlots = [[NSMutableDictionary alloc] initWithCapacity:attractions.count];
+    uint8_t *terms = malloc(ECNEIGHBOR_DIMENSION);
+    unichar *sharedBuffer = malloc(SHARED_CHARACTER_COUNT * sizeof(unichar));
+    NSUInteger changed = 0;
+    
+    if (NULL == terms || NULL == sharedBuffer)
+    {
+        free(terms);
+        free(sharedBuffer);
+        return;
+    }
+    
+    for (ECParkAttraction *attraction in attractions)
+    {
+        NSString *key = [attraction attraction_Key];
+        
+        // The duplicated names share the slot
+        if (nil != [dicSlots objectForKey:key])
+            continue;
+        
+        NSNumber *group = [_dicGroups objectForKey:attraction.parkName];
+        
+        if (nil == group)
+        {
+            group = @(_dicGroups.count);
+            [_dicGroups setObject:group forKey:attraction.parkName];
+        }
+        
+        // The terms of the introduction and the name
+        NSString *text = [NSString stringWithFormat:@"%@ %@", attraction.name, attraction.introduction];
+        NSUInteger length = text.length;
+        unichar *characters = (length <= SHARED_CHARACTER_COUNT) ? sharedBuffer : malloc(length * sizeof(unichar));
+        
+        if (NULL == characters)
+            continue;
+        
+        [text getCharacters:characters range:NSMakeRange(0, length)];
+        
+        memset(terms, 0, ECNEIGHBOR_DIMENSION);
+        ECNeighborTerms(characters, length, terms);
+        
+        if (characters != sharedBuffer)
+            free(characters);
+        
+        NSNumber *slot = [_dicSlots objectForKey:key];
+        uint32_t identifier = 0;
+        
+        if (nil != slot)
+        {
+            identifier = slot.unsignedIntValue;
+            
+            // Not changed by the refresh
+            if (0 == memcmp(_index.terms + (size_t)identifier * ECNEIGHBOR_DIMENSION, terms, ECNEIGHBOR_DIMENSION) && _index.groups[identifier] == group.unsignedIntValue)
+            {
+                [dicSlots setObject:slot forKey:key];
+                [_dicAttractions setObject:attraction forKey:slot];
+                continue;
+            }
+        }
+        else if (_freeSlots.count > 0)
+        {
+            identifier = (uint32_t)_freeSlots.firstIndex;
+            [_freeSlots removeIndex:identifier];
+        }
+        else
+        {
+            identifier = _slotCount++;
+        }
+        
+        if (0 != ECNeighborIndexSet(&_index, identifier, terms, group.unsignedIntValue))
+            continue;
+        
+        slot = @(identifier);
+        [dicSlots setObject:slot forKey:key];
+        [_dicAttractions setObject:attraction forKey:slot];
+        changed++;
+    }
+    
+    free(terms);
+    free(sharedBuffer);
+    
+    // The attractions not in the refresh
+    NSUInteger removed = 0;
+    
+    for (NSString *key in _dicSlots)
+    {
+        NSNumber *slot = [_dicSlots objectForKey:key];
+        
+        if (nil != [dicSlots objectForKey:key])
+            continue;
+        
+        ECNeighborIndexRemove(&_index, slot.unsignedIntValue);
+        [_freeSlots addIndex:slot.unsignedIntegerValue];
+        [_dicAttractions removeObjectForKey:slot];
+        removed++;
+    }
+    
+    _dicSlots = dicSlots;
+    
+#ifdef DEBUG
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+#endif
+    
+    size_t computed = ECNeighborIndexUpdate(&_index);
+    
+#ifdef DEBUG
+    NSLog(@"[Related] %lu attractions, %lu set, %lu removed, %lu lists computed in %.1f ms", (unsigned long)dicSlots.count, (unsigned long)changed, (unsigned long)removed, (unsigned long)computed, (CFAbsoluteTimeGetCurrent() - start) * 1000);
+#endif
+    
+    // Publish the lists of all attractions
+    NSMutableDictionary *dicRelated = [[NSMutableDictionary alloc] initWithCapacity:dicSlots.count];
+    ECNeighbor neighbors[ECNEIGHBOR_MAX_NEIGHBORS];
+    
+    for (NSString *key in dicSlots)
+    {
+        NSNumber *slot = [dicSlots objectForKey:key];
+        size_t count = ECNeighborIndexNeighbors(&_index, slot.unsignedIntValue, neighbors, ECNEIGHBOR_MAX_NEIGHBORS);
+        NSMutableArray *related = [[NSMutableArray alloc] initWithCapacity:count];
+        
+        for (size_t i = 0; i < count; i++)
+        {
+            ECParkAttraction *attraction = [_dicAttractions objectForKey:@(neighbors[i].identifier)];
+            
+            if (nil != attraction)
+                [related addObject:attraction];
+        }
+        
+        [dicRelated setObject:related forKey:key];
+    }
+    
+    @synchronized (self)
+    {
+        _dicRelated = dicRelated;
+    }
+    
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:ECRelatedAttractionsDidUpdateNotification object:self];
+    });
+}
+
+@end
@@ -0,0 +1,390 @@
+/**
+ * \file 	ECSchemaDecoder.c
+ * \brief	Decode the records of a JSON array straight into typed values, driven by a schema.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECSchemaDecoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_FIELDS 64
+
+typedef struct ECSchemaDecoder
+{
+    const ECSchema *schema;
+    ECSchemaRecordCallback callback;
+    void *context;
+    size_t fieldLengths[MAX_FIELDS];
+    
+    int depth;
+    size_t matched;             // Count of the path keys matched, the key i is matched at depth i + 1
+    int keyMatches;             // The last key matches the next path key
+    int arrayDepth;             // Depth of the records array, 0 before it is found
+    int recordDepth;            // Depth of the current record, 0 out of a record
+    int field;                  // Field of the last key in the record, -1 for the skipped members
+    size_t recordCount;
+    
+    // The values of the current record, the strings are kept in the arena by offset
+    ECSchemaValue values[MAX_FIELDS];
+    size_t offsets[MAX_FIELDS];
+    char *arena;
+    size_t arenaLength;
+    size_t arenaCapacity;
+} ECSchemaDecoder;
+
+// Private Functions
+
+static void _reset_Record(ECSchemaDecoder *d)
+{
+    size_t i;
+    
+    d->arenaLength = 0;
+    d->field = -1;
+    
+    for (i = 0; i < d->schema->fieldCount; i++)
+    {
+        const ECSchemaField *field = &d->schema->fields[i];
+        ECSchemaValue *value = &d->values[i];
+        
+        value->present = 0;
+        value->string = field->defaultString;
+        value->length = (NULL != field->defaultString) ? strlen(field->defaultString) : 0;
+        value->integer = field->defaultInteger;
+        value->real = field->defaultDouble;
+        d->offsets[i] = (size_t)-1;
+    }
+}
+
+static int _store_String(ECSchemaDecoder *d, int index, const char *bytes, size_t length)
+{
+    if (d->arenaLength + length > d->arenaCapacity)
+    {
+        size_t capacity = d->arenaCapacity * 2;
+        char *arena;
+        
+        while (capacity < d->arenaLength + length)
+            capacity *= 2;
+        
+        arena = (char*)realloc(d->arena, capacity);
+        
+        if (NULL == arena)
+            return 1;
+        
+        d->arena = arena;
+        d->arenaCapacity = capacity;
+    }
+    
+    memcpy(d->arena + d->arenaLength, bytes, length);
+    
+    d->offsets[index] = d->arenaLength;
+    d->values[index].length = length;
+    d->values[index].present = 1;
+    d->arenaLength += length;
+    
+    return 0;
+}
+
+static int _emit_Record(ECSchemaDecoder *d)
+{
+    size_t i;
+    
+    // The arena is stable now, resolve the offsets
+    for (i = 0; i < d->schema->fieldCount; i++)
+    {
+        if ((size_t)-1 != d->offsets[i])
+            d->values[i].string = d->arena + d->offsets[i];
+    }
+    
+    d->recordCount++;
+    
+    return d->callback(d->context, d->values, d->schema->fieldCount);
+}
+
+/**
+ * \brief	Get the field of the key in the record, -1 if it is not in the schema.
+ */
+static int _find_Field(ECSchemaDecoder *d, const char *bytes, size_t length)
+{
+    size_t i;
+    
+    for (i = 0; i < d->schema->fieldCount; i++)
+    {
+        if (d->fieldLengths[i] == length && 0 == memcmp(d->schema->fields[i].name, bytes, length))
+            return (int)i;
+    }
+    
+    return -1;
+}
+
+/**
+ * \brief	Get the field which receives the scalar value at the current position, -1 if none.
+ */
+static int _take_Field(ECSchemaDecoder *d)
+{
+    int field = -1;
+    
+    if (0 < d->recordDepth && d->depth == d->recordDepth)
+    {
+        field = d->field;
+        d->field = -1;
+    }
+    
+    d->keyMatches = 0;
+    
+    return field;
+}
+
+static int _parse_Number_Text(const char *bytes, size_t length, int64_t *integer, double *real)
+{
+    char buffer[64];
+    char *end = NULL;
+    
+    if (0 == length || length >= sizeof(buffer) || !('-' == bytes[0] || ('0' <= bytes[0] && bytes[0] <= '9')))
+        return 0;
+    
+    memcpy(buffer, bytes, length);
+    buffer[length] = '\0';
+    
+    *real = strtod(buffer, &end);
+    
+    if (end != buffer + length || !(-9.2e18 < *real && *real < 9.2e18))
+        return 0;
+    
+    *integer = (int64_t)*real;
+    
+    return 1;
+}
+
+// Callbacks of the parser
+
+static int _begin_Container(void *context, int isObject)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    int keyMatches = d->keyMatches;
+    
+    // A container under a field does not match its type, the default is kept.
+    _take_Field(d);
+    d->depth++;
+    
+    if (keyMatches && d->matched < d->schema->pathCount)
+        d->matched++;
+    
+    if (0 == d->arrayDepth && !isObject && d->matched == d->schema->pathCount && (size_t)d->depth == d->matched + 1)
+    {
+        d->arrayDepth = d->depth;
+    }
+    else if (isObject && 0 < d->arrayDepth && d->depth == d->arrayDepth + 1 && 0 == d->recordDepth)
+    {
+        d->recordDepth = d->depth;
+        _reset_Record(d);
+    }
+    
+    return 0;
+}
+
+static int _end_Container(void *context, int isObject)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    int status = 0;
+    
+    if (isObject && 0 < d->recordDepth && d->depth == d->recordDepth)
+    {
+        d->recordDepth = 0;
+        status = _emit_Record(d);
+    }
+    
+    if (d->depth == d->arrayDepth)
+        d->arrayDepth = -1;     // Done, the following arrays are not records
+    
+    // Leaving the container of a matched key, the key i is matched at depth i + 1 and its container is at depth i + 2
+    if (2 <= d->depth && (size_t)d->depth < d->matched + 2)
+        d->matched = (size_t)d->depth - 2;
+    
+    d->depth--;
+    
+    return status;
+}
+
+static int _begin_Object(void *context)  { return _begin_Container(context, 1); }
+static int _end_Object(void *context)    { return _end_Container(context, 1); }
+static int _begin_Array(void *context)   { return _begin_Container(context, 0); }
+static int _end_Array(void *context)     { return _end_Container(context, 0); }
+
+static int _key(void *context, const char *bytes, size_t length)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    
+    d->keyMatches = 0;
+    
+    if (0 < d->recordDepth && d->depth == d->recordDepth)
+    {
+        d->field = _find_Field(d, bytes, length);
+    }
+    else if (d->matched < d->schema->pathCount && (size_t)d->depth == d->matched + 1)
+    {
+        const char *name = d->schema->path[d->matched];
+        
+        d->keyMatches = (strlen(name) == length && 0 == memcmp(name, bytes, length));
+    }
+    
+    return 0;
+}
+
+static int _string(void *context, const char *bytes, size_t length)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    int field = _take_Field(d);
+    int64_t integer;
+    double real;
+    
+    if (field < 0)
+        return 0;
+    
+    switch (d->schema->fields[field].type)
+    {
+        case ECSchemaFieldString:
+            return _store_String(d, field, bytes, length);
+        case ECSchemaFieldInteger:
+        case ECSchemaFieldDouble:
+            if (_parse_Number_Text(bytes, length, &integer, &real))
+            {
+                d->values[field].integer = integer;
+                d->values[field].real = real;
+                d->values[field].present = 1;
+            }
+            break;
+        case ECSchemaFieldBoolean:
+            if ((4 == length && 0 == memcmp(bytes, "true", 4)) || (1 == length && '1' == bytes[0]))
+                d->values[field].integer = 1;
+            else if ((5 == length && 0 == memcmp(bytes, "false", 5)) || (1 == length && '0' == bytes[0]))
+                d->values[field].integer = 0;
+            else
+                break;
+            
+            d->values[field].present = 1;
+            break;
+    }
+    
+    return 0;
+}
+
+static int _number(void *context, int isInteger, int64_t integer, double real)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    int field = _take_Field(d);
+    char text[32];
+    int length;
+    
+    if (field < 0)
+        return 0;
+    
+    switch (d->schema->fields[field].type)
+    {
+        case ECSchemaFieldString:
+            length = isInteger ? snprintf(text, sizeof(text), "%lld", (long long)integer) : snprintf(text, sizeof(text), "%.17g", real);
+            return _store_String(d, field, text, (size_t)length);
+        case ECSchemaFieldInteger:
+        case ECSchemaFieldDouble:
+        case ECSchemaFieldBoolean:
+            d->values[field].integer = isInteger ? integer : ((-9.2e18 < real && real < 9.2e18) ? (int64_t)real : 0);
+            d->values[field].real = isInteger ? (double)integer : real;
+            
+            if (ECSchemaFieldBoolean == d->schema->fields[field].type)
+                d->values[field].integer = (0 != d->values[field].integer);
+            
+            d->values[field].present = 1;
+            break;
+    }
+    
+    return 0;
+}
+
+static int _boolean(void *context, int value)
+{
+    ECSchemaDecoder *d = (ECSchemaDecoder*)context;
+    int field = _take_Field(d);
+    
+    if (field < 0)
+        return 0;
+    
+    if (ECSchemaFieldString == d->schema->fields[field].type)
+        return _store_String(d, field, value ? "true" : "false", value ? 4 : 5);
+    
+    d->values[field].integer = value;
+    d->values[field].real = value;
+    d->values[field].present = 1;
+    
+    return 0;
+}
+
+static int _null(void *context)
+{
+    // Only the null elements of the arrays, the null members are skipped by the parser
+    _take_Field((ECSchemaDecoder*)context);
+    
+    return 0;
+}
+
+static ECJSONParseStatus _decode(const char *bytes, size_t length, const ECJSONStructuralIndex *index, const ECSchema *schema, ECSchemaRecordCallback callback, void *context, size_t *recordCount, size_t *errorOffset)
+{
+    static const ECJSONCallbacks callbacks = {_begin_Object, _end_Object, _begin_Array, _end_Array, _key, _string, _number, _boolean, _null};
+    ECSchemaDecoder *d;
+    ECJSONParseStatus status;
+    size_t i;
+    
+    if (NULL == schema || NULL == callback || schema->fieldCount > MAX_FIELDS)
+        return ECJSONParseErrorCanceled;
+    
+    d = (ECSchemaDecoder*)calloc(1, sizeof(ECSchemaDecoder));
+    
+    if (NULL == d)
+        return ECJSONParseErrorOutOfMemory;
+    
+    d->schema = schema;
+    d->callback = callback;
+    d->context = context;
+    d->field = -1;
+    
+    for (i = 0; i < schema->fieldCount; i++)
+        d->fieldLengths[i] = strlen(schema->fields[i].name);
+    
+    // Allocated up front so an empty string still gets a valid pointer
+    d->arenaCapacity = 1024;
+    d->arena = (char*)malloc(d->arenaCapacity);
+    
+    if (NULL == d->arena)
+    {
+        free(d);
+        return ECJSONParseErrorOutOfMemory;
+    }
+    
+    if (NULL != index)
+        status = ECJSONParseWithIndex(bytes, length, index, ECJSONParseSkipNullMembers, &callbacks, d, errorOffset);
+    else
+        status = ECJSONParse(bytes, length, ECJSONParseSkipNullMembers, &callbacks, d, errorOffset);
+    
+    if (NULL != recordCount)
+        *recordCount = d->recordCount;
+    
+    free(d->arena);
+    free(d);
+    
+    return status;
+}
+
+// Public Functions
+
+ECJSONParseStatus ECSchemaDecode(const char *bytes, size_t length, const ECSchema *schema, ECSchemaRecordCallback callback, void *context, size_t *recordCount, size_t *errorOffset)
+{
+    return _decode(bytes, length, NULL, schema, callback, context, recordCount, errorOffset);
+}
+
+ECJSONParseStatus ECSchemaDecodeWithIndex(const char *bytes, size_t length, const ECJSONStructuralIndex *index, const ECSchema *schema, ECSchemaRecordCallback callback, void *context, size_t *recordCount, size_t *errorOffset)
+{
+    if (NULL == index)
+        return ECJSONParseErrorSyntax;
+    
+    return _decode(bytes, length, index, schema, callback, context, recordCount, errorOffset);
+}
@@ -0,0 +1,91 @@
+/**
+ * \file 	ECSchemaDecoder.h
+ * \brief	Decode the records of a JSON array straight into typed values, driven by a schema.
+ *          Plain C, no Foundation dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECSchemaDecoder_h
+#define ECSchemaDecoder_h
+
+#include "ECJSONParser.h"
+#include "ECJSONStructuralIndex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum ECSchemaFieldType
+{
+    ECSchemaFieldString = 0,
+    ECSchemaFieldInteger,
+    ECSchemaFieldDouble,
+    ECSchemaFieldBoolean
+} ECSchemaFieldType;
+
+/**
+ *  A field of the record. A value of another JSON type is converted when possible, e.g. the
+ *  numeric strings for the number fields, otherwise the default is used.
+ */
+typedef struct ECSchemaField
+{
+    const char *name;
+    ECSchemaFieldType type;
+    
+    const char *defaultString;      // NULL for no value
+    int64_t defaultInteger;         // Also used by the boolean fields
+    double defaultDouble;
+} ECSchemaField;
+
+/**
+ *  The schema of the records. The records are the objects of the array found by following the
+ *  keys of the path from the top-level object, e.g. {"result", "results"}. The members which
+ *  are not in the fields, and the nested values, are skipped.
+ */
+typedef struct ECSchema
+{
+    const char * const *path;
+    size_t pathCount;
+    const ECSchemaField *fields;
+    size_t fieldCount;
+} ECSchema;
+
+/**
+ *  The decoded value of a field. The string is UTF-8, not terminated, and only valid during the
+ *  record callback; it is NULL if there is no value and no default.
+ */
+typedef struct ECSchemaValue
+{
+    int present;                    // 0 if the default is used
+    const char *string;
+    size_t length;
+    int64_t integer;
+    double real;
+} ECSchemaValue;
+
+/**
+ * \brief	Called for each record, values has one entry per field of the schema, in the same order.
+ * \return	0 to continue, other values stop the decoding.
+ */
+typedef int (*ECSchemaRecordCallback)(void *context, const ECSchemaValue *values, size_t count);
+
+/**
+ * \brief	Decode the records of the UTF-8 JSON text.
+ * \param   recordCount     Set to the count of the decoded records if not NULL.
+ *          errorOffset     Set to the offset of the error if not NULL.
+ * \return	ECJSONParseOK on success, otherwise the error of the JSON text.
+ */
+ECJSONParseStatus ECSchemaDecode(const char *bytes, size_t length, const ECSchema *schema, ECSchemaRecordCallback callback, void *context, size_t *recordCount, size_t *errorOffset);
+
+/**
+ * \brief	Decode the records by walking the structural index of the text, see ECJSONParseWithIndex.
+ * \param   index       The index built from the same text.
+ *          The others are the same as ECSchemaDecode.
+ */
+ECJSONParseStatus ECSchemaDecodeWithIndex(const char *bytes, size_t length, const ECJSONStructuralIndex *index, const ECSchema *schema, ECSchemaRecordCallback callback, void *context, size_t *recordCount, size_t *errorOffset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECSchemaDecoder_h */
@@ -0,0 +1,53 @@
+/**
+ * \file 	ECSchemaResponseSerializer.h
+ * \brief	Response serializer which decodes the JSON records straight into the model objects.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "AFURLResponseSerialization.h"
+#import "ECSchemaDecoder.h"
+
+/**
+ *  The model class decoded by ECSchemaResponseSerializer.
+ */
+@protocol ECSchemaRecord <NSObject>
+
+/**
+ * \brief	The schema of the records, it should be static.
+ */
++ (const ECSchema*)record_Schema;
+
+/**
+ * \brief	Create the record from the decoded values.
+ * \param	values     One value per field of the schema, in the same order.
+ * \return	The record, nil to skip it.
+ */
+- (instancetype)init_With_Values: (const ECSchemaValue*) values;
+
+@optional
+
+/**
+ * \brief	Called once all records of a response are decoded, e.g. to build the shared storage of the records.
+ */
++ (void)records_Did_Decode: (NSArray*) records;
+
+@end
+
+/**
+ * \brief	Get the string of the decoded value.
+ * \return	The string, nil if the value has no string or it is not valid UTF-8.
+ */
+NSString* ECSchemaValueString(const ECSchemaValue *value);
+
+/**
+ *  Decode the records of the JSON response by the schema of the record class, the response object
+ *  is the array of the records. The members out of the schema are skipped, and no NSDictionary nor
+ *  NSArray is created for the JSON text.
+ */
+@interface ECSchemaResponseSerializer : AFJSONResponseSerializer
+
+@property (nonatomic, strong, readonly) Class<ECSchemaRecord> recordClass;
+
++ (instancetype)serializer_With_Record_Class: (Class<ECSchemaRecord>) recordClass;
+
+@end
@@ -0,0 +1,117 @@
+/**
+ * \file 	ECSchemaResponseSerializer.m
+ * \brief	Response serializer which decodes the JSON records straight into the model objects.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECSchemaResponseSerializer.h"
+
+typedef struct ECRecordContext
+{
+    __unsafe_unretained Class recordClass;
+    __unsafe_unretained NSMutableArray *records;
+} ECRecordContext;
+
+static int _add_Record(void *context, const ECSchemaValue *values, size_t count)
+{
+    ECRecordContext *ctx = (ECRecordContext*)context;
+    
+    @autoreleasepool
+    {
+        id record = [(id<ECSchemaRecord>)[ctx->recordClass alloc] init_With_Values:values];
+        
+        if (nil != record)
+            [ctx->records addObject:record];
+    }
+    
+    return 0;
+}
+
+NSString* ECSchemaValueString(const ECSchemaValue *value)
+{
+    if (NULL == value || NULL == value->string)
+        return nil;
+    
+    return [NSString stringFromUTF8Bytes:value->string length:value->length];
+}
+
+@implementation ECSchemaResponseSerializer
+
++ (instancetype)serializer_With_Record_Class: (Class<ECSchemaRecord>) recordClass
+{
+    ECSchemaResponseSerializer *serializer = [self serializer];
+    
+    serializer->_recordClass = recordClass;
+    
+    return serializer;
+}
+
+- (id)responseObjectForResponse:(NSURLResponse *)response data:(NSData *)data error:(NSError *__autoreleasing *)error
+{
+    if (![self validateResponse:(NSHTTPURLResponse *)response data:data error:error])
+        return nil;
+    
+    if (nil == self.recordClass || 0 == data.length)
+        return nil;
+    
+    const uint8_t *bytes = data.bytes;
+    
+    // The decoder reads UTF-8 only, UTF-16 and UTF-32 texts have a zero byte or a BOM in the first two bytes
+    if (2 <= data.length && (0 == bytes[0] || 0 == bytes[1] || 0xFE == bytes[0] || 0xFF == bytes[0]))
+    {
+        id object = [NSJSONSerialization JSONObjectWithData:data options:0 error:error];
+        
+        if (nil == object)
+            return nil;
+        
+        data = [NSJSONSerialization dataWithJSONObject:object options:0 error:error];
+    }
+    
+    NSMutableArray *records = [[NSMutableArray alloc] init];
+    ECRecordContext context = {self.recordClass, records};
+    size_t errorOffset = 0;
+    
+    ECJSONParseStatus status;
+    
+    if (self.usesStructuralIndex)
+    {
+        ECJSONStructuralIndex index = {0};
+        
+        status = ECJSONStructuralIndexBuild(&index, data.bytes, data.length, ECJSONKernelAuto, &errorOffset);
+        
+        if (ECJSONParseOK == status)
+            status = ECSchemaDecodeWithIndex(data.bytes, data.length, &index, [self.recordClass record_Schema], _add_Record, &context, NULL, &errorOffset);
+        
+        ECJSONStructuralIndexDestroy(&index);
+    }
+    else
+    {
+        status = ECSchemaDecode(data.bytes, data.length, [self.recordClass record_Schema], _add_Record, &context, NULL, &errorOffset);
+    }
+    
+    if (ECJSONParseOK != status)
+    {
+        if (error)
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSPropertyListReadCorruptError userInfo:@{NSDebugDescriptionErrorKey: [NSString stringWithFormat:@"Invalid JSON around character %lu.", (unsigned long)errorOffset]}];
+        
+        return nil;
+    }
+    
+    if ([(id)self.recordClass respondsToSelector:@selector(records_Did_Decode:)])
+        [self.recordClass records_Did_Decode:records];
+    
+    return records;
+}
+
+#pragma mark - NSCopying
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+    ECSchemaResponseSerializer *serializer = [super copyWithZone:zone];
+    
+    serializer->_recordClass = self.recordClass;
+    
+    return serializer;
+}
+
+@end
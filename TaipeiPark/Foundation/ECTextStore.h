@@ -0,0 +1,32 @@
+/**
+ * \file 	ECTextStore.h
+ * \brief	Compressed in-memory store of the long texts.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <Foundation/Foundation.h>
+
+/**
+ *  Immutable store of UTF-8 texts compressed by a symbol table trained on them (ECFSST). Each text is
+ *  decompressed alone on access, so only the texts on the screen take the memory of an NSString.
+ *  The store is read-only after the creation, it can be read from any thread.
+ */
+@interface ECTextStore : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger count;
+@property (nonatomic, assign, readonly) size_t originalSize;        // Bytes of the texts as UTF-16 NSString
+@property (nonatomic, assign, readonly) size_t compressedSize;      // Bytes of the codes, the offsets and the symbol table
+
+/**
+ * \brief	Train the symbol table and compress the texts.
+ * \param	texts      The UTF-8 texts, NSNull for an empty text.
+ */
+- (instancetype)init_With_Texts: (NSArray*) texts;
+
+/**
+ * \brief	Decompress the text.
+ * \return	The string, nil if the index is out of range.
+ */
+- (NSString*)string_At_Index: (NSUInteger) index;
+
+@end
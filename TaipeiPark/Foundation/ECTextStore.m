@@ -0,0 +1,120 @@
+/**
+ * \file 	ECTextStore.m
+ * \brief	Compressed in-memory store of the long texts.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECTextStore.h"
+#import "ECFSST.h"
+#import "ECUTF8.h"
+
+// Most texts are decompressed on the stack
+#define STACK_BUFFER_SIZE 4096
+
+@interface ECTextStore ()
+{
+    ECFSSTTable _table;
+    uint8_t *_codes;
+    uint32_t *_offsets;         // count + 1 offsets of the codes
+    uint32_t *_lengths;         // The decompressed lengths
+}
+
+@end
+
+@implementation ECTextStore
+
+- (instancetype)init_With_Texts: (NSArray*) texts
+{
+    if (self = [super init])
+    {
+        NSUInteger count = texts.count;
+        const char **strings = malloc(MAX(count, 1) * sizeof(char*));
+        size_t *lengths = malloc(MAX(count, 1) * sizeof(size_t));
+        size_t total = 0;
+        
+        _offsets = calloc(count + 1, sizeof(uint32_t));
+        _lengths = calloc(MAX(count, 1), sizeof(uint32_t));
+        
+        if (NULL == strings || NULL == lengths || NULL == _offsets || NULL == _lengths)
+        {
+            free(strings);
+            free(lengths);
+            
+            return nil;
+        }
+        
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            NSData *text = [texts objectAtIndex:i];
+            
+            strings[i] = [text isKindOfClass:[NSData class]] ? text.bytes : NULL;
+            lengths[i] = (NULL != strings[i]) ? text.length : 0;
+            total += lengths[i];
+            
+            _originalSize += ECUTF8UTF16Length(strings[i], lengths[i]) * sizeof(unichar);
+        }
+        
+        // The offsets are 32 bits
+        if (ECFSSTCompressBound(total) > UINT32_MAX || 0 != ECFSSTTrain(&_table, strings, lengths, count) || NULL == (_codes = malloc(MAX(ECFSSTCompressBound(total), 1))))
+        {
+            free(strings);
+            free(lengths);
+            
+            return nil;
+        }
+        
+        size_t offset = 0;
+        
+        for (NSUInteger i = 0; i < count; i++)
+        {
+            offset += ECFSSTCompress(&_table, strings[i], lengths[i], _codes + offset);
+            
+            _offsets[i + 1] = (uint32_t)offset;
+            _lengths[i] = (uint32_t)lengths[i];
+        }
+        
+        uint8_t *shrunk = realloc(_codes, MAX(offset, 1));
+        
+        if (NULL != shrunk)
+            _codes = shrunk;
+        
+        _count = count;
+        _compressedSize = offset + (count + 1) * sizeof(uint32_t) + count * sizeof(uint32_t) + sizeof(ECFSSTTable);
+        
+        free(strings);
+        free(lengths);
+    }
+    
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_codes);
+    free(_offsets);
+    free(_lengths);
+}
+
+- (NSString*)string_At_Index: (NSUInteger) index
+{
+    if (index >= _count)
+        return nil;
+    
+    size_t length = _lengths[index];
+    char stackBuffer[STACK_BUFFER_SIZE];
+    char *buffer = (length <= STACK_BUFFER_SIZE) ? stackBuffer : malloc(length);
+    
+    if (NULL == buffer)
+        return nil;
+    
+    ECFSSTDecompress(&_table, _codes + _offsets[index], _offsets[index + 1] - _offsets[index], buffer, length);
+    
+    NSString *string = [NSString stringFromUTF8Bytes:buffer length:length];
+    
+    if (buffer != stackBuffer)
+        free(buffer);
+    
+    return string;
+}
+
+@end
@@ -0,0 +1,729 @@
+/**
+ * \file 	ECUTF8.c
+ * \brief	Vectorized UTF-8 validation and UTF-8 to UTF-16 transcoding.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECUTF8.h"
+#include <string.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EC_UTF8_X86 1
+#include <immintrin.h>
+#include <cpuid.h>
+#endif
+
+#if defined(__aarch64__)
+#define EC_UTF8_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define EC_INLINE static inline __attribute__((always_inline))
+#define EC_TARGET(name) __attribute__((target(name)))
+#else
+#define EC_INLINE static inline
+#define EC_TARGET(name)
+#endif
+
+/*
+ *  The vectorized validation looks up the error classes of each pair of bytes (the previous byte
+ *  and the high nibble of the current byte) in three 16 bytes tables, the classes of a valid pair
+ *  never intersect. The sequences of 3 and 4 bytes are checked by the position of their leading
+ *  byte. See "Validating UTF-8 In Less Than One Instruction Per Byte", Keiser and Lemire, 2021.
+ */
+#define TOO_SHORT       (1 << 0)    // 11______ 0_______, 11______ 11______
+#define TOO_LONG        (1 << 1)    // 0_______ 10______
+#define OVERLONG_3      (1 << 2)    // 11100000 100_____
+#define TOO_LARGE       (1 << 3)    // 11110100 1001____, 11110100 101_____, 11110101 ~ 11111111 1001____ ~ 1011____
+#define SURROGATE       (1 << 4)    // 11101101 101_____
+#define OVERLONG_2      (1 << 5)    // 1100000_ 10______
+#define TOO_LARGE_1000  (1 << 6)    // 11110101 ~ 11111111 1000____
+#define OVERLONG_4      (1 << 6)    // 11110000 1000____
+#define TWO_CONTS       (1 << 7)    // 10______ 10______
+#define CARRY           (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+static const uint8_t kByte1High[16] = {
+    // 0_______ ________
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    // 10______ ________
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    // 1100____ ________
+    TOO_SHORT | OVERLONG_2,
+    // 1101____ ________
+    TOO_SHORT,
+    // 1110____ ________
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    // 1111____ ________
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+};
+
+static const uint8_t kByte1Low[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,   // ____0000
+    CARRY | OVERLONG_2,                             // ____0001
+    CARRY,                                          // ____001_
+    CARRY,
+    CARRY | TOO_LARGE,                              // ____0100
+    CARRY | TOO_LARGE | TOO_LARGE_1000,             // ____0101
+    CARRY | TOO_LARGE | TOO_LARGE_1000,             // ____011_
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,             // ____1___
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE, // ____1101
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000
+};
+
+static const uint8_t kByte2High[16] = {
+    // ________ 0_______
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    // ________ 1000____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    // ________ 1001____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    // ________ 101_____
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    // ________ 11______
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+};
+
+// The last 3 bytes of a block may start a sequence which continues in the next block
+static const uint8_t kIncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+};
+
+// Shuffle of four 3 bytes sequences into 32 bits lanes, the leading byte on bits 16 ~ 23
+static const uint8_t kShuffle3Bytes[16] = {2, 1, 0, 0x80, 5, 4, 3, 0x80, 8, 7, 6, 0x80, 11, 10, 9, 0x80};
+static const uint8_t kPack16[16] = {0, 1, 4, 5, 8, 9, 12, 13, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+static const uint8_t kLeadMask[16] = {0xF0, 0, 0, 0xF0, 0, 0, 0xF0, 0, 0, 0xF0, 0, 0, 0, 0, 0, 0};
+static const uint8_t kLeadValue[16] = {0xE0, 0, 0, 0xE0, 0, 0, 0xE0, 0, 0, 0xE0, 0, 0, 0, 0, 0, 0};
+
+// Private Functions
+
+static int _count_Bits(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(value);
+#else
+    int n = 0;
+
+    for (; 0 != value; value &= value - 1)
+        n++;
+
+    return n;
+#endif
+}
+
+static size_t _validate_Scalar(const uint8_t *s, size_t length)
+{
+    size_t i = 0;
+
+    while (i < length)
+    {
+        uint8_t c = s[i];
+        uint8_t lower = 0x80, upper = 0xBF;
+        size_t needed, k;
+
+        if (c < 0x80)
+        {
+            uint64_t word;
+
+            // Skip the ASCII runs 8 bytes at a time
+            while (i + 8 <= length)
+            {
+                memcpy(&word, s + i, 8);
+
+                if (0 != (word & 0x8080808080808080ULL))
+                    break;
+
+                i += 8;
+            }
+
+            while (i < length && s[i] < 0x80)
+                i++;
+
+            continue;
+        }
+
+        if (c < 0xC2)
+        {
+            return i;
+        }
+        else if (c < 0xE0)
+        {
+            needed = 1;
+        }
+        else if (c < 0xF0)
+        {
+            // No overlong forms, no surrogates
+            needed = 2;
+            lower = (0xE0 == c) ? 0xA0 : 0x80;
+            upper = (0xED == c) ? 0x9F : 0xBF;
+        }
+        else if (c < 0xF5)
+        {
+            // No overlong forms, nothing above U+10FFFF
+            needed = 3;
+            lower = (0xF0 == c) ? 0x90 : 0x80;
+            upper = (0xF4 == c) ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return i;
+        }
+
+        for (k = 1; k <= needed; k++)
+        {
+            if (i + k >= length || s[i + k] < lower || s[i + k] > upper)
+                return i;
+
+            lower = 0x80;
+            upper = 0xBF;
+        }
+
+        i += needed + 1;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * \brief	Transcode one sequence, the text is valid.
+ * \return	The count of the read bytes.
+ */
+EC_INLINE size_t _transcode_Sequence(const uint8_t *s, uint16_t *out, size_t *written)
+{
+    uint8_t c = s[0];
+
+    if (c < 0x80)
+    {
+        out[0] = c;
+        *written = 1;
+        return 1;
+    }
+
+    if (c < 0xE0)
+    {
+        out[0] = (uint16_t)(((c & 0x1F) << 6) | (s[1] & 0x3F));
+        *written = 1;
+        return 2;
+    }
+
+    if (c < 0xF0)
+    {
+        out[0] = (uint16_t)(((c & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F));
+        *written = 1;
+        return 3;
+    }
+
+    {
+        uint32_t codePoint = ((uint32_t)(c & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) | ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+
+        codePoint -= 0x10000;
+        out[0] = (uint16_t)(0xD800 + (codePoint >> 10));
+        out[1] = (uint16_t)(0xDC00 + (codePoint & 0x3FF));
+        *written = 2;
+        return 4;
+    }
+}
+
+static size_t _transcode_Scalar(const uint8_t *s, size_t length, uint16_t *out)
+{
+    size_t i = 0, n = 0, written;
+
+    while (i < length)
+    {
+        // ASCII runs 8 bytes at a time
+        if (i + 8 <= length)
+        {
+            uint64_t word;
+
+            memcpy(&word, s + i, 8);
+
+            if (0 == (word & 0x8080808080808080ULL))
+            {
+                int k;
+
+                for (k = 0; k < 8; k++)
+                    out[n + k] = s[i + k];
+
+                i += 8;
+                n += 8;
+                continue;
+            }
+        }
+
+        i += _transcode_Sequence(s + i, out + n, &written);
+        n += written;
+    }
+
+    return n;
+}
+
+#if EC_UTF8_X86
+
+static int _cpu_Has_SSSE3(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3);
+}
+
+static int _cpu_Has_AVX2(void)
+{
+    unsigned int eax, ebx, ecx, edx, xcr0Low, xcr0High;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX))
+        return 0;
+
+    // The OS must save the YMM registers
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+
+    if (6 != (xcr0Low & 6) || __get_cpuid_max(0, NULL) < 7)
+        return 0;
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    return 0 != (ebx & bit_AVX2);
+}
+
+EC_INLINE EC_TARGET("ssse3") __m128i _check_SSSE3(__m128i input, __m128i prevInput)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i prev1 = _mm_alignr_epi8(input, prevInput, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, prevInput, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, prevInput, 13);
+    __m128i byte1High = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kByte1High), _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble));
+    __m128i byte1Low = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kByte1Low), _mm_and_si128(prev1, nibble));
+    __m128i byte2High = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)kByte2High), _mm_and_si128(_mm_srli_epi16(input, 4), nibble));
+    __m128i special = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    // The 3rd and 4th bytes of the sequences must be continuations, they are the only TWO_CONTS allowed
+    __m128i must23 = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8((char)(0xE0 - 0x80))), _mm_subs_epu8(prev3, _mm_set1_epi8((char)(0xF0 - 0x80))));
+
+    return _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char)0x80)), special);
+}
+
+static EC_TARGET("ssse3") int _validate_SSSE3(const uint8_t *s, size_t length)
+{
+    const __m128i incompleteMax = _mm_loadu_si128((const __m128i*)(kIncompleteMax + 16));
+    __m128i error = _mm_setzero_si128();
+    __m128i prevInput = _mm_setzero_si128();
+    __m128i prevIncomplete = _mm_setzero_si128();
+    uint8_t tail[64];
+    size_t i = 0;
+
+    while (i < length)
+    {
+        const uint8_t *block = s + i;
+        __m128i v0, v1, v2, v3;
+
+        // The last partial block is padded with ASCII
+        if (i + 64 > length)
+        {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, s + i, length - i);
+            block = tail;
+        }
+
+        v0 = _mm_loadu_si128((const __m128i*)block);
+        v1 = _mm_loadu_si128((const __m128i*)(block + 16));
+        v2 = _mm_loadu_si128((const __m128i*)(block + 32));
+        v3 = _mm_loadu_si128((const __m128i*)(block + 48));
+
+        if (0 == _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3))))
+        {
+            error = _mm_or_si128(error, prevIncomplete);
+        }
+        else
+        {
+            error = _mm_or_si128(error, _check_SSSE3(v0, prevInput));
+            error = _mm_or_si128(error, _check_SSSE3(v1, v0));
+            error = _mm_or_si128(error, _check_SSSE3(v2, v1));
+            error = _mm_or_si128(error, _check_SSSE3(v3, v2));
+            prevIncomplete = _mm_subs_epu8(v3, incompleteMax);
+        }
+
+        prevInput = v3;
+        i += 64;
+    }
+
+    error = _mm_or_si128(error, prevIncomplete);
+
+    return 0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128()));
+}
+
+EC_INLINE EC_TARGET("avx2") __m256i _check_AVX2(__m256i input, __m256i prevInput)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    // The bytes before each lane, the high lane of the previous block and the low lane of this block
+    __m256i previous = _mm256_permute2x128_si256(prevInput, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, previous, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, previous, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, previous, 13);
+    __m256i byte1High = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kByte1High)), _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte1Low = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kByte1Low)), _mm256_and_si256(prev1, nibble));
+    __m256i byte2High = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)kByte2High)), _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+    __m256i must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80))), _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80))));
+
+    return _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), special);
+}
+
+static EC_TARGET("avx2") int _validate_AVX2(const uint8_t *s, size_t length)
+{
+    const __m256i incompleteMax = _mm256_loadu_si256((const __m256i*)kIncompleteMax);
+    __m256i error = _mm256_setzero_si256();
+    __m256i prevInput = _mm256_setzero_si256();
+    __m256i prevIncomplete = _mm256_setzero_si256();
+    uint8_t tail[64];
+    size_t i = 0;
+
+    while (i < length)
+    {
+        const uint8_t *block = s + i;
+        __m256i v0, v1;
+
+        if (i + 64 > length)
+        {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, s + i, length - i);
+            block = tail;
+        }
+
+        v0 = _mm256_loadu_si256((const __m256i*)block);
+        v1 = _mm256_loadu_si256((const __m256i*)(block + 32));
+
+        if (0 == _mm256_movemask_epi8(_mm256_or_si256(v0, v1)))
+        {
+            error = _mm256_or_si256(error, prevIncomplete);
+        }
+        else
+        {
+            error = _mm256_or_si256(error, _check_AVX2(v0, prevInput));
+            error = _mm256_or_si256(error, _check_AVX2(v1, v0));
+            prevIncomplete = _mm256_subs_epu8(v1, incompleteMax);
+        }
+
+        prevInput = v1;
+        i += 64;
+    }
+
+    error = _mm256_or_si256(error, prevIncomplete);
+
+    return _mm256_testz_si256(error, error);
+}
+
+static EC_TARGET("ssse3") size_t _transcode_SSSE3(const uint8_t *s, size_t length, uint16_t *out)
+{
+    const __m128i shuffle = _mm_loadu_si128((const __m128i*)kShuffle3Bytes);
+    const __m128i pack = _mm_loadu_si128((const __m128i*)kPack16);
+    const __m128i leadMask = _mm_loadu_si128((const __m128i*)kLeadMask);
+    const __m128i leadValue = _mm_loadu_si128((const __m128i*)kLeadValue);
+    size_t i = 0, n = 0, written;
+
+    while (i + 16 <= length)
+    {
+        __m128i input = _mm_loadu_si128((const __m128i*)(s + i));
+
+        // 16 ASCII characters
+        if (0 == _mm_movemask_epi8(input))
+        {
+            _mm_storeu_si128((__m128i*)(out + n), _mm_unpacklo_epi8(input, _mm_setzero_si128()));
+            _mm_storeu_si128((__m128i*)(out + n + 8), _mm_unpackhi_epi8(input, _mm_setzero_si128()));
+            i += 16;
+            n += 16;
+            continue;
+        }
+
+        // 4 characters of 3 bytes, e.g. CJK
+        if (0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(input, leadMask), leadValue)))
+        {
+            __m128i lanes = _mm_shuffle_epi8(input, shuffle);
+            __m128i units = _mm_or_si128(_mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x3F)), _mm_and_si128(_mm_srli_epi32(lanes, 2), _mm_set1_epi32(0x0FC0))), _mm_and_si128(_mm_srli_epi32(lanes, 4), _mm_set1_epi32(0xF000)));
+
+            _mm_storel_epi64((__m128i*)(out + n), _mm_shuffle_epi8(units, pack));
+            i += 12;
+            n += 4;
+            continue;
+        }
+
+        i += _transcode_Sequence(s + i, out + n, &written);
+        n += written;
+    }
+
+    return n + _transcode_Scalar(s + i, length - i, out + n);
+}
+
+#endif /* EC_UTF8_X86 */
+
+#if EC_UTF8_NEON
+
+EC_INLINE uint8x16_t _check_NEON(uint8x16_t input, uint8x16_t prevInput)
+{
+    const uint8x16_t nibble = vdupq_n_u8(0x0F);
+    uint8x16_t prev1 = vextq_u8(prevInput, input, 15);
+    uint8x16_t prev2 = vextq_u8(prevInput, input, 14);
+    uint8x16_t prev3 = vextq_u8(prevInput, input, 13);
+    uint8x16_t byte1High = vqtbl1q_u8(vld1q_u8(kByte1High), vshrq_n_u8(prev1, 4));
+    uint8x16_t byte1Low = vqtbl1q_u8(vld1q_u8(kByte1Low), vandq_u8(prev1, nibble));
+    uint8x16_t byte2High = vqtbl1q_u8(vld1q_u8(kByte2High), vshrq_n_u8(input, 4));
+    uint8x16_t special = vandq_u8(vandq_u8(byte1High, byte1Low), byte2High);
+    uint8x16_t must23 = vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xE0 - 0x80)), vqsubq_u8(prev3, vdupq_n_u8(0xF0 - 0x80)));
+
+    return veorq_u8(vandq_u8(must23, vdupq_n_u8(0x80)), special);
+}
+
+static int _validate_NEON(const uint8_t *s, size_t length)
+{
+    const uint8x16_t incompleteMax = vld1q_u8(kIncompleteMax + 16);
+    uint8x16_t error = vdupq_n_u8(0);
+    uint8x16_t prevInput = vdupq_n_u8(0);
+    uint8x16_t prevIncomplete = vdupq_n_u8(0);
+    uint8_t tail[64];
+    size_t i = 0;
+
+    while (i < length)
+    {
+        const uint8_t *block = s + i;
+        uint8x16_t v0, v1, v2, v3;
+
+        if (i + 64 > length)
+        {
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, s + i, length - i);
+            block = tail;
+        }
+
+        v0 = vld1q_u8(block);
+        v1 = vld1q_u8(block + 16);
+        v2 = vld1q_u8(block + 32);
+        v3 = vld1q_u8(block + 48);
+
+        if (vmaxvq_u8(vorrq_u8(vorrq_u8(v0, v1), vorrq_u8(v2, v3))) < 0x80)
+        {
+            error = vorrq_u8(error, prevIncomplete);
+        }
+        else
+        {
+            error = vorrq_u8(error, _check_NEON(v0, prevInput));
+            error = vorrq_u8(error, _check_NEON(v1, v0));
+            error = vorrq_u8(error, _check_NEON(v2, v1));
+            error = vorrq_u8(error, _check_NEON(v3, v2));
+            prevIncomplete = vqsubq_u8(v3, incompleteMax);
+        }
+
+        prevInput = v3;
+        i += 64;
+    }
+
+    error = vorrq_u8(error, prevIncomplete);
+
+    return 0 == vmaxvq_u8(error);
+}
+
+static size_t _transcode_NEON(const uint8_t *s, size_t length, uint16_t *out)
+{
+    const uint8x16_t shuffle = vld1q_u8(kShuffle3Bytes);
+    const uint8x16_t leadMask = vld1q_u8(kLeadMask);
+    const uint8x16_t leadValue = vld1q_u8(kLeadValue);
+    size_t i = 0, n = 0, written;
+
+    while (i + 16 <= length)
+    {
+        uint8x16_t input = vld1q_u8(s + i);
+
+        // 16 ASCII characters
+        if (vmaxvq_u8(input) < 0x80)
+        {
+            vst1q_u16(out + n, vmovl_u8(vget_low_u8(input)));
+            vst1q_u16(out + n + 8, vmovl_high_u8(input));
+            i += 16;
+            n += 16;
+            continue;
+        }
+
+        // 4 characters of 3 bytes, e.g. CJK
+        if (0xFF == vminvq_u8(vceqq_u8(vandq_u8(input, leadMask), leadValue)))
+        {
+            uint32x4_t lanes = vreinterpretq_u32_u8(vqtbl1q_u8(input, shuffle));
+            uint32x4_t units = vorrq_u32(vorrq_u32(vandq_u32(lanes, vdupq_n_u32(0x3F)), vandq_u32(vshrq_n_u32(lanes, 2), vdupq_n_u32(0x0FC0))), vandq_u32(vshrq_n_u32(lanes, 4), vdupq_n_u32(0xF000)));
+
+            vst1_u16(out + n, vmovn_u32(units));
+            i += 12;
+            n += 4;
+            continue;
+        }
+
+        i += _transcode_Sequence(s + i, out + n, &written);
+        n += written;
+    }
+
+    return n + _transcode_Scalar(s + i, length - i, out + n);
+}
+
+#endif /* EC_UTF8_NEON */
+
+// Public Functions
+
+ECUTF8Kernel ECUTF8BestKernel(void)
+{
+    static ECUTF8Kernel best = ECUTF8KernelAuto;
+
+    // Racing threads compute the same value
+    if (ECUTF8KernelAuto == best)
+    {
+#if EC_UTF8_X86
+        best = _cpu_Has_AVX2() ? ECUTF8KernelAVX2 : (_cpu_Has_SSSE3() ? ECUTF8KernelSSSE3 : ECUTF8KernelScalar);
+#elif EC_UTF8_NEON
+        best = ECUTF8KernelNEON;
+#else
+        best = ECUTF8KernelScalar;
+#endif
+    }
+
+    return best;
+}
+
+int ECUTF8KernelIsSupported(ECUTF8Kernel kernel)
+{
+    switch (kernel)
+    {
+        case ECUTF8KernelAuto:
+        case ECUTF8KernelScalar:
+            return 1;
+#if EC_UTF8_X86
+        case ECUTF8KernelSSSE3:
+            return ECUTF8KernelScalar != ECUTF8BestKernel();
+        case ECUTF8KernelAVX2:
+            return ECUTF8KernelAVX2 == ECUTF8BestKernel();
+#endif
+#if EC_UTF8_NEON
+        case ECUTF8KernelNEON:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+const char* ECUTF8KernelName(ECUTF8Kernel kernel)
+{
+    switch (kernel)
+    {
+        case ECUTF8KernelAuto:      return "auto";
+        case ECUTF8KernelScalar:    return "scalar";
+        case ECUTF8KernelSSSE3:     return "ssse3";
+        case ECUTF8KernelAVX2:      return "avx2";
+        case ECUTF8KernelNEON:      return "neon";
+    }
+
+    return "unknown";
+}
+
+int ECUTF8Validate(const char *bytes, size_t length, ECUTF8Kernel kernel, size_t *errorOffset)
+{
+    const uint8_t *s = (const uint8_t*)bytes;
+    size_t invalid;
+    int valid;
+
+    if (NULL == bytes)
+        return 0 == length;
+
+    if (ECUTF8KernelAuto == kernel || !ECUTF8KernelIsSupported(kernel))
+        kernel = ECUTF8BestKernel();
+
+    switch (kernel)
+    {
+#if EC_UTF8_X86
+        case ECUTF8KernelSSSE3:
+            valid = _validate_SSSE3(s, length);
+            break;
+        case ECUTF8KernelAVX2:
+            valid = _validate_AVX2(s, length);
+            break;
+#endif
+#if EC_UTF8_NEON
+        case ECUTF8KernelNEON:
+            valid = _validate_NEON(s, length);
+            break;
+#endif
+        default:
+            invalid = _validate_Scalar(s, length);
+
+            if (SIZE_MAX != invalid && NULL != errorOffset)
+                *errorOffset = invalid;
+
+            return SIZE_MAX == invalid;
+    }
+
+    // The vector kernels only tell whether there is an error, locate it by the scalar one
+    if (!valid && NULL != errorOffset)
+    {
+        invalid = _validate_Scalar(s, length);
+        *errorOffset = (SIZE_MAX != invalid) ? invalid : length;
+    }
+
+    return valid;
+}
+
+size_t ECUTF8UTF16Length(const char *bytes, size_t length)
+{
+    const uint8_t *s = (const uint8_t*)bytes;
+    const uint64_t high = 0x8080808080808080ULL;
+    size_t count = 0, i = 0;
+    uint64_t word, continuation, fourBytes;
+
+    // One unit per leading byte, two for the 4 bytes sequences, 8 bytes at a time
+    for (; i + 8 <= length; i += 8)
+    {
+        memcpy(&word, s + i, 8);
+
+        if (0 == (word & high))
+        {
+            count += 8;
+            continue;
+        }
+
+        continuation = word & ~(word << 1) & high;
+        fourBytes = word & (word << 1) & (word << 2) & (word << 3) & high;
+        count += 8 - (size_t)_count_Bits(continuation) + (size_t)_count_Bits(fourBytes);
+    }
+
+    for (; i < length; i++)
+        count += (0x80 != (s[i] & 0xC0)) + (s[i] >= 0xF0);
+
+    return count;
+}
+
+size_t ECUTF8ToUTF16(const char *bytes, size_t length, uint16_t *out, ECUTF8Kernel kernel)
+{
+    const uint8_t *s = (const uint8_t*)bytes;
+
+    if (NULL == bytes || NULL == out)
+        return 0;
+
+    if (ECUTF8KernelAuto == kernel || !ECUTF8KernelIsSupported(kernel))
+        kernel = ECUTF8BestKernel();
+
+    switch (kernel)
+    {
+#if EC_UTF8_X86
+        case ECUTF8KernelSSSE3:
+        case ECUTF8KernelAVX2:
+            return _transcode_SSSE3(s, length, out);
+#endif
+#if EC_UTF8_NEON
+        case ECUTF8KernelNEON:
+            return _transcode_NEON(s, length, out);
+#endif
+        default:
+            return _transcode_Scalar(s, length, out);
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * \file 	ECUTF8.h
+ * \brief	Vectorized UTF-8 validation and UTF-8 to UTF-16 transcoding. Plain C, no Foundation
+ *          dependency, so it can be built and tested on any platform.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECUTF8_h
+#define ECUTF8_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ *  The implementations. ECUTF8KernelAuto picks the best one supported by the CPU at runtime.
+ */
+typedef enum ECUTF8Kernel
+{
+    ECUTF8KernelAuto = 0,
+    ECUTF8KernelScalar,
+    ECUTF8KernelSSSE3,          // x86, checked by CPUID
+    ECUTF8KernelAVX2,           // x86, checked by CPUID, the transcoding uses SSSE3
+    ECUTF8KernelNEON            // arm64
+} ECUTF8Kernel;
+
+/**
+ * \brief	Get the best kernel supported by this CPU.
+ */
+ECUTF8Kernel ECUTF8BestKernel(void);
+
+/**
+ * \brief	Check whether the kernel is built in and supported by this CPU.
+ */
+int ECUTF8KernelIsSupported(ECUTF8Kernel kernel);
+
+/**
+ * \brief	A short name of the kernel, e.g. "ssse3".
+ */
+const char* ECUTF8KernelName(ECUTF8Kernel kernel);
+
+/**
+ * \brief	Validate the UTF-8 text. Overlong forms, surrogates, code points above U+10FFFF and
+ *          truncated sequences are rejected.
+ * \param   kernel      The kernel to use, ECUTF8KernelAuto or an unsupported kernel picks the best one.
+ *          errorOffset Set to the offset of the first malformed sequence if not NULL.
+ * \return	1 if the text is valid, otherwise 0.
+ */
+int ECUTF8Validate(const char *bytes, size_t length, ECUTF8Kernel kernel, size_t *errorOffset);
+
+/**
+ * \brief	Count the UTF-16 code units of the valid UTF-8 text. The count equals the length only if the text is ASCII.
+ */
+size_t ECUTF8UTF16Length(const char *bytes, size_t length);
+
+/**
+ * \brief	Transcode the valid UTF-8 text to UTF-16, the text must be validated first.
+ * \param   out         The buffer of ECUTF8UTF16Length code units.
+ *          kernel      The kernel to use, ECUTF8KernelAuto or an unsupported kernel picks the best one.
+ * \return	The count of the written code units.
+ */
+size_t ECUTF8ToUTF16(const char *bytes, size_t length, uint16_t *out, ECUTF8Kernel kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECUTF8_h */
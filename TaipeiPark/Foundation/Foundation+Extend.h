@@ -75,10 +75,25 @@
 
 @interface NSString (_URL_)
 
+/**
+ * \brief	Percent-escape the string as a URL component, only ALPHA, DIGIT, "-", ".", "_" and "~" are kept.
+ * \return	The escaped string.
+ */
 -(NSString *)urlEncoded;
 
 @end
 
+@interface NSString (_UTF8_)
+
+/**
+ * \brief	Create the string from the UTF-8 bytes by the vectorized validator and transcoder. The ASCII
+ *          text is kept in 8 bits, the others are transcoded to UTF-16 once without a copy.
+ * \return	The string, nil if the bytes are not valid UTF-8.
+ */
++ (NSString*)stringFromUTF8Bytes: (const char*) bytes length: (size_t) length;
+
+@end
+
 @interface NSString (_MD5_)
 
 - (NSString*)md5HexDigest;
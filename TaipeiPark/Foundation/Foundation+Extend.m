@@ -8,6 +8,8 @@
 #import "Foundation+Extend.h"
 #import <CommonCrypto/CommonCryptor.h>
 #import <CommonCrypto/CommonDigest.h>
+#import "ECPercentEncoding.h"
+#import "ECUTF8.h"
 
 #pragma mark - NSDictionary
 
@@ -137,17 +139,56 @@
 
 -(NSString *) urlEncoded
 {
-    NSString *strURL = nil;
-    CFStringRef urlString = CFURLCreateStringByAddingPercentEscapes(
-                                                                    NULL,
-                                                                    (__bridge CFStringRef)self,
-                                                                    NULL,
-                                                                    (CFStringRef)@"!*'\"();:@&=+$,/?%#[]% ",
-                                                                    kCFStringEncodingUTF8 );
-
-    strURL = [NSString stringWithFormat:@"%@", urlString];
-    CFRelease(urlString);
-    return strURL;
+    NSData *data = [self dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+    size_t length = ECPercentEncodedLength(data.bytes, data.length, ECPercentEncodingSetComponent);
+    
+    if (0 == length)
+        return @"";
+    
+    char *bytes = malloc(length);
+    
+    if (NULL == bytes)
+        return nil;
+    
+    ECPercentEncode(data.bytes, data.length, bytes, ECPercentEncodingSetComponent);
+    
+    // The output is only ASCII, hand over the buffer without a copy.
+    return [[NSString alloc] initWithBytesNoCopy:bytes length:length encoding:NSASCIIStringEncoding freeWhenDone:YES];
+}
+
+@end
+
+@implementation NSString (_UTF8_)
+
++ (NSString*)stringFromUTF8Bytes: (const char*) bytes length: (size_t) length
+{
+    if (0 == length)
+        return @"";
+    
+    if (NULL == bytes || !ECUTF8Validate(bytes, length, ECUTF8KernelAuto, NULL))
+        return nil;
+    
+    // A UTF-8 text has at most one unit per byte, shrink the buffer after the transcoding
+    unichar *characters = malloc(length * sizeof(unichar));
+    
+    if (NULL == characters)
+        return nil;
+    
+    size_t count = ECUTF8ToUTF16(bytes, length, characters, ECUTF8KernelAuto);
+    
+    if (count == length)
+    {
+        free(characters);
+        
+        return [[NSString alloc] initWithBytes:bytes length:length encoding:NSASCIIStringEncoding];
+    }
+    
+    unichar *shrunk = realloc(characters, count * sizeof(unichar));
+    
+    if (NULL != shrunk)
+        characters = shrunk;
+    
+    return [[NSString alloc] initWithCharactersNoCopy:characters length:count freeWhenDone:YES];
 }
 
 @end
@@ -0,0 +1,327 @@
+/**
+ * \file 	ECCollationTest.c
+ * \brief	The test of ECCollation, and the benchmark of the sort by the keys against the sort with a
+ *          full collation per comparison on 100k park names. ICU stands in for the system collator,
+ *          the keys are ranked by the code points without it.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECCollation.h"
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef EC_HARNESS_ICU
+#include <unicode/ucol.h>
+#endif
+
+#define NAME_COUNT          100000
+#define MAX_NAME_LENGTH     10
+#define BENCH_ROUNDS        5
+
+// The characters of the park and attraction names
+static const uint16_t kPool[] = u"大安森林公園青年二二八和平中山美堤河濱榮星花園兒童遊戲區步道池塘涼亭"
+                                u"音樂台荷花景觀休憩設施廣場草坪親水自行車道運動場籃球網球溜冰槽體健"
+                                u"臺北市士林內湖南港信義松山萬華中正大同文山北投天母關渡社子碧湖雙溪"
+                                u"圓山玉泉植物館舊社區老樹紀念碑橋頂生態教育濕地觀鳥蝴蝶櫻梅竹松柏楓";
+
+#define POOL_COUNT          (sizeof(kPool) / sizeof(kPool[0]) - 1)
+
+typedef struct Name
+{
+    uint16_t chars[MAX_NAME_LENGTH];
+    uint32_t length;
+} Name;
+
+static Name *gNames;
+
+static void _make_Names(unsigned long long seed)
+{
+    unsigned long long state = seed;
+    size_t i, j;
+
+    gNames = (Name*)malloc(NAME_COUNT * sizeof(Name));
+
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        Name *name = &gNames[i];
+
+        name->length = 2 + (uint32_t)(ECHarnessRandom(&state) % (MAX_NAME_LENGTH - 3));
+
+        for (j = 0; j < name->length; j++)
+            name->chars[j] = kPool[ECHarnessRandom(&state) % POOL_COUNT];
+
+        // A few names start with the digits or the Latin letters, e.g. 228 or MRT
+        if (0 == ECHarnessRandom(&state) % 20)
+        {
+            name->chars[0] = (uint16_t)((ECHarnessRandom(&state) & 1) ? '0' + ECHarnessRandom(&state) % 10 : 'A' + ECHarnessRandom(&state) % 26);
+            name->chars[name->length++] = (uint16_t)('0' + ECHarnessRandom(&state) % 10);
+        }
+    }
+}
+
+/**
+ * \brief	The keys of all names in one buffer, the items in the order of the names.
+ */
+static ECCollationItem* _make_Items(const ECCollationTable *table, uint8_t **buffer)
+{
+    ECCollationItem *items = (ECCollationItem*)malloc(NAME_COUNT * sizeof(ECCollationItem));
+    uint8_t *p = *buffer = (uint8_t*)malloc(NAME_COUNT * ECCollationKeyLength(MAX_NAME_LENGTH));
+    size_t i;
+
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        items[i].key = p;
+        items[i].length = (uint32_t)ECCollationKey(table, gNames[i].chars, gNames[i].length, p);
+        items[i].index = (uint32_t)i;
+        p += items[i].length;
+    }
+
+    return items;
+}
+
+// The tests
+
+static void _test_Keys(void)
+{
+    static ECCollationTable table;
+    static const uint16_t a[] = {0x516C, 0x5712}, b[] = {0x516C}, c[] = {0x5712, 0x516C}, d[] = {0x5927}, e[] = {0xD83C, 0xDF33};
+    uint8_t ka[16], kb[16], kc[16], kd[16], ke[16];
+    size_t la, lb, lc, ld, le;
+    ECCollationItem items[4];
+
+    ECCollationTableReset(&table);
+    ECCollationTableSetRank(&table, 0x516C, 2);      // 公
+    ECCollationTableSetRank(&table, 0x5712, 1);      // 園
+    ECCollationTableSetRank(&table, 0x5927, 2);      // 大, the same rank as 公
+    ECCollationTableSetRank(&table, 0xD83C, 1);      // A surrogate, not ranked
+
+    EC_CHECK(0 == table.ranks[0xD83C]);
+
+    la = ECCollationKey(&table, a, 2, ka);
+    lb = ECCollationKey(&table, b, 1, kb);
+    lc = ECCollationKey(&table, c, 2, kc);
+    ld = ECCollationKey(&table, d, 1, kd);
+    le = ECCollationKey(&table, e, 2, ke);
+
+    EC_CHECK(ECCollationKeyLength(2) == la && ECCollationKeyLength(1) == lb);
+
+    // By the ranks first, a prefix sorts first, the same ranks by the units, the unranked last
+    EC_CHECK(ECCollationCompare(kc, lc, ka, la) < 0);
+    EC_CHECK(ECCollationCompare(kb, lb, ka, la) < 0);
+    EC_CHECK(ECCollationCompare(kb, lb, kd, ld) < 0);
+    EC_CHECK(ECCollationCompare(ka, la, ke, le) < 0);
+    EC_CHECK(0 == ECCollationCompare(ka, la, ka, la));
+
+    // The equal keys keep the order of their indexes
+    items[0].key = ka; items[0].length = (uint32_t)la; items[0].index = 0;
+    items[1].key = kc; items[1].length = (uint32_t)lc; items[1].index = 1;
+    items[2].key = ka; items[2].length = (uint32_t)la; items[2].index = 2;
+    items[3].key = kb; items[3].length = (uint32_t)lb; items[3].index = 3;
+
+    ECCollationSort(items, 4);
+
+    EC_CHECK(1 == items[0].index && 3 == items[1].index && 0 == items[2].index && 2 == items[3].index);
+}
+
+// The benchmark
+
+#ifdef EC_HARNESS_ICU
+
+static UCollator *gCollator;
+
+static int _compare_Names(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t*)a, y = *(const uint32_t*)b;
+    UCollationResult result = ucol_strcoll(gCollator, gNames[x].chars, (int32_t)gNames[x].length, gNames[y].chars, (int32_t)gNames[y].length);
+
+    if (UCOL_EQUAL != result)
+        return (UCOL_LESS == result) ? -1 : 1;
+
+    return (x < y) ? -1 : (x > y);
+}
+
+static int _compare_Characters(const void *a, const void *b)
+{
+    UCollationResult result = ucol_strcoll(gCollator, (const UChar*)a, 1, (const UChar*)b, 1);
+
+    return (UCOL_LESS == result) ? -1 : (UCOL_GREATER == result);
+}
+
+/**
+ * \brief	Rank the distinct characters of the names by the collator, as ECCollator does with NSLocale.
+ * \return	The count of the distinct characters.
+ */
+static size_t _rank_Characters(ECCollationTable *table)
+{
+    static uint8_t seen[65536 / 8];
+    static uint16_t characters[65536];
+    size_t count = 0, i, j;
+    uint16_t rank = 0;
+
+    memset(seen, 0, sizeof(seen));
+    ECCollationTableReset(table);
+
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        for (j = 0; j < gNames[i].length; j++)
+        {
+            uint16_t c = gNames[i].chars[j];
+
+            if (0 == (seen[c >> 3] & (1 << (c & 7))))
+            {
+                seen[c >> 3] |= (uint8_t)(1 << (c & 7));
+                characters[count++] = c;
+            }
+        }
+    }
+
+    qsort(characters, count, sizeof(uint16_t), _compare_Characters);
+
+    for (i = 0; i < count; i++)
+    {
+        if (0 == i || 0 != _compare_Characters(&characters[i - 1], &characters[i]))
+            rank++;
+
+        ECCollationTableSetRank(table, characters[i], rank);
+    }
+
+    return count;
+}
+
+static void _benchmark(const char *locale)
+{
+    static ECCollationTable table;
+    UErrorCode error = U_ZERO_ERROR;
+    uint32_t *order = (uint32_t*)malloc(NAME_COUNT * sizeof(uint32_t));
+    ECCollationItem *items = NULL;
+    uint8_t *buffer = NULL;
+    double fullTime = 1e9, rankTime = 1e9, keyTime = 1e9, sortTime = 1e9, start, time;
+    size_t distinct = 0, i, same = 0, misordered = 0;
+    int round;
+
+    gCollator = ucol_open(locale, &error);
+    EC_CHECK(U_SUCCESS(error));
+
+    if (U_FAILURE(error))
+        return;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        // A full collation per comparison, as sortedArrayUsingComparator: with compare:options:range:locale:
+        for (i = 0; i < NAME_COUNT; i++)
+            order[i] = (uint32_t)i;
+
+        start = ECHarnessNow();
+        qsort(order, NAME_COUNT, sizeof(uint32_t), _compare_Names);
+
+        if ((time = ECHarnessNow() - start) < fullTime)
+            fullTime = time;
+
+        // The characters ranked once, the keys, then memcmp only
+        start = ECHarnessNow();
+        distinct = _rank_Characters(&table);
+
+        if ((time = ECHarnessNow() - start) < rankTime)
+            rankTime = time;
+
+        free(items);
+        free(buffer);
+
+        start = ECHarnessNow();
+        items = _make_Items(&table, &buffer);
+
+        if ((time = ECHarnessNow() - start) < keyTime)
+            keyTime = time;
+
+        start = ECHarnessNow();
+        ECCollationSort(items, NAME_COUNT);
+
+        if ((time = ECHarnessNow() - start) < sortTime)
+            sortTime = time;
+    }
+
+    // The same name at each position as the full collation, the equal names may swap
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        const Name *x = &gNames[items[i].index], *y = &gNames[order[i]];
+
+        if (x->length == y->length && 0 == memcmp(x->chars, y->chars, x->length * sizeof(uint16_t)))
+            same++;
+
+        if (i > 0 && UCOL_GREATER == ucol_strcoll(gCollator, gNames[items[i - 1].index].chars, (int32_t)gNames[items[i - 1].index].length, x->chars, (int32_t)x->length))
+            misordered++;
+    }
+
+    EC_CHECK(0 == misordered);
+
+    printf("%s, %d names, %zu distinct characters, best of %d:\n", locale, NAME_COUNT, distinct, BENCH_ROUNDS);
+    printf("  full collation per comparison  %7.1f ms\n", fullTime * 1e3);
+    printf("  rank the characters            %7.1f ms\n", rankTime * 1e3);
+    printf("  build the keys                 %7.1f ms\n", keyTime * 1e3);
+    printf("  sort by the keys               %7.1f ms, %.1fx faster in total\n", sortTime * 1e3, fullTime / (rankTime + keyTime + sortTime));
+    printf("  %.2f%% at the same position as the full collation, %zu out of order\n", 100.0 * same / NAME_COUNT, misordered);
+
+    ucol_close(gCollator);
+    free(order);
+    free(items);
+    free(buffer);
+}
+
+#else
+
+static void _benchmark(const char *locale)
+{
+    static ECCollationTable table;
+    ECCollationItem *items;
+    uint8_t *buffer = NULL;
+    double keyTime = 1e9, sortTime = 1e9, start, time;
+    size_t i;
+    int round;
+
+    // No collator, the characters are ranked by their code points
+    ECCollationTableReset(&table);
+
+    for (i = 0; i < POOL_COUNT; i++)
+        ECCollationTableSetRank(&table, kPool[i], kPool[i] >> 4);
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        start = ECHarnessNow();
+        items = _make_Items(&table, &buffer);
+
+        if ((time = ECHarnessNow() - start) < keyTime)
+            keyTime = time;
+
+        start = ECHarnessNow();
+        ECCollationSort(items, NAME_COUNT);
+
+        if ((time = ECHarnessNow() - start) < sortTime)
+            sortTime = time;
+
+        for (i = 1; i < NAME_COUNT; i++)
+            EC_CHECK(ECCollationCompare(items[i - 1].key, items[i - 1].length, items[i].key, items[i].length) <= 0);
+
+        free(items);
+        free(buffer);
+    }
+
+    printf("%s not compared, ICU not found, %d names ranked by the code points, best of %d:\n", locale, NAME_COUNT, BENCH_ROUNDS);
+    printf("  build the keys                 %7.1f ms\n", keyTime * 1e3);
+    printf("  sort by the keys               %7.1f ms\n", sortTime * 1e3);
+}
+
+#endif
+
+int main(void)
+{
+    _test_Keys();
+    _make_Names(0x9E3779B97F4A7C15ULL);
+
+    _benchmark("zh_Hant_TW@collation=stroke");
+    _benchmark("zh_Hant_TW@collation=zhuyin");
+
+    free(gNames);
+
+    return EC_HARNESS_RESULT("ECCollationTest");
+}
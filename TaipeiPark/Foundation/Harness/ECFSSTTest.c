@@ -0,0 +1,352 @@
+/**
+ * \file 	ECFSSTTest.c
+ * \brief	The test of ECFSST, the round trip of random and real texts, the empty and the long strings and
+ *          the tables not made by the training, and the benchmark of the compression ratio and the decode
+ *          latency on the checked-in sample of introductions, ECIntroductionsSample.txt.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECFSST.h"
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_PATH         "ECIntroductionsSample.txt"
+#define MAX_TEXTS           1024
+#define FUZZ_ROUNDS         200
+#define FUZZ_STRINGS        64
+#define LONG_LENGTH         (1024 * 1024)
+#define BENCH_ROUNDS        5
+#define BENCH_PASSES        200
+
+typedef struct Texts
+{
+    char *bytes;
+    const char *strings[MAX_TEXTS];
+    size_t lengths[MAX_TEXTS];
+    size_t count;
+    size_t total;
+} Texts;
+
+static Texts gSample;
+
+/**
+ * \brief	Read the sample, one introduction per line.
+ */
+static int _load_Sample(const char *path, Texts *texts)
+{
+    FILE *file = fopen(path, "rb");
+    long size;
+    char *line;
+
+    if (NULL == file)
+        return -1;
+
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    texts->bytes = (char*)malloc((size_t)size + 1);
+
+    if (NULL == texts->bytes || (size_t)size != fread(texts->bytes, 1, (size_t)size, file))
+    {
+        fclose(file);
+        return -1;
+    }
+
+    fclose(file);
+    texts->bytes[size] = '\0';
+
+    for (line = texts->bytes; *line && texts->count < MAX_TEXTS; )
+    {
+        char *end = strchr(line, '\n');
+        size_t length = (NULL != end) ? (size_t)(end - line) : strlen(line);
+
+        if (length > 0)
+        {
+            texts->strings[texts->count] = line;
+            texts->lengths[texts->count] = length;
+            texts->total += length;
+            texts->count++;
+        }
+
+        line += length + ((NULL != end) ? 1 : 0);
+    }
+
+    return 0;
+}
+
+/**
+ * \brief	Compress and decompress the string, 0 if it comes back the same.
+ */
+static int _round_Trip(const ECFSSTTable *table, const char *string, size_t length)
+{
+    uint8_t *codes = (uint8_t*)malloc(ECFSSTCompressBound(length) + 1);
+    char *out = (char*)malloc(length + 1);
+    size_t codeLength, outLength;
+    int result;
+
+    codeLength = ECFSSTCompress(table, string, length, codes);
+    outLength = ECFSSTDecompress(table, codes, codeLength, out, length);
+    result = (codeLength <= ECFSSTCompressBound(length) && outLength == length && 0 == memcmp(out, string, length)) ? 0 : -1;
+
+    free(codes);
+    free(out);
+
+    return result;
+}
+
+// The tests
+
+/**
+ *  Random strings of any byte, the real texts, and their pieces, trained on and not.
+ */
+static void _test_Fuzz(void)
+{
+    static char pool[FUZZ_STRINGS][512];
+    const char *strings[FUZZ_STRINGS];
+    size_t lengths[FUZZ_STRINGS];
+    unsigned long long state = 0x2545F4914F6CDD1DULL;
+    ECFSSTTable *table = (ECFSSTTable*)malloc(sizeof(ECFSSTTable));
+    int round, failures = 0, checked = 0;
+    size_t i, k;
+
+    for (round = 0; round < FUZZ_ROUNDS; round++)
+    {
+        // Bytes of a small alphabet repeat, so the table has long symbols; a full alphabet has escapes
+        unsigned alphabet = (round & 1) ? 256 : 2 + (unsigned)(ECHarnessRandom(&state) % 16);
+
+        for (i = 0; i < FUZZ_STRINGS; i++)
+        {
+            lengths[i] = ECHarnessRandom(&state) % sizeof(pool[i]);
+
+            if (0 == round % 3 && gSample.count > 0)
+            {
+                // A piece of an introduction, cut anywhere, even inside a character
+                const Texts *texts = &gSample;
+                size_t text = ECHarnessRandom(&state) % texts->count;
+                size_t start = ECHarnessRandom(&state) % (texts->lengths[text] + 1);
+
+                lengths[i] = (lengths[i] < texts->lengths[text] - start) ? lengths[i] : texts->lengths[text] - start;
+                memcpy(pool[i], texts->strings[text] + start, lengths[i]);
+            }
+            else
+            {
+                for (k = 0; k < lengths[i]; k++)
+                    pool[i][k] = (char)(ECHarnessRandom(&state) % alphabet);
+            }
+
+            strings[i] = pool[i];
+        }
+
+        // Trained on half of the strings, all of them must come back
+        EC_CHECK(0 == ECFSSTTrain(table, strings, lengths, FUZZ_STRINGS / 2));
+        EC_CHECK(table->count <= ECFSST_MAX_SYMBOLS);
+
+        for (i = 0; i < FUZZ_STRINGS; i++, checked++)
+            failures += (0 == _round_Trip(table, strings[i], lengths[i])) ? 0 : 1;
+    }
+
+    EC_CHECK(0 == failures);
+
+    printf("fuzz: %d strings of 0 ~ %zu bytes, %d failed\n", checked, sizeof(pool[0]) - 1, failures);
+
+    free(table);
+}
+
+/**
+ *  The empty string, the table of no strings, and a long string in a small buffer.
+ */
+static void _test_Edges(void)
+{
+    ECFSSTTable *table = (ECFSSTTable*)malloc(sizeof(ECFSSTTable));
+    const char *empty[] = {"", ""};
+    size_t emptyLengths[] = {0, 0}, i, length;
+    char *longString = (char*)malloc(LONG_LENGTH), *out = (char*)malloc(LONG_LENGTH + 16);
+    uint8_t *codes = (uint8_t*)malloc(ECFSSTCompressBound(LONG_LENGTH));
+    uint8_t small[8];
+
+    // No strings, or only empty ones: no symbols, every byte is escaped
+    EC_CHECK(0 == ECFSSTTrain(table, NULL, NULL, 0) && 0 == table->count);
+    EC_CHECK(0 == ECFSSTTrain(table, empty, emptyLengths, 2) && 0 == table->count);
+    EC_CHECK(0 == ECFSSTCompress(table, "", 0, small));
+    EC_CHECK(0 == ECFSSTDecompress(table, small, 0, out, 0));
+    EC_CHECK(4 == ECFSSTCompress(table, "ab", 2, small) && 255 == small[0] && 'a' == small[1]);
+    EC_CHECK(0 == _round_Trip(table, "\0\xFF\x01", 3));
+
+    // A long string, the sample repeated, with the table of the sample
+    for (i = 0, length = 0; length < LONG_LENGTH && gSample.count > 0; i = (i + 1) % gSample.count)
+    {
+        size_t n = (gSample.lengths[i] < LONG_LENGTH - length) ? gSample.lengths[i] : LONG_LENGTH - length;
+
+        memcpy(longString + length, gSample.strings[i], n);
+        length += n;
+    }
+
+    EC_CHECK(0 == ECFSSTTrain(table, gSample.strings, gSample.lengths, gSample.count));
+    EC_CHECK(0 == _round_Trip(table, longString, length));
+
+    // Too small a buffer: the length is still returned, and nothing is written past the capacity
+    length = ECFSSTCompress(table, longString, 1000, codes);
+    memset(out, 0x5A, 1016);
+    EC_CHECK(1000 == ECFSSTDecompress(table, codes, length, out, 100));
+    EC_CHECK(0 == memcmp(out, longString, 100));
+
+    for (i = 100; i < 1016; i++)
+    {
+        if (0x5A != (uint8_t)out[i])
+            break;
+    }
+
+    EC_CHECK(1016 == i);
+
+    free(table);
+    free(longString);
+    free(out);
+    free(codes);
+}
+
+/**
+ *  The decoder stops at the codes it cannot decode, whatever the table holds.
+ */
+static void _test_Invalid_Tables(void)
+{
+    ECFSSTTable *table = (ECFSSTTable*)calloc(1, sizeof(ECFSSTTable));
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    uint8_t codes[64];
+    char out[256];
+    size_t i, k;
+
+    // A code out of the table, and an escape without its byte, end the string
+    table->count = 1;
+    table->lengths[0] = 2;
+    memcpy(&table->symbols[0], "ab", 2);
+
+    codes[0] = 0;
+    codes[1] = 1;
+    codes[2] = 0;
+    EC_CHECK(2 == ECFSSTDecompress(table, codes, 3, out, sizeof(out)) && 0 == memcmp(out, "ab", 2));
+
+    codes[1] = 255;
+    EC_CHECK(2 == ECFSSTDecompress(table, codes, 2, out, sizeof(out)));
+
+    // Symbols of no bytes, or longer than a word
+    table->lengths[0] = 0;
+    EC_CHECK(0 == ECFSSTDecompress(table, codes, 1, out, sizeof(out)));
+
+    table->lengths[0] = ECFSST_MAX_SYMBOL_LENGTH + 1;
+    EC_CHECK(0 == ECFSSTDecompress(table, codes, 1, out, sizeof(out)));
+
+    // Random tables and codes, run under the sanitizers to check nothing is read or written out of bounds
+    for (i = 0; i < 10000; i++)
+    {
+        size_t n, capacity = ECHarnessRandom(&state) % sizeof(out);
+
+        for (k = 0; k < sizeof(ECFSSTTable); k++)
+            ((uint8_t*)table)[k] = (uint8_t)ECHarnessRandom(&state);
+
+        for (k = 0; k < sizeof(codes); k++)
+            codes[k] = (uint8_t)ECHarnessRandom(&state);
+
+        n = ECFSSTDecompress(table, codes, sizeof(codes), out, capacity);
+
+        EC_CHECK(n <= sizeof(codes) * ECFSST_MAX_SYMBOL_LENGTH);
+    }
+
+    free(table);
+}
+
+// The benchmark
+
+static void _benchmark(void)
+{
+    ECFSSTTable *table = (ECFSSTTable*)malloc(sizeof(ECFSSTTable));
+    uint8_t *codes = (uint8_t*)malloc(ECFSSTCompressBound(gSample.total));
+    uint32_t offsets[MAX_TEXTS + 1];
+    size_t utf16Size = 0, stored, i, k, maxLength = 0;
+    double trainTime, decodeTime = 1e9, copyTime = 1e9, start, time;
+    char *out;
+    int round;
+    volatile size_t sink = 0;
+
+    if (0 == gSample.count)
+        return;
+
+    // The UTF-16 length, as the NSString of ECTextStore originalSize
+    for (i = 0; i < gSample.total; i++)
+    {
+        uint8_t byte = (uint8_t)gSample.bytes[i];
+
+        utf16Size += (0x80 == (byte & 0xC0)) ? 0 : ((byte >= 0xF0) ? 4 : 2);
+    }
+
+    start = ECHarnessNow();
+    ECFSSTTrain(table, gSample.strings, gSample.lengths, gSample.count);
+    trainTime = ECHarnessNow() - start;
+
+    offsets[0] = 0;
+
+    for (i = 0; i < gSample.count; i++)
+    {
+        offsets[i + 1] = offsets[i] + (uint32_t)ECFSSTCompress(table, gSample.strings[i], gSample.lengths[i], codes + offsets[i]);
+        maxLength = (gSample.lengths[i] > maxLength) ? gSample.lengths[i] : maxLength;
+    }
+
+    stored = offsets[gSample.count] + (gSample.count + 1) * sizeof(uint32_t);
+    out = (char*)malloc(maxLength);
+
+    // Each introduction alone, as string_At_Index: does, against a copy of the raw bytes
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        start = ECHarnessNow();
+
+        for (k = 0; k < BENCH_PASSES; k++)
+        {
+            for (i = 0; i < gSample.count; i++)
+                sink += ECFSSTDecompress(table, codes + offsets[i], offsets[i + 1] - offsets[i], out, gSample.lengths[i]);
+        }
+
+        if ((time = ECHarnessNow() - start) < decodeTime)
+            decodeTime = time;
+
+        start = ECHarnessNow();
+
+        for (k = 0; k < BENCH_PASSES; k++)
+        {
+            for (i = 0; i < gSample.count; i++)
+            {
+                memcpy(out, gSample.strings[i], gSample.lengths[i]);
+                sink += (size_t)out[0];
+            }
+        }
+
+        if ((time = ECHarnessNow() - start) < copyTime)
+            copyTime = time;
+    }
+
+    printf("%zu introductions, %zu bytes of UTF-8, %zu bytes as UTF-16, %u symbols trained in %.2f ms:\n", gSample.count, gSample.total, utf16Size, table->count, trainTime * 1e3);
+    printf("  codes            %6u bytes, %.1f%% of UTF-8\n", offsets[gSample.count], 100.0 * offsets[gSample.count] / gSample.total);
+    printf("  with the offsets %6zu bytes, %.1f%% of UTF-16\n", stored, 100.0 * stored / utf16Size);
+    printf("  the table        %6zu bytes, paid once per store\n", sizeof(ECFSSTTable));
+    printf("  decode           %6.0f ns per introduction, %.0f MB/s (memcpy %.0f ns)\n", decodeTime * 1e9 / (BENCH_PASSES * gSample.count), gSample.total * (double)BENCH_PASSES / decodeTime / 1e6, copyTime * 1e9 / (BENCH_PASSES * gSample.count));
+
+    free(table);
+    free(codes);
+    free(out);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = (argc > 1) ? argv[1] : SAMPLE_PATH;
+
+    EC_CHECK(0 == _load_Sample(path, &gSample) && gSample.count > 0);
+
+    _test_Fuzz();
+    _test_Edges();
+    _test_Invalid_Tables();
+    _benchmark();
+
+    free(gSample.bytes);
+
+    return EC_HARNESS_RESULT("ECFSSTTest");
+}
@@ -0,0 +1,53 @@
+/**
+ * \file 	ECHarness.h
+ * \brief	The checks and the timer shared by the standalone harnesses of the plain C modules.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECHarness_h
+#define ECHarness_h
+
+#include <stdio.h>
+#include <time.h>
+
+static int _harnessFailures = 0;
+
+/**
+ *  Check a condition, the failure is printed and counted, the harness goes on.
+ */
+#define EC_CHECK(condition) \
+    do { if (!(condition)) { _harnessFailures++; fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); } } while (0)
+
+/**
+ *  The exit code of the harness, 0 if all checks passed.
+ */
+#define EC_HARNESS_RESULT(name) \
+    ((0 == _harnessFailures) ? (printf("%s: all checks passed\n", name), 0) : (printf("%s: %d checks failed\n", name, _harnessFailures), 1))
+
+/**
+ * \brief	The monotonic time in seconds.
+ */
+static inline double ECHarnessNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * \brief	A deterministic random number, xorshift64.
+ */
+static inline unsigned long long ECHarnessRandom(unsigned long long *state)
+{
+    unsigned long long x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    return *state = x;
+}
+
+#endif /* ECHarness_h */
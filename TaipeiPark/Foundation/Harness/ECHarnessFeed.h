@@ -0,0 +1,131 @@
+/**
+ * \file 	ECHarnessFeed.h
+ * \brief	A generated feed in the shape of the park API response, shared by the JSON harnesses.
+ *          The records have the fields of the real feed, long Traditional Chinese introductions,
+ *          escapes, numbers and a few null members.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECHarnessFeed_h
+#define ECHarnessFeed_h
+
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct ECHarnessBuffer
+{
+    char *bytes;
+    size_t length;
+    size_t capacity;
+} ECHarnessBuffer;
+
+static const char *kHarnessWords[] =
+{
+    "\xE5\x85\xAC\xE5\x9C\x92",                                 // 公園
+    "\xE5\xA4\xA7\xE5\xAE\x89\xE6\xA3\xAE\xE6\x9E\x97",         // 大安森林
+    "\xE6\xAD\xA5\xE9\x81\x93",                                 // 步道
+    "\xE8\x8A\xB1\xE5\x9C\x92",                                 // 花園
+    "\xE5\x85\x92\xE7\xAB\xA5\xE9\x81\x8A\xE6\x88\xB2\xE5\x8D\x80", // 兒童遊戲區
+    "\xE6\xB1\xA0\xE5\xA1\x98",                                 // 池塘
+    "\xE6\xA8\xB9\xE6\x9C\xA8",                                 // 樹木
+    "\xE4\xBC\x91\xE6\x86\xA9\xE8\xA8\xAD\xE6\x96\xBD",         // 休憩設施
+    "\xE6\x99\xAF\xE8\xA7\x80",                                 // 景觀
+    "\xE8\x87\xBA\xE5\x8C\x97\xE5\xB8\x82",                     // 臺北市
+    "\xE9\x9F\xB3\xE6\xA8\x82\xE5\x8F\xB0",                     // 音樂台
+    "\xE8\x8D\xB7\xE8\x8A\xB1",                                 // 荷花
+};
+
+static const char *kHarnessPunctuations[] =
+{
+    "\xEF\xBC\x8C",                                             // ，
+    "\xE3\x80\x82",                                             // 。
+    "\xE3\x80\x81",                                             // 、
+    "\\n",
+    "\\\"",
+    " MRT ",
+};
+
+static inline void ECHarnessAppend(ECHarnessBuffer *buffer, const char *bytes, size_t length)
+{
+    if (buffer->length + length + 1 > buffer->capacity)
+    {
+        size_t capacity = (buffer->capacity > 0) ? buffer->capacity * 2 : 4096;
+
+        while (capacity < buffer->length + length + 1)
+            capacity *= 2;
+
+        buffer->bytes = (char*)realloc(buffer->bytes, capacity);
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->bytes + buffer->length, bytes, length);
+    buffer->length += length;
+    buffer->bytes[buffer->length] = '\0';
+}
+
+static inline void ECHarnessAppendString(ECHarnessBuffer *buffer, const char *string)
+{
+    ECHarnessAppend(buffer, string, strlen(string));
+}
+
+/**
+ * \brief	A Traditional Chinese paragraph of about the given count of words, with the escapes of the real introductions.
+ */
+static inline void ECHarnessAppendParagraph(ECHarnessBuffer *buffer, unsigned long long *state, size_t wordCount)
+{
+    size_t i;
+
+    for (i = 0; i < wordCount; i++)
+    {
+        ECHarnessAppendString(buffer, kHarnessWords[ECHarnessRandom(state) % (sizeof(kHarnessWords) / sizeof(kHarnessWords[0]))]);
+
+        if (0 == ECHarnessRandom(state) % 4)
+            ECHarnessAppendString(buffer, kHarnessPunctuations[ECHarnessRandom(state) % (sizeof(kHarnessPunctuations) / sizeof(kHarnessPunctuations[0]))]);
+    }
+}
+
+/**
+ * \brief	Generate the feed of the records, the caller frees the bytes.
+ * \param   introductionWords   The average count of words of the introductions, the real feed has about 60.
+ */
+static inline char* ECHarnessMakeFeed(size_t recordCount, size_t introductionWords, unsigned long long seed, size_t *length)
+{
+    ECHarnessBuffer buffer = {NULL, 0, 0};
+    unsigned long long state = seed;
+    char field[256];
+    size_t i;
+
+    snprintf(field, sizeof(field), "{\"result\":{\"limit\":%zu,\"offset\":0,\"count\":%zu,\"sort\":\"\",\"results\":[", recordCount, recordCount);
+    ECHarnessAppendString(&buffer, field);
+
+    for (i = 0; i < recordCount; i++)
+    {
+        if (i > 0)
+            ECHarnessAppendString(&buffer, ",");
+
+        snprintf(field, sizeof(field), "{\"_id\":%zu,\"ParkName\":\"", i + 1);
+        ECHarnessAppendString(&buffer, field);
+        ECHarnessAppendParagraph(&buffer, &state, 1 + ECHarnessRandom(&state) % 2);
+        ECHarnessAppendString(&buffer, "\",\"Name\":\"");
+        ECHarnessAppendParagraph(&buffer, &state, 1 + ECHarnessRandom(&state) % 3);
+
+        snprintf(field, sizeof(field), "\",\"YearBuilt\":%s,\"OpenTime\":%s,\"Image\":\"http://parks.taipei/parks/m2/pkl_%05zu.jpg\",\"Introduction\":\"",
+                 (0 == ECHarnessRandom(&state) % 3) ? "null" : "\"\xE6\xB0\x91\xE5\x9C\x8B" "72\xE5\xB9\xB4\"",
+                 (0 == ECHarnessRandom(&state) % 4) ? "null" : "\"24H\"", i);
+        ECHarnessAppendString(&buffer, field);
+        ECHarnessAppendParagraph(&buffer, &state, introductionWords / 2 + ECHarnessRandom(&state) % (introductionWords + 1));
+
+        snprintf(field, sizeof(field), "\",\"Latitude\":%.6f,\"Longitude\":%.6f,\"Opening\":%s,\"Facilities\":[\"WC\",null,\"Parking\"]}",
+                 25.0 + (ECHarnessRandom(&state) % 1000000) / 1e7, 121.5 + (ECHarnessRandom(&state) % 1000000) / 1e7,
+                 (ECHarnessRandom(&state) & 1) ? "true" : "false");
+        ECHarnessAppendString(&buffer, field);
+    }
+
+    ECHarnessAppendString(&buffer, "]}}");
+    *length = buffer.length;
+
+    return buffer.bytes;
+}
+
+#endif /* ECHarnessFeed_h */
@@ -0,0 +1,259 @@
+/**
+ * \file 	ECHarnessTree.h
+ * \brief	A model of the Foundation tree built by AFJSONTreeBuilder, the generic JSON path of the
+ *          harnesses: one allocation per container, string and number, and the shared null and
+ *          booleans, like kCFNull and kCFBooleanTrue. The allocations are counted.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#ifndef ECHarnessTree_h
+#define ECHarnessTree_h
+
+#include "ECJSONParser.h"
+#include "ECJSONStructuralIndex.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum ECValueType
+{
+    kValueNull = 0,
+    kValueFalse,
+    kValueTrue,
+    kValueNumber,
+    kValueString,
+    kValueArray,
+    kValueObject
+} ECValueType;
+
+typedef struct ECValue
+{
+    ECValueType type;
+    size_t count;
+    struct ECValue **items;         // The items of the array, the keys then the values of the object
+    char *bytes;
+    size_t length;
+    int isInteger;
+    int64_t integer;
+    double real;
+} ECValue;
+
+static ECValue kNull = {kValueNull, 0, NULL, NULL, 0, 0, 0, 0};
+static ECValue kFalse = {kValueFalse, 0, NULL, NULL, 0, 0, 0, 0};
+static ECValue kTrue = {kValueTrue, 0, NULL, NULL, 0, 0, 0, 0};
+
+static size_t ECHarnessAllocationCount = 0;
+static size_t ECHarnessAllocationBytes = 0;
+static size_t ECHarnessContainerCount = 0;
+
+static inline void* ECHarnessAllocate(size_t size)
+{
+    ECHarnessAllocationCount++;
+    ECHarnessAllocationBytes += size;
+
+    return malloc(size);
+}
+
+static inline ECValue* ECHarnessNewContainer(ECValueType type, size_t count)
+{
+    size_t slots = (kValueObject == type) ? count * 2 : count;
+    ECValue *value = (ECValue*)ECHarnessAllocate(sizeof(ECValue) + slots * sizeof(ECValue*));
+
+    ECHarnessContainerCount++;
+
+    memset(value, 0, sizeof(ECValue));
+    value->type = type;
+    value->count = count;
+    value->items = (ECValue**)(value + 1);
+
+    return value;
+}
+
+static inline void ECHarnessRelease(ECValue *value, int releasesChildren)
+{
+    size_t i;
+
+    if (kValueNull == value->type || kValueFalse == value->type || kValueTrue == value->type)
+        return;
+
+    if (releasesChildren && (kValueArray == value->type || kValueObject == value->type))
+    {
+        for (i = 0; i < ((kValueObject == value->type) ? value->count * 2 : value->count); i++)
+            ECHarnessRelease(value->items[i], 1);
+    }
+
+    free(value);
+}
+
+static inline int ECHarnessEqualValues(const ECValue *a, const ECValue *b)
+{
+    size_t i;
+
+    if (a->type != b->type || a->count != b->count)
+        return 0;
+
+    switch (a->type)
+    {
+        case kValueNumber:
+            return a->isInteger == b->isInteger && a->integer == b->integer && a->real == b->real;
+
+        case kValueString:
+            return a->length == b->length && 0 == memcmp(a->bytes, b->bytes, a->length);
+
+        case kValueArray:
+        case kValueObject:
+            for (i = 0; i < ((kValueObject == a->type) ? a->count * 2 : a->count); i++)
+            {
+                if (!ECHarnessEqualValues(a->items[i], b->items[i]))
+                    return 0;
+            }
+
+            return 1;
+
+        default:
+            return 1;
+    }
+}
+
+// The builder, the values of the open containers on one stack, like AFJSONTreeBuilder
+
+typedef struct ECTreeBuilder
+{
+    ECValue **values;
+    size_t count;
+    size_t capacity;
+    size_t frames[ECJSON_MAX_DEPTH];
+    int depth;
+} ECTreeBuilder;
+
+static inline int ECHarnessPush(ECTreeBuilder *builder, ECValue *value)
+{
+    if (builder->count == builder->capacity)
+    {
+        builder->capacity = (builder->capacity > 0) ? builder->capacity * 2 : 256;
+        builder->values = (ECValue**)realloc(builder->values, builder->capacity * sizeof(ECValue*));
+    }
+
+    builder->values[builder->count++] = value;
+
+    return 0;
+}
+
+static inline int ECHarnessBeginContainer(void *context)
+{
+    ECTreeBuilder *builder = (ECTreeBuilder*)context;
+
+    builder->frames[builder->depth++] = builder->count;
+
+    return 0;
+}
+
+static inline int ECHarnessEndContainer(ECTreeBuilder *builder, ECValueType type)
+{
+    size_t start = builder->frames[--builder->depth];
+    size_t slots = builder->count - start, i;
+    ECValue *container = ECHarnessNewContainer(type, (kValueObject == type) ? slots / 2 : slots);
+
+    if (kValueObject == type)
+    {
+        // The keys and the values are interleaved on the stack
+        for (i = 0; i < container->count; i++)
+        {
+            container->items[i] = builder->values[start + 2 * i];
+            container->items[container->count + i] = builder->values[start + 2 * i + 1];
+        }
+    }
+    else
+    {
+        memcpy(container->items, builder->values + start, slots * sizeof(ECValue*));
+    }
+
+    builder->count = start;
+
+    return ECHarnessPush(builder, container);
+}
+
+static inline int ECHarnessEndArray(void *context)
+{
+    return ECHarnessEndContainer((ECTreeBuilder*)context, kValueArray);
+}
+
+static inline int ECHarnessEndObject(void *context)
+{
+    return ECHarnessEndContainer((ECTreeBuilder*)context, kValueObject);
+}
+
+static inline int ECHarnessString(void *context, const char *bytes, size_t length)
+{
+    ECValue *value = (ECValue*)ECHarnessAllocate(sizeof(ECValue) + length);
+
+    memset(value, 0, sizeof(ECValue));
+    value->type = kValueString;
+    value->bytes = (char*)(value + 1);
+    value->length = length;
+    memcpy(value->bytes, bytes, length);
+
+    return ECHarnessPush((ECTreeBuilder*)context, value);
+}
+
+static inline int ECHarnessNumber(void *context, int isInteger, int64_t integer, double real)
+{
+    ECValue *value = (ECValue*)ECHarnessAllocate(sizeof(ECValue));
+
+    memset(value, 0, sizeof(ECValue));
+    value->type = kValueNumber;
+    value->isInteger = isInteger;
+    value->integer = integer;
+    value->real = isInteger ? (double)integer : real;
+
+    return ECHarnessPush((ECTreeBuilder*)context, value);
+}
+
+static inline int ECHarnessBoolean(void *context, int value)
+{
+    return ECHarnessPush((ECTreeBuilder*)context, value ? &kTrue : &kFalse);
+}
+
+static inline int ECHarnessNull(void *context)
+{
+    return ECHarnessPush((ECTreeBuilder*)context, &kNull);
+}
+
+static const ECJSONCallbacks kHarnessTreeCallbacks =
+{
+    ECHarnessBeginContainer, ECHarnessEndObject, ECHarnessBeginContainer, ECHarnessEndArray, ECHarnessString, ECHarnessString, ECHarnessNumber, ECHarnessBoolean, ECHarnessNull
+};
+
+/**
+ * \brief	Build the tree by ECJSONParse, or by ECJSONParseWithIndex if the index is not NULL. NULL on error.
+ */
+static inline ECValue* ECHarnessParseTreeWithIndex(const char *bytes, size_t length, const ECJSONStructuralIndex *index, unsigned int options, ECJSONParseStatus *status)
+{
+    ECTreeBuilder builder;
+    ECValue *root = NULL;
+
+    memset(&builder, 0, sizeof(builder));
+
+    if (NULL != index)
+        *status = ECJSONParseWithIndex(bytes, length, index, options, &kHarnessTreeCallbacks, &builder, NULL);
+    else
+        *status = ECJSONParse(bytes, length, options, &kHarnessTreeCallbacks, &builder, NULL);
+
+    if (ECJSONParseOK == *status && 1 == builder.count)
+        root = builder.values[0];
+    else
+    {
+        while (builder.count > 0)
+            ECHarnessRelease(builder.values[--builder.count], 1);
+    }
+
+    free(builder.values);
+
+    return root;
+}
+
+static inline ECValue* ECHarnessParseTree(const char *bytes, size_t length, unsigned int options, ECJSONParseStatus *status)
+{
+    return ECHarnessParseTreeWithIndex(bytes, length, NULL, options, status);
+}
+
+#endif /* ECHarnessTree_h */
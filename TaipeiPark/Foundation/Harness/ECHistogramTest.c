@@ -0,0 +1,173 @@
+/**
+ * \file 	ECHistogramTest.c
+ * \brief	The unit test and the benchmark of ECHistogram.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECHistogram.h"
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define SAMPLE_COUNT        100000
+#define BENCH_COUNT         10000000
+
+static int _compare_Int64(const void *a, const void *b)
+{
+    int64_t x = *(const int64_t*)a, y = *(const int64_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+static void _test_Init(void)
+{
+    ECHistogram h;
+
+    EC_CHECK(-1 == ECHistogramInit(&h, 0, 1000, 3));
+    EC_CHECK(-1 == ECHistogramInit(&h, 10, 15, 3));
+    EC_CHECK(-1 == ECHistogramInit(&h, 1, 1000, 0));
+    EC_CHECK(-1 == ECHistogramInit(&h, 1, 1000, 6));
+    EC_CHECK(-1 == ECHistogramInit(NULL, 1, 1000, 3));
+
+    EC_CHECK(0 == ECHistogramInit(&h, 1, 3600000000LL, 3));
+    EC_CHECK(0 == ECHistogramTotalCount(&h));
+    EC_CHECK(0 == ECHistogramMin(&h));
+    EC_CHECK(0 == ECHistogramValueAtPercentile(&h, 50));
+    EC_CHECK(0 < ECHistogramMemorySize(&h));
+
+    ECHistogramDestroy(&h);
+    EC_CHECK(0 == ECHistogramMemorySize(&h));
+    EC_CHECK(0 == ECHistogramRecordValue(&h, 1));
+}
+
+/**
+ *  The percentiles are within the precision of the exact ones, on log-uniform latencies of 1 us ~ 10 s.
+ */
+static void _test_Percentiles(void)
+{
+    static int64_t values[SAMPLE_COUNT];
+    static const double percentiles[] = {0, 1, 10, 50, 90, 99, 99.9, 100};
+    unsigned long long state = 88172645463325252ULL;
+    double maxError = 0, sum = 0;
+    ECHistogram h;
+    size_t i;
+
+    EC_CHECK(0 == ECHistogramInit(&h, 1, 3600000000LL, 3));
+
+    for (i = 0; i < SAMPLE_COUNT; i++)
+    {
+        values[i] = (int64_t)exp((ECHarnessRandom(&state) % 1000000) / 1000000.0 * log(1e7));
+        sum += values[i];
+        EC_CHECK(1 == ECHistogramRecordValue(&h, values[i]));
+    }
+
+    qsort(values, SAMPLE_COUNT, sizeof(int64_t), _compare_Int64);
+
+    EC_CHECK(SAMPLE_COUNT == ECHistogramTotalCount(&h));
+    EC_CHECK(values[0] == ECHistogramMin(&h));
+    EC_CHECK(values[SAMPLE_COUNT - 1] == ECHistogramMax(&h));
+    EC_CHECK(fabs(ECHistogramMean(&h) - sum / SAMPLE_COUNT) < 1e-6 * sum / SAMPLE_COUNT);
+
+    for (i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++)
+    {
+        size_t rank = (size_t)(percentiles[i] / 100.0 * SAMPLE_COUNT + 0.5);
+        int64_t exact = values[(0 == rank) ? 0 : rank - 1];
+        int64_t value = ECHistogramValueAtPercentile(&h, percentiles[i]);
+        double error = fabs((double)(value - exact)) / (double)exact;
+
+        if (error > maxError)
+            maxError = error;
+
+        EC_CHECK(error <= 1e-3);
+    }
+
+    printf("percentiles: max relative error %.5f of 0.001\n", maxError);
+
+    ECHistogramDestroy(&h);
+}
+
+static void _test_Saturation_And_Merge(void)
+{
+    ECHistogram a, b, c;
+    int64_t i;
+
+    EC_CHECK(0 == ECHistogramInit(&a, 1, 1000000, 3));
+    EC_CHECK(0 == ECHistogramInit(&b, 1, 1000000, 3));
+    EC_CHECK(0 == ECHistogramInit(&c, 1, 10000, 2));
+
+    // Negative values are ignored, the outliers are clamped
+    EC_CHECK(0 == ECHistogramRecordValue(&a, -5));
+    EC_CHECK(1 == ECHistogramRecordValue(&a, 5000000));
+    EC_CHECK(1 == a.saturatedCount);
+    EC_CHECK(1000000 == ECHistogramMax(&a));
+
+    for (i = 1; i <= 1000; i++)
+    {
+        ECHistogramRecordValue(&b, i);
+        ECHistogramRecordValue(&c, i);
+    }
+
+    // The same layout, then a different one
+    EC_CHECK(0 == ECHistogramAdd(&a, &b));
+    EC_CHECK(1001 == ECHistogramTotalCount(&a));
+    EC_CHECK(1 == ECHistogramMin(&a));
+    EC_CHECK(0 == ECHistogramAdd(&a, &c));
+    EC_CHECK(2001 == ECHistogramTotalCount(&a));
+    EC_CHECK(1 == a.saturatedCount);
+
+    ECHistogramReset(&a);
+    EC_CHECK(0 == ECHistogramTotalCount(&a));
+    EC_CHECK(0 == a.saturatedCount);
+    EC_CHECK(0 == ECHistogramMax(&a));
+
+    ECHistogramDestroy(&a);
+    ECHistogramDestroy(&b);
+    ECHistogramDestroy(&c);
+}
+
+static void _benchmark(void)
+{
+    int64_t *values = (int64_t*)malloc(BENCH_COUNT * sizeof(int64_t));
+    unsigned long long state = 2463534242ULL;
+    volatile int64_t sink = 0;
+    ECHistogram h;
+    double start, recordTime, queryTime;
+    int i;
+
+    if (NULL == values || 0 != ECHistogramInit(&h, 1, 3600000000LL, 3))
+        return;
+
+    for (i = 0; i < BENCH_COUNT; i++)
+        values[i] = (int64_t)(ECHarnessRandom(&state) % 10000000);
+
+    start = ECHarnessNow();
+
+    for (i = 0; i < BENCH_COUNT; i++)
+        ECHistogramRecordValue(&h, values[i]);
+
+    recordTime = ECHarnessNow() - start;
+    start = ECHarnessNow();
+
+    for (i = 0; i < 1000; i++)
+        sink += ECHistogramValueAtPercentile(&h, i / 10.0);
+
+    queryTime = ECHarnessNow() - start;
+
+    printf("record: %.1f ns per value, percentile: %.1f us per query, %zu KB of counts\n",
+           recordTime * 1e9 / BENCH_COUNT, queryTime * 1e6 / 1000, ECHistogramMemorySize(&h) / 1024);
+
+    ECHistogramDestroy(&h);
+    free(values);
+    (void)sink;
+}
+
+int main(void)
+{
+    _test_Init();
+    _test_Percentiles();
+    _test_Saturation_And_Merge();
+    _benchmark();
+
+    return EC_HARNESS_RESULT("ECHistogramTest");
+}
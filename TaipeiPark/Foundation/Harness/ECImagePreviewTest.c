@@ -0,0 +1,245 @@
+/**
+ * \file 	ECImagePreviewTest.c
+ * \brief	The test of ECImagePreview, the round trip of the flat colors and the gradients at every aspect
+ *          ratio the previews are drawn at, and the time to encode and decode a preview.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECImagePreview.h"
+#include "ECHarness.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENCODE_SIDE         32      // As ECImagePreviews.m
+#define PLACEHOLDER_SIDE    16
+#define FLAT_COUNT          20000
+#define BENCH_ITERATIONS    20000
+#define BENCH_ROUNDS        5
+
+/**
+ * \brief	The size of the bitmap of the long side in the aspect ratio, as _preview_Of_Image: does.
+ */
+static void _fit_Side(float aspect, size_t side, size_t *width, size_t *height)
+{
+    *width = (aspect >= 1) ? side : (size_t)fmaxf(1, lroundf(side * aspect));
+    *height = (aspect >= 1) ? (size_t)fmaxf(1, lroundf(side / aspect)) : side;
+}
+
+/**
+ * \brief	The max difference of the channels of the pixels.
+ * \param   step    1 to compare the pixels of a with the pixels of b, 0 to compare the first pixel of a with all of b.
+ */
+static int _max_Error(const uint8_t *a, const uint8_t *b, size_t count, size_t step)
+{
+    int maxError = 0;
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        const uint8_t *p = a + i * step * 4, *q = b + i * 4;
+        int error = abs((int)p[0] - q[0]);
+
+        error = (abs((int)p[1] - q[1]) > error) ? abs((int)p[1] - q[1]) : error;
+        error = (abs((int)p[2] - q[2]) > error) ? abs((int)p[2] - q[2]) : error;
+
+        if (error > maxError)
+            maxError = error;
+    }
+
+    return maxError;
+}
+
+// The tests
+
+/**
+ *  A flat color comes back as the same color, whatever the shape of the bitmap and the count of the components.
+ */
+static void _test_Flat_Colors(void)
+{
+    static uint8_t pixels[ECPREVIEW_MAX_SIDE * ECPREVIEW_MAX_SIDE * 4], decoded[ECPREVIEW_MAX_SIDE * ECPREVIEW_MAX_SIDE * 4];
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    uint8_t preview[256];
+    int i, maxError = 0, worst = 0, failures = 0;
+    size_t x;
+
+    for (i = 0; i < FLAT_COUNT; i++)
+    {
+        size_t width = 1 + ECHarnessRandom(&state) % ECPREVIEW_MAX_SIDE, height = 1 + ECHarnessRandom(&state) % ECPREVIEW_MAX_SIDE, length, outWidth, outHeight;
+        unsigned componentsX = 1 + (unsigned)(ECHarnessRandom(&state) % ECPREVIEW_MAX_COMPONENTS), componentsY = 1 + (unsigned)(ECHarnessRandom(&state) % ECPREVIEW_MAX_COMPONENTS);
+        float aspect = (float)width / height;
+        int error;
+
+        // Half of them in the shapes of the app, up to 40:1
+        if (i & 1)
+        {
+            aspect = exp2f((float)(ECHarnessRandom(&state) % 1000) / 1000.0f * 10.64f - 5.32f);
+            _fit_Side(aspect, ENCODE_SIDE, &width, &height);
+            componentsX = (aspect >= 1) ? 4 : 3;
+            componentsY = (aspect >= 1) ? 3 : 4;
+        }
+
+        for (x = 0; x < width * height; x++)
+        {
+            pixels[x * 4] = (uint8_t)(state >> 8);
+            pixels[x * 4 + 1] = (uint8_t)(state >> 16);
+            pixels[x * 4 + 2] = (uint8_t)(state >> 24);
+            pixels[x * 4 + 3] = 255;
+        }
+
+        length = ECImagePreviewEncode(pixels, width, height, width * 4, aspect, componentsX, componentsY, preview, sizeof(preview));
+
+        if (0 == length)
+        {
+            failures++;
+            continue;
+        }
+
+        // At the encoded size, and at the size of the placeholder
+        error = (0 == ECImagePreviewDecode(preview, length, decoded, width, height, width * 4)) ? _max_Error(pixels, decoded, width * height, 0) : 255;
+        _fit_Side(aspect, PLACEHOLDER_SIDE, &outWidth, &outHeight);
+
+        if (0 == ECImagePreviewDecode(preview, length, decoded, outWidth, outHeight, outWidth * 4))
+            error = (_max_Error(pixels, decoded, outWidth * outHeight, 0) > error) ? _max_Error(pixels, decoded, outWidth * outHeight, 0) : error;
+        else
+            error = 255;
+
+        if (error > maxError)
+        {
+            maxError = error;
+            worst = i;
+        }
+    }
+
+    EC_CHECK(0 == failures);
+    EC_CHECK(maxError <= 2);
+
+    printf("flat colors: %d bitmaps of 1 ~ %d pixels a side, max error %d/255 (bitmap %d)\n", FLAT_COUNT, ECPREVIEW_MAX_SIDE, maxError, worst);
+}
+
+/**
+ *  The components are clamped to the sides of the bitmap, e.g. a 13:1 image drawn at 32 x 2.
+ */
+static void _test_Clamp(void)
+{
+    uint8_t pixels[ENCODE_SIDE * 2 * 4], preview[256];
+    float aspect = 0;
+    size_t x, length;
+
+    for (x = 0; x < ENCODE_SIDE * 2; x++)
+    {
+        pixels[x * 4] = (uint8_t)(x * 8);
+        pixels[x * 4 + 1] = 90;
+        pixels[x * 4 + 2] = (uint8_t)(255 - x * 4);
+        pixels[x * 4 + 3] = 255;
+    }
+
+    length = ECImagePreviewEncode(pixels, ENCODE_SIDE, 2, ENCODE_SIDE * 4, 13, 4, 3, preview, sizeof(preview));
+
+    EC_CHECK(ECImagePreviewLength(4, 2) == length);
+    EC_CHECK(0x13 == preview[0]);
+    EC_CHECK(0 == ECImagePreviewInfo(preview, length, &aspect, NULL) && fabsf(aspect - 13) < 0.5f);
+
+    // A single pixel keeps its average color only
+    length = ECImagePreviewEncode(pixels, 1, 1, 4, 0, ECPREVIEW_MAX_COMPONENTS, ECPREVIEW_MAX_COMPONENTS, preview, sizeof(preview));
+
+    EC_CHECK(ECPREVIEW_HEADER_LENGTH == length && 0 == preview[0]);
+
+    // Too short for the components asked, long enough for the clamped ones
+    EC_CHECK(ECImagePreviewLength(1, 1) == ECImagePreviewEncode(pixels, 1, 1, 4, 0, 4, 3, preview, ECPREVIEW_HEADER_LENGTH));
+    EC_CHECK(0 == ECImagePreviewEncode(pixels, 2, 2, 8, 0, 4, 3, preview, ECPREVIEW_HEADER_LENGTH));
+}
+
+/**
+ *  A smooth image comes back close to itself, at every aspect ratio.
+ */
+static void _test_Gradients(void)
+{
+    static uint8_t pixels[ENCODE_SIDE * ENCODE_SIDE * 4], decoded[ENCODE_SIDE * ENCODE_SIDE * 4];
+    static const float aspects[] = {1.0f / 40, 1.0f / 13, 1.0f / 4, 0.75f, 1, 4.0f / 3, 4, 13, 20, 40};
+    uint8_t preview[256];
+    int maxError = 0;
+    size_t a, x, y, width, height, length;
+
+    for (a = 0; a < sizeof(aspects) / sizeof(aspects[0]); a++)
+    {
+        _fit_Side(aspects[a], ENCODE_SIDE, &width, &height);
+
+        for (y = 0; y < height; y++)
+        {
+            for (x = 0; x < width; x++)
+            {
+                uint8_t *pixel = pixels + (y * width + x) * 4;
+
+                pixel[0] = (uint8_t)(60 + 120 * x / width);
+                pixel[1] = (uint8_t)(200 - 100 * y / height);
+                pixel[2] = 140;
+                pixel[3] = 255;
+            }
+        }
+
+        length = ECImagePreviewEncode(pixels, width, height, width * 4, aspects[a], (aspects[a] >= 1) ? 4 : 3, (aspects[a] >= 1) ? 3 : 4, preview, sizeof(preview));
+
+        EC_CHECK(0 < length && 0 == ECImagePreviewDecode(preview, length, decoded, width, height, width * 4));
+
+        if (_max_Error(pixels, decoded, width * height, 1) > maxError)
+            maxError = _max_Error(pixels, decoded, width * height, 1);
+    }
+
+    EC_CHECK(maxError <= 16);
+
+    printf("gradients: %zu aspect ratios from 1:40 to 40:1, max error %d/255\n", sizeof(aspects) / sizeof(aspects[0]), maxError);
+}
+
+// The benchmark
+
+static void _benchmark(void)
+{
+    static uint8_t pixels[ENCODE_SIDE * ENCODE_SIDE * 4], placeholder[PLACEHOLDER_SIDE * PLACEHOLDER_SIDE * 4];
+    double encodeTime = 1e9, decodeTime = 1e9, start, time;
+    uint8_t preview[64];
+    size_t i, length = 0;
+    int round;
+
+    // The same sample as +[ECImagePreviews benchmark_Iterations:]
+    for (i = 0; i < ENCODE_SIDE * ENCODE_SIDE; i++)
+    {
+        pixels[i * 4] = (uint8_t)(i % ENCODE_SIDE * 8);
+        pixels[i * 4 + 1] = (uint8_t)(i / ENCODE_SIDE * 8);
+        pixels[i * 4 + 2] = 128;
+        pixels[i * 4 + 3] = 255;
+    }
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        start = ECHarnessNow();
+
+        for (i = 0; i < BENCH_ITERATIONS; i++)
+            length = ECImagePreviewEncode(pixels, ENCODE_SIDE, ENCODE_SIDE * 3 / 4, ENCODE_SIDE * 4, 0, 4, 3, preview, sizeof(preview));
+
+        if ((time = ECHarnessNow() - start) < encodeTime)
+            encodeTime = time;
+
+        start = ECHarnessNow();
+
+        for (i = 0; i < BENCH_ITERATIONS; i++)
+            ECImagePreviewDecode(preview, length, placeholder, PLACEHOLDER_SIDE, PLACEHOLDER_SIDE * 3 / 4, PLACEHOLDER_SIDE * 4);
+
+        if ((time = ECHarnessNow() - start) < decodeTime)
+            decodeTime = time;
+    }
+
+    printf("%zu bytes, best of %d x %d:\n", length, BENCH_ROUNDS, BENCH_ITERATIONS);
+    printf("  encode %dx%d, 4x3 components   %6.2f us\n", ENCODE_SIDE, ENCODE_SIDE * 3 / 4, encodeTime * 1e6 / BENCH_ITERATIONS);
+    printf("  decode %dx%d placeholder       %6.2f us\n", PLACEHOLDER_SIDE, PLACEHOLDER_SIDE * 3 / 4, decodeTime * 1e6 / BENCH_ITERATIONS);
+}
+
+int main(void)
+{
+    _test_Flat_Colors();
+    _test_Clamp();
+    _test_Gradients();
+    _benchmark();
+
+    return EC_HARNESS_RESULT("ECImagePreviewTest");
+}
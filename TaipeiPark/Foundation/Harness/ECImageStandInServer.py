@@ -0,0 +1,356 @@
+#!/usr/bin/env python3
+"""
+ECImageStandInServer.py
+
+A local stand-in for the image hosts of the open-data feed, with the oversized fixtures the
+AFImageDownloader limits are checked against. The fixtures are generated, so nothing large is
+checked in:
+
+  /                 200 text/html, the target of the HEAD preconnects
+  /small.png        200 image/png, a 1x1 image which must be downloaded
+  /oversized.jpg    200 image/jpeg, Content-Length of --size-mb, rejected from the response
+  /chunked.jpg      200 image/jpeg, chunked without a length, rejected once the limit is received
+  /page.jpg         200 text/html, rejected by the content type
+  POST /upload      reads the body, with a length or chunked, and answers the bytes received and the
+                    seconds taken as JSON, the target of the multipart upload benchmark
+  /stats            the requests and the bytes sent per path, as JSON
+  /reset            clears the stats
+
+Run it on the Mac and launch the DEBUG app in the simulator with the argument
+"-ECImageStandInServer http://127.0.0.1:8765", the image limit check of AFImageDownloader and the upload
+benchmark of AFHTTPSessionManager log their reports:
+
+  python3 ECImageStandInServer.py --port 8765
+
+  make -C TaipeiPark/Foundation/Harness standin
+
+checks the server itself, with a client which stops reading like a cancelled task.
+
+ - 2026/10/19    edmundchen    File created.
+"""
+
+import argparse
+import base64
+import http.client
+import http.server
+import json
+import sys
+import threading
+import time
+
+# A 1x1 transparent PNG
+SMALL_PNG = base64.b64decode(
+    "iVBORw0KGgoAAAANSUhEUgAAAAEAAAABCAYAAAAfFcSJAAAADUlEQVR42mNkYPhfDwAChwGA60e6kgAAAABJRU5ErkJggg==")
+
+CHUNK_SIZE = 64 * 1024
+
+# A JPEG start of image, the rest of the body is padding
+JPEG_CHUNK = b"\xff\xd8\xff\xe0" + bytes(CHUNK_SIZE - 4)
+PADDING_CHUNK = bytes(CHUNK_SIZE)
+
+
+class Stats:
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.paths = {}
+
+    def add(self, path, requests=0, sent=0, received=0):
+        with self.lock:
+            entry = self.paths.setdefault(path, {"requests": 0, "bytes": 0})
+            entry["requests"] += requests
+            entry["bytes"] += sent + received
+
+    def snapshot(self):
+        with self.lock:
+            return json.loads(json.dumps(self.paths))
+
+    def reset(self):
+        with self.lock:
+            self.paths.clear()
+
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def log_message(self, format, *args):
+        if self.server.verbose:
+            super().log_message(format, *args)
+
+    def do_HEAD(self):
+        self._respond(False)
+
+    def do_GET(self):
+        self._respond(True)
+
+    def do_POST(self):
+        path = self.path.split("?")[0]
+
+        if "/upload" != path:
+            # The body is not read, so the connection cannot be reused
+            self.close_connection = True
+            self._send_bytes("text/plain", b"Not Found", True, status=404)
+            return
+
+        self.server.stats.add(path, requests=1)
+        start = time.monotonic()
+        received = self._read_body()
+
+        body = json.dumps({"bytes": received, "seconds": time.monotonic() - start}).encode()
+        self._send_bytes("application/json", body, True)
+
+    def _read_body(self):
+        """Reads and drops the request body, returns its size."""
+        received = 0
+
+        if "chunked" == self.headers.get("Transfer-Encoding", "").lower():
+            while True:
+                size = int(self.rfile.readline().split(b";")[0], 16)
+
+                if 0 == size:
+                    # The trailers, up to the empty line
+                    while self.rfile.readline() not in (b"\r\n", b"\n", b""):
+                        pass
+                    break
+
+                received += self._drain(size)
+                self.rfile.readline()
+        else:
+            received = self._drain(int(self.headers.get("Content-Length", "0")))
+
+        self.server.stats.add("/upload", received=received)
+
+        return received
+
+    def _drain(self, size):
+        received = 0
+
+        while received < size:
+            chunk = self.rfile.read(min(CHUNK_SIZE, size - received))
+
+            if not chunk:
+                break
+
+            received += len(chunk)
+
+        return received
+
+    def _respond(self, sends_body):
+        path = self.path.split("?")[0]
+        stats = self.server.stats
+
+        if "/stats" == path or "/reset" == path:
+            if "/reset" == path:
+                stats.reset()
+
+            self._send_bytes("application/json", json.dumps(stats.snapshot()).encode(), sends_body)
+            return
+
+        stats.add(path, requests=1)
+
+        if "/" == path or "/page.jpg" == path:
+            self._send_bytes("text/html", b"<html><body>Taipei parks</body></html>", sends_body, path)
+        elif "/small.png" == path:
+            self._send_bytes("image/png", SMALL_PNG, sends_body, path)
+        elif "/oversized.jpg" == path:
+            self._send_stream(path, sends_body, chunked=False)
+        elif "/chunked.jpg" == path:
+            self._send_stream(path, sends_body, chunked=True)
+        else:
+            self._send_bytes("text/plain", b"Not Found", sends_body, status=404)
+
+    def _send_bytes(self, content_type, body, sends_body, path=None, status=200):
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+
+        if sends_body:
+            self.wfile.write(body)
+
+            if path is not None:
+                self.server.stats.add(path, sent=len(body))
+
+    def _send_stream(self, path, sends_body, chunked):
+        size = self.server.size
+
+        self.send_response(200)
+        self.send_header("Content-Type", "image/jpeg")
+
+        if chunked:
+            self.send_header("Transfer-Encoding", "chunked")
+        else:
+            self.send_header("Content-Length", str(size))
+
+        self.end_headers()
+
+        if not sends_body:
+            return
+
+        sent = 0
+
+        # Stops when the client closes the connection, e.g. the task is cancelled
+        try:
+            while sent < size:
+                chunk = JPEG_CHUNK if 0 == sent else PADDING_CHUNK
+                chunk = chunk[:size - sent]
+
+                if chunked:
+                    self.wfile.write(b"%x\r\n" % len(chunk) + chunk + b"\r\n")
+                else:
+                    self.wfile.write(chunk)
+
+                sent += len(chunk)
+                self.server.stats.add(path, sent=len(chunk))
+
+            if chunked:
+                self.wfile.write(b"0\r\n\r\n")
+        except (BrokenPipeError, ConnectionResetError):
+            self.close_connection = True
+
+
+def make_server(port, size, verbose):
+    server = http.server.ThreadingHTTPServer(("127.0.0.1", port), Handler)
+    server.daemon_threads = True
+    server.stats = Stats()
+    server.size = size
+    server.verbose = verbose
+
+    return server
+
+
+# The self test
+
+failures = 0
+
+
+def check(condition, message):
+    global failures
+
+    if not condition:
+        failures += 1
+        print("FAILED: %s" % message)
+
+
+def _wait_for_stats(server, path):
+    """The bytes sent of the path, once they stop growing."""
+    last = -1
+
+    for _ in range(100):
+        sent = server.stats.snapshot().get(path, {}).get("bytes", 0)
+
+        if sent == last:
+            return sent
+
+        last = sent
+        time.sleep(0.05)
+
+    return last
+
+
+def _read_and_close(port, path, limit):
+    """Read at most the limit of the body, then close the connection like a cancelled task."""
+    connection = http.client.HTTPConnection("127.0.0.1", port, timeout=10)
+    connection.request("GET", path)
+    response = connection.getresponse()
+    received = len(response.read(limit))
+    headers = dict(response.getheaders())
+    connection.sock.close()
+    connection.close()
+
+    return response.status, headers, received
+
+
+def self_test(size):
+    server = make_server(0, size, False)
+    port = server.server_address[1]
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+
+    # The image and the preconnect target
+    connection = http.client.HTTPConnection("127.0.0.1", port, timeout=10)
+    connection.request("GET", "/small.png")
+    response = connection.getresponse()
+    body = response.read()
+    check(200 == response.status and "image/png" == response.getheader("Content-Type") and SMALL_PNG == body, "/small.png")
+
+    connection.request("HEAD", "/")
+    response = connection.getresponse()
+    response.read()
+    check(200 == response.status and "text/html" == response.getheader("Content-Type"), "HEAD /")
+
+    connection.request("GET", "/page.jpg")
+    response = connection.getresponse()
+    response.read()
+    check("text/html" == response.getheader("Content-Type"), "/page.jpg is not an image")
+    connection.close()
+
+    # The oversized fixtures stop once the client stops reading
+    limit = 1024 * 1024
+
+    for path, chunked in (("/oversized.jpg", False), ("/chunked.jpg", True)):
+        status, headers, received = _read_and_close(port, path, limit)
+        sent = _wait_for_stats(server, path)
+
+        check(200 == status and "image/jpeg" == headers.get("Content-Type"), path)
+        check(chunked == ("Content-Length" not in headers), "%s length header" % path)
+        check(str(size) == headers.get("Content-Length", str(size)), "%s Content-Length" % path)
+        check(limit == received, "%s received %d bytes" % (path, received))
+        check(sent < size, "%s sent %d of %d bytes after the client closed" % (path, sent, size))
+
+        print("%-15s %s, %.1f of %.1f MB sent after the client closed at %.1f MB" % (path, "chunked" if chunked else "with a length", sent / 1048576.0, size / 1048576.0, limit / 1048576.0))
+
+    # The upload target counts the whole body, with a length and chunked
+    upload = 8 * 1024 * 1024
+
+    for chunked in (False, True):
+        connection = http.client.HTTPConnection("127.0.0.1", port, timeout=10)
+        start = time.monotonic()
+
+        if chunked:
+            connection.request("POST", "/upload", body=(PADDING_CHUNK for _ in range(upload // CHUNK_SIZE)), encode_chunked=True)
+        else:
+            connection.request("POST", "/upload", body=bytes(upload))
+
+        response = connection.getresponse()
+        result = json.loads(response.read())
+        seconds = time.monotonic() - start
+        connection.close()
+
+        check(200 == response.status and upload == result.get("bytes"), "/upload %s received %s bytes" % ("chunked" if chunked else "with a length", result.get("bytes")))
+        print("/upload         %s, %.1f MB received in %.3f s" % ("chunked" if chunked else "with a length", upload / 1048576.0, seconds))
+
+    check(2 * upload == server.stats.snapshot().get("/upload", {}).get("bytes"), "/upload stats")
+
+    server.shutdown()
+    server.server_close()
+
+    print("ECImageStandInServer: %s" % ("FAILED" if failures else "OK"))
+
+    return 1 if failures else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="A local stand-in for the image hosts, with oversized fixtures.")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--size-mb", type=int, default=64, help="the size of the oversized fixtures, above maximumImageContentLength")
+    parser.add_argument("--self-test", action="store_true", help="check the server with a client which stops reading, then exit")
+    parser.add_argument("--verbose", action="store_true")
+    arguments = parser.parse_args()
+    size = arguments.size_mb * 1024 * 1024
+
+    if arguments.self_test:
+        return self_test(size)
+
+    server = make_server(arguments.port, size, arguments.verbose)
+    print("Serving the stand-in image host on http://127.0.0.1:%d" % arguments.port)
+
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
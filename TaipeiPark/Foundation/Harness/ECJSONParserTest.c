@@ -0,0 +1,192 @@
+/**
+ * \file 	ECJSONParserTest.c
+ * \brief	The test of ECJSONParser, and the benchmark of the null members dropped while parsing
+ *          against the tree cleaned up after parsing.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECJSONParser.h"
+#include "ECHarnessFeed.h"
+#include "ECHarnessTree.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FEED_RECORDS        5000
+#define BENCH_ROUNDS        10
+
+/**
+ *  AFJSONObjectByRemovingKeysWithNullValues: the array copied into a mutable array then into an
+ *  immutable one, the dictionary copied by dictionaryWithDictionary:, the null keys removed, then
+ *  copied again. The leaves are shared, the former containers are released.
+ */
+static ECValue* _remove_Null_Members(ECValue *value)
+{
+    ECValue *mutableCopy, *copy;
+    size_t i, n = 0;
+
+    if (kValueArray == value->type)
+    {
+        mutableCopy = ECHarnessNewContainer(kValueArray, value->count);
+
+        for (i = 0; i < value->count; i++)
+            mutableCopy->items[i] = _remove_Null_Members(value->items[i]);
+
+        copy = ECHarnessNewContainer(kValueArray, value->count);
+        memcpy(copy->items, mutableCopy->items, value->count * sizeof(ECValue*));
+    }
+    else if (kValueObject == value->type)
+    {
+        mutableCopy = ECHarnessNewContainer(kValueObject, value->count);
+
+        for (i = 0; i < value->count; i++)
+        {
+            if (kValueNull == value->items[value->count + i]->type)
+                continue;
+
+            mutableCopy->items[n] = value->items[i];
+            mutableCopy->items[value->count + n++] = _remove_Null_Members(value->items[value->count + i]);
+        }
+
+        copy = ECHarnessNewContainer(kValueObject, n);
+
+        for (i = 0; i < n; i++)
+        {
+            copy->items[i] = mutableCopy->items[i];
+            copy->items[n + i] = mutableCopy->items[value->count + i];
+        }
+    }
+    else
+    {
+        return value;
+    }
+
+    free(mutableCopy);
+    free(value);
+
+    return copy;
+}
+
+// The tests
+
+static int _parses(const char *text, unsigned int options, ECJSONParseStatus expected)
+{
+    ECJSONParseStatus status;
+    ECValue *root = ECHarnessParseTree(text, strlen(text), options, &status);
+
+    if (NULL != root)
+        ECHarnessRelease(root, 1);
+
+    return status == expected;
+}
+
+static void _test_Vectors(void)
+{
+    ECJSONParseStatus status;
+    ECValue *root;
+    const char *text = "{\"a\":null,\"b\":[null,1,\"x\\u00e9\\n\"],\"c\":{\"d\":null},\"e\":-2.5e3}";
+
+    EC_CHECK(_parses("{}", 0, ECJSONParseOK));
+    EC_CHECK(_parses("[1, 2.5, -0, 1e10, true, false, null, \"\\ud83c\\udf33\"]", 0, ECJSONParseOK));
+    EC_CHECK(_parses("42", 0, ECJSONParseErrorFragment));
+    EC_CHECK(_parses("42", ECJSONParseAllowFragments, ECJSONParseOK));
+    EC_CHECK(_parses("{\"a\":1,}", 0, ECJSONParseErrorSyntax));
+    EC_CHECK(_parses("[01]", 0, ECJSONParseErrorSyntax));
+    EC_CHECK(_parses("[\"\x01\"]", 0, ECJSONParseErrorInvalidString));
+    EC_CHECK(_parses("[\"\\x\"]", 0, ECJSONParseErrorInvalidString));
+    EC_CHECK(_parses("[1] x", 0, ECJSONParseErrorSyntax));
+
+    // The null members are dropped, the nulls of the arrays are kept, as AFJSONObjectByRemovingKeysWithNullValues
+    root = ECHarnessParseTree(text, strlen(text), ECJSONParseSkipNullMembers, &status);
+    EC_CHECK(ECJSONParseOK == status && NULL != root);
+
+    if (NULL != root)
+    {
+        EC_CHECK(3 == root->count);
+        EC_CHECK(kValueArray == root->items[3]->type && 3 == root->items[3]->count && kValueNull == root->items[3]->items[0]->type);
+        EC_CHECK(kValueObject == root->items[4]->type && 0 == root->items[4]->count);
+        EC_CHECK(kValueString == root->items[3]->items[2]->type && 4 == root->items[3]->items[2]->length);
+        EC_CHECK(-2500.0 == root->items[5]->real);
+        ECHarnessRelease(root, 1);
+    }
+}
+
+/**
+ *  The feed parsed with the null members dropped equals the feed cleaned up after parsing.
+ */
+static void _test_Feed(const char *feed, size_t length)
+{
+    ECJSONParseStatus status, strippedStatus;
+    ECValue *fused = ECHarnessParseTree(feed, length, ECJSONParseSkipNullMembers, &status);
+    ECValue *stripped = ECHarnessParseTree(feed, length, 0, &strippedStatus);
+
+    EC_CHECK(ECJSONParseOK == status && ECJSONParseOK == strippedStatus);
+
+    if (NULL != fused && NULL != stripped)
+    {
+        stripped = _remove_Null_Members(stripped);
+        EC_CHECK(ECHarnessEqualValues(fused, stripped));
+    }
+
+    if (NULL != fused)
+        ECHarnessRelease(fused, 1);
+
+    if (NULL != stripped)
+        ECHarnessRelease(stripped, 1);
+}
+
+static double _run(const char *feed, size_t length, int fused, size_t *count, size_t *containers, size_t *bytes)
+{
+    ECJSONParseStatus status;
+    double start;
+
+    ECHarnessAllocationCount = ECHarnessAllocationBytes = ECHarnessContainerCount = 0;
+    start = ECHarnessNow();
+
+    if (fused)
+        ECHarnessRelease(ECHarnessParseTree(feed, length, ECJSONParseSkipNullMembers, &status), 1);
+    else
+        ECHarnessRelease(_remove_Null_Members(ECHarnessParseTree(feed, length, 0, &status)), 1);
+
+    *count = ECHarnessAllocationCount;
+    *containers = ECHarnessContainerCount;
+    *bytes = ECHarnessAllocationBytes;
+
+    return ECHarnessNow() - start;
+}
+
+/**
+ *  The rounds alternate and the best time of each way is kept, as the heap left by one way slows down the other.
+ */
+static void _benchmark(const char *feed, size_t length)
+{
+    size_t formerCount, formerContainers, formerBytes, fusedCount, fusedContainers, fusedBytes;
+    double formerTime = 1e9, fusedTime = 1e9, time;
+    int round;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        if ((time = _run(feed, length, 0, &formerCount, &formerContainers, &formerBytes)) < formerTime)
+            formerTime = time;
+
+        if ((time = _run(feed, length, 1, &fusedCount, &fusedContainers, &fusedBytes)) < fusedTime)
+            fusedTime = time;
+    }
+
+    printf("feed of %d records, %zu KB:\n", FEED_RECORDS, length / 1024);
+    printf("  parse then remove nulls: %zu allocations (%zu containers), %zu KB, %.2f ms\n", formerCount, formerContainers, formerBytes / 1024, formerTime * 1e3);
+    printf("  nulls dropped in parse:  %zu allocations (%zu containers), %zu KB, %.2f ms\n", fusedCount, fusedContainers, fusedBytes / 1024, fusedTime * 1e3);
+}
+
+int main(void)
+{
+    size_t length = 0;
+    char *feed = ECHarnessMakeFeed(FEED_RECORDS, 60, 0x2545F4914F6CDD1DULL, &length);
+
+    _test_Vectors();
+    _test_Feed(feed, length);
+    _benchmark(feed, length);
+
+    free(feed);
+
+    return EC_HARNESS_RESULT("ECJSONParserTest");
+}
@@ -0,0 +1,242 @@
+/**
+ * \file 	ECJSONStructuralIndexTest.c
+ * \brief	The test of ECJSONStructuralIndex, each kernel against the scalar one and the tree walked
+ *          from the index against ECJSONParse, and the benchmark of the kernels on feeds up to 256 MB.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECJSONStructuralIndex.h"
+#include "ECHarnessFeed.h"
+#include "ECHarnessTree.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_COUNT          400
+
+static const ECJSONKernel kKernels[] = {ECJSONKernelScalar, ECJSONKernelSSE2, ECJSONKernelAVX2, ECJSONKernelNEON};
+
+#define KERNEL_COUNT        (sizeof(kKernels) / sizeof(kKernels[0]))
+
+static int _equal_Indexes(const ECJSONStructuralIndex *a, const ECJSONStructuralIndex *b)
+{
+    return a->count == b->count && 0 == memcmp(a->positions, b->positions, a->count * sizeof(uint32_t));
+}
+
+/**
+ * \brief	An array of strings made of backslash runs, escaped quotes and CJK characters, so the escapes
+ *          and the quotes fall on every offset of the 64 byte blocks.
+ */
+static char* _escape_Document(unsigned long long *state, size_t *length)
+{
+    static const char *pieces[] = {"a", "\\\\", "\\\"", "\\\\\\\"", "\xE5\x85\xAC", "\\n", "\\u00e9", ":", ",", "{", "]", " "};
+    ECHarnessBuffer buffer = {NULL, 0, 0};
+    size_t strings = 1 + ECHarnessRandom(state) % 40, i, j;
+
+    ECHarnessAppendString(&buffer, "[");
+
+    for (i = 0; i < strings; i++)
+    {
+        size_t count = ECHarnessRandom(state) % 48;
+
+        ECHarnessAppendString(&buffer, (i > 0) ? ",\"" : "\"");
+
+        for (j = 0; j < count; j++)
+            ECHarnessAppendString(&buffer, pieces[ECHarnessRandom(state) % (sizeof(pieces) / sizeof(pieces[0]))]);
+
+        ECHarnessAppendString(&buffer, "\"");
+
+        if (0 == ECHarnessRandom(state) % 3)
+            ECHarnessAppendString(&buffer, ",{\"k\":[1,-2.5e3,true,null]}");
+    }
+
+    ECHarnessAppendString(&buffer, "]");
+    *length = buffer.length;
+
+    return buffer.bytes;
+}
+
+/**
+ *  Each supported kernel gives the same index and the same error as the scalar one, and the walk of the
+ *  index gives the same tree or the same error as ECJSONParse.
+ */
+static void _check_Document(const char *text, size_t length, ECJSONStructuralIndex *indexes, int *mismatches)
+{
+    ECJSONParseStatus status[KERNEL_COUNT], treeStatus, indexedStatus;
+    size_t offsets[KERNEL_COUNT], k;
+    ECValue *tree, *indexedTree;
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+    {
+        if (!ECJSONKernelIsSupported(kKernels[k]))
+            continue;
+
+        offsets[k] = 0;
+        status[k] = ECJSONStructuralIndexBuild(&indexes[k], text, length, kKernels[k], &offsets[k]);
+
+        if (indexes[k].kernel != kKernels[k] || status[k] != status[0] ||
+            (ECJSONParseOK == status[0] ? !_equal_Indexes(&indexes[k], &indexes[0]) : offsets[k] != offsets[0]))
+            (*mismatches)++;
+    }
+
+    if (ECJSONParseOK != status[0])
+        return;
+
+    tree = ECHarnessParseTree(text, length, 0, &treeStatus);
+    indexedTree = ECHarnessParseTreeWithIndex(text, length, &indexes[0], 0, &indexedStatus);
+
+    // A corrupted document may still be valid UTF-8, then both stages reject the syntax
+    if (treeStatus != indexedStatus || (NULL != tree && (NULL == indexedTree || !ECHarnessEqualValues(tree, indexedTree))))
+        (*mismatches)++;
+
+    if (NULL != tree)
+        ECHarnessRelease(tree, 1);
+
+    if (NULL != indexedTree)
+        ECHarnessRelease(indexedTree, 1);
+}
+
+static void _test_Kernels(void)
+{
+    ECJSONStructuralIndex indexes[KERNEL_COUNT];
+    unsigned long long state = 0xD1B54A32D192ED03ULL;
+    int i, mismatches = 0, invalidAccepted = 0;
+    size_t k;
+
+    memset(indexes, 0, sizeof(indexes));
+
+    for (i = 0; i < FUZZ_COUNT; i++)
+    {
+        size_t length = 0;
+        char *text = (i & 1) ? _escape_Document(&state, &length) : ECHarnessMakeFeed(1 + ECHarnessRandom(&state) % 20, 30, ECHarnessRandom(&state), &length);
+        size_t at = ECHarnessRandom(&state) % length;
+        char saved = text[at];
+
+        _check_Document(text, length, indexes, &mismatches);
+
+        // A stray continuation byte, a truncated sequence or a control character somewhere
+        text[at] = (0 == i % 3) ? (char)0x80 : ((1 == i % 3) ? (char)0xE5 : '\x01');
+        _check_Document(text, length, indexes, &mismatches);
+
+        // Unless it replaced another continuation byte
+        if (0x80 == (uint8_t)text[at] && 0x80 != ((uint8_t)saved & 0xC0) && ECJSONParseOK == ECJSONStructuralIndexBuild(&indexes[0], text, length, ECJSONKernelScalar, NULL))
+            invalidAccepted++;
+
+        text[at] = saved;
+        free(text);
+    }
+
+    EC_CHECK(0 == mismatches);
+    EC_CHECK(0 == invalidAccepted);
+
+    printf("kernels:");
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+        printf(" %s%s", ECJSONKernelName(kKernels[k]), ECJSONKernelIsSupported(kKernels[k]) ? "" : " (not supported)");
+
+    printf(", best %s\n", ECJSONKernelName(ECJSONBestKernel()));
+    printf("fuzz: %d documents and their corrupted copies, %d mismatches\n", FUZZ_COUNT, mismatches);
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+        ECJSONStructuralIndexDestroy(&indexes[k]);
+}
+
+// The benchmark
+
+static int _ignore_Event(void *context)
+{
+    (void)context;
+    return 0;
+}
+
+static int _ignore_Bytes(void *context, const char *bytes, size_t length)
+{
+    (void)context; (void)bytes; (void)length;
+    return 0;
+}
+
+static int _ignore_Number(void *context, int isInteger, int64_t integer, double real)
+{
+    (void)context; (void)isInteger; (void)integer; (void)real;
+    return 0;
+}
+
+static int _ignore_Boolean(void *context, int value)
+{
+    (void)context; (void)value;
+    return 0;
+}
+
+static const ECJSONCallbacks kIgnoreCallbacks =
+{
+    _ignore_Event, _ignore_Event, _ignore_Event, _ignore_Event, _ignore_Bytes, _ignore_Bytes, _ignore_Number, _ignore_Boolean, _ignore_Event
+};
+
+static void _benchmark(size_t records, int rounds)
+{
+    ECJSONStructuralIndex index;
+    size_t length = 0, k;
+    char *feed = ECHarnessMakeFeed(records, 60, 0x2545F4914F6CDD1DULL, &length);
+    double scalarTime = 0, parseTime = 1e9, walkTime = 1e9, start, time;
+    int round;
+
+    memset(&index, 0, sizeof(index));
+    printf("feed of %zu records, %.1f MB, best of %d:\n", records, length / 1048576.0, rounds);
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+    {
+        double best = 1e9;
+
+        if (!ECJSONKernelIsSupported(kKernels[k]))
+            continue;
+
+        for (round = 0; round < rounds; round++)
+        {
+            start = ECHarnessNow();
+            EC_CHECK(ECJSONParseOK == ECJSONStructuralIndexBuild(&index, feed, length, kKernels[k], NULL));
+
+            if ((time = ECHarnessNow() - start) < best)
+                best = time;
+        }
+
+        if (ECJSONKernelScalar == kKernels[k])
+            scalarTime = best;
+
+        printf("  index %-12s %8.1f ms %6.0f MB/s, %.2fx the scalar one\n", ECJSONKernelName(kKernels[k]), best * 1e3, length / best / 1e6, scalarTime / best);
+    }
+
+    // The second stage on the index of the best kernel, against the one pass parser, both without building values
+    EC_CHECK(ECJSONParseOK == ECJSONStructuralIndexBuild(&index, feed, length, ECJSONKernelAuto, NULL));
+
+    for (round = 0; round < rounds; round++)
+    {
+        start = ECHarnessNow();
+        EC_CHECK(ECJSONParseOK == ECJSONParse(feed, length, 0, &kIgnoreCallbacks, NULL, NULL));
+
+        if ((time = ECHarnessNow() - start) < parseTime)
+            parseTime = time;
+
+        start = ECHarnessNow();
+        EC_CHECK(ECJSONParseOK == ECJSONParseWithIndex(feed, length, &index, 0, &kIgnoreCallbacks, NULL, NULL));
+
+        if ((time = ECHarnessNow() - start) < walkTime)
+            walkTime = time;
+    }
+
+    printf("  one pass parse     %8.1f ms %6.0f MB/s\n", parseTime * 1e3, length / parseTime / 1e6);
+    printf("  walk of the index  %8.1f ms %6.0f MB/s, %zu structurals, %zu MB of index\n", walkTime * 1e3, length / walkTime / 1e6, index.count, index.capacity * sizeof(uint32_t) / 1048576);
+
+    ECJSONStructuralIndexDestroy(&index);
+    free(feed);
+}
+
+int main(void)
+{
+    _test_Kernels();
+
+    // About 1, 16 and 256 MB
+    _benchmark(1250, 20);
+    _benchmark(20000, 5);
+    _benchmark(320000, 2);
+
+    return EC_HARNESS_RESULT("ECJSONStructuralIndexTest");
+}
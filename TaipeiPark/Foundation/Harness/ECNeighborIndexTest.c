@@ -0,0 +1,305 @@
+/**
+ * \file 	ECNeighborIndexTest.c
+ * \brief	The test of ECNeighborIndex, the neighbors after the incremental updates against a full rebuild
+ *          under the same IDF and against a scalar scan, the kernels against each other, and the benchmark
+ *          of the full build and the incremental update.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECNeighborIndex.h"
+#include "ECHarness.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NEIGHBOR_COUNT      12          // maxCount of ECRelatedAttractions
+#define GROUP_WEIGHT        0.2f        // parkWeight of ECRelatedAttractions
+#define DOCUMENT_COUNT      600
+#define GROUP_COUNT         60
+#define VOCABULARY          400         // The terms used, hashed to the dimension
+#define ROUNDS              12
+#define SCORE_EPSILON       1e-5f
+#define BENCH_DOCUMENTS     2000
+#define BENCH_CHANGES       20
+
+typedef struct Corpus
+{
+    uint8_t *terms;                     // ECNEIGHBOR_DIMENSION per identifier
+    uint32_t *groups;
+    uint8_t *alive;
+    size_t capacity;
+} Corpus;
+
+/**
+ * \brief	The terms of a document, a Zipf-like draw from the vocabulary so a few terms are common.
+ */
+static void _random_Terms(unsigned long long *state, uint8_t *terms)
+{
+    size_t count = 5 + ECHarnessRandom(state) % 60, i;
+
+    memset(terms, 0, ECNEIGHBOR_DIMENSION);
+
+    for (i = 0; i < count; i++)
+    {
+        double u = (double)(ECHarnessRandom(state) % 1000000) / 1000000.0;
+        size_t term = (size_t)(VOCABULARY * u * u * u) * 2654435761u % ECNEIGHBOR_DIMENSION;
+
+        if (terms[term] < 255)
+            terms[term]++;
+    }
+}
+
+static void _set_Document(ECNeighborIndex *index, Corpus *corpus, uint32_t identifier, unsigned long long *state)
+{
+    uint8_t *terms = corpus->terms + (size_t)identifier * ECNEIGHBOR_DIMENSION;
+
+    _random_Terms(state, terms);
+    corpus->groups[identifier] = (uint32_t)(ECHarnessRandom(state) % GROUP_COUNT);
+    corpus->alive[identifier] = 1;
+
+    EC_CHECK(0 == ECNeighborIndexSet(index, identifier, terms, corpus->groups[identifier]));
+}
+
+/**
+ * \brief	A new index of the alive documents of the corpus, built at once with the IDF of the other index.
+ */
+static void _rebuild(const ECNeighborIndex *incremental, const Corpus *corpus, ECNeighborIndex *full, ECNeighborKernel kernel)
+{
+    uint32_t i;
+
+    ECNeighborIndexInit(full, NEIGHBOR_COUNT, GROUP_WEIGHT, kernel);
+
+    for (i = 0; i < corpus->capacity; i++)
+    {
+        if (corpus->alive[i])
+            ECNeighborIndexSet(full, i, corpus->terms + (size_t)i * ECNEIGHBOR_DIMENSION, corpus->groups[i]);
+    }
+
+    // The same IDF, kept by the update as the count of the documents is the same
+    memcpy(full->idf, incremental->idf, sizeof(full->idf));
+    full->idfDocumentCount = full->documentCount;
+
+    ECNeighborIndexUpdate(full);
+}
+
+/**
+ * \brief	The score of two documents by a scalar scan, with the IDF of the index.
+ */
+static float _scan_Score(const ECNeighborIndex *index, const Corpus *corpus, uint32_t a, uint32_t b)
+{
+    const uint8_t *x = corpus->terms + (size_t)a * ECNEIGHBOR_DIMENSION, *y = corpus->terms + (size_t)b * ECNEIGHBOR_DIMENSION;
+    double dot = 0, normX = 0, normY = 0;
+    size_t d;
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+    {
+        double wx = (0 == x[d]) ? 0 : (1.0 + log(x[d])) * index->idf[d];
+        double wy = (0 == y[d]) ? 0 : (1.0 + log(y[d])) * index->idf[d];
+
+        dot += wx * wy;
+        normX += wx * wx;
+        normY += wy * wy;
+    }
+
+    dot = (normX > 0 && normY > 0) ? dot / sqrt(normX) / sqrt(normY) : 0;
+
+    return (float)((1.0 - GROUP_WEIGHT) * dot + ((corpus->groups[a] == corpus->groups[b]) ? GROUP_WEIGHT : 0));
+}
+
+/**
+ * \brief	Compare the neighbors of the two indexes. The identifiers may only differ between the scores
+ *          which are equal within the epsilon, the ties of the last digits.
+ * \return	The count of the documents whose neighbors differ.
+ */
+static size_t _compare(const ECNeighborIndex *a, const ECNeighborIndex *b, const Corpus *corpus, int scan)
+{
+    ECNeighbor x[NEIGHBOR_COUNT], y[NEIGHBOR_COUNT];
+    size_t mismatches = 0, countX, countY, j;
+    uint32_t i;
+
+    for (i = 0; i < corpus->capacity; i++)
+    {
+        int same;
+
+        if (!corpus->alive[i])
+        {
+            mismatches += (0 == ECNeighborIndexNeighbors(a, i, x, NEIGHBOR_COUNT)) ? 0 : 1;
+            continue;
+        }
+
+        countX = ECNeighborIndexNeighbors(a, i, x, NEIGHBOR_COUNT);
+        countY = ECNeighborIndexNeighbors(b, i, y, NEIGHBOR_COUNT);
+        same = (countX == countY);
+
+        for (j = 0; same && j < countX; j++)
+        {
+            same = fabsf(x[j].score - y[j].score) <= SCORE_EPSILON;
+
+            if (same && x[j].identifier != y[j].identifier)
+                same = (j + 1 < countX && fabsf(x[j].score - x[j + 1].score) <= SCORE_EPSILON) || (j > 0 && fabsf(x[j].score - x[j - 1].score) <= SCORE_EPSILON) || j + 1 == countX;
+
+            // The kept score is the score of the pair, by a scan of the terms
+            if (same && scan)
+                same = corpus->alive[x[j].identifier] && fabsf(x[j].score - _scan_Score(a, corpus, i, x[j].identifier)) <= SCORE_EPSILON;
+        }
+
+        mismatches += same ? 0 : 1;
+    }
+
+    return mismatches;
+}
+
+// The tests
+
+/**
+ *  Rounds of sets, replacements and removals, each checked against a rebuild under the same IDF.
+ */
+static void _test_Incremental(ECNeighborKernel kernel)
+{
+    unsigned long long state = 0x853C49E6748FEA9BULL;
+    ECNeighborIndex incremental, full;
+    Corpus corpus;
+    size_t round, i, mismatches = 0, computed = 0, kept = 0, rebuilds = 0;
+    uint32_t nextIdentifier = DOCUMENT_COUNT;
+
+    corpus.capacity = DOCUMENT_COUNT * 2;
+    corpus.terms = (uint8_t*)calloc(corpus.capacity, ECNEIGHBOR_DIMENSION);
+    corpus.groups = (uint32_t*)calloc(corpus.capacity, sizeof(uint32_t));
+    corpus.alive = (uint8_t*)calloc(corpus.capacity, 1);
+
+    ECNeighborIndexInit(&incremental, NEIGHBOR_COUNT, GROUP_WEIGHT, kernel);
+
+    for (i = 0; i < DOCUMENT_COUNT; i++)
+        _set_Document(&incremental, &corpus, (uint32_t)i, &state);
+
+    EC_CHECK(DOCUMENT_COUNT == ECNeighborIndexUpdate(&incremental));
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        // A refresh: a few changed, a few removed, a few new ones in the freed or the new slots.
+        // The last rounds add enough documents to compute the IDF again.
+        size_t changes = (round < ROUNDS - 2) ? 5 + ECHarnessRandom(&state) % 40 : DOCUMENT_COUNT / 3;
+        size_t documentCount = incremental.idfDocumentCount;
+
+        for (i = 0; i < changes; i++)
+        {
+            uint32_t identifier = (uint32_t)(ECHarnessRandom(&state) % nextIdentifier);
+            unsigned long long action = ECHarnessRandom(&state) % 3;
+
+            if (round >= ROUNDS - 2 && nextIdentifier < corpus.capacity)
+                _set_Document(&incremental, &corpus, nextIdentifier++, &state);
+            else if (0 == action && corpus.alive[identifier])
+            {
+                ECNeighborIndexRemove(&incremental, identifier);
+                corpus.alive[identifier] = 0;
+            }
+            else
+                _set_Document(&incremental, &corpus, identifier, &state);
+        }
+
+        computed += ECNeighborIndexUpdate(&incremental);
+
+        if (incremental.idfDocumentCount == documentCount)
+            kept++;
+        else
+            rebuilds++;
+
+        _rebuild(&incremental, &corpus, &full, kernel);
+        mismatches += _compare(&incremental, &full, &corpus, 1 == round % 4);
+        ECNeighborIndexDestroy(&full);
+    }
+
+    EC_CHECK(0 == mismatches);
+    EC_CHECK(kept > 0 && rebuilds > 0);
+
+    printf("incremental, kernel %d: %d rounds, %zu under the kept IDF, %zu with a new IDF, %zu documents computed, %zu differ from the rebuild\n", (int)kernel, ROUNDS, kept, rebuilds, computed, mismatches);
+
+    ECNeighborIndexDestroy(&incremental);
+    free(corpus.terms);
+    free(corpus.groups);
+    free(corpus.alive);
+}
+
+/**
+ *  The terms of the texts: the pairs of the Han characters and the ASCII words, case insensitive.
+ */
+static void _test_Terms(void)
+{
+    static const uint16_t a[] = u"大安森林公園 MRT Park";
+    static const uint16_t b[] = u"mrt park，大安森林公園。";
+    uint8_t x[ECNEIGHBOR_DIMENSION] = {0}, y[ECNEIGHBOR_DIMENSION] = {0};
+    size_t d, count = 0;
+
+    ECNeighborTerms(a, sizeof(a) / sizeof(a[0]) - 1, x);
+    ECNeighborTerms(b, sizeof(b) / sizeof(b[0]) - 1, y);
+
+    for (d = 0; d < ECNEIGHBOR_DIMENSION; d++)
+        count += x[d];
+
+    // 5 pairs of characters and 2 words, the same in both texts
+    EC_CHECK(7 == count);
+    EC_CHECK(0 == memcmp(x, y, ECNEIGHBOR_DIMENSION));
+}
+
+// The benchmark
+
+static void _benchmark(ECNeighborKernel kernel)
+{
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    ECNeighborIndex index;
+    Corpus corpus;
+    double start, buildTime, updateTime;
+    size_t i, computed;
+
+    corpus.capacity = BENCH_DOCUMENTS;
+    corpus.terms = (uint8_t*)calloc(corpus.capacity, ECNEIGHBOR_DIMENSION);
+    corpus.groups = (uint32_t*)calloc(corpus.capacity, sizeof(uint32_t));
+    corpus.alive = (uint8_t*)calloc(corpus.capacity, 1);
+
+    ECNeighborIndexInit(&index, NEIGHBOR_COUNT, GROUP_WEIGHT, kernel);
+
+    for (i = 0; i < BENCH_DOCUMENTS; i++)
+        _set_Document(&index, &corpus, (uint32_t)i, &state);
+
+    start = ECHarnessNow();
+    ECNeighborIndexUpdate(&index);
+    buildTime = ECHarnessNow() - start;
+
+    for (i = 0; i < BENCH_CHANGES; i++)
+        _set_Document(&index, &corpus, (uint32_t)(ECHarnessRandom(&state) % BENCH_DOCUMENTS), &state);
+
+    start = ECHarnessNow();
+    computed = ECNeighborIndexUpdate(&index);
+    updateTime = ECHarnessNow() - start;
+
+    printf("  kernel %d: full build %7.1f ms, update of %d changed %6.2f ms (%zu documents computed)\n", (int)kernel, buildTime * 1e3, BENCH_CHANGES, updateTime * 1e3, computed);
+
+    ECNeighborIndexDestroy(&index);
+    free(corpus.terms);
+    free(corpus.groups);
+    free(corpus.alive);
+}
+
+int main(void)
+{
+    static const ECNeighborKernel kernels[] = {ECNeighborKernelScalar, ECNeighborKernelAVX2, ECNeighborKernelNEON};
+    size_t i;
+
+    _test_Terms();
+
+    for (i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+    {
+        if (ECNeighborKernelIsSupported(kernels[i]))
+            _test_Incremental(kernels[i]);
+    }
+
+    printf("%d documents, %d neighbors each:\n", BENCH_DOCUMENTS, NEIGHBOR_COUNT);
+
+    for (i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+    {
+        if (ECNeighborKernelIsSupported(kernels[i]))
+            _benchmark(kernels[i]);
+    }
+
+    return EC_HARNESS_RESULT("ECNeighborIndexTest");
+}
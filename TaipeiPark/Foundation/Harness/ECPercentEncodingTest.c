@@ -0,0 +1,159 @@
+/**
+ * \file 	ECPercentEncodingTest.c
+ * \brief	The test, the fuzz run and the benchmark of the ECPercentEncoding kernel.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECPercentEncoding.h"
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_COUNT          200000
+#define BENCH_LENGTH        (1 << 20)
+#define BENCH_ROUNDS        20
+
+static const char *kUnreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~";
+
+// The reference encoder, one byte at a time
+
+static size_t _reference_Encode(const uint8_t *src, size_t length, char *dst, ECPercentEncodingSet set)
+{
+    size_t i, n = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        int kept = (0 != src[i] && NULL != strchr(kUnreserved, src[i])) ||
+                   (ECPercentEncodingSetQuery == set && ('/' == src[i] || '?' == src[i]));
+
+        if (kept)
+            dst[n++] = (char)src[i];
+        else
+        {
+            dst[n++] = '%';
+            dst[n++] = "0123456789ABCDEF"[src[i] >> 4];
+            dst[n++] = "0123456789ABCDEF"[src[i] & 15];
+        }
+    }
+
+    return n;
+}
+
+static int _encodes(const char *src, ECPercentEncodingSet set, const char *expected)
+{
+    char out[256];
+    size_t length = ECPercentEncode((const uint8_t*)src, strlen(src), out, set);
+
+    return length == strlen(expected) && length == ECPercentEncodedLength((const uint8_t*)src, strlen(src), set) && 0 == memcmp(out, expected, length);
+}
+
+static void _test_Vectors(void)
+{
+    EC_CHECK(_encodes("", ECPercentEncodingSetQuery, ""));
+    EC_CHECK(_encodes("resourceAquire", ECPercentEncodingSetQuery, "resourceAquire"));
+    EC_CHECK(_encodes("a b&c=d", ECPercentEncodingSetQuery, "a%20b%26c%3Dd"));
+    EC_CHECK(_encodes("http://x/y?z", ECPercentEncodingSetQuery, "http%3A//x/y?z"));
+    EC_CHECK(_encodes("http://x/y?z", ECPercentEncodingSetComponent, "http%3A%2F%2Fx%2Fy%3Fz"));
+    EC_CHECK(_encodes("-._~!*'()", ECPercentEncodingSetComponent, "-._~%21%2A%27%28%29"));
+    EC_CHECK(_encodes("\xE5\x85\xAC\xE5\x9C\x92", ECPercentEncodingSetQuery, "%E5%85%AC%E5%9C%92"));
+    EC_CHECK(0 == ECPercentEncode(NULL, 3, (char*)kUnreserved, ECPercentEncodingSetQuery));
+    EC_CHECK(0 == ECPercentEncodedLength((const uint8_t*)"abc", 3, ECPercentEncodingSetCount));
+}
+
+/**
+ *  Random bytes against the reference, in both sets.
+ */
+static void _fuzz(void)
+{
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    uint8_t src[64];
+    char out[3 * 64], expected[3 * 64 + 1];
+    int i, mismatches = 0;
+
+    for (i = 0; i < FUZZ_COUNT; i++)
+    {
+        size_t length = ECHarnessRandom(&state) % sizeof(src), j;
+        ECPercentEncodingSet set = (ECPercentEncodingSet)(i % ECPercentEncodingSetCount);
+        unsigned long long bits = ECHarnessRandom(&state);
+
+        // Mostly ASCII, like the parameters
+        for (j = 0; j < length; j++)
+            src[j] = (uint8_t)((bits >> (j % 64)) & 1 ? ECHarnessRandom(&state) : 0x20 + ECHarnessRandom(&state) % 0x5F);
+
+        size_t n = ECPercentEncode(src, length, out, set);
+        size_t m = _reference_Encode(src, length, expected, set);
+
+        if (n != m || n != ECPercentEncodedLength(src, length, set) || 0 != memcmp(out, expected, n))
+            mismatches++;
+    }
+
+    EC_CHECK(0 == mismatches);
+    printf("fuzz: %d random strings, %d mismatches\n", FUZZ_COUNT, mismatches);
+}
+
+// The benchmark of the kernel. The query builders, AFQueryStringFromParameters and the former pair
+// objects, are measured in the app by +[AFHTTPRequestSerializer benchmarkQueryStringsWithIterations:].
+
+static double _encode_Time(const uint8_t *src, size_t length, char *dst, int reference)
+{
+    double start = ECHarnessNow();
+    int round;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        if (reference)
+            _reference_Encode(src, length, dst, ECPercentEncodingSetQuery);
+        else
+            ECPercentEncode(src, length, dst, ECPercentEncodingSetQuery);
+    }
+
+    return (ECHarnessNow() - start) / BENCH_ROUNDS;
+}
+
+static void _benchmark(void)
+{
+    static const char *words[] = {"park", "attraction", "\xE5\xA4\xA7\xE5\xAE\x89\xE6\xA3\xAE\xE6\x9E\x97\xE5\x85\xAC\xE5\x9C\x92", "a b", "x&y=z", "resourceAquire"};
+    static const char *kinds[] = {"ASCII identifiers", "mixed values"};
+    uint8_t *src = (uint8_t*)malloc(BENCH_LENGTH + 64);
+    char *dst = (char*)malloc(3 * (BENCH_LENGTH + 64)), *expected = (char*)malloc(3 * (BENCH_LENGTH + 64) + 1);
+    unsigned long long state = 1234567ULL;
+    int kind;
+
+    for (kind = 0; kind < 2; kind++)
+    {
+        size_t length = 0, n;
+        double referenceTime, kernelTime;
+
+        // The identifiers of the queries of the app, or the words of the values with their spaces and delimiters
+        while (length < BENCH_LENGTH)
+        {
+            const char *word = (0 == kind) ? kUnreserved + ECHarnessRandom(&state) % 52 : words[ECHarnessRandom(&state) % 6];
+            size_t wordLength = (0 == kind) ? 1 + ECHarnessRandom(&state) % 12 : strlen(word);
+
+            memcpy(src + length, word, wordLength);
+            length += wordLength;
+        }
+
+        n = ECPercentEncode(src, length, dst, ECPercentEncodingSetQuery);
+        EC_CHECK(n == _reference_Encode(src, length, expected, ECPercentEncodingSetQuery) && 0 == memcmp(dst, expected, n));
+
+        referenceTime = _encode_Time(src, length, expected, 1);
+        kernelTime = _encode_Time(src, length, dst, 0);
+
+        printf("%s, %zu bytes to %zu: reference %.0f MB/s, ECPercentEncode %.0f MB/s, %.1fx\n",
+               kinds[kind], length, n, length / referenceTime / 1e6, length / kernelTime / 1e6, referenceTime / kernelTime);
+    }
+
+    free(src);
+    free(dst);
+    free(expected);
+}
+
+int main(void)
+{
+    _test_Vectors();
+    _fuzz();
+    _benchmark();
+
+    return EC_HARNESS_RESULT("ECPercentEncodingTest");
+}
@@ -0,0 +1,364 @@
+/**
+ * \file 	ECPhoneticTest.c
+ * \brief	The test of ECPhonetic and ECFuzzyIndex, the index against a linear scan of the keys, and the
+ *          benchmark of the build and the search on 100k names.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECPhonetic.h"
+#include "ECFuzzyIndex.h"
+#include "ECHarness.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define NAME_COUNT          100000
+#define MAX_SYLLABLES       8
+#define MAX_RESULTS         100         // MAX_SEARCH_RESULTS of MainViewController
+#define CHECK_QUERIES       60
+#define BENCH_QUERIES       2000
+
+// The readings of the park names after the Mandarin-Latin transform, with ü as v
+static const char *kSyllables[] =
+{
+    "da", "an", "sen", "lin", "gong", "yuan", "qing", "nian", "er", "ba", "he", "ping", "zhong", "shan",
+    "mei", "ti", "bin", "rong", "xing", "hua", "tong", "you", "xi", "qu", "bu", "dao", "chi", "tang",
+    "liang", "ting", "yin", "yue", "tai", "lv", "nv", "lve", "jue", "xue", "yu", "yong", "wu", "wei",
+    "zhi", "shi", "ri", "zi", "ci", "si", "tian", "mu", "guan", "du", "she", "bi", "hu", "shuang",
+    "quan", "jiu", "lao", "shu", "ji", "bei", "qiao", "ding", "sheng", "jiao", "di", "niao", "die",
+    "ying", "zhu", "song", "bai", "feng", "xiong", "liu", "gui", "lun", "chuang", "kuai", "cao"
+};
+
+#define SYLLABLE_COUNT      (sizeof(kSyllables) / sizeof(kSyllables[0]))
+
+typedef struct Name
+{
+    uint8_t key[64];
+    uint8_t syllables[MAX_SYLLABLES];   // The index of the syllable of each word
+    uint8_t starts[MAX_SYLLABLES];      // The offset of the key of each word
+    uint8_t length;
+    uint8_t wordCount;
+} Name;
+
+static Name *gNames;
+
+static size_t _key_Of_ASCII(const char *text, uint8_t *out)
+{
+    uint16_t chars[128];
+    size_t count = strlen(text), i;
+
+    for (i = 0; i < count; i++)
+        chars[i] = (uint8_t)text[i];
+
+    return ECPhoneticKey(chars, count, out);
+}
+
+static size_t _key_Of_UTF16(const uint16_t *text, uint8_t *out)
+{
+    size_t count = 0;
+
+    while (0 != text[count])
+        count++;
+
+    return ECPhoneticKey(text, count, out);
+}
+
+// The tests
+
+static void _test_Keys(void)
+{
+    static const struct { const char *pinyin; const uint16_t *zhuyin; } pairs[] =
+    {
+        {"zhuang", u"ㄓㄨㄤ"}, {"lv", u"ㄌㄩ"}, {"lve", u"ㄌㄩㄝ"}, {"lue", u"ㄌㄩㄝ"}, {"nv", u"ㄋㄩ"},
+        {"yue", u"ㄩㄝ"}, {"yuan", u"ㄩㄢ"}, {"yong", u"ㄩㄥ"}, {"xiong", u"ㄒㄩㄥ"}, {"ju", u"ㄐㄩ"},
+        {"wu", u"ㄨ"}, {"wei", u"ㄨㄟ"}, {"zhi", u"ㄓ"}, {"si", u"ㄙ"}, {"er", u"ㄦ"}, {"ying", u"ㄧㄥ"},
+        {"liu", u"ㄌㄧㄡ"}, {"gui", u"ㄍㄨㄟ"}, {"lun", u"ㄌㄨㄣ"}, {"daan", u"ㄉㄚˋㄢ"},
+        {"Da An 2", u"ㄉㄚ ㄢ2"}, {"daan senlin gongyuan", u"ㄉㄚˋㄢ ㄙㄣ ㄌㄧㄣˊ ㄍㄨㄥ ㄩㄢˊ"}
+    };
+    uint8_t a[128], b[128];
+    size_t i, la, lb;
+
+    for (i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++)
+    {
+        la = _key_Of_ASCII(pairs[i].pinyin, a);
+        lb = _key_Of_UTF16(pairs[i].zhuyin, b);
+
+        EC_CHECK(la == lb && 0 == memcmp(a, b, la));
+    }
+
+    // Not a syllable
+    EC_CHECK(0 == ECPhoneticSyllable("bx", 2, a));
+    EC_CHECK(0 == ECPhoneticSyllable("q", 1, a));
+
+    // The ü is not a letter here, the search index maps it to v before the key
+    la = _key_Of_UTF16(u"lü", a);
+    lb = _key_Of_ASCII("lv", b);
+    EC_CHECK(1 == la && 2 == lb);
+}
+
+/**
+ * \brief	The edit distance of the query to the nearest prefix of the key.
+ */
+static unsigned int _prefix_Distance(const uint8_t *query, size_t m, const uint8_t *key, size_t n)
+{
+    unsigned int rows[2][ECFUZZY_MAX_QUERY_LENGTH + 1], best;
+    size_t i, j;
+
+    for (i = 0; i <= m; i++)
+        rows[0][i] = (unsigned int)i;
+
+    best = rows[0][m];
+
+    for (j = 1; j <= n; j++)
+    {
+        unsigned int *previous = rows[(j - 1) & 1], *row = rows[j & 1];
+
+        row[0] = (unsigned int)j;
+
+        for (i = 1; i <= m; i++)
+        {
+            unsigned int cost = previous[i - 1] + (query[i - 1] != key[j - 1]);
+
+            if (previous[i] + 1 < cost)
+                cost = previous[i] + 1;
+
+            if (row[i - 1] + 1 < cost)
+                cost = row[i - 1] + 1;
+
+            row[i] = cost;
+        }
+
+        if (row[m] < best)
+            best = row[m];
+    }
+
+    return best;
+}
+
+/**
+ * \brief	The nearest distance of each name over the keys from each word, the linear scan.
+ */
+static double _scan(const uint8_t *query, size_t length, unsigned int *distances)
+{
+    double start = ECHarnessNow();
+    size_t i, w;
+
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        unsigned int best = 0xFF;
+
+        for (w = 0; w < gNames[i].wordCount; w++)
+        {
+            size_t offset = gNames[i].starts[w];
+            unsigned int distance = _prefix_Distance(query, length, gNames[i].key + offset, gNames[i].length - offset);
+
+            if (distance < best)
+                best = distance;
+        }
+
+        distances[i] = best;
+    }
+
+    return ECHarnessNow() - start;
+}
+
+static void _make_Names(ECFuzzyIndex *index, unsigned long long seed, double *buildTime)
+{
+    unsigned long long state = seed;
+    size_t i, w;
+    double start;
+
+    gNames = (Name*)malloc(NAME_COUNT * sizeof(Name));
+    start = ECHarnessNow();
+
+    for (i = 0; i < NAME_COUNT; i++)
+    {
+        Name *name = &gNames[i];
+
+        name->wordCount = (uint8_t)(2 + ECHarnessRandom(&state) % (MAX_SYLLABLES - 1));
+        name->length = 0;
+
+        for (w = 0; w < name->wordCount; w++)
+        {
+            name->syllables[w] = (uint8_t)(ECHarnessRandom(&state) % SYLLABLE_COUNT);
+            name->starts[w] = name->length;
+            name->length += (uint8_t)_key_Of_ASCII(kSyllables[name->syllables[w]], name->key + name->length);
+        }
+
+        // The key from each word, as ECPhoneticSearchIndex adds them
+        for (w = 0; w < name->wordCount; w++)
+            EC_CHECK(0 == ECFuzzyIndexAdd(index, name->key + name->starts[w], name->length - name->starts[w], (uint32_t)i));
+    }
+
+    EC_CHECK(0 == ECFuzzyIndexBuild(index));
+    *buildTime = ECHarnessNow() - start;
+}
+
+/**
+ * \brief	A query typed from a few words of a name, with up to two typos in the letters.
+ * \return	The length of the key of the query.
+ */
+static size_t _make_Query(unsigned long long *state, uint8_t *key)
+{
+    const Name *name = &gNames[ECHarnessRandom(state) % NAME_COUNT];
+    size_t from = ECHarnessRandom(state) % name->wordCount, words = 1 + ECHarnessRandom(state) % 4, length, typos, i;
+    char text[64];
+
+    // Typed again without the spaces, so the typos go through ECPhoneticKey
+    text[0] = '\0';
+
+    for (i = 0; i < words && from + i < name->wordCount; i++)
+        strcat(text, kSyllables[name->syllables[from + i]]);
+
+    length = strlen(text);
+    typos = ECHarnessRandom(state) % 3;
+
+    for (i = 0; i < typos && length > 1; i++)
+        text[ECHarnessRandom(state) % length] = (char)('a' + ECHarnessRandom(state) % 26);
+
+    return _key_Of_ASCII(text, key);
+}
+
+static unsigned int _max_Distance(size_t length)
+{
+    // As ECPhoneticSearchIndex
+    return (length <= 3) ? 0 : ((length <= 8) ? 1 : 2);
+}
+
+/**
+ *  With room for all matches, the index finds exactly the names of the scan within the bound, at the
+ *  same distances. With MAX_RESULTS, the nearest ones are kept.
+ */
+static void _test_Index(const ECFuzzyIndex *index)
+{
+    unsigned long long state = 0xBF58476D1CE4E5B9ULL;
+    unsigned int *distances = (unsigned int*)malloc(NAME_COUNT * sizeof(unsigned int));
+    ECFuzzyMatch *matches = (ECFuzzyMatch*)malloc(NAME_COUNT * sizeof(ECFuzzyMatch));
+    size_t histogram[4], q, i, count, expected, mismatches = 0, total = 0;
+    uint8_t key[64];
+
+    for (q = 0; q < CHECK_QUERIES; q++)
+    {
+        size_t length = _make_Query(&state, key);
+        unsigned int maxDistance = _max_Distance(length), d;
+
+        if (length > ECFUZZY_MAX_QUERY_LENGTH)
+            length = ECFUZZY_MAX_QUERY_LENGTH;
+
+        if (0 == length)
+            continue;
+
+        _scan(key, length, distances);
+        memset(histogram, 0, sizeof(histogram));
+
+        for (i = 0, expected = 0; i < NAME_COUNT; i++)
+        {
+            if (distances[i] <= maxDistance)
+            {
+                histogram[distances[i]]++;
+                expected++;
+            }
+        }
+
+        count = ECFuzzyIndexSearch(index, key, length, maxDistance, matches, NAME_COUNT);
+        total += count;
+
+        if (count != expected)
+            mismatches++;
+
+        for (i = 0; i < count; i++)
+        {
+            if (matches[i].distance != distances[matches[i].identifier])
+                mismatches++;
+        }
+
+        // The first MAX_RESULTS of the nearest distances
+        count = ECFuzzyIndexSearch(index, key, length, maxDistance, matches, MAX_RESULTS);
+
+        for (i = 0, d = 0; i < count; i++)
+        {
+            while (d <= maxDistance && 0 == histogram[d])
+                d++;
+
+            if (d > maxDistance || matches[i].distance != d || matches[i].distance != distances[matches[i].identifier])
+            {
+                mismatches++;
+                break;
+            }
+
+            histogram[d]--;
+        }
+
+        if (count != ((expected < MAX_RESULTS) ? expected : MAX_RESULTS))
+            mismatches++;
+    }
+
+    EC_CHECK(0 == mismatches);
+    printf("index against the scan: %d queries, %zu matches, %zu mismatches\n", CHECK_QUERIES, total, mismatches);
+
+    free(distances);
+    free(matches);
+}
+
+static void _benchmark(const ECFuzzyIndex *index, double buildTime)
+{
+    unsigned long long state = 0x94D049BB133111EBULL;
+    ECFuzzyMatch matches[MAX_RESULTS];
+    unsigned int *distances = (unsigned int*)malloc(NAME_COUNT * sizeof(unsigned int));
+    double times[3] = {0, 0, 0}, worst[3] = {0, 0, 0}, scanTime = 0, start, time;
+    size_t counts[3] = {0, 0, 0}, q, results = 0;
+    uint8_t key[64];
+
+    for (q = 0; q < BENCH_QUERIES; q++)
+    {
+        size_t length = _make_Query(&state, key);
+        unsigned int maxDistance = _max_Distance(length);
+
+        if (0 == length)
+            continue;
+
+        start = ECHarnessNow();
+        results += ECFuzzyIndexSearch(index, key, length, maxDistance, matches, MAX_RESULTS);
+        time = ECHarnessNow() - start;
+
+        times[maxDistance] += time;
+        counts[maxDistance]++;
+
+        if (time > worst[maxDistance])
+            worst[maxDistance] = time;
+
+        // The scan is slow, a few queries are enough
+        if (q < 20)
+            scanTime += _scan(key, (length > ECFUZZY_MAX_QUERY_LENGTH) ? ECFUZZY_MAX_QUERY_LENGTH : length, distances);
+    }
+
+    printf("%d names, %zu keys, %zu trie nodes, built in %.1f ms\n", NAME_COUNT, index->entryCount, index->nodeCount, buildTime * 1e3);
+
+    for (q = 0; q < 3; q++)
+    {
+        if (counts[q] > 0)
+            printf("  search within %zu edits: %5zu queries, %7.3f ms average, %7.3f ms worst\n", q, counts[q], times[q] / counts[q] * 1e3, worst[q] * 1e3);
+    }
+
+    printf("  %.1f results per query, the linear scan takes %.1f ms per query\n", (double)results / BENCH_QUERIES, scanTime / 20 * 1e3);
+
+    free(distances);
+}
+
+int main(void)
+{
+    ECFuzzyIndex index;
+    double buildTime = 0;
+
+    _test_Keys();
+
+    ECFuzzyIndexInit(&index);
+    _make_Names(&index, 0x9E3779B97F4A7C15ULL, &buildTime);
+
+    _test_Index(&index);
+    _benchmark(&index, buildTime);
+
+    ECFuzzyIndexDestroy(&index);
+    free(gNames);
+
+    return EC_HARNESS_RESULT("ECPhoneticTest");
+}
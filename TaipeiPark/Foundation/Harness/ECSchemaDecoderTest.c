@@ -0,0 +1,498 @@
+/**
+ * \file 	ECSchemaDecoderTest.c
+ * \brief	The fuzz run of ECSchemaDecoder against the records read out of the generic tree, and the
+ *          benchmark of both ways on the feed.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECSchemaDecoder.h"
+#include "ECHarnessFeed.h"
+#include "ECHarnessTree.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_COUNT          3000
+#define MAX_RECORDS         12
+#define FEED_RECORDS        20000
+#define BENCH_ROUNDS        5
+
+typedef struct ECRecordValue
+{
+    int present;
+    int hasString;
+    char string[512];
+    size_t length;
+    int64_t integer;
+    double real;
+} ECRecordValue;
+
+typedef struct ECRecords
+{
+    ECRecordValue values[MAX_RECORDS * 4][8];
+    size_t count;
+} ECRecords;
+
+static const char * const kPath[] = {"result", "results"};
+
+static const ECSchemaField kFuzzFields[] =
+{
+    {"Name", ECSchemaFieldString, "", 0, 0},
+    {"Count", ECSchemaFieldInteger, NULL, -1, 0},
+    {"Ratio", ECSchemaFieldDouble, NULL, 0, 0.5},
+    {"Open", ECSchemaFieldBoolean, NULL, 0, 0},
+    {"Note", ECSchemaFieldString, NULL, 0, 0},
+};
+
+static const ECSchema kFuzzSchema = {kPath, 2, kFuzzFields, sizeof(kFuzzFields) / sizeof(kFuzzFields[0])};
+
+// The fields of ECParkAttraction
+static const ECSchemaField kParkFields[] =
+{
+    {"Name", ECSchemaFieldString, "", 0, 0},
+    {"ParkName", ECSchemaFieldString, "", 0, 0},
+    {"Image", ECSchemaFieldString, "", 0, 0},
+    {"Introduction", ECSchemaFieldString, "", 0, 0},
+    {"OpenTime", ECSchemaFieldString, "", 0, 0},
+};
+
+static const ECSchema kParkSchema = {kPath, 2, kParkFields, sizeof(kParkFields) / sizeof(kParkFields[0])};
+
+static void _set_String(ECRecordValue *value, const char *bytes, size_t length)
+{
+    value->hasString = 1;
+    value->length = (length < sizeof(value->string)) ? length : sizeof(value->string) - 1;
+    memcpy(value->string, bytes, value->length);
+}
+
+static int _collect_Record(void *context, const ECSchemaValue *values, size_t count)
+{
+    ECRecords *records = (ECRecords*)context;
+    size_t i;
+
+    if (records->count >= MAX_RECORDS * 4)
+        return 1;
+
+    for (i = 0; i < count; i++)
+    {
+        ECRecordValue *value = &records->values[records->count][i];
+
+        memset(value, 0, sizeof(ECRecordValue));
+        value->present = values[i].present;
+        value->integer = values[i].integer;
+        value->real = values[i].real;
+
+        if (NULL != values[i].string)
+            _set_String(value, values[i].string, values[i].length);
+    }
+
+    records->count++;
+
+    return 0;
+}
+
+// The reference: the records read out of the generic tree, the members applied in order
+
+static int _parse_Number_Text(const char *bytes, size_t length, int64_t *integer, double *real)
+{
+    char buffer[64], *end = NULL;
+
+    if (0 == length || length >= sizeof(buffer) || !('-' == bytes[0] || ('0' <= bytes[0] && bytes[0] <= '9')))
+        return 0;
+
+    memcpy(buffer, bytes, length);
+    buffer[length] = '\0';
+    *real = strtod(buffer, &end);
+
+    if (end != buffer + length || !(-9.2e18 < *real && *real < 9.2e18))
+        return 0;
+
+    *integer = (int64_t)*real;
+
+    return 1;
+}
+
+static void _apply_Member(ECRecordValue *value, ECSchemaFieldType type, const ECValue *member)
+{
+    char text[32];
+    int64_t integer;
+    double real;
+
+    if (kValueString == member->type)
+    {
+        if (ECSchemaFieldString == type)
+        {
+            _set_String(value, member->bytes, member->length);
+            value->present = 1;
+        }
+        else if (ECSchemaFieldBoolean != type)
+        {
+            if (_parse_Number_Text(member->bytes, member->length, &integer, &real))
+            {
+                value->integer = integer;
+                value->real = real;
+                value->present = 1;
+            }
+        }
+        else if ((4 == member->length && 0 == memcmp(member->bytes, "true", 4)) || (1 == member->length && '1' == member->bytes[0]))
+        {
+            value->integer = 1;
+            value->present = 1;
+        }
+        else if ((5 == member->length && 0 == memcmp(member->bytes, "false", 5)) || (1 == member->length && '0' == member->bytes[0]))
+        {
+            value->integer = 0;
+            value->present = 1;
+        }
+    }
+    else if (kValueNumber == member->type)
+    {
+        if (ECSchemaFieldString == type)
+        {
+            int length = member->isInteger ? snprintf(text, sizeof(text), "%lld", (long long)member->integer) : snprintf(text, sizeof(text), "%.17g", member->real);
+
+            _set_String(value, text, (size_t)length);
+        }
+        else
+        {
+            value->integer = member->isInteger ? member->integer : ((-9.2e18 < member->real && member->real < 9.2e18) ? (int64_t)member->real : 0);
+            value->real = member->real;
+
+            if (ECSchemaFieldBoolean == type)
+                value->integer = (0 != value->integer);
+        }
+
+        value->present = 1;
+    }
+    else if (kValueTrue == member->type || kValueFalse == member->type)
+    {
+        if (ECSchemaFieldString == type)
+        {
+            _set_String(value, (kValueTrue == member->type) ? "true" : "false", (kValueTrue == member->type) ? 4 : 5);
+        }
+        else
+        {
+            value->integer = (kValueTrue == member->type);
+            value->real = (double)value->integer;
+        }
+
+        value->present = 1;
+    }
+}
+
+static const ECValue* _member(const ECValue *object, const char *key)
+{
+    size_t i;
+
+    for (i = 0; NULL != object && kValueObject == object->type && i < object->count; i++)
+    {
+        if (strlen(key) == object->items[i]->length && 0 == memcmp(key, object->items[i]->bytes, object->items[i]->length))
+            return object->items[object->count + i];
+    }
+
+    return NULL;
+}
+
+static void _reference_Records(const ECValue *root, const ECSchema *schema, ECRecords *records)
+{
+    const ECValue *array = _member(_member(root, schema->path[0]), schema->path[1]);
+    size_t i, j, f;
+
+    records->count = 0;
+
+    if (NULL == array || kValueArray != array->type)
+        return;
+
+    for (i = 0; i < array->count && records->count < MAX_RECORDS * 4; i++)
+    {
+        const ECValue *record = array->items[i];
+
+        if (kValueObject != record->type)
+            continue;
+
+        for (f = 0; f < schema->fieldCount; f++)
+        {
+            ECRecordValue *value = &records->values[records->count][f];
+            const ECSchemaField *field = &schema->fields[f];
+
+            memset(value, 0, sizeof(ECRecordValue));
+            value->integer = field->defaultInteger;
+            value->real = field->defaultDouble;
+
+            if (NULL != field->defaultString)
+                _set_String(value, field->defaultString, strlen(field->defaultString));
+
+            for (j = 0; j < record->count; j++)
+            {
+                const ECValue *key = record->items[j];
+
+                if (strlen(field->name) == key->length && 0 == memcmp(field->name, key->bytes, key->length))
+                    _apply_Member(value, field->type, record->items[record->count + j]);
+            }
+        }
+
+        records->count++;
+    }
+}
+
+static int _equal_Records(const ECRecords *a, const ECRecords *b, const ECSchema *schema)
+{
+    size_t i, f;
+
+    if (a->count != b->count)
+        return 0;
+
+    for (i = 0; i < a->count; i++)
+    {
+        for (f = 0; f < schema->fieldCount; f++)
+        {
+            const ECRecordValue *x = &a->values[i][f], *y = &b->values[i][f];
+
+            if (x->present != y->present)
+                return 0;
+
+            if (ECSchemaFieldString == schema->fields[f].type)
+            {
+                if (x->hasString != y->hasString || x->length != y->length || 0 != memcmp(x->string, y->string, x->length))
+                    return 0;
+            }
+            else if (x->integer != y->integer || (ECSchemaFieldBoolean != schema->fields[f].type && x->real != y->real))
+            {
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+// The fuzz documents
+
+static void _append_Value(ECHarnessBuffer *buffer, unsigned long long *state, int depth)
+{
+    static const char *strings[] = {"\"\"", "\"12\"", "\"-3.5e2\"", "\" 7\"", "\"1\"", "\"0\"", "\"true\"", "\"false\"", "\"abc\"",
+                                    "\"a\\\"b\\\\c\\n\"", "\"\\u516c\\u5712\"", "\"\xE5\xA4\xA7\xE5\xAE\x89\"", "\"9e99\""};
+    static const char *scalars[] = {"0", "-1", "42", "3.25", "-0.5", "1e3", "9223372036854775807", "1e300", "true", "false", "null"};
+    char text[64];
+
+    switch (ECHarnessRandom(state) % 6)
+    {
+        case 0:
+        case 1:
+            ECHarnessAppendString(buffer, strings[ECHarnessRandom(state) % (sizeof(strings) / sizeof(strings[0]))]);
+            break;
+        case 2:
+        case 3:
+            ECHarnessAppendString(buffer, scalars[ECHarnessRandom(state) % (sizeof(scalars) / sizeof(scalars[0]))]);
+            break;
+        case 4:
+            snprintf(text, sizeof(text), "%lld", (long long)(ECHarnessRandom(state) % 2000001) - 1000000);
+            ECHarnessAppendString(buffer, text);
+            break;
+        default:
+            if (depth > 2)
+                ECHarnessAppendString(buffer, "[]");
+            else if (ECHarnessRandom(state) & 1)
+            {
+                ECHarnessAppendString(buffer, "{\"Name\":");
+                _append_Value(buffer, state, depth + 1);
+                ECHarnessAppendString(buffer, ",\"Count\":[1,{\"Open\":true}]}");
+            }
+            else
+            {
+                ECHarnessAppendString(buffer, "[");
+                _append_Value(buffer, state, depth + 1);
+                ECHarnessAppendString(buffer, ",null]");
+            }
+            break;
+    }
+}
+
+static char* _fuzz_Document(unsigned long long *state, size_t *length)
+{
+    static const char *keys[] = {"Name", "Count", "Ratio", "Open", "Note", "name", "Other", "Names", ""};
+    ECHarnessBuffer buffer = {NULL, 0, 0};
+    size_t records = ECHarnessRandom(state) % MAX_RECORDS, i, j;
+
+    // Decoys before and after the records
+    ECHarnessAppendString(&buffer, "{\"meta\":{\"results\":[{\"Name\":\"decoy\"}]},\"result\":{\"other\":{\"results\":[{\"Name\":\"decoy\"}]},\"count\":1,\"results\":[");
+
+    for (i = 0; i < records; i++)
+    {
+        size_t members = ECHarnessRandom(state) % 9;
+
+        if (i > 0)
+            ECHarnessAppendString(&buffer, ",");
+
+        // Some elements are not records
+        if (0 == ECHarnessRandom(state) % 8)
+        {
+            _append_Value(&buffer, state, 1);
+            continue;
+        }
+
+        ECHarnessAppendString(&buffer, "{");
+
+        for (j = 0; j < members; j++)
+        {
+            if (j > 0)
+                ECHarnessAppendString(&buffer, ",");
+
+            ECHarnessAppendString(&buffer, "\"");
+            ECHarnessAppendString(&buffer, keys[ECHarnessRandom(state) % (sizeof(keys) / sizeof(keys[0]))]);
+            ECHarnessAppendString(&buffer, "\":");
+            _append_Value(&buffer, state, 1);
+        }
+
+        ECHarnessAppendString(&buffer, "}");
+    }
+
+    ECHarnessAppendString(&buffer, "]},\"tail\":[{\"Name\":\"after\"}]}");
+    *length = buffer.length;
+
+    return buffer.bytes;
+}
+
+static void _fuzz(void)
+{
+    static ECRecords decoded, indexed, expected;
+    unsigned long long state = 0x9E3779B97F4A7C15ULL;
+    ECJSONStructuralIndex index;
+    int i, mismatches = 0, truncatedAccepted = 0;
+
+    memset(&index, 0, sizeof(index));
+
+    for (i = 0; i < FUZZ_COUNT; i++)
+    {
+        size_t length = 0, cut;
+        char *text = _fuzz_Document(&state, &length);
+        ECJSONParseStatus status;
+        ECValue *root = ECHarnessParseTree(text, length, 0, &status);
+
+        EC_CHECK(ECJSONParseOK == status);
+        _reference_Records(root, &kFuzzSchema, &expected);
+
+        decoded.count = indexed.count = 0;
+        status = ECSchemaDecode(text, length, &kFuzzSchema, _collect_Record, &decoded, NULL, NULL);
+        EC_CHECK(ECJSONParseOK == status);
+
+        if (ECJSONParseOK == ECJSONStructuralIndexBuild(&index, text, length, ECJSONKernelAuto, NULL))
+            EC_CHECK(ECJSONParseOK == ECSchemaDecodeWithIndex(text, length, &index, &kFuzzSchema, _collect_Record, &indexed, NULL, NULL));
+
+        if (!_equal_Records(&decoded, &expected, &kFuzzSchema) || !_equal_Records(&indexed, &expected, &kFuzzSchema))
+            mismatches++;
+
+        // A truncated document is rejected by both
+        cut = ECHarnessRandom(&state) % length;
+        decoded.count = 0;
+
+        if (ECJSONParseOK == ECSchemaDecode(text, cut, &kFuzzSchema, _collect_Record, &decoded, NULL, NULL))
+            truncatedAccepted++;
+
+        if (ECJSONParseOK == ECJSONStructuralIndexBuild(&index, text, cut, ECJSONKernelAuto, NULL) &&
+            ECJSONParseOK == ECSchemaDecodeWithIndex(text, cut, &index, &kFuzzSchema, _collect_Record, &indexed, NULL, NULL))
+            truncatedAccepted++;
+
+        ECHarnessRelease(root, 1);
+        free(text);
+    }
+
+    EC_CHECK(0 == mismatches);
+    EC_CHECK(0 == truncatedAccepted);
+    printf("fuzz: %d documents, %d mismatches against the generic tree, %d truncated documents accepted\n", FUZZ_COUNT, mismatches, truncatedAccepted);
+
+    ECJSONStructuralIndexDestroy(&index);
+}
+
+// The benchmark, both ways only sum the lengths of the five strings, as the records keep them
+
+static int _sum_Record(void *context, const ECSchemaValue *values, size_t count)
+{
+    size_t i;
+
+    for (i = 0; i < count; i++)
+        *(size_t*)context += values[i].length;
+
+    return 0;
+}
+
+static size_t _sum_Tree(const ECValue *root)
+{
+    const ECValue *array = _member(_member(root, "result"), "results");
+    size_t i, f, sum = 0;
+
+    for (i = 0; NULL != array && i < array->count; i++)
+    {
+        for (f = 0; f < kParkSchema.fieldCount; f++)
+        {
+            const ECValue *value = _member(array->items[i], kParkFields[f].name);
+
+            if (NULL != value && kValueString == value->type)
+                sum += value->length;
+        }
+    }
+
+    return sum;
+}
+
+static double _best(double start, double best)
+{
+    double time = ECHarnessNow() - start;
+
+    return (time < best) ? time : best;
+}
+
+static void _benchmark(void)
+{
+    size_t length = 0, treeSum = 0, schemaSum = 0, indexSum = 0, records = 0, allocations = 0, treeBytes = 0;
+    char *feed = ECHarnessMakeFeed(FEED_RECORDS, 60, 0x2545F4914F6CDD1DULL, &length);
+    double treeTime = 1e9, schemaTime = 1e9, indexTime = 1e9, start;
+    ECJSONStructuralIndex index;
+    ECJSONParseStatus status;
+    int round;
+
+    memset(&index, 0, sizeof(index));
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        ECValue *root;
+
+        ECHarnessAllocationCount = ECHarnessAllocationBytes = 0;
+        start = ECHarnessNow();
+        root = ECHarnessParseTree(feed, length, ECJSONParseSkipNullMembers, &status);
+        treeSum = _sum_Tree(root);
+        ECHarnessRelease(root, 1);
+        treeTime = _best(start, treeTime);
+        allocations = ECHarnessAllocationCount;
+        treeBytes = ECHarnessAllocationBytes;
+
+        schemaSum = 0;
+        start = ECHarnessNow();
+        EC_CHECK(ECJSONParseOK == ECSchemaDecode(feed, length, &kParkSchema, _sum_Record, &schemaSum, &records, NULL));
+        schemaTime = _best(start, schemaTime);
+
+        indexSum = 0;
+        start = ECHarnessNow();
+        EC_CHECK(ECJSONParseOK == ECJSONStructuralIndexBuild(&index, feed, length, ECJSONKernelAuto, NULL));
+        EC_CHECK(ECJSONParseOK == ECSchemaDecodeWithIndex(feed, length, &index, &kParkSchema, _sum_Record, &indexSum, NULL, NULL));
+        indexTime = _best(start, indexTime);
+    }
+
+    EC_CHECK(FEED_RECORDS == records);
+    EC_CHECK(treeSum == schemaSum && treeSum == indexSum);
+
+    printf("feed of %d records, %zu KB, best of %d:\n", FEED_RECORDS, length / 1024, BENCH_ROUNDS);
+    printf("  generic tree then fields: %.1f ms, %.0f MB/s, %zu allocations, %zu KB\n", treeTime * 1e3, length / treeTime / 1e6, allocations, treeBytes / 1024);
+    printf("  schema decoder:           %.1f ms, %.0f MB/s\n", schemaTime * 1e3, length / schemaTime / 1e6);
+    printf("  index (%s) and decoder: %.1f ms, %.0f MB/s\n", ECJSONKernelName(index.kernel), indexTime * 1e3, length / indexTime / 1e6);
+
+    ECJSONStructuralIndexDestroy(&index);
+    free(feed);
+}
+
+int main(void)
+{
+    _fuzz();
+    _benchmark();
+
+    return EC_HARNESS_RESULT("ECSchemaDecoderTest");
+}
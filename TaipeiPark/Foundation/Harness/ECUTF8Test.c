@@ -0,0 +1,277 @@
+/**
+ * \file 	ECUTF8Test.c
+ * \brief	The test of ECUTF8, each kernel against a reference decoder, and the throughput of the
+ *          validation and the transcoding on CJK text.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#include "ECUTF8.h"
+#include "ECHarnessFeed.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_COUNT          200000
+#define TEXT_SIZE           (8 * 1024 * 1024)
+#define INTRODUCTION_SIZE   600
+
+static const ECUTF8Kernel kKernels[] = {ECUTF8KernelScalar, ECUTF8KernelSSSE3, ECUTF8KernelAVX2, ECUTF8KernelNEON};
+
+#define KERNEL_COUNT        (sizeof(kKernels) / sizeof(kKernels[0]))
+
+/**
+ * \brief	The reference, one code point at a time.
+ * \return	The count of the UTF-16 code units, or -1 with the offset of the first malformed sequence.
+ */
+static long _reference_Decode(const uint8_t *s, size_t length, uint16_t *out, size_t *errorOffset)
+{
+    size_t i = 0, n = 0;
+
+    while (i < length)
+    {
+        uint32_t c = s[i], minimum;
+        size_t count, j;
+
+        if (c < 0x80)
+        {
+            count = 1;
+            minimum = 0;
+        }
+        else if (c >= 0xC2 && c <= 0xDF)
+        {
+            count = 2;
+            minimum = 0x80;
+            c &= 0x1F;
+        }
+        else if (c >= 0xE0 && c <= 0xEF)
+        {
+            count = 3;
+            minimum = 0x800;
+            c &= 0x0F;
+        }
+        else if (c >= 0xF0 && c <= 0xF4)
+        {
+            count = 4;
+            minimum = 0x10000;
+            c &= 0x07;
+        }
+        else
+        {
+            *errorOffset = i;
+            return -1;
+        }
+
+        if (i + count > length)
+        {
+            *errorOffset = i;
+            return -1;
+        }
+
+        for (j = 1; j < count; j++)
+        {
+            if (0x80 != (s[i + j] & 0xC0))
+            {
+                *errorOffset = i;
+                return -1;
+            }
+
+            c = (c << 6) | (s[i + j] & 0x3F);
+        }
+
+        if (c < minimum || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+        {
+            *errorOffset = i;
+            return -1;
+        }
+
+        if (c >= 0x10000)
+        {
+            if (NULL != out)
+            {
+                out[n] = (uint16_t)(0xD800 + ((c - 0x10000) >> 10));
+                out[n + 1] = (uint16_t)(0xDC00 + ((c - 0x10000) & 0x3FF));
+            }
+
+            n += 2;
+        }
+        else
+        {
+            if (NULL != out)
+                out[n] = (uint16_t)c;
+
+            n++;
+        }
+
+        i += count;
+    }
+
+    return (long)n;
+}
+
+static size_t _append_Random(uint8_t *s, unsigned long long *state)
+{
+    static const char *sequences[] = {"\xE5\x85\xAC", "\xE5\x9C\x92", "\xEF\xBC\x8C", "\xC3\xA9", "\xF0\x9F\x8C\xB3", "\xE2\x80\x94", "\xEF\xBF\xBF", "\xF4\x8F\xBF\xBF"};
+    static const char *malformed[] = {"\xC0\x80", "\xC1\xBF", "\xE0\x80\x80", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80",
+                                      "\xF5\x80\x80\x80", "\xFF", "\x80", "\xBF", "\xE5\x85", "\xF0\x9F\x8C", "\xC3"};
+    unsigned long long r = ECHarnessRandom(state);
+    const char *piece;
+
+    if (r % 100 < 45)
+    {
+        s[0] = (uint8_t)(0x20 + r / 100 % 0x5F);
+        return 1;
+    }
+
+    if (r % 100 < 99)
+        piece = sequences[r / 100 % (sizeof(sequences) / sizeof(sequences[0]))];
+    else
+        piece = malformed[r / 100 % (sizeof(malformed) / sizeof(malformed[0]))];
+
+    memcpy(s, piece, strlen(piece));
+
+    return strlen(piece);
+}
+
+static void _fuzz(void)
+{
+    static uint8_t text[512];
+    static uint16_t expected[512], out[512];
+    unsigned long long state = 0x853C49E6748FEA9BULL;
+    int i, mismatches = 0, invalid = 0;
+    size_t k;
+
+    for (i = 0; i < FUZZ_COUNT; i++)
+    {
+        size_t length = 0, target = ECHarnessRandom(&state) % 160, expectedOffset = 0;
+        long count;
+
+        while (length < target)
+            length += _append_Random(text + length, &state);
+
+        count = _reference_Decode(text, length, expected, &expectedOffset);
+        invalid += (count < 0);
+
+        for (k = 0; k < KERNEL_COUNT; k++)
+        {
+            size_t offset = (size_t)-1;
+            int valid;
+
+            if (!ECUTF8KernelIsSupported(kKernels[k]))
+                continue;
+
+            valid = ECUTF8Validate((const char*)text, length, kKernels[k], &offset);
+
+            if (valid != (count >= 0) || (!valid && offset != expectedOffset))
+            {
+                mismatches++;
+                continue;
+            }
+
+            if (valid && ((size_t)count != ECUTF8UTF16Length((const char*)text, length) ||
+                          (size_t)count != ECUTF8ToUTF16((const char*)text, length, out, kKernels[k]) ||
+                          0 != memcmp(out, expected, (size_t)count * sizeof(uint16_t))))
+                mismatches++;
+        }
+    }
+
+    EC_CHECK(0 == mismatches);
+
+    printf("kernels:");
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+        printf(" %s%s", ECUTF8KernelName(kKernels[k]), ECUTF8KernelIsSupported(kKernels[k]) ? "" : " (not supported)");
+
+    printf(", best %s\n", ECUTF8KernelName(ECUTF8BestKernel()));
+    printf("fuzz: %d strings, %d of them malformed, %d mismatches\n", FUZZ_COUNT, invalid, mismatches);
+}
+
+/**
+ * \brief	The best time of the rounds over the strings of the size, the last one shorter.
+ * \param   transcodes  0 for the validation, 1 for the transcoding, 2 for the reference decoder.
+ */
+static double _measure(const char *text, size_t length, size_t size, ECUTF8Kernel kernel, int transcodes, uint16_t *out, int rounds)
+{
+    double best = 1e9, start, time;
+    size_t offset = 0;
+    int round;
+
+    for (round = 0; round < rounds; round++)
+    {
+        size_t from = 0;
+
+        start = ECHarnessNow();
+
+        while (from < length)
+        {
+            size_t to = (from + size < length) ? from + size : length;
+
+            // The strings of the feed are cut on character boundaries
+            while (to < length && 0x80 == ((uint8_t)text[to] & 0xC0))
+                to++;
+
+            if (0 == transcodes)
+                EC_CHECK(ECUTF8Validate(text + from, to - from, kernel, NULL));
+            else if (1 == transcodes)
+                ECUTF8ToUTF16(text + from, to - from, out, kernel);
+            else
+                EC_CHECK(0 <= _reference_Decode((const uint8_t*)text + from, to - from, out, &offset));
+
+            from = to;
+        }
+
+        if ((time = ECHarnessNow() - start) < best)
+            best = time;
+    }
+
+    return length / best / 1e6;
+}
+
+static void _benchmark(const char *name, const char *text, size_t length)
+{
+    uint16_t *out = (uint16_t*)malloc((length + 1) * sizeof(uint16_t));
+    size_t units = ECUTF8UTF16Length(text, length), k;
+
+    printf("%s, %.1f MB, %.2f bytes of UTF-16 per byte of UTF-8, in MB/s of UTF-8:\n", name, length / 1048576.0, 2.0 * units / length);
+    printf("  %-10s %9s %10s %14s %15s\n", "", "validate", "transcode", "validate 600 B", "transcode 600 B");
+    printf("  %-10s %9s %10.0f %14s %15.0f\n", "reference", "", _measure(text, length, length, ECUTF8KernelScalar, 2, out, 3),
+           "", _measure(text, length, INTRODUCTION_SIZE, ECUTF8KernelScalar, 2, out, 3));
+
+    for (k = 0; k < KERNEL_COUNT; k++)
+    {
+        if (!ECUTF8KernelIsSupported(kKernels[k]))
+            continue;
+
+        printf("  %-10s %9.0f %10.0f %14.0f %15.0f\n", ECUTF8KernelName(kKernels[k]),
+               _measure(text, length, length, kKernels[k], 0, out, 5), _measure(text, length, length, kKernels[k], 1, out, 5),
+               _measure(text, length, INTRODUCTION_SIZE, kKernels[k], 0, out, 5), _measure(text, length, INTRODUCTION_SIZE, kKernels[k], 1, out, 5));
+    }
+
+    free(out);
+}
+
+int main(void)
+{
+    ECHarnessBuffer cjk = {NULL, 0, 0}, ascii = {NULL, 0, 0};
+    unsigned long long state = 0x2545F4914F6CDD1DULL;
+    char line[96];
+    size_t i = 0;
+
+    _fuzz();
+
+    // The introductions of the feed, and the image URLs for the ASCII case
+    while (cjk.length < TEXT_SIZE)
+        ECHarnessAppendParagraph(&cjk, &state, 60);
+
+    while (ascii.length < TEXT_SIZE)
+    {
+        snprintf(line, sizeof(line), "http://parks.taipei/parks/m2/pkl_%05zu.jpg", i++);
+        ECHarnessAppendString(&ascii, line);
+    }
+
+    _benchmark("CJK introductions", cjk.bytes, cjk.length);
+    _benchmark("ASCII image URLs", ascii.bytes, ascii.length);
+
+    free(cjk.bytes);
+    free(ascii.bytes);
+
+    return EC_HARNESS_RESULT("ECUTF8Test");
+}
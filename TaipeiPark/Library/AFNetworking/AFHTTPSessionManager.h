@@ -290,6 +290,27 @@ NS_ASSUME_NONNULL_BEGIN
                          success:(nullable void (^)(NSURLSessionDataTask *task, id _Nullable responseObject))success
                          failure:(nullable void (^)(NSURLSessionDataTask * _Nullable task, NSError *error))failure;
 
+#ifdef DEBUG
+
+///---------------
+/// @name Benchmark
+///---------------
+
+/**
+ Uploads a multipart body with a memory-mapped file part to the `upload` path of the stand-in server of `Harness/ECImageStandInServer.py`, once unthrottled and once throttled, one after the other. Each upload checks the byte count the server received against the content length of the body.
+
+ @param server The URL of the stand-in server, e.g. `http://127.0.0.1:8765`.
+ @param megabytes The size of the file part.
+ @param bytesPerSecond The rate of the throttled upload, in 16 KB packets.
+ @param completion A block called on the main queue with the report of the time and the rate of each upload.
+ */
++ (void)benchmarkUploadsToServer:(NSURL *)server
+                       megabytes:(NSUInteger)megabytes
+         throttledBytesPerSecond:(NSUInteger)bytesPerSecond
+                      completion:(void (^)(NSString *report))completion;
+
+#endif
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -358,4 +358,70 @@
     return HTTPClient;
 }
 
+#pragma mark - Benchmark
+
+#ifdef DEBUG
+
+static NSUInteger const AFUploadBenchmarkPacketSize = 16 * 1024;
+
+static void AFBenchmarkUpload(AFHTTPSessionManager *manager, NSURL *URL, NSURL *fileURL, NSUInteger bytesPerSecond, NSMutableString *report, void (^completion)(void)) {
+    NSError *serializationError = nil;
+    NSMutableURLRequest *request = [manager.requestSerializer multipartFormRequestWithMethod:@"POST" URLString:URL.absoluteString parameters:@{@"name": @"benchmark"} constructingBodyWithBlock:^(id<AFMultipartFormData> formData) {
+        [formData appendPartWithFileURL:fileURL name:@"image" error:nil];
+        if (bytesPerSecond > 0) {
+            [formData throttleBandwidthWithPacketSize:AFUploadBenchmarkPacketSize delay:(NSTimeInterval)AFUploadBenchmarkPacketSize / bytesPerSecond];
+        }
+    } error:&serializationError];
+
+    if (serializationError) {
+        [report appendFormat:@"FAILED %@\n", serializationError.localizedDescription];
+        completion();
+        return;
+    }
+
+    long long contentLength = [[request valueForHTTPHeaderField:@"Content-Length"] longLongValue];
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+
+    [[manager uploadTaskWithStreamedRequest:request progress:nil completionHandler:^(NSURLResponse *response, id responseObject, NSError *error) {
+        CFAbsoluteTime time = CFAbsoluteTimeGetCurrent() - start;
+        long long received = [responseObject isKindOfClass:[NSDictionary class]] ? [responseObject[@"bytes"] longLongValue] : -1;
+        NSString *rate = (bytesPerSecond > 0) ? [NSString stringWithFormat:@"throttled to %.2f MB/s", bytesPerSecond / 1048576.0] : @"unthrottled";
+
+        if (error) {
+            [report appendFormat:@"FAILED %@: %@\n", rate, error.localizedDescription];
+        } else {
+            [report appendFormat:@"%@ %@: %.1f MB in %.2f s, %.2f MB/s, %lld of %lld bytes received\n", (received == contentLength) ? @"OK    " : @"FAILED", rate, contentLength / 1048576.0, time, contentLength / 1048576.0 / MAX(time, 1e-9), received, contentLength];
+        }
+        completion();
+    }] resume];
+}
+
++ (void)benchmarkUploadsToServer:(NSURL *)server
+                       megabytes:(NSUInteger)megabytes
+         throttledBytesPerSecond:(NSUInteger)bytesPerSecond
+                      completion:(void (^)(NSString *report))completion
+{
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"AFUploadBenchmark.jpg"]];
+    NSURL *URL = [server URLByAppendingPathComponent:@"upload"];
+    NSMutableString *report = [NSMutableString string];
+
+    // Zeros, the file part is mapped and read in slices, so its content does not matter
+    if (![[NSMutableData dataWithLength:megabytes * 1024 * 1024] writeToURL:fileURL atomically:YES]) {
+        completion(@"FAILED the file part could not be written\n");
+        return;
+    }
+
+    AFHTTPSessionManager *manager = [[self alloc] initWithBaseURL:nil sessionConfiguration:[NSURLSessionConfiguration ephemeralSessionConfiguration]];
+
+    AFBenchmarkUpload(manager, URL, fileURL, 0, report, ^{
+        AFBenchmarkUpload(manager, URL, fileURL, bytesPerSecond, report, ^{
+            [manager invalidateSessionCancelingTasks:NO];
+            [[NSFileManager defaultManager] removeItemAtURL:fileURL error:nil];
+            completion(report);
+        });
+    });
+}
+
+#endif
+
 @end
@@ -0,0 +1,163 @@
+// AFNetworkMetrics.h
+// Copyright (c) 2011–2016 Alamofire Software Foundation ( http://alamofire.org/ )
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The phases of a request recorded by `AFNetworkMetricsCollector`.
+
+ `AFNetworkMetricsPhaseTimeToFirstByte` is measured from the request start, so it does not depend on the connection. The cold and warm phases are measured from the fetch start, including the DNS lookup and the handshakes, and are split by whether the transaction opened a new connection or reused one.
+ */
+typedef NS_ENUM(NSInteger, AFNetworkMetricsPhase) {
+    AFNetworkMetricsPhaseDomainLookup = 0,
+    AFNetworkMetricsPhaseConnect,
+    AFNetworkMetricsPhaseSecureConnection,
+    AFNetworkMetricsPhaseTimeToFirstByte,
+    AFNetworkMetricsPhaseTransfer,
+    AFNetworkMetricsPhaseTotal,
+    AFNetworkMetricsPhaseSerialization,
+    AFNetworkMetricsPhaseColdTimeToFirstByte,
+    AFNetworkMetricsPhaseWarmTimeToFirstByte,
+    AFNetworkMetricsPhaseCount
+};
+
+/**
+ Returns a short name for the phase, used in the dump output.
+ */
+FOUNDATION_EXPORT NSString * AFNetworkMetricsPhaseName(AFNetworkMetricsPhase phase);
+
+/**
+ `AFNetworkMetricsSummary` is an immutable snapshot of one histogram. All durations are in seconds.
+ */
+@interface AFNetworkMetricsSummary : NSObject
+
+@property (readonly, nonatomic, assign) AFNetworkMetricsPhase phase;
+@property (readonly, nonatomic, assign) NSUInteger count;
+@property (readonly, nonatomic, assign) NSTimeInterval min;
+@property (readonly, nonatomic, assign) NSTimeInterval max;
+@property (readonly, nonatomic, assign) NSTimeInterval mean;
+@property (readonly, nonatomic, assign) NSTimeInterval p50;
+@property (readonly, nonatomic, assign) NSTimeInterval p90;
+@property (readonly, nonatomic, assign) NSTimeInterval p99;
+
+@end
+
+/**
+ `AFNetworkMetricsCollector` aggregates the `NSURLSessionTaskMetrics` of the tasks run by an `AFURLSessionManager`, together with the time spent by its response serializer, into per-host and per-endpoint latency histograms.
+
+ Recording is asynchronous on a private serial queue, so it is safe to record from the session delegate queue and the processing queue. An endpoint is identified by the host and path of the request URL, the query string is ignored. The path segments made of digits, of a long hexadecimal value or of a UUID are replaced by `:id`, so `/items/42` and `/items/43` are one endpoint.
+ */
+@interface AFNetworkMetricsCollector : NSObject
+
+/**
+ The shared collector, used by the app for all session managers.
+ */
++ (instancetype)sharedCollector;
+
+/**
+ The maximum count of endpoints with histograms, `64` by default. Each endpoint holds up to one histogram of about 20 KB per phase, so once the count is reached, the least recently recorded endpoint is removed. The hosts are not limited.
+ */
+@property (nonatomic, assign) NSUInteger maximumEndpointCount;
+
+///---------------
+/// @name Recording
+///---------------
+
+/**
+ Records the transaction metrics of a finished task. Only the last transaction, the one that produced the response, is recorded. Transactions served from the local cache are skipped.
+ */
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics NS_AVAILABLE_IOS(10_0);
+
+/**
+ Records the transaction metrics of a finished task, for the host and, if `perEndpoint` is `YES`, for the endpoint.
+ */
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics perEndpoint:(BOOL)perEndpoint NS_AVAILABLE_IOS(10_0);
+
+/**
+ Records a duration for the specified request and phase.
+
+ @param duration The duration in seconds.
+ @param phase The phase to record.
+ @param request The request, used to get the host and the endpoint.
+ */
+- (void)recordDuration:(NSTimeInterval)duration phase:(AFNetworkMetricsPhase)phase forRequest:(NSURLRequest *)request;
+
+/**
+ Records a duration for the specified request and phase, for the host and, if `perEndpoint` is `YES`, for the endpoint.
+ */
+- (void)recordDuration:(NSTimeInterval)duration phase:(AFNetworkMetricsPhase)phase forRequest:(NSURLRequest *)request perEndpoint:(BOOL)perEndpoint;
+
+///--------------
+/// @name Queries
+///--------------
+
+/**
+ The hosts that have recorded values.
+ */
+- (NSArray <NSString *> *)hosts;
+
+/**
+ The endpoints, formatted as `host/path`, that have recorded values.
+ */
+- (NSArray <NSString *> *)endpoints;
+
+/**
+ Returns the summary of the specified host and phase, or `nil` if nothing has been recorded.
+ */
+- (nullable AFNetworkMetricsSummary *)summaryForHost:(NSString *)host phase:(AFNetworkMetricsPhase)phase;
+
+/**
+ Returns the summary of the specified endpoint and phase, or `nil` if nothing has been recorded.
+ */
+- (nullable AFNetworkMetricsSummary *)summaryForEndpoint:(NSString *)endpoint phase:(AFNetworkMetricsPhase)phase;
+
+/**
+ A human readable table of all the recorded histograms.
+ */
+- (NSString *)dump;
+
+/**
+ Removes all recorded values.
+ */
+- (void)reset;
+
+///---------------------
+/// @name Periodic Dump
+///---------------------
+
+/**
+ Starts to dump the recorded histograms periodically.
+
+ @param interval The interval of the dump, in seconds.
+ @param handler The block to receive the dump, called on a private queue. If `nil`, the dump is written by `NSLog`.
+ */
+- (void)startPeriodicDumpWithInterval:(NSTimeInterval)interval handler:(nullable void (^)(NSString *dump))handler;
+
+/**
+ Stops the periodic dump.
+ */
+- (void)stopPeriodicDump;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,413 @@
+// AFNetworkMetrics.m
+// Copyright (c) 2011–2016 Alamofire Software Foundation ( http://alamofire.org/ )
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#import "AFNetworkMetrics.h"
+#import "ECHistogram.h"
+
+// Durations are recorded in microseconds, from 1us to 2 minutes with 2 significant figures (~20KB per histogram).
+static int64_t const AFNetworkMetricsLowestValue = 1;
+static int64_t const AFNetworkMetricsHighestValue = 120LL * 1000 * 1000;
+static int const AFNetworkMetricsSignificantFigures = 2;
+
+static NSUInteger const AFNetworkMetricsDefaultMaximumEndpointCount = 64;
+
+NSString * AFNetworkMetricsPhaseName(AFNetworkMetricsPhase phase) {
+    switch (phase) {
+        case AFNetworkMetricsPhaseDomainLookup:     return @"dns";
+        case AFNetworkMetricsPhaseConnect:          return @"connect";
+        case AFNetworkMetricsPhaseSecureConnection: return @"tls";
+        case AFNetworkMetricsPhaseTimeToFirstByte:  return @"ttfb";
+        case AFNetworkMetricsPhaseTransfer:         return @"transfer";
+        case AFNetworkMetricsPhaseTotal:            return @"total";
+        case AFNetworkMetricsPhaseSerialization:    return @"serialize";
+        case AFNetworkMetricsPhaseColdTimeToFirstByte: return @"ttfb.cold";
+        case AFNetworkMetricsPhaseWarmTimeToFirstByte: return @"ttfb.warm";
+        default:                                    return @"unknown";
+    }
+}
+
+static inline NSTimeInterval AFNetworkMetricsInterval(NSDate *start, NSDate *end) {
+    if (!start || !end) {
+        return -1;
+    }
+    return [end timeIntervalSinceDate:start];
+}
+
+static BOOL AFNetworkMetricsIsIdentifier(NSString *segment) {
+    static NSCharacterSet *nonDigits = nil;
+    static NSCharacterSet *nonHexDigits = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+        nonHexDigits = [[NSCharacterSet characterSetWithCharactersInString:@"0123456789abcdefABCDEF-"] invertedSet];
+    });
+
+    if (segment.length == 0) {
+        return NO;
+    }
+    if ([segment rangeOfCharacterFromSet:nonDigits].location == NSNotFound) {
+        return YES;
+    }
+
+    // A long hexadecimal value or a UUID, e.g. a resource ID or a hash
+    return segment.length >= 16 && [segment rangeOfCharacterFromSet:nonHexDigits].location == NSNotFound;
+}
+
+// The path with the identifier segments replaced, so the IDs in the paths do not make new endpoints.
+static NSString * AFNetworkMetricsNormalizedPath(NSString *path) {
+    if (path.length == 0) {
+        return @"/";
+    }
+
+    NSMutableArray *segments = [[path componentsSeparatedByString:@"/"] mutableCopy];
+    for (NSUInteger i = 0; i < segments.count; i++) {
+        if (AFNetworkMetricsIsIdentifier(segments[i])) {
+            segments[i] = @":id";
+        }
+    }
+    return [segments componentsJoinedByString:@"/"];
+}
+
+// Wrapped in a struct so it can be captured by a block.
+typedef struct {
+    NSTimeInterval values[AFNetworkMetricsPhaseCount];
+} AFNetworkMetricsDurations;
+
+#pragma mark -
+
+@interface AFNetworkMetricsSummary ()
+@property (readwrite, nonatomic, assign) AFNetworkMetricsPhase phase;
+@property (readwrite, nonatomic, assign) NSUInteger count;
+@property (readwrite, nonatomic, assign) NSTimeInterval min;
+@property (readwrite, nonatomic, assign) NSTimeInterval max;
+@property (readwrite, nonatomic, assign) NSTimeInterval mean;
+@property (readwrite, nonatomic, assign) NSTimeInterval p50;
+@property (readwrite, nonatomic, assign) NSTimeInterval p90;
+@property (readwrite, nonatomic, assign) NSTimeInterval p99;
+@end
+
+@implementation AFNetworkMetricsSummary
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%-9@ n=%-5lu p50=%8.1fms p90=%8.1fms p99=%8.1fms max=%8.1fms",
+            AFNetworkMetricsPhaseName(self.phase), (unsigned long)self.count,
+            self.p50 * 1000.0, self.p90 * 1000.0, self.p99 * 1000.0, self.max * 1000.0];
+}
+
+@end
+
+#pragma mark -
+
+/**
+ Holds one histogram per phase for a host or an endpoint. The histograms are created on first use.
+ */
+@interface _AFNetworkMetricsHistogramSet : NSObject
+- (void)recordMicroseconds:(int64_t)value phase:(AFNetworkMetricsPhase)phase;
+- (AFNetworkMetricsSummary *)summaryForPhase:(AFNetworkMetricsPhase)phase;
+@end
+
+@implementation _AFNetworkMetricsHistogramSet {
+    ECHistogram *_histograms[AFNetworkMetricsPhaseCount];
+}
+
+- (void)dealloc {
+    for (NSInteger i = 0; i < AFNetworkMetricsPhaseCount; i++) {
+        if (_histograms[i]) {
+            ECHistogramDestroy(_histograms[i]);
+            free(_histograms[i]);
+        }
+    }
+}
+
+- (void)recordMicroseconds:(int64_t)value phase:(AFNetworkMetricsPhase)phase {
+    if (phase < 0 || phase >= AFNetworkMetricsPhaseCount) {
+        return;
+    }
+
+    if (!_histograms[phase]) {
+        ECHistogram *histogram = malloc(sizeof(ECHistogram));
+        if (!histogram || 0 != ECHistogramInit(histogram, AFNetworkMetricsLowestValue, AFNetworkMetricsHighestValue, AFNetworkMetricsSignificantFigures)) {
+            free(histogram);
+            return;
+        }
+        _histograms[phase] = histogram;
+    }
+
+    ECHistogramRecordValue(_histograms[phase], value);
+}
+
+- (AFNetworkMetricsSummary *)summaryForPhase:(AFNetworkMetricsPhase)phase {
+    if (phase < 0 || phase >= AFNetworkMetricsPhaseCount || !_histograms[phase]) {
+        return nil;
+    }
+
+    ECHistogram *histogram = _histograms[phase];
+    AFNetworkMetricsSummary *summary = [[AFNetworkMetricsSummary alloc] init];
+    summary.phase = phase;
+    summary.count = (NSUInteger)ECHistogramTotalCount(histogram);
+    summary.min = ECHistogramMin(histogram) / 1e6;
+    summary.max = ECHistogramMax(histogram) / 1e6;
+    summary.mean = ECHistogramMean(histogram) / 1e6;
+    summary.p50 = ECHistogramValueAtPercentile(histogram, 50.0) / 1e6;
+    summary.p90 = ECHistogramValueAtPercentile(histogram, 90.0) / 1e6;
+    summary.p99 = ECHistogramValueAtPercentile(histogram, 99.0) / 1e6;
+
+    return summary;
+}
+
+@end
+
+#pragma mark -
+
+@interface AFNetworkMetricsCollector ()
+@property (nonatomic, strong) dispatch_queue_t synchronizationQueue;
+@property (nonatomic, strong) NSMutableDictionary <NSString *, _AFNetworkMetricsHistogramSet *> *histogramsKeyedByHost;
+@property (nonatomic, strong) NSMutableDictionary <NSString *, _AFNetworkMetricsHistogramSet *> *histogramsKeyedByEndpoint;
+@property (nonatomic, strong) NSMutableOrderedSet <NSString *> *endpointsByRecentUse;
+@property (nonatomic, strong) dispatch_source_t dumpTimer;
+@end
+
+@implementation AFNetworkMetricsCollector
+
++ (instancetype)sharedCollector {
+    static AFNetworkMetricsCollector *sharedCollector = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCollector = [[self alloc] init];
+    });
+    return sharedCollector;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        NSString *name = [NSString stringWithFormat:@"com.alamofire.networking.metrics-%@", [[NSUUID UUID] UUIDString]];
+        self.synchronizationQueue = dispatch_queue_create([name cStringUsingEncoding:NSASCIIStringEncoding], DISPATCH_QUEUE_SERIAL);
+        self.histogramsKeyedByHost = [[NSMutableDictionary alloc] init];
+        self.histogramsKeyedByEndpoint = [[NSMutableDictionary alloc] init];
+        self.endpointsByRecentUse = [[NSMutableOrderedSet alloc] init];
+        _maximumEndpointCount = AFNetworkMetricsDefaultMaximumEndpointCount;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self stopPeriodicDump];
+}
+
+#pragma mark - Recording
+
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics {
+    [self recordTaskMetrics:metrics perEndpoint:YES];
+}
+
+- (void)recordTaskMetrics:(NSURLSessionTaskMetrics *)metrics perEndpoint:(BOOL)perEndpoint {
+    NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+    if (!transaction || transaction.resourceFetchType == NSURLSessionTaskMetricsResourceFetchTypeLocalCache) {
+        return;
+    }
+
+    AFNetworkMetricsDurations durations;
+    for (NSInteger i = 0; i < AFNetworkMetricsPhaseCount; i++) {
+        durations.values[i] = -1;
+    }
+
+    // A reused connection has no lookup, connect and TLS dates, so nothing is recorded for them.
+    durations.values[AFNetworkMetricsPhaseDomainLookup] = AFNetworkMetricsInterval(transaction.domainLookupStartDate, transaction.domainLookupEndDate);
+    durations.values[AFNetworkMetricsPhaseConnect] = AFNetworkMetricsInterval(transaction.connectStartDate, transaction.connectEndDate);
+    durations.values[AFNetworkMetricsPhaseSecureConnection] = AFNetworkMetricsInterval(transaction.secureConnectionStartDate, transaction.secureConnectionEndDate);
+    durations.values[AFNetworkMetricsPhaseTimeToFirstByte] = AFNetworkMetricsInterval(transaction.requestStartDate, transaction.responseStartDate);
+    durations.values[AFNetworkMetricsPhaseTransfer] = AFNetworkMetricsInterval(transaction.responseStartDate, transaction.responseEndDate);
+    durations.values[AFNetworkMetricsPhaseTotal] = metrics.taskInterval.duration;
+
+    AFNetworkMetricsPhase firstBytePhase = transaction.isReusedConnection ? AFNetworkMetricsPhaseWarmTimeToFirstByte : AFNetworkMetricsPhaseColdTimeToFirstByte;
+    durations.values[firstBytePhase] = AFNetworkMetricsInterval(transaction.fetchStartDate, transaction.responseStartDate);
+
+    NSURLRequest *request = transaction.request;
+
+    dispatch_async(self.synchronizationQueue, ^{
+        for (NSInteger i = 0; i < AFNetworkMetricsPhaseCount; i++) {
+            if (durations.values[i] >= 0) {
+                [self safelyRecordDuration:durations.values[i] phase:i forURL:request.URL perEndpoint:perEndpoint];
+            }
+        }
+    });
+}
+
+- (void)recordDuration:(NSTimeInterval)duration phase:(AFNetworkMetricsPhase)phase forRequest:(NSURLRequest *)request {
+    [self recordDuration:duration phase:phase forRequest:request perEndpoint:YES];
+}
+
+- (void)recordDuration:(NSTimeInterval)duration phase:(AFNetworkMetricsPhase)phase forRequest:(NSURLRequest *)request perEndpoint:(BOOL)perEndpoint {
+    if (duration < 0 || !request.URL) {
+        return;
+    }
+
+    NSURL *URL = request.URL;
+    dispatch_async(self.synchronizationQueue, ^{
+        [self safelyRecordDuration:duration phase:phase forURL:URL perEndpoint:perEndpoint];
+    });
+}
+
+- (void)safelyRecordDuration:(NSTimeInterval)duration phase:(AFNetworkMetricsPhase)phase forURL:(NSURL *)URL perEndpoint:(BOOL)perEndpoint {
+    NSString *host = URL.host ?: @"";
+    int64_t microseconds = (int64_t)llround(duration * 1e6);
+
+    _AFNetworkMetricsHistogramSet *hostSet = self.histogramsKeyedByHost[host];
+    if (!hostSet) {
+        hostSet = [[_AFNetworkMetricsHistogramSet alloc] init];
+        self.histogramsKeyedByHost[host] = hostSet;
+    }
+    [hostSet recordMicroseconds:microseconds phase:phase];
+
+    if (!perEndpoint || self.maximumEndpointCount == 0) {
+        return;
+    }
+
+    NSString *endpoint = [host stringByAppendingString:AFNetworkMetricsNormalizedPath(URL.path)];
+    _AFNetworkMetricsHistogramSet *endpointSet = self.histogramsKeyedByEndpoint[endpoint];
+    if (!endpointSet) {
+        // The least recently recorded endpoints make room
+        while (self.endpointsByRecentUse.count >= self.maximumEndpointCount) {
+            [self.histogramsKeyedByEndpoint removeObjectForKey:self.endpointsByRecentUse.firstObject];
+            [self.endpointsByRecentUse removeObjectAtIndex:0];
+        }
+        endpointSet = [[_AFNetworkMetricsHistogramSet alloc] init];
+        self.histogramsKeyedByEndpoint[endpoint] = endpointSet;
+    } else {
+        [self.endpointsByRecentUse removeObject:endpoint];
+    }
+    [self.endpointsByRecentUse addObject:endpoint];
+    [endpointSet recordMicroseconds:microseconds phase:phase];
+}
+
+#pragma mark - Queries
+
+- (NSArray <NSString *> *)hosts {
+    __block NSArray *hosts = nil;
+    dispatch_sync(self.synchronizationQueue, ^{
+        hosts = [self.histogramsKeyedByHost.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    });
+    return hosts;
+}
+
+- (NSArray <NSString *> *)endpoints {
+    __block NSArray *endpoints = nil;
+    dispatch_sync(self.synchronizationQueue, ^{
+        endpoints = [self.histogramsKeyedByEndpoint.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    });
+    return endpoints;
+}
+
+- (AFNetworkMetricsSummary *)summaryForHost:(NSString *)host phase:(AFNetworkMetricsPhase)phase {
+    __block AFNetworkMetricsSummary *summary = nil;
+    dispatch_sync(self.synchronizationQueue, ^{
+        summary = [self.histogramsKeyedByHost[host] summaryForPhase:phase];
+    });
+    return summary;
+}
+
+- (AFNetworkMetricsSummary *)summaryForEndpoint:(NSString *)endpoint phase:(AFNetworkMetricsPhase)phase {
+    __block AFNetworkMetricsSummary *summary = nil;
+    dispatch_sync(self.synchronizationQueue, ^{
+        summary = [self.histogramsKeyedByEndpoint[endpoint] summaryForPhase:phase];
+    });
+    return summary;
+}
+
+- (NSString *)dump {
+    __block NSString *dump = nil;
+    dispatch_sync(self.synchronizationQueue, ^{
+        dump = [self safelyDump];
+    });
+    return dump;
+}
+
+- (NSString *)safelyDump {
+    NSMutableString *dump = [NSMutableString stringWithString:@"[AFNetworkMetrics]\n"];
+
+    void (^appendSets)(NSDictionary *) = ^(NSDictionary *setsKeyedByName) {
+        for (NSString *name in [setsKeyedByName.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            _AFNetworkMetricsHistogramSet *set = setsKeyedByName[name];
+            [dump appendFormat:@"  %@\n", name];
+            for (NSInteger i = 0; i < AFNetworkMetricsPhaseCount; i++) {
+                AFNetworkMetricsSummary *summary = [set summaryForPhase:i];
+                if (summary) {
+                    [dump appendFormat:@"    %@\n", summary];
+                }
+            }
+        }
+    };
+
+    [dump appendString:@" hosts:\n"];
+    appendSets(self.histogramsKeyedByHost);
+    [dump appendString:@" endpoints:\n"];
+    appendSets(self.histogramsKeyedByEndpoint);
+
+    return dump;
+}
+
+- (void)reset {
+    dispatch_async(self.synchronizationQueue, ^{
+        [self.histogramsKeyedByHost removeAllObjects];
+        [self.histogramsKeyedByEndpoint removeAllObjects];
+        [self.endpointsByRecentUse removeAllObjects];
+    });
+}
+
+#pragma mark - Periodic Dump
+
+- (void)startPeriodicDumpWithInterval:(NSTimeInterval)interval handler:(void (^)(NSString *dump))handler {
+    [self stopPeriodicDump];
+
+    if (interval <= 0) {
+        return;
+    }
+
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.synchronizationQueue);
+    uint64_t nanoseconds = (uint64_t)(interval * NSEC_PER_SEC);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)nanoseconds), nanoseconds, nanoseconds / 10);
+
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_source_set_event_handler(timer, ^{
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        NSString *dump = [strongSelf safelyDump];
+        if (!dump) {
+            return;
+        }
+        if (handler) {
+            handler(dump);
+        } else {
+            NSLog(@"%@", dump);
+        }
+    });
+
+    self.dumpTimer = timer;
+    dispatch_resume(timer);
+}
+
+- (void)stopPeriodicDump {
+    if (self.dumpTimer) {
+        dispatch_source_cancel(self.dumpTimer);
+        self.dumpTimer = nil;
+    }
+}
+
+@end
@@ -273,6 +273,28 @@ forHTTPHeaderField:(NSString *)field;
                              writingStreamContentsToFile:(NSURL *)fileURL
                                        completionHandler:(nullable void (^)(NSError * _Nullable error))handler;
 
+#ifdef DEBUG
+
+/**
+ Builds GET requests with a few query parameters and a changed timeout, once by setting the changed properties through key-value coding on each request, as before the request template, and once from the template.
+
+ @param iterations The number of requests built each way.
+
+ @return The report of the requests built per second each way.
+ */
++ (NSString *)benchmarkRequestsWithIterations:(NSUInteger)iterations;
+
+/**
+ Builds the query strings of a few hundred parameters of ASCII, Chinese and emoji values, once with `AFQueryStringFromParameters` and once as before the single buffer builder: a pair object per parameter, each key and value escaped in batches of 50 characters through `NSCharacterSet`, and the pairs joined at the end. The two queries must be the same.
+
+ @param iterations The number of queries built each way.
+
+ @return The report of the time per query each way, or of the mismatch.
+ */
++ (NSString *)benchmarkQueryStringsWithIterations:(NSUInteger)iterations;
+
+#endif
+
 @end
 
 #pragma mark -
@@ -365,6 +387,8 @@ forHTTPHeaderField:(NSString *)field;
 /**
  Throttles request bandwidth by limiting the packet size and adding a delay for each chunk read from the upload stream.
 
+ The throttling is a token bucket holding at most one packet and refilled at `numberOfBytes / delay` bytes per second. The upload stream does not sleep after each packet: when the bucket is empty it reports no bytes available and signals the session again once it has been refilled. A client reading the stream without waiting for the events is never blocked either: it gets the bytes the tokens allow, at least one, and the next event waits until that debt is refilled.
+
  When uploading over a 3G or EDGE connection, requests may fail with "request body stream exhausted". Setting a maximum packet size and delay according to the recommended values (`kAFUploadStream3GSuggestedPacketSize` and `kAFUploadStream3GSuggestedDelay`) lowers the risk of the input stream exceeding its allocated bandwidth. Unfortunately, there is no definite way to distinguish between a 3G, EDGE, or LTE connection over `NSURLConnection`. As such, it is not recommended that you throttle bandwidth based solely on network reachability. Instead, you should consider checking for the "request body stream exhausted" in a failure block, and then retrying the request with throttled bandwidth.
 
  @param numberOfBytes Maximum packet size, in number of bytes. The default packet size for an input stream is 16kb.
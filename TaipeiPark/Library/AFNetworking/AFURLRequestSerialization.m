@@ -20,6 +20,7 @@
 // THE SOFTWARE.
 
 #import "AFURLRequestSerialization.h"
+#import "ECPercentEncoding.h"
 
 #if TARGET_OS_IOS || TARGET_OS_WATCH || TARGET_OS_TV
 #import <MobileCoreServices/MobileCoreServices.h>
@@ -32,6 +33,105 @@ NSString * const AFNetworkingOperationFailingURLRequestErrorKey = @"com.alamofir
 
 typedef NSString * (^AFQueryStringSerializationBlock)(NSURLRequest *request, id parameters, NSError *__autoreleasing *error);
 
+#pragma mark -
+
+/**
+ The output of the query string builder. The bytes are only ASCII, so the buffer is handed over to the resulting string without a copy.
+ */
+typedef struct {
+    char *bytes;
+    size_t length;
+    size_t capacity;
+    NSUInteger count;
+} AFQueryBuffer;
+
+static BOOL AFQueryBufferReserve(AFQueryBuffer *buffer, size_t additional) {
+    if (buffer->length + additional <= buffer->capacity) {
+        return YES;
+    }
+
+    size_t capacity = MAX(buffer->capacity * 2, buffer->length + additional);
+    char *bytes = realloc(buffer->bytes, capacity);
+    if (!bytes) {
+        return NO;
+    }
+
+    buffer->bytes = bytes;
+    buffer->capacity = capacity;
+
+    return YES;
+}
+
+static void AFQueryBufferAppendBytes(AFQueryBuffer *buffer, const char *bytes, size_t length) {
+    if (length > 0 && AFQueryBufferReserve(buffer, length)) {
+        memcpy(buffer->bytes + buffer->length, bytes, length);
+        buffer->length += length;
+    }
+}
+
+static void AFQueryBufferAppendPercentEscapedString(AFQueryBuffer *buffer, NSString *string) {
+    NSUInteger length = string.length;
+    if (length == 0) {
+        return;
+    }
+
+    uint8_t stackBytes[512];
+    uint8_t *heapBytes = NULL;
+    NSData *lossyData = nil;
+    const uint8_t *utf8 = NULL;
+    size_t utf8Length = 0;
+
+    // ASCII fast path, the string already stores its characters as ASCII bytes, one per character.
+    const char *cString = CFStringGetCStringPtr((__bridge CFStringRef)string, kCFStringEncodingUTF8);
+    if (cString) {
+        utf8 = (const uint8_t *)cString;
+        utf8Length = length;
+    } else {
+        // A UTF-16 unit takes at most 3 bytes in UTF-8.
+        NSUInteger maxLength = length * 3;
+        uint8_t *bytes = stackBytes;
+        if (maxLength > sizeof(stackBytes)) {
+            bytes = heapBytes = malloc(maxLength);
+        }
+
+        NSUInteger usedLength = 0;
+        NSRange remainingRange = NSMakeRange(0, 0);
+        if (bytes && [string getBytes:bytes maxLength:maxLength usedLength:&usedLength encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, length) remainingRange:&remainingRange] && remainingRange.length == 0) {
+            utf8 = bytes;
+            utf8Length = usedLength;
+        } else {
+            // Unpaired surrogates can not be converted strictly.
+            lossyData = [string dataUsingEncoding:NSUTF8StringEncoding allowLossyConversion:YES];
+            utf8 = lossyData.bytes;
+            utf8Length = lossyData.length;
+        }
+    }
+
+    size_t encodedLength = ECPercentEncodedLength(utf8, utf8Length, ECPercentEncodingSetQuery);
+    if (encodedLength > 0 && AFQueryBufferReserve(buffer, encodedLength)) {
+        buffer->length += ECPercentEncode(utf8, utf8Length, buffer->bytes + buffer->length, ECPercentEncodingSetQuery);
+    }
+
+    free(heapBytes);
+}
+
+static NSString * AFQueryBufferCopyString(AFQueryBuffer *buffer) {
+    NSString *string = nil;
+    if (buffer->length > 0) {
+        string = [[NSString alloc] initWithBytesNoCopy:buffer->bytes length:buffer->length encoding:NSASCIIStringEncoding freeWhenDone:YES];
+    }
+
+    if (!string) {
+        free(buffer->bytes);
+        string = @"";
+    }
+
+    buffer->bytes = NULL;
+    buffer->length = buffer->capacity = 0;
+
+    return string;
+}
+
 /**
  Returns a percent-escaped string following RFC 3986 for a query string key or value.
  RFC 3986 states that the following characters are "reserved" characters.
@@ -41,42 +141,16 @@ typedef NSString * (^AFQueryStringSerializationBlock)(NSURLRequest *request, id
  In RFC 3986 - Section 3.4, it states that the "?" and "/" characters should not be escaped to allow
  query strings to include a URL. Therefore, all "reserved" characters with the exception of "?" and "/"
  should be percent-escaped in the query string.
+
+ The UTF-8 bytes are escaped one by one with a lookup table, so composed character sequences such as 👴🏻👮🏽 are never broken up.
     - parameter string: The string to be percent-escaped.
     - returns: The percent-escaped string.
  */
 NSString * AFPercentEscapedStringFromString(NSString *string) {
-    static NSString * const kAFCharactersGeneralDelimitersToEncode = @":#[]@"; // does not include "?" or "/" due to RFC 3986 - Section 3.4
-    static NSString * const kAFCharactersSubDelimitersToEncode = @"!$&'()*+,;=";
-
-    NSMutableCharacterSet * allowedCharacterSet = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
-    [allowedCharacterSet removeCharactersInString:[kAFCharactersGeneralDelimitersToEncode stringByAppendingString:kAFCharactersSubDelimitersToEncode]];
-
-	// FIXME: https://github.com/AFNetworking/AFNetworking/pull/3028
-    // return [string stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacterSet];
-
-    static NSUInteger const batchSize = 50;
-
-    NSUInteger index = 0;
-    NSMutableString *escaped = @"".mutableCopy;
-
-    while (index < string.length) {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wgnu"
-        NSUInteger length = MIN(string.length - index, batchSize);
-#pragma GCC diagnostic pop
-        NSRange range = NSMakeRange(index, length);
+    AFQueryBuffer buffer = {NULL, 0, 0, 0};
+    AFQueryBufferAppendPercentEscapedString(&buffer, string);
 
-        // To avoid breaking up character sequences such as 👴🏻👮🏽
-        range = [string rangeOfComposedCharacterSequencesForRange:range];
-
-        NSString *substring = [string substringWithRange:range];
-        NSString *encoded = [substring stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacterSet];
-        [escaped appendString:encoded];
-
-        index += range.length;
-    }
-
-	return escaped;
+    return AFQueryBufferCopyString(&buffer);
 }
 
 #pragma mark -
@@ -86,8 +160,6 @@ NSString * AFPercentEscapedStringFromString(NSString *string) {
 @property (readwrite, nonatomic, strong) id value;
 
 - (instancetype)initWithField:(id)field value:(id)value;
-
-- (NSString *)URLEncodedStringValue;
 @end
 
 @implementation AFQueryStringPair
@@ -104,14 +176,6 @@ NSString * AFPercentEscapedStringFromString(NSString *string) {
     return self;
 }
 
-- (NSString *)URLEncodedStringValue {
-    if (!self.value || [self.value isEqual:[NSNull null]]) {
-        return AFPercentEscapedStringFromString([self.field description]);
-    } else {
-        return [NSString stringWithFormat:@"%@=%@", AFPercentEscapedStringFromString([self.field description]), AFPercentEscapedStringFromString([self.value description])];
-    }
-}
-
 @end
 
 #pragma mark -
@@ -119,13 +183,86 @@ NSString * AFPercentEscapedStringFromString(NSString *string) {
 FOUNDATION_EXPORT NSArray * AFQueryStringPairsFromDictionary(NSDictionary *dictionary);
 FOUNDATION_EXPORT NSArray * AFQueryStringPairsFromKeyAndValue(NSString *key, id value);
 
-NSString * AFQueryStringFromParameters(NSDictionary *parameters) {
-    NSMutableArray *mutablePairs = [NSMutableArray array];
-    for (AFQueryStringPair *pair in AFQueryStringPairsFromDictionary(parameters)) {
-        [mutablePairs addObject:[pair URLEncodedStringValue]];
+// Sort dictionary keys to ensure consistent ordering in query string, which is important when deserializing potentially ambiguous sequences, such as an array of dictionaries
+static NSArray * AFSortedObjects(NSArray *objects) {
+    if (objects.count < 2) {
+        return objects;
     }
 
-    return [mutablePairs componentsJoinedByString:@"&"];
+    for (id object in objects) {
+        if (![object isKindOfClass:[NSString class]]) {
+            NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"description" ascending:YES selector:@selector(compare:)];
+            return [objects sortedArrayUsingDescriptors:@[ sortDescriptor ]];
+        }
+    }
+
+    // The description of a string is itself, skip the key-value coding.
+    return [objects sortedArrayUsingSelector:@selector(compare:)];
+}
+
+/**
+ Appends the pairs of the value to the query. `field` holds the percent-escaped field of the value, it is extended for the nested values and restored before returning.
+ */
+static void AFQueryBufferAppendKeyAndValue(AFQueryBuffer *buffer, AFQueryBuffer *field, id value) {
+    size_t fieldLength = field->length;
+
+    if ([value isKindOfClass:[NSDictionary class]]) {
+        NSDictionary *dictionary = value;
+        for (id nestedKey in AFSortedObjects(dictionary.allKeys)) {
+            if (fieldLength > 0 || field->count > 0) {
+                AFQueryBufferAppendBytes(field, "%5B", 3);
+                AFQueryBufferAppendPercentEscapedString(field, [nestedKey description]);
+                AFQueryBufferAppendBytes(field, "%5D", 3);
+            } else {
+                AFQueryBufferAppendPercentEscapedString(field, [nestedKey description]);
+            }
+            field->count++;
+
+            AFQueryBufferAppendKeyAndValue(buffer, field, dictionary[nestedKey]);
+
+            field->length = fieldLength;
+            field->count--;
+        }
+    } else if ([value isKindOfClass:[NSArray class]]) {
+        AFQueryBufferAppendBytes(field, "%5B%5D", 6);
+        field->count++;
+        for (id nestedValue in value) {
+            AFQueryBufferAppendKeyAndValue(buffer, field, nestedValue);
+        }
+        field->length = fieldLength;
+        field->count--;
+    } else if ([value isKindOfClass:[NSSet class]]) {
+        for (id obj in AFSortedObjects([value allObjects])) {
+            AFQueryBufferAppendKeyAndValue(buffer, field, obj);
+        }
+    } else {
+        if (buffer->count > 0) {
+            AFQueryBufferAppendBytes(buffer, "&", 1);
+        }
+        buffer->count++;
+
+        AFQueryBufferAppendBytes(buffer, field->bytes, field->length);
+        if (value && ![value isEqual:[NSNull null]]) {
+            AFQueryBufferAppendBytes(buffer, "=", 1);
+            AFQueryBufferAppendPercentEscapedString(buffer, [value description]);
+        }
+    }
+}
+
+NSString * AFQueryStringFromParameters(NSDictionary *parameters) {
+    // Most parameters are short, so the buffer rarely grows.
+    AFQueryBuffer buffer = {NULL, 0, 0, 0};
+    AFQueryBufferReserve(&buffer, MAX((size_t)64, parameters.count * 48));
+
+    // The field nests at most a few levels, it is reused by all the pairs.
+    AFQueryBuffer field = {NULL, 0, 0, 0};
+    AFQueryBufferReserve(&field, 128);
+
+    AFQueryBufferAppendKeyAndValue(&buffer, &field, parameters);
+
+    free(field.bytes);
+
+    return AFQueryBufferCopyString(&buffer);
 }
 
 NSArray * AFQueryStringPairsFromDictionary(NSDictionary *dictionary) {
@@ -135,12 +272,9 @@ NSArray * AFQueryStringPairsFromDictionary(NSDictionary *dictionary) {
 NSArray * AFQueryStringPairsFromKeyAndValue(NSString *key, id value) {
     NSMutableArray *mutableQueryStringComponents = [NSMutableArray array];
 
-    NSSortDescriptor *sortDescriptor = [NSSortDescriptor sortDescriptorWithKey:@"description" ascending:YES selector:@selector(compare:)];
-
     if ([value isKindOfClass:[NSDictionary class]]) {
         NSDictionary *dictionary = value;
-        // Sort dictionary keys to ensure consistent ordering in query string, which is important when deserializing potentially ambiguous sequences, such as an array of dictionaries
-        for (id nestedKey in [dictionary.allKeys sortedArrayUsingDescriptors:@[ sortDescriptor ]]) {
+        for (id nestedKey in AFSortedObjects(dictionary.allKeys)) {
             id nestedValue = dictionary[nestedKey];
             if (nestedValue) {
                 [mutableQueryStringComponents addObjectsFromArray:AFQueryStringPairsFromKeyAndValue((key ? [NSString stringWithFormat:@"%@[%@]", key, nestedKey] : nestedKey), nestedValue)];
@@ -153,7 +287,7 @@ NSArray * AFQueryStringPairsFromKeyAndValue(NSString *key, id value) {
         }
     } else if ([value isKindOfClass:[NSSet class]]) {
         NSSet *set = value;
-        for (id obj in [set sortedArrayUsingDescriptors:@[ sortDescriptor ]]) {
+        for (id obj in AFSortedObjects(set.allObjects)) {
             [mutableQueryStringComponents addObjectsFromArray:AFQueryStringPairsFromKeyAndValue(key, obj)];
         }
     } else {
@@ -163,6 +297,57 @@ NSArray * AFQueryStringPairsFromKeyAndValue(NSString *key, id value) {
     return mutableQueryStringComponents;
 }
 
+#ifdef DEBUG
+
+// The former escaping and query building, kept to be measured against the single buffer.
+
+static NSString * AFFormerPercentEscapedStringFromString(NSString *string) {
+    static NSString * const kAFCharactersGeneralDelimitersToEncode = @":#[]@"; // does not include "?" or "/" due to RFC 3986 - Section 3.4
+    static NSString * const kAFCharactersSubDelimitersToEncode = @"!$&'()*+,;=";
+
+    NSMutableCharacterSet * allowedCharacterSet = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
+    [allowedCharacterSet removeCharactersInString:[kAFCharactersGeneralDelimitersToEncode stringByAppendingString:kAFCharactersSubDelimitersToEncode]];
+
+    static NSUInteger const batchSize = 50;
+
+    NSUInteger index = 0;
+    NSMutableString *escaped = @"".mutableCopy;
+
+    while (index < string.length) {
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wgnu"
+        NSUInteger length = MIN(string.length - index, batchSize);
+#pragma GCC diagnostic pop
+        NSRange range = NSMakeRange(index, length);
+
+        // To avoid breaking up character sequences such as 👴🏻👮🏽
+        range = [string rangeOfComposedCharacterSequencesForRange:range];
+
+        NSString *substring = [string substringWithRange:range];
+        NSString *encoded = [substring stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacterSet];
+        [escaped appendString:encoded];
+
+        index += range.length;
+    }
+
+    return escaped;
+}
+
+static NSString * AFFormerQueryStringFromParameters(NSDictionary *parameters) {
+    NSMutableArray *mutablePairs = [NSMutableArray array];
+    for (AFQueryStringPair *pair in AFQueryStringPairsFromDictionary(parameters)) {
+        if (!pair.value || [pair.value isEqual:[NSNull null]]) {
+            [mutablePairs addObject:AFFormerPercentEscapedStringFromString([pair.field description])];
+        } else {
+            [mutablePairs addObject:[NSString stringWithFormat:@"%@=%@", AFFormerPercentEscapedStringFromString([pair.field description]), AFFormerPercentEscapedStringFromString([pair.value description])]];
+        }
+    }
+
+    return [mutablePairs componentsJoinedByString:@"&"];
+}
+
+#endif
+
 #pragma mark -
 
 @interface AFStreamingMultipartFormData : NSObject <AFMultipartFormData>
@@ -191,6 +376,9 @@ static void *AFHTTPRequestSerializerObserverContext = &AFHTTPRequestSerializerOb
 @property (readwrite, nonatomic, strong) NSMutableDictionary *mutableHTTPRequestHeaders;
 @property (readwrite, nonatomic, assign) AFHTTPRequestQueryStringSerializationStyle queryStringSerializationStyle;
 @property (readwrite, nonatomic, copy) AFQueryStringSerializationBlock queryStringSerialization;
+@property (readwrite, nonatomic, strong) NSURLRequest *requestTemplate;
+@property (readwrite, nonatomic, strong) NSDictionary *immutableHTTPRequestHeaders;
+@property (readwrite, nonatomic, strong) NSLock *requestTemplateLock;
 @end
 
 @implementation AFHTTPRequestSerializer
@@ -207,6 +395,9 @@ static void *AFHTTPRequestSerializerObserverContext = &AFHTTPRequestSerializerOb
 
     self.stringEncoding = NSUTF8StringEncoding;
 
+    self.requestTemplateLock = [[NSLock alloc] init];
+    self.requestTemplateLock.name = @"com.alamofire.networking.serializer.template.lock";
+
     self.mutableHTTPRequestHeaders = [NSMutableDictionary dictionary];
 
     // Accept-Language HTTP Header; see http://www.w3.org/Protocols/rfc2616/rfc2616-sec14.html#sec14.4
@@ -306,13 +497,26 @@ static void *AFHTTPRequestSerializerObserverContext = &AFHTTPRequestSerializerOb
 #pragma mark -
 
 - (NSDictionary *)HTTPRequestHeaders {
-    return [NSDictionary dictionaryWithDictionary:self.mutableHTTPRequestHeaders];
+    [self.requestTemplateLock lock];
+    if (!self.immutableHTTPRequestHeaders) {
+        self.immutableHTTPRequestHeaders = [NSDictionary dictionaryWithDictionary:self.mutableHTTPRequestHeaders];
+    }
+    NSDictionary *HTTPRequestHeaders = self.immutableHTTPRequestHeaders;
+    [self.requestTemplateLock unlock];
+
+    return HTTPRequestHeaders;
+}
+
+- (void)setMutableHTTPRequestHeaders:(NSMutableDictionary *)mutableHTTPRequestHeaders {
+    _mutableHTTPRequestHeaders = mutableHTTPRequestHeaders;
+    [self invalidateRequestTemplate];
 }
 
 - (void)setValue:(NSString *)value
 forHTTPHeaderField:(NSString *)field
 {
 	[self.mutableHTTPRequestHeaders setValue:value forKey:field];
+    [self invalidateRequestTemplate];
 }
 
 - (NSString *)valueForHTTPHeaderField:(NSString *)field {
@@ -329,6 +533,58 @@ forHTTPHeaderField:(NSString *)field
 
 - (void)clearAuthorizationHeader {
 	[self.mutableHTTPRequestHeaders removeObjectForKey:@"Authorization"];
+    [self invalidateRequestTemplate];
+}
+
+#pragma mark -
+
+- (void)invalidateRequestTemplate {
+    [self.requestTemplateLock lock];
+    self.requestTemplate = nil;
+    self.immutableHTTPRequestHeaders = nil;
+    [self.requestTemplateLock unlock];
+}
+
+/**
+ Returns a request with the changed observed properties and the default headers applied, built once and reused until the configuration changes. Requests are created by copying it, instead of going through key-value coding and copying the headers each time.
+ */
+- (NSURLRequest *)currentRequestTemplate {
+    [self.requestTemplateLock lock];
+    NSURLRequest *requestTemplate = self.requestTemplate;
+    if (!requestTemplate) {
+        NSMutableURLRequest *mutableRequest = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:@"about:blank"]];
+
+        // The unchanged properties keep the defaults of the request, as before.
+        NSSet *changedKeyPaths = self.mutableObservedChangedKeyPaths;
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(allowsCellularAccess))]) {
+            mutableRequest.allowsCellularAccess = self.allowsCellularAccess;
+        }
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(cachePolicy))]) {
+            mutableRequest.cachePolicy = self.cachePolicy;
+        }
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(HTTPShouldHandleCookies))]) {
+            mutableRequest.HTTPShouldHandleCookies = self.HTTPShouldHandleCookies;
+        }
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(HTTPShouldUsePipelining))]) {
+            mutableRequest.HTTPShouldUsePipelining = self.HTTPShouldUsePipelining;
+        }
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(networkServiceType))]) {
+            mutableRequest.networkServiceType = self.networkServiceType;
+        }
+        if ([changedKeyPaths containsObject:NSStringFromSelector(@selector(timeoutInterval))]) {
+            mutableRequest.timeoutInterval = self.timeoutInterval;
+        }
+
+        [self.mutableHTTPRequestHeaders enumerateKeysAndObjectsUsingBlock:^(id field, id value, BOOL * __unused stop) {
+            [mutableRequest setValue:value forHTTPHeaderField:field];
+        }];
+
+        requestTemplate = [mutableRequest copy];
+        self.requestTemplate = requestTemplate;
+    }
+    [self.requestTemplateLock unlock];
+
+    return requestTemplate;
 }
 
 #pragma mark -
@@ -356,18 +612,18 @@ forHTTPHeaderField:(NSString *)field
 
     NSParameterAssert(url);
 
-    NSMutableURLRequest *mutableRequest = [[NSMutableURLRequest alloc] initWithURL:url];
+    NSMutableURLRequest *mutableRequest = [[self currentRequestTemplate] mutableCopy];
+    mutableRequest.URL = url;
     mutableRequest.HTTPMethod = method;
 
-    for (NSString *keyPath in AFHTTPRequestSerializerObservedKeyPaths()) {
-        if ([self.mutableObservedChangedKeyPaths containsObject:keyPath]) {
-            [mutableRequest setValue:[self valueForKeyPath:keyPath] forKey:keyPath];
-        }
-    }
+    NSURLRequest *serializedRequest = [self requestBySerializingRequest:mutableRequest withParameters:parameters error:error];
 
-    mutableRequest = [[self requestBySerializingRequest:mutableRequest withParameters:parameters error:error] mutableCopy];
+    // The serialized request is already a new mutable copy, unless a subclass returns something else.
+    if ([serializedRequest isKindOfClass:[NSMutableURLRequest class]] && serializedRequest != mutableRequest) {
+        return (NSMutableURLRequest *)serializedRequest;
+    }
 
-	return mutableRequest;
+	return [serializedRequest mutableCopy];
 }
 
 - (NSMutableURLRequest *)multipartFormRequestWithMethod:(NSString *)method
@@ -533,11 +789,15 @@ forHTTPHeaderField:(NSString *)field
                        context:(void *)context
 {
     if (context == AFHTTPRequestSerializerObserverContext) {
+        [self.requestTemplateLock lock];
         if ([change[NSKeyValueChangeNewKey] isEqual:[NSNull null]]) {
             [self.mutableObservedChangedKeyPaths removeObject:keyPath];
         } else {
             [self.mutableObservedChangedKeyPaths addObject:keyPath];
         }
+        [self.requestTemplateLock unlock];
+
+        [self invalidateRequestTemplate];
     }
 }
 
@@ -575,6 +835,84 @@ forHTTPHeaderField:(NSString *)field
     return serializer;
 }
 
+#pragma mark - Benchmark
+
+#ifdef DEBUG
+
++ (NSString *)benchmarkRequestsWithIterations:(NSUInteger)iterations {
+    AFHTTPRequestSerializer *serializer = [self serializer];
+    serializer.timeoutInterval = 15;
+    [serializer setValue:@"application/json" forHTTPHeaderField:@"Accept"];
+    NSDictionary *parameters = @{@"scope": @"resourceAquire", @"rid": @"bf073841-c734-49bf-a97f-3757a6013812", @"limit": @"1000"};
+    NSString *URLString = @"https://data.taipei/opendata/datalist/apiAccess";
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            NSMutableURLRequest *mutableRequest = [[NSMutableURLRequest alloc] initWithURL:[NSURL URLWithString:URLString]];
+            mutableRequest.HTTPMethod = @"GET";
+            for (NSString *keyPath in AFHTTPRequestSerializerObservedKeyPaths()) {
+                if ([serializer.mutableObservedChangedKeyPaths containsObject:keyPath]) {
+                    [mutableRequest setValue:[serializer valueForKeyPath:keyPath] forKey:keyPath];
+                }
+            }
+            mutableRequest = [[serializer requestBySerializingRequest:mutableRequest withParameters:parameters error:nil] mutableCopy];
+        }
+    }
+    CFAbsoluteTime formerTime = CFAbsoluteTimeGetCurrent() - start;
+
+    start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            [serializer requestWithMethod:@"GET" URLString:URLString parameters:parameters error:nil];
+        }
+    }
+    CFAbsoluteTime templateTime = CFAbsoluteTimeGetCurrent() - start;
+
+    return [NSString stringWithFormat:@"%lu GET requests: key-value coding %.0f, template %.0f requests per second",
+            (unsigned long)iterations, iterations / MAX(formerTime, 1e-9), iterations / MAX(templateTime, 1e-9)];
+}
+
++ (NSString *)benchmarkQueryStringsWithIterations:(NSUInteger)iterations {
+    NSArray *words = @[@"park", @"attraction", @"大安森林公園", @"a b", @"x&y=z", @"resourceAquire", @"👴🏻👮🏽"];
+    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < 300; i++) {
+        NSMutableString *value = [NSMutableString string];
+        for (NSUInteger count = 1 + arc4random_uniform(6); count > 0; count--) {
+            [value appendString:words[arc4random_uniform((uint32_t)words.count)]];
+        }
+        parameters[[NSString stringWithFormat:@"key%03lu", (unsigned long)i]] = value;
+    }
+    parameters[@"filter"] = @{@"district": @"大安區", @"tags": @[@"公園", @"步道"]};
+
+    NSString *query = AFQueryStringFromParameters(parameters);
+    if (![query isEqualToString:AFFormerQueryStringFromParameters(parameters)]) {
+        return [NSString stringWithFormat:@"the queries differ, %@", query];
+    }
+
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            AFFormerQueryStringFromParameters(parameters);
+        }
+    }
+    CFAbsoluteTime formerTime = CFAbsoluteTimeGetCurrent() - start;
+
+    start = CFAbsoluteTimeGetCurrent();
+    for (NSUInteger i = 0; i < iterations; i++) {
+        @autoreleasepool {
+            AFQueryStringFromParameters(parameters);
+        }
+    }
+    CFAbsoluteTime bufferTime = CFAbsoluteTimeGetCurrent() - start;
+
+    return [NSString stringWithFormat:@"%lu queries of %lu parameters, %lu bytes: pairs %.3f ms, single buffer %.3f ms, %.1fx",
+            (unsigned long)iterations, (unsigned long)parameters.count, (unsigned long)query.length,
+            formerTime * 1000 / MAX(iterations, 1), bufferTime * 1000 / MAX(iterations, 1), formerTime / MAX(bufferTime, 1e-9)];
+}
+
+#endif
+
 @end
 
 #pragma mark -
@@ -825,7 +1163,19 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
 @property (readwrite, copy) NSError *streamError;
 @end
 
-@interface AFMultipartBodyStream () <NSCopying>
+@interface AFMultipartBodyStream () <NSCopying> {
+    double _availableTokens;
+    NSTimeInterval _lastRefillTime;
+    dispatch_queue_t _refillQueue;
+    dispatch_block_t _refillBlock;
+
+    NSLock *_clientLock;
+    CFOptionFlags _clientFlags;
+    CFReadStreamClientCallBack _clientCallback;
+    CFStreamClientContext _clientContext;
+    CFRunLoopRef _clientRunLoop;
+    CFStringRef _clientRunLoopMode;
+}
 @property (readwrite, nonatomic, assign) NSStringEncoding stringEncoding;
 @property (readwrite, nonatomic, strong) NSMutableArray *HTTPBodyParts;
 @property (readwrite, nonatomic, strong) NSEnumerator *HTTPBodyPartEnumerator;
@@ -854,9 +1204,20 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
     self.HTTPBodyParts = [NSMutableArray array];
     self.numberOfBytesInPacket = NSIntegerMax;
 
+    // The pending refill event is only read and written on this queue.
+    _refillQueue = dispatch_queue_create("com.alamofire.networking.multipart.refill", DISPATCH_QUEUE_SERIAL);
+
+    // The client is set on the stream thread and read by the refill events, so it is only touched under this lock.
+    _clientLock = [[NSLock alloc] init];
+
     return self;
 }
 
+- (void)dealloc {
+    [self _setCFClientFlags:0 callback:NULL context:NULL];
+    [self _unscheduleFromCFRunLoop:_clientRunLoop forMode:_clientRunLoopMode];
+}
+
 - (void)setInitialAndFinalBoundaries {
     if ([self.HTTPBodyParts count] > 0) {
         for (AFHTTPBodyPart *bodyPart in self.HTTPBodyParts) {
@@ -877,6 +1238,30 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
     return [self.HTTPBodyParts count] == 0;
 }
 
+#pragma mark - Throttling
+
+- (BOOL)isThrottled {
+    return self.delay > 0.0f && self.numberOfBytesInPacket > 0;
+}
+
+- (double)bytesPerSecond {
+    return (double)self.numberOfBytesInPacket / self.delay;
+}
+
+- (void)refillTokens {
+    NSTimeInterval now = [[NSProcessInfo processInfo] systemUptime];
+    if (_lastRefillTime <= 0) {
+        _availableTokens = self.numberOfBytesInPacket;
+    } else {
+        _availableTokens = MIN((double)self.numberOfBytesInPacket, _availableTokens + (now - _lastRefillTime) * [self bytesPerSecond]);
+    }
+    _lastRefillTime = now;
+}
+
+- (NSTimeInterval)timeUntilTokensAvailable {
+    return MAX(0, (1.0 - _availableTokens) / [self bytesPerSecond]);
+}
+
 #pragma mark - NSInputStream
 
 - (NSInteger)read:(uint8_t *)buffer
@@ -886,31 +1271,44 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
         return 0;
     }
 
+    NSUInteger maxLength = MIN(length, self.numberOfBytesInPacket);
+
+    if ([self isThrottled]) {
+        [self refillTokens];
+
+        // Only the bytes the tokens allow. Returning 0 would end the stream, so an empty bucket still gives one byte, and the debt holds back hasBytesAvailable and the refill event until it is paid.
+        maxLength = MIN(maxLength, (NSUInteger)MAX(1.0, _availableTokens));
+    }
+
     NSInteger totalNumberOfBytesRead = 0;
 
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wgnu"
-    while ((NSUInteger)totalNumberOfBytesRead < MIN(length, self.numberOfBytesInPacket)) {
+    while ((NSUInteger)totalNumberOfBytesRead < maxLength) {
         if (!self.currentHTTPBodyPart || ![self.currentHTTPBodyPart hasBytesAvailable]) {
             if (!(self.currentHTTPBodyPart = [self.HTTPBodyPartEnumerator nextObject])) {
                 break;
             }
         } else {
-            NSUInteger maxLength = MIN(length, self.numberOfBytesInPacket) - (NSUInteger)totalNumberOfBytesRead;
-            NSInteger numberOfBytesRead = [self.currentHTTPBodyPart read:&buffer[totalNumberOfBytesRead] maxLength:maxLength];
+            NSInteger numberOfBytesRead = [self.currentHTTPBodyPart read:&buffer[totalNumberOfBytesRead] maxLength:maxLength - (NSUInteger)totalNumberOfBytesRead];
             if (numberOfBytesRead == -1) {
                 self.streamError = self.currentHTTPBodyPart.inputStream.streamError;
                 break;
             } else {
                 totalNumberOfBytesRead += numberOfBytesRead;
-
-                if (self.delay > 0.0f) {
-                    [NSThread sleepForTimeInterval:self.delay];
-                }
             }
         }
     }
-#pragma clang diagnostic pop
+
+    if ([self isThrottled]) {
+        _availableTokens -= totalNumberOfBytesRead;
+    }
+
+    if (totalNumberOfBytesRead == 0 && !self.streamError) {
+        [self postClientEvent:kCFStreamEventEndEncountered];
+    } else if ([self hasBytesAvailable]) {
+        [self postClientEvent:kCFStreamEventHasBytesAvailable];
+    } else {
+        [self scheduleRefillEvent];
+    }
 
     return totalNumberOfBytesRead;
 }
@@ -922,7 +1320,102 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
 }
 
 - (BOOL)hasBytesAvailable {
-    return [self streamStatus] == NSStreamStatusOpen;
+    if ([self streamStatus] != NSStreamStatusOpen) {
+        return NO;
+    }
+
+    if ([self isThrottled]) {
+        [self refillTokens];
+        return _availableTokens >= 1.0;
+    }
+
+    return YES;
+}
+
+#pragma mark - Client Events
+
+- (void)postClientEvent:(CFStreamEventType)event {
+    [_clientLock lock];
+    if (!_clientCallback || !_clientRunLoop || !(_clientFlags & event)) {
+        [_clientLock unlock];
+        return;
+    }
+
+    // Retained, as the stream thread may unschedule the client as soon as the lock is released.
+    CFRunLoopRef runLoop = (CFRunLoopRef)CFRetain(_clientRunLoop);
+    CFStringRef runLoopMode = (CFStringRef)CFRetain(_clientRunLoopMode);
+    [_clientLock unlock];
+
+    __weak __typeof__(self) weakSelf = self;
+    CFRunLoopPerformBlock(runLoop, runLoopMode, ^{
+        [weakSelf deliverClientEvent:event];
+    });
+    CFRunLoopWakeUp(runLoop);
+
+    CFRelease(runLoopMode);
+    CFRelease(runLoop);
+}
+
+- (void)deliverClientEvent:(CFStreamEventType)event {
+    [_clientLock lock];
+    if (!_clientCallback || !(_clientFlags & event)) {
+        [_clientLock unlock];
+        return;
+    }
+
+    // The client of the time of the delivery, kept alive while it is called outside the lock.
+    CFReadStreamClientCallBack callback = _clientCallback;
+    void *info = _clientContext.info;
+    void (*releaseInfo)(void *) = _clientContext.release;
+    if (info && _clientContext.retain) {
+        info = (void *)_clientContext.retain(info);
+    }
+    [_clientLock unlock];
+
+    callback((__bridge CFReadStreamRef)self, event, info);
+
+    if (info && releaseInfo) {
+        releaseInfo(info);
+    }
+}
+
+- (void)scheduleRefillEvent {
+    if (![self isThrottled] || [self streamStatus] != NSStreamStatusOpen) {
+        return;
+    }
+
+    // The tokens belong to the reading thread, so the delay is computed here.
+    int64_t delay = (int64_t)([self timeUntilTokensAvailable] * NSEC_PER_SEC);
+    dispatch_queue_t refillQueue = _refillQueue;
+
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_async(refillQueue, ^{
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (!strongSelf || strongSelf->_refillBlock) {
+            return;
+        }
+
+        // Kept until it fires, so close can cancel it.
+        strongSelf->_refillBlock = dispatch_block_create(0, ^{
+            __strong __typeof__(weakSelf) refillingSelf = weakSelf;
+            if (refillingSelf) {
+                refillingSelf->_refillBlock = nil;
+                [refillingSelf postClientEvent:kCFStreamEventHasBytesAvailable];
+            }
+        });
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, delay), refillQueue, strongSelf->_refillBlock);
+    });
+}
+
+- (void)cancelRefillEvent {
+    __weak __typeof__(self) weakSelf = self;
+    dispatch_async(_refillQueue, ^{
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        if (strongSelf && strongSelf->_refillBlock) {
+            dispatch_block_cancel(strongSelf->_refillBlock);
+            strongSelf->_refillBlock = nil;
+        }
+    });
 }
 
 #pragma mark - NSStream
@@ -936,10 +1429,15 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
 
     [self setInitialAndFinalBoundaries];
     self.HTTPBodyPartEnumerator = [self.HTTPBodyParts objectEnumerator];
+
+    _lastRefillTime = 0;
+    [self postClientEvent:kCFStreamEventOpenCompleted];
+    [self postClientEvent:kCFStreamEventHasBytesAvailable];
 }
 
 - (void)close {
     self.streamStatus = NSStreamStatusClosed;
+    [self cancelRefillEvent];
 }
 
 - (id)propertyForKey:(__unused NSString *)key {
@@ -971,18 +1469,64 @@ NSTimeInterval const kAFUploadStream3GSuggestedDelay = 0.2;
 
 #pragma mark - Undocumented CFReadStream Bridged Methods
 
-- (void)_scheduleInCFRunLoop:(__unused CFRunLoopRef)aRunLoop
-                     forMode:(__unused CFStringRef)aMode
-{}
+// The client events are only needed to resume a throttled stream without blocking the reading thread.
 
-- (void)_unscheduleFromCFRunLoop:(__unused CFRunLoopRef)aRunLoop
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)aRunLoop
+                     forMode:(CFStringRef)aMode
+{
+    [_clientLock lock];
+    if (aRunLoop && aMode && !_clientRunLoop) {
+        _clientRunLoop = (CFRunLoopRef)CFRetain(aRunLoop);
+        _clientRunLoopMode = CFStringCreateCopy(kCFAllocatorDefault, aMode);
+    }
+    [_clientLock unlock];
+}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)aRunLoop
                          forMode:(__unused CFStringRef)aMode
-{}
+{
+    [_clientLock lock];
+    if (!aRunLoop || aRunLoop != _clientRunLoop) {
+        [_clientLock unlock];
+        return;
+    }
 
-- (BOOL)_setCFClientFlags:(__unused CFOptionFlags)inFlags
-                 callback:(__unused CFReadStreamClientCallBack)inCallback
-                  context:(__unused CFStreamClientContext *)inContext {
-    return NO;
+    CFRunLoopRef runLoop = _clientRunLoop;
+    CFStringRef runLoopMode = _clientRunLoopMode;
+    _clientRunLoop = NULL;
+    _clientRunLoopMode = NULL;
+    [_clientLock unlock];
+
+    CFRelease(runLoop);
+    CFRelease(runLoopMode);
+}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)inFlags
+                 callback:(CFReadStreamClientCallBack)inCallback
+                  context:(CFStreamClientContext *)inContext {
+    BOOL isSet = inCallback && [self isThrottled];
+    CFStreamClientContext context;
+    memset(&context, 0, sizeof(CFStreamClientContext));
+    if (isSet && inContext) {
+        memcpy(&context, inContext, sizeof(CFStreamClientContext));
+        if (context.info && context.retain) {
+            context.info = (void *)context.retain(context.info);
+        }
+    }
+
+    [_clientLock lock];
+    CFStreamClientContext previousContext = _clientContext;
+    _clientContext = context;
+    _clientFlags = isSet ? inFlags : 0;
+    _clientCallback = isSet ? inCallback : NULL;
+    [_clientLock unlock];
+
+    // Released outside the lock, a pending delivery holds its own reference.
+    if (previousContext.info && previousContext.release) {
+        previousContext.release(previousContext.info);
+    }
+
+    return isSet;
 }
 
 #pragma mark - NSCopying
@@ -1013,6 +1557,9 @@ typedef enum {
 @interface AFHTTPBodyPart () <NSCopying> {
     AFHTTPBodyPartReadPhase _phase;
     NSInputStream *_inputStream;
+    NSData *_bodyData;
+    BOOL _bodyDataLoaded;
+    BOOL _finished;
     unsigned long long _phaseReadOffset;
 }
 
@@ -1058,6 +1605,22 @@ typedef enum {
     return _inputStream;
 }
 
+/**
+ The body as contiguous bytes, so it is copied in large slices without an input stream. Files are memory-mapped, their pages are read on demand. Returns `nil` for the input stream bodies, or if the file can not be mapped.
+ */
+- (NSData *)bodyData {
+    if (!_bodyDataLoaded && self.body) {
+        if ([self.body isKindOfClass:[NSData class]]) {
+            _bodyData = self.body;
+        } else if ([self.body isKindOfClass:[NSURL class]] && [self.body isFileURL]) {
+            _bodyData = [NSData dataWithContentsOfURL:self.body options:NSDataReadingMappedAlways error:nil];
+        }
+        _bodyDataLoaded = YES;
+    }
+
+    return _bodyData;
+}
+
 - (NSString *)stringForHeaders {
     NSMutableString *headerString = [NSMutableString string];
     for (NSString *field in [self.headers allKeys]) {
@@ -1091,6 +1654,10 @@ typedef enum {
         return YES;
     }
 
+    if ([self bodyData]) {
+        return !_finished;
+    }
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wcovered-switch-default"
     switch (self.inputStream.streamStatus) {
@@ -1124,7 +1691,9 @@ typedef enum {
         totalNumberOfBytesRead += [self readData:headersData intoBuffer:&buffer[totalNumberOfBytesRead] maxLength:(length - (NSUInteger)totalNumberOfBytesRead)];
     }
 
-    if (_phase == AFBodyPhase) {
+    if (_phase == AFBodyPhase && [self bodyData]) {
+        totalNumberOfBytesRead += [self readData:[self bodyData] intoBuffer:&buffer[totalNumberOfBytesRead] maxLength:(length - (NSUInteger)totalNumberOfBytesRead)];
+    } else if (_phase == AFBodyPhase) {
         NSInteger numberOfBytesRead = 0;
 
         numberOfBytesRead = [self.inputStream read:&buffer[totalNumberOfBytesRead] maxLength:(length - (NSUInteger)totalNumberOfBytesRead)];
@@ -1167,7 +1736,8 @@ typedef enum {
 }
 
 - (BOOL)transitionToNextPhase {
-    if (![[NSThread currentThread] isMainThread]) {
+    // Only the input stream needs to be scheduled on the main run loop.
+    if (![self bodyData] && ![[NSThread currentThread] isMainThread]) {
         dispatch_sync(dispatch_get_main_queue(), ^{
             [self transitionToNextPhase];
         });
@@ -1181,15 +1751,22 @@ typedef enum {
             _phase = AFHeaderPhase;
             break;
         case AFHeaderPhase:
-            [self.inputStream scheduleInRunLoop:[NSRunLoop currentRunLoop] forMode:NSRunLoopCommonModes];
-            [self.inputStream open];
+            if (![self bodyData]) {
+                [self.inputStream scheduleInRunLoop:[NSRunLoop currentRunLoop] forMode:NSRunLoopCommonModes];
+                [self.inputStream open];
+            }
             _phase = AFBodyPhase;
             break;
         case AFBodyPhase:
-            [self.inputStream close];
+            if (![self bodyData]) {
+                [self.inputStream close];
+            }
             _phase = AFFinalBoundaryPhase;
             break;
         case AFFinalBoundaryPhase:
+            _finished = YES;
+            _phase = AFEncapsulationBoundaryPhase;
+            break;
         default:
             _phase = AFEncapsulationBoundaryPhase;
             break;
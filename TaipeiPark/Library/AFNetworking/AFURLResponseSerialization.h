@@ -123,9 +123,18 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  Whether to remove keys with `NSNull` values from response JSON. Defaults to `NO`.
+
+ When enabled, UTF-8 responses are parsed by a built-in parser which drops those keys while parsing, instead of walking and copying the tree parsed by `NSJSONSerialization`. Null elements of arrays are kept.
  */
 @property (nonatomic, assign) BOOL removesKeysWithNullValues;
 
+/**
+ Whether to parse UTF-8 responses in two stages. Defaults to `NO`.
+
+ The first stage indexes the structural characters and validates the UTF-8 with the vector instructions of the CPU, SSE2 or AVX2 on x86 and NEON on arm64, selected at runtime, with a scalar fallback. The second stage builds the objects by walking the index. It pays off for large responses, e.g. feeds of several megabytes.
+ */
+@property (nonatomic, assign) BOOL usesStructuralIndex;
+
 /**
  Creates and returns a JSON serializer with specified reading and writing options.
 
@@ -20,6 +20,8 @@
 // THE SOFTWARE.
 
 #import "AFURLResponseSerialization.h"
+#import "ECJSONParser.h"
+#import "ECJSONStructuralIndex.h"
 
 #import <TargetConditionals.h>
 
@@ -85,6 +87,289 @@ static id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingO
     return JSONObject;
 }
 
+#pragma mark -
+
+enum {
+    AFJSONKeyCacheSize = 256,
+    AFJSONKeyCacheMaxLength = 32,
+};
+
+typedef struct {
+    size_t length;
+    char bytes[AFJSONKeyCacheMaxLength];
+    CFStringRef string;
+} AFJSONKeyCacheEntry;
+
+/**
+ Builds the Foundation objects from the events of `ECJSONParse`. All the values of the open containers are kept on one stack, and each container is created once from its slice of the stack when it ends, so no container is ever copied. The keys repeat a lot in feeds, so the short ones are cached.
+ */
+typedef struct {
+    CFMutableArrayRef values;
+    CFIndex *frames;
+    NSUInteger depth;
+    NSUInteger frameCapacity;
+    const void **scratch;
+    CFIndex scratchCapacity;
+    NSJSONReadingOptions readingOptions;
+    BOOL invalidString;
+    AFJSONKeyCacheEntry keyCache[AFJSONKeyCacheSize];
+} AFJSONTreeBuilder;
+
+static int AFJSONTreeBuilderPushValue(AFJSONTreeBuilder *builder, CFTypeRef value) {
+    if (!value) {
+        return 1;
+    }
+
+    CFArrayAppendValue(builder->values, value);
+    CFRelease(value);
+
+    return 0;
+}
+
+static int AFJSONTreeBuilderBeginContainer(void *context) {
+    AFJSONTreeBuilder *builder = context;
+    if (builder->depth == builder->frameCapacity) {
+        NSUInteger frameCapacity = MAX((NSUInteger)16, builder->frameCapacity * 2);
+        CFIndex *frames = realloc(builder->frames, frameCapacity * sizeof(CFIndex));
+        if (!frames) {
+            return 1;
+        }
+        builder->frames = frames;
+        builder->frameCapacity = frameCapacity;
+    }
+
+    builder->frames[builder->depth++] = CFArrayGetCount(builder->values);
+
+    return 0;
+}
+
+static BOOL AFJSONTreeBuilderReserveScratch(AFJSONTreeBuilder *builder, CFIndex count) {
+    if (count <= builder->scratchCapacity) {
+        return YES;
+    }
+
+    CFIndex scratchCapacity = MAX(count, builder->scratchCapacity * 2);
+    const void **scratch = realloc(builder->scratch, (size_t)scratchCapacity * sizeof(void *));
+    if (!scratch) {
+        return NO;
+    }
+    builder->scratch = scratch;
+    builder->scratchCapacity = scratchCapacity;
+
+    return YES;
+}
+
+static int AFJSONTreeBuilderEndArray(void *context) {
+    AFJSONTreeBuilder *builder = context;
+    CFIndex start = builder->frames[--builder->depth];
+    CFRange range = CFRangeMake(start, CFArrayGetCount(builder->values) - start);
+
+    CFArrayRef array = NULL;
+    if (builder->readingOptions & NSJSONReadingMutableContainers) {
+        CFMutableArrayRef mutableArray = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+        CFArrayAppendArray(mutableArray, builder->values, range);
+        array = mutableArray;
+    } else {
+        if (!AFJSONTreeBuilderReserveScratch(builder, range.length)) {
+            return 1;
+        }
+        CFArrayGetValues(builder->values, range, builder->scratch);
+        array = CFArrayCreate(kCFAllocatorDefault, builder->scratch, range.length, &kCFTypeArrayCallBacks);
+    }
+
+    CFArrayReplaceValues(builder->values, range, NULL, 0);
+
+    return AFJSONTreeBuilderPushValue(builder, array);
+}
+
+static int AFJSONTreeBuilderEndObject(void *context) {
+    AFJSONTreeBuilder *builder = context;
+    CFIndex start = builder->frames[--builder->depth];
+    CFRange range = CFRangeMake(start, CFArrayGetCount(builder->values) - start);
+    CFIndex count = range.length / 2;
+
+    // The keys and the values are interleaved on the stack.
+    if (!AFJSONTreeBuilderReserveScratch(builder, range.length * 2)) {
+        return 1;
+    }
+    const void **keys = builder->scratch + range.length;
+    const void **values = keys + count;
+    CFArrayGetValues(builder->values, range, builder->scratch);
+    for (CFIndex i = 0; i < count; i++) {
+        keys[i] = builder->scratch[2 * i];
+        values[i] = builder->scratch[2 * i + 1];
+    }
+
+    CFDictionaryRef dictionary = NULL;
+    if (builder->readingOptions & NSJSONReadingMutableContainers) {
+        CFMutableDictionaryRef mutableDictionary = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+        for (CFIndex i = 0; i < count; i++) {
+            CFDictionarySetValue(mutableDictionary, keys[i], values[i]);
+        }
+        dictionary = mutableDictionary;
+    } else {
+        dictionary = CFDictionaryCreate(kCFAllocatorDefault, keys, values, count, &kCFTypeDictionaryKeyCallBacks, &kCFTypeDictionaryValueCallBacks);
+    }
+
+    CFArrayReplaceValues(builder->values, range, NULL, 0);
+
+    return AFJSONTreeBuilderPushValue(builder, dictionary);
+}
+
+static CFStringRef AFJSONTreeBuilderCreateString(AFJSONTreeBuilder *builder, const char *bytes, size_t length, BOOL mutableLeaf) {
+    CFStringRef string = CFStringCreateWithBytes(kCFAllocatorDefault, (const UInt8 *)bytes, (CFIndex)length, kCFStringEncodingUTF8, false);
+    if (!string) {
+        builder->invalidString = YES;
+        return NULL;
+    }
+
+    if (mutableLeaf) {
+        CFMutableStringRef mutableString = CFStringCreateMutableCopy(kCFAllocatorDefault, 0, string);
+        CFRelease(string);
+        return mutableString;
+    }
+
+    return string;
+}
+
+static int AFJSONTreeBuilderKey(void *context, const char *bytes, size_t length) {
+    AFJSONTreeBuilder *builder = context;
+    if (length > AFJSONKeyCacheMaxLength) {
+        return AFJSONTreeBuilderPushValue(builder, AFJSONTreeBuilderCreateString(builder, bytes, length, NO));
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)bytes[i]) * 16777619u;
+    }
+
+    AFJSONKeyCacheEntry *entry = &builder->keyCache[hash % AFJSONKeyCacheSize];
+    if (!entry->string || entry->length != length || memcmp(entry->bytes, bytes, length) != 0) {
+        CFStringRef string = AFJSONTreeBuilderCreateString(builder, bytes, length, NO);
+        if (!string) {
+            return 1;
+        }
+        if (entry->string) {
+            CFRelease(entry->string);
+        }
+        entry->string = string;
+        entry->length = length;
+        memcpy(entry->bytes, bytes, length);
+    }
+
+    CFArrayAppendValue(builder->values, entry->string);
+
+    return 0;
+}
+
+static int AFJSONTreeBuilderString(void *context, const char *bytes, size_t length) {
+    AFJSONTreeBuilder *builder = context;
+    return AFJSONTreeBuilderPushValue(builder, AFJSONTreeBuilderCreateString(builder, bytes, length, (builder->readingOptions & NSJSONReadingMutableLeaves) != 0));
+}
+
+static int AFJSONTreeBuilderNumber(void *context, int isInteger, int64_t integer, double real) {
+    AFJSONTreeBuilder *builder = context;
+    CFNumberRef number = isInteger ? CFNumberCreate(kCFAllocatorDefault, kCFNumberSInt64Type, &integer) : CFNumberCreate(kCFAllocatorDefault, kCFNumberDoubleType, &real);
+
+    return AFJSONTreeBuilderPushValue(builder, number);
+}
+
+static int AFJSONTreeBuilderBoolean(void *context, int value) {
+    AFJSONTreeBuilder *builder = context;
+    CFArrayAppendValue(builder->values, value ? kCFBooleanTrue : kCFBooleanFalse);
+
+    return 0;
+}
+
+static int AFJSONTreeBuilderNull(void *context) {
+    AFJSONTreeBuilder *builder = context;
+    CFArrayAppendValue(builder->values, kCFNull);
+
+    return 0;
+}
+
+static BOOL AFJSONDataIsUTF8(NSData *data) {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+
+    // UTF-16 and UTF-32 texts start with a BOM, or have a zero byte in the first two bytes, because the text starts with ASCII.
+    if (length >= 2 && ((bytes[0] == 0xFE && bytes[1] == 0xFF) || (bytes[0] == 0xFF && bytes[1] == 0xFE) || bytes[0] == 0 || bytes[1] == 0)) {
+        return NO;
+    }
+
+    return YES;
+}
+
+/**
+ Parses the JSON data with the built-in parser. When `removesKeysWithNullValues` is set, the keys with null values are dropped while parsing, so no `NSNull` is created for them and no container is copied afterwards. When `usesStructuralIndex` is set, the structural characters are indexed first by `ECJSONStructuralIndexBuild`, which also validates the UTF-8, then the objects are built by walking the index. Data which is not UTF-8 is parsed by `NSJSONSerialization`.
+ */
+static id AFJSONObjectFromData(NSData *data, NSJSONReadingOptions readingOptions, BOOL removesKeysWithNullValues, BOOL usesStructuralIndex, NSError * __autoreleasing *error) {
+    if (!AFJSONDataIsUTF8(data)) {
+        id JSONObject = [NSJSONSerialization JSONObjectWithData:data options:readingOptions error:error];
+        return (JSONObject && removesKeysWithNullValues) ? AFJSONObjectByRemovingKeysWithNullValues(JSONObject, readingOptions) : JSONObject;
+    }
+
+    static const ECJSONCallbacks callbacks = {
+        AFJSONTreeBuilderBeginContainer,
+        AFJSONTreeBuilderEndObject,
+        AFJSONTreeBuilderBeginContainer,
+        AFJSONTreeBuilderEndArray,
+        AFJSONTreeBuilderKey,
+        AFJSONTreeBuilderString,
+        AFJSONTreeBuilderNumber,
+        AFJSONTreeBuilderBoolean,
+        AFJSONTreeBuilderNull
+    };
+
+    AFJSONTreeBuilder *builder = calloc(1, sizeof(AFJSONTreeBuilder));
+    if (!builder) {
+        return nil;
+    }
+    builder->values = CFArrayCreateMutable(kCFAllocatorDefault, 0, &kCFTypeArrayCallBacks);
+    builder->readingOptions = readingOptions;
+
+    unsigned int options = removesKeysWithNullValues ? ECJSONParseSkipNullMembers : 0;
+    if (readingOptions & NSJSONReadingAllowFragments) {
+        options |= ECJSONParseAllowFragments;
+    }
+
+    size_t errorOffset = 0;
+    ECJSONParseStatus status;
+    if (usesStructuralIndex) {
+        ECJSONStructuralIndex index = {0};
+        status = ECJSONStructuralIndexBuild(&index, data.bytes, data.length, ECJSONKernelAuto, &errorOffset);
+        if (status == ECJSONParseOK) {
+            status = ECJSONParseWithIndex(data.bytes, data.length, &index, options, &callbacks, builder, &errorOffset);
+        } else if (status == ECJSONParseErrorInvalidUTF8) {
+            builder->invalidString = YES;
+        }
+        ECJSONStructuralIndexDestroy(&index);
+    } else {
+        status = ECJSONParse(data.bytes, data.length, options, &callbacks, builder, &errorOffset);
+    }
+
+    id JSONObject = nil;
+    if (status == ECJSONParseOK && CFArrayGetCount(builder->values) == 1) {
+        JSONObject = (__bridge id)CFArrayGetValueAtIndex(builder->values, 0);
+    } else if (error) {
+        NSString *description = builder->invalidString ? @"Unable to convert data to string around character %lu." : @"Invalid JSON around character %lu.";
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSPropertyListReadCorruptError userInfo:@{NSDebugDescriptionErrorKey: [NSString stringWithFormat:description, (unsigned long)errorOffset]}];
+    }
+
+    CFRelease(builder->values);
+    for (NSUInteger i = 0; i < AFJSONKeyCacheSize; i++) {
+        if (builder->keyCache[i].string) {
+            CFRelease(builder->keyCache[i].string);
+        }
+    }
+    free(builder->frames);
+    free(builder->scratch);
+    free(builder);
+
+    return JSONObject;
+}
+
 @implementation AFHTTPResponseSerializer
 
 + (instancetype)serializer {
@@ -248,15 +533,15 @@ static id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingO
     // See https://github.com/rails/rails/issues/1742
     BOOL isSpace = [data isEqualToData:[NSData dataWithBytes:" " length:1]];
     if (data.length > 0 && !isSpace) {
-        responseObject = [NSJSONSerialization JSONObjectWithData:data options:self.readingOptions error:&serializationError];
+        if (self.removesKeysWithNullValues || self.usesStructuralIndex) {
+            responseObject = AFJSONObjectFromData(data, self.readingOptions, self.removesKeysWithNullValues, self.usesStructuralIndex, &serializationError);
+        } else {
+            responseObject = [NSJSONSerialization JSONObjectWithData:data options:self.readingOptions error:&serializationError];
+        }
     } else {
         return nil;
     }
 
-    if (self.removesKeysWithNullValues && responseObject) {
-        responseObject = AFJSONObjectByRemovingKeysWithNullValues(responseObject, self.readingOptions);
-    }
-
     if (error) {
         *error = AFErrorWithUnderlyingError(serializationError, *error);
     }
@@ -274,6 +559,7 @@ static id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingO
 
     self.readingOptions = [[decoder decodeObjectOfClass:[NSNumber class] forKey:NSStringFromSelector(@selector(readingOptions))] unsignedIntegerValue];
     self.removesKeysWithNullValues = [[decoder decodeObjectOfClass:[NSNumber class] forKey:NSStringFromSelector(@selector(removesKeysWithNullValues))] boolValue];
+    self.usesStructuralIndex = [[decoder decodeObjectOfClass:[NSNumber class] forKey:NSStringFromSelector(@selector(usesStructuralIndex))] boolValue];
 
     return self;
 }
@@ -283,6 +569,7 @@ static id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingO
 
     [coder encodeObject:@(self.readingOptions) forKey:NSStringFromSelector(@selector(readingOptions))];
     [coder encodeObject:@(self.removesKeysWithNullValues) forKey:NSStringFromSelector(@selector(removesKeysWithNullValues))];
+    [coder encodeObject:@(self.usesStructuralIndex) forKey:NSStringFromSelector(@selector(usesStructuralIndex))];
 }
 
 #pragma mark - NSCopying
@@ -291,6 +578,7 @@ static id AFJSONObjectByRemovingKeysWithNullValues(id JSONObject, NSJSONReadingO
     AFJSONResponseSerializer *serializer = [[[self class] allocWithZone:zone] init];
     serializer.readingOptions = self.readingOptions;
     serializer.removesKeysWithNullValues = self.removesKeysWithNullValues;
+    serializer.usesStructuralIndex = self.usesStructuralIndex;
 
     return serializer;
 }
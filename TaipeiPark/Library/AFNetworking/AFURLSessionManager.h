@@ -25,6 +25,7 @@
 #import "AFURLResponseSerialization.h"
 #import "AFURLRequestSerialization.h"
 #import "AFSecurityPolicy.h"
+#import "AFNetworkMetrics.h"
 #if !TARGET_OS_WATCH
 #import "AFNetworkReachabilityManager.h"
 #endif
@@ -53,6 +54,7 @@
  - `URLSession:task:didSendBodyData:totalBytesSent:totalBytesExpectedToSend:`
  - `URLSession:task:needNewBodyStream:`
  - `URLSession:task:didCompleteWithError:`
+ - `URLSession:task:didFinishCollectingMetrics:`
 
  ### `NSURLSessionDataDelegate`
 
@@ -126,6 +128,20 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readwrite, nonatomic, strong) AFNetworkReachabilityManager *reachabilityManager;
 #endif
 
+///-------------------------
+/// @name Collecting Metrics
+///-------------------------
+
+/**
+ The collector receiving the transaction metrics of the tasks (iOS 10 and later) and the time spent by the `responseSerializer`. `nil` by default, which disables the collection.
+ */
+@property (nonatomic, strong, nullable) AFNetworkMetricsCollector *metricsCollector;
+
+/**
+ Whether the `metricsCollector` records the requests per endpoint as well as per host. `YES` by default. Set it to `NO` for a session whose paths are unbounded, e.g. one request per image, so it does not make one endpoint per URL.
+ */
+@property (nonatomic, assign) BOOL recordsMetricsPerEndpoint;
+
 ///----------------------------
 /// @name Getting Session Tasks
 ///----------------------------
@@ -223,6 +239,21 @@ NS_ASSUME_NONNULL_BEGIN
                              downloadProgress:(nullable void (^)(NSProgress *downloadProgress))downloadProgressBlock
                             completionHandler:(nullable void (^)(NSURLResponse *response, id _Nullable responseObject,  NSError * _Nullable error))completionHandler;
 
+///------------------------------
+/// @name Warming Up Connections
+///------------------------------
+
+/**
+ Opens the connections to the origins of the specified URLs ahead of the first real request, so the DNS lookup, TCP and TLS handshakes are not paid by a user-visible request. A `HEAD` request is sent to the root of each distinct origin, and the connection is then kept in the session's pool for the following tasks, as long as the server keeps it alive.
+
+ @param URLs The URLs to warm up. Only the scheme, host and port are used.
+ @param completion A block object to be executed on the `completionQueue` when all the warm-up requests finish. It takes the origins whose server responded, whatever the status code.
+
+ @return The resumed warm-up tasks.
+ */
+- (NSArray <NSURLSessionDataTask *> *)preconnectToURLs:(NSArray <NSURL *> *)URLs
+                                             completion:(nullable void (^)(NSArray <NSURL *> *connectedURLs))completion;
+
 ///---------------------------
 /// @name Running Upload Tasks
 ///---------------------------
@@ -377,6 +408,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)setTaskDidCompleteBlock:(nullable void (^)(NSURLSession *session, NSURLSessionTask *task, NSError * _Nullable error))block;
 
+/**
+ Sets a block to be executed when the metrics of a task have been collected, as handled by the `NSURLSessionTaskDelegate` method `URLSession:task:didFinishCollectingMetrics:`.
+
+ @param block A block object to be executed when the metrics of a task have been collected. The block has no return value, and takes three arguments: the session, the task, and the collected metrics.
+ */
+- (void)setTaskDidFinishCollectingMetricsBlock:(nullable void (^)(NSURLSession *session, NSURLSessionTask *task, NSURLSessionTaskMetrics *metrics))block NS_AVAILABLE_IOS(10_0);
+
 ///-------------------------------------------
 /// @name Setting Data Task Delegate Callbacks
 ///-------------------------------------------
@@ -97,6 +97,7 @@ typedef void (^AFURLSessionDidFinishEventsForBackgroundURLSessionBlock)(NSURLSes
 typedef NSInputStream * (^AFURLSessionTaskNeedNewBodyStreamBlock)(NSURLSession *session, NSURLSessionTask *task);
 typedef void (^AFURLSessionTaskDidSendBodyDataBlock)(NSURLSession *session, NSURLSessionTask *task, int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend);
 typedef void (^AFURLSessionTaskDidCompleteBlock)(NSURLSession *session, NSURLSessionTask *task, NSError *error);
+typedef void (^AFURLSessionTaskDidFinishCollectingMetricsBlock)(NSURLSession *session, NSURLSessionTask *task, id metrics);
 
 typedef NSURLSessionResponseDisposition (^AFURLSessionDataTaskDidReceiveResponseBlock)(NSURLSession *session, NSURLSessionDataTask *dataTask, NSURLResponse *response);
 typedef void (^AFURLSessionDataTaskDidBecomeDownloadTaskBlock)(NSURLSession *session, NSURLSessionDataTask *dataTask, NSURLSessionDownloadTask *downloadTask);
@@ -289,8 +290,16 @@ didCompleteWithError:(NSError *)error
     } else {
         dispatch_async(url_session_manager_processing_queue(), ^{
             NSError *serializationError = nil;
+            CFAbsoluteTime serializationStartTime = CFAbsoluteTimeGetCurrent();
             responseObject = [manager.responseSerializer responseObjectForResponse:task.response data:data error:&serializationError];
 
+            if (manager.metricsCollector && task.originalRequest) {
+                [manager.metricsCollector recordDuration:CFAbsoluteTimeGetCurrent() - serializationStartTime
+                                                   phase:AFNetworkMetricsPhaseSerialization
+                                              forRequest:task.originalRequest
+                                             perEndpoint:manager.recordsMetricsPerEndpoint];
+            }
+
             if (self.downloadFileURL) {
                 responseObject = self.downloadFileURL;
             }
@@ -493,6 +502,7 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
 @property (readwrite, nonatomic, copy) AFURLSessionTaskNeedNewBodyStreamBlock taskNeedNewBodyStream;
 @property (readwrite, nonatomic, copy) AFURLSessionTaskDidSendBodyDataBlock taskDidSendBodyData;
 @property (readwrite, nonatomic, copy) AFURLSessionTaskDidCompleteBlock taskDidComplete;
+@property (readwrite, nonatomic, copy) AFURLSessionTaskDidFinishCollectingMetricsBlock taskDidFinishCollectingMetrics;
 @property (readwrite, nonatomic, copy) AFURLSessionDataTaskDidReceiveResponseBlock dataTaskDidReceiveResponse;
 @property (readwrite, nonatomic, copy) AFURLSessionDataTaskDidBecomeDownloadTaskBlock dataTaskDidBecomeDownloadTask;
 @property (readwrite, nonatomic, copy) AFURLSessionDataTaskDidReceiveDataBlock dataTaskDidReceiveData;
@@ -529,6 +539,8 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
 
     self.securityPolicy = [AFSecurityPolicy defaultPolicy];
 
+    self.recordsMetricsPerEndpoint = YES;
+
 #if !TARGET_OS_WATCH
     self.reachabilityManager = [AFNetworkReachabilityManager sharedManager];
 #endif
@@ -773,6 +785,63 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
 
 #pragma mark -
 
+- (NSArray <NSURLSessionDataTask *> *)preconnectToURLs:(NSArray <NSURL *> *)URLs
+                                             completion:(void (^)(NSArray <NSURL *> *connectedURLs))completion
+{
+    NSMutableOrderedSet <NSURL *> *origins = [NSMutableOrderedSet orderedSet];
+    for (NSURL *URL in URLs) {
+        NSURLComponents *components = [[NSURLComponents alloc] init];
+        components.scheme = URL.scheme.lowercaseString;
+        components.host = URL.host.lowercaseString;
+        components.port = URL.port;
+        components.path = @"/";
+
+        if (components.scheme.length > 0 && components.host.length > 0 && components.URL) {
+            [origins addObject:components.URL];
+        }
+    }
+
+    dispatch_group_t group = dispatch_group_create();
+    NSMutableArray <NSURL *> *connectedURLs = [NSMutableArray arrayWithCapacity:origins.count];
+    NSMutableArray <NSURLSessionDataTask *> *tasks = [NSMutableArray arrayWithCapacity:origins.count];
+
+    for (NSURL *origin in origins) {
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:origin cachePolicy:NSURLRequestReloadIgnoringLocalCacheData timeoutInterval:10];
+        request.HTTPMethod = @"HEAD";
+
+        dispatch_group_enter(group);
+        NSURLSessionDataTask *task = [self dataTaskWithRequest:request completionHandler:^(NSURLResponse *response, id responseObject, NSError *error) {
+            // Any response, even an error status, means the connection is open.
+            if (response) {
+                @synchronized (connectedURLs) {
+                    [connectedURLs addObject:origin];
+                }
+            }
+            dispatch_group_leave(group);
+        }];
+        [tasks addObject:task];
+    }
+
+    dispatch_group_notify(group, self.completionQueue ?: dispatch_get_main_queue(), ^{
+        if (completion) {
+            NSArray *result = nil;
+            @synchronized (connectedURLs) {
+                result = [connectedURLs copy];
+            }
+            completion(result);
+        }
+    });
+
+    for (NSURLSessionDataTask *task in tasks) {
+        task.priority = NSURLSessionTaskPriorityHigh;
+        [task resume];
+    }
+
+    return [tasks copy];
+}
+
+#pragma mark -
+
 - (NSURLSessionUploadTask *)uploadTaskWithRequest:(NSURLRequest *)request
                                          fromFile:(NSURL *)fileURL
                                          progress:(void (^)(NSProgress *uploadProgress)) uploadProgressBlock
@@ -900,6 +969,10 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
     self.taskDidComplete = block;
 }
 
+- (void)setTaskDidFinishCollectingMetricsBlock:(void (^)(NSURLSession *session, NSURLSessionTask *task, NSURLSessionTaskMetrics *metrics))block {
+    self.taskDidFinishCollectingMetrics = block;
+}
+
 #pragma mark -
 
 - (void)setDataTaskDidReceiveResponseBlock:(NSURLSessionResponseDisposition (^)(NSURLSession *session, NSURLSessionDataTask *dataTask, NSURLResponse *response))block {
@@ -947,6 +1020,8 @@ static NSString * const AFNSURLSessionTaskDidSuspendNotification = @"com.alamofi
         return self.dataTaskWillCacheResponse != nil;
     } else if (selector == @selector(URLSessionDidFinishEventsForBackgroundURLSession:)) {
         return self.didFinishEventsForBackgroundURLSession != nil;
+    } else if (selector == @selector(URLSession:task:didFinishCollectingMetrics:)) {
+        return self.metricsCollector != nil || self.taskDidFinishCollectingMetrics != nil;
     }
 
     return [[self class] instancesRespondToSelector:selector];
@@ -1097,6 +1172,17 @@ didCompleteWithError:(NSError *)error
     }
 }
 
+- (void)URLSession:(NSURLSession *)session
+              task:(NSURLSessionTask *)task
+didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    [self.metricsCollector recordTaskMetrics:metrics perEndpoint:self.recordsMetricsPerEndpoint];
+
+    if (self.taskDidFinishCollectingMetrics) {
+        self.taskDidFinishCollectingMetrics(session, task, metrics);
+    }
+}
+
 #pragma mark - NSURLSessionDataDelegate
 
 - (void)URLSession:(NSURLSession *)session
@@ -104,7 +104,7 @@ NS_ASSUME_NONNULL_BEGIN
 @end
 
 /**
- The `AutoPurgingImageCache` in an in-memory image cache used to store images up to a given memory capacity. When the memory capacity is reached, the image cache is sorted by last access date, then the oldest image is continuously purged until the preferred memory usage after purge is met. Each time an image is accessed through the cache, the internal access date of the image is updated.
+ The `AutoPurgingImageCache` in an in-memory image cache used to store images up to a given memory capacity. When the memory capacity is reached, the image cache is sorted by last access date, then the oldest image is continuously purged until the preferred memory usage after purge is met. Each time an image is accessed through the cache, the internal access date of the image is updated. Lookups read an immutable copy of the cache published after each write, so they never wait for the writes; an image added asynchronously may be missed until its write has finished.
  */
 @interface AFAutoPurgingImageCache : NSObject <AFImageRequestCache>
 
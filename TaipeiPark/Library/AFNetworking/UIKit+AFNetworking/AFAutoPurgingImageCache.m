@@ -30,7 +30,7 @@
 @property (nonatomic, strong) UIImage *image;
 @property (nonatomic, strong) NSString *identifier;
 @property (nonatomic, assign) UInt64 totalBytes;
-@property (nonatomic, strong) NSDate *lastAccessDate;
+@property (atomic, assign) CFAbsoluteTime lastAccessTime;
 @property (nonatomic, assign) UInt64 currentMemoryUsage;
 
 @end
@@ -46,18 +46,18 @@
         CGFloat bytesPerPixel = 4.0;
         CGFloat bytesPerSize = imageSize.width * imageSize.height;
         self.totalBytes = (UInt64)bytesPerPixel * (UInt64)bytesPerSize;
-        self.lastAccessDate = [NSDate date];
+        self.lastAccessTime = CFAbsoluteTimeGetCurrent();
     }
     return self;
 }
 
 - (UIImage*)accessImage {
-    self.lastAccessDate = [NSDate date];
+    self.lastAccessTime = CFAbsoluteTimeGetCurrent();
     return self.image;
 }
 
 - (NSString *)description {
-    NSString *descriptionString = [NSString stringWithFormat:@"Idenfitier: %@  lastAccessDate: %@ ", self.identifier, self.lastAccessDate];
+    NSString *descriptionString = [NSString stringWithFormat:@"Idenfitier: %@  lastAccessDate: %@ ", self.identifier, [NSDate dateWithTimeIntervalSinceReferenceDate:self.lastAccessTime]];
     return descriptionString;
 
 }
@@ -66,8 +66,10 @@
 
 @interface AFAutoPurgingImageCache ()
 @property (nonatomic, strong) NSMutableDictionary <NSString* , AFCachedImage*> *cachedImages;
+@property (atomic, copy) NSDictionary <NSString* , AFCachedImage*> *publishedImages;
 @property (nonatomic, assign) UInt64 currentMemoryUsage;
 @property (nonatomic, strong) dispatch_queue_t synchronizationQueue;
+@property (nonatomic, strong) NSCache <NSURL*, NSString*> *cacheKeys;
 @end
 
 @implementation AFAutoPurgingImageCache
@@ -81,6 +83,9 @@
         self.memoryCapacity = memoryCapacity;
         self.preferredMemoryUsageAfterPurge = preferredMemoryCapacity;
         self.cachedImages = [[NSMutableDictionary alloc] init];
+        self.publishedImages = @{};
+        self.cacheKeys = [[NSCache alloc] init];
+        self.cacheKeys.countLimit = 512;
 
         NSString *queueName = [NSString stringWithFormat:@"com.alamofire.autopurgingimagecache-%@", [[NSUUID UUID] UUIDString]];
         self.synchronizationQueue = dispatch_queue_create([queueName cStringUsingEncoding:NSASCIIStringEncoding], DISPATCH_QUEUE_CONCURRENT);
@@ -124,9 +129,11 @@
         if (self.currentMemoryUsage > self.memoryCapacity) {
             UInt64 bytesToPurge = self.currentMemoryUsage - self.preferredMemoryUsageAfterPurge;
             NSMutableArray <AFCachedImage*> *sortedImages = [NSMutableArray arrayWithArray:self.cachedImages.allValues];
-            NSSortDescriptor *sortDescriptor = [[NSSortDescriptor alloc] initWithKey:@"lastAccessDate"
-                                                                           ascending:YES];
-            [sortedImages sortUsingDescriptors:@[sortDescriptor]];
+            [sortedImages sortUsingComparator:^NSComparisonResult(AFCachedImage *image1, AFCachedImage *image2) {
+                CFAbsoluteTime time1 = image1.lastAccessTime;
+                CFAbsoluteTime time2 = image2.lastAccessTime;
+                return (time1 < time2) ? NSOrderedAscending : ((time1 > time2) ? NSOrderedDescending : NSOrderedSame);
+            }];
 
             UInt64 bytesPurged = 0;
 
@@ -139,6 +146,7 @@
             }
             self.currentMemoryUsage -= bytesPurged;
         }
+        [self publishCachedImages];
     });
 }
 
@@ -149,6 +157,7 @@
         if (cachedImage != nil) {
             [self.cachedImages removeObjectForKey:identifier];
             self.currentMemoryUsage -= cachedImage.totalBytes;
+            [self publishCachedImages];
             removed = YES;
         }
     });
@@ -161,19 +170,23 @@
         if (self.cachedImages.count > 0) {
             [self.cachedImages removeAllObjects];
             self.currentMemoryUsage = 0;
+            [self publishCachedImages];
             removed = YES;
         }
     });
     return removed;
 }
 
+//This method should only be called from safely within the synchronizationQueue
+- (void)publishCachedImages {
+    self.publishedImages = self.cachedImages;
+}
+
 - (nullable UIImage *)imageWithIdentifier:(NSString *)identifier {
-    __block UIImage *image = nil;
-    dispatch_sync(self.synchronizationQueue, ^{
-        AFCachedImage *cachedImage = self.cachedImages[identifier];
-        image = [cachedImage accessImage];
-    });
-    return image;
+    // The lookups read the immutable copy published by the last write, so they never wait for the
+    // synchronization queue, e.g. the main thread while a purge is sorting the images
+    AFCachedImage *cachedImage = self.publishedImages[identifier];
+    return [cachedImage accessImage];
 }
 
 - (void)addImage:(UIImage *)image forRequest:(NSURLRequest *)request withAdditionalIdentifier:(NSString *)identifier {
@@ -189,7 +202,14 @@
 }
 
 - (NSString *)imageCacheKeyFromURLRequest:(NSURLRequest *)request withAdditionalIdentifier:(NSString *)additionalIdentifier {
-    NSString *key = request.URL.absoluteString;
+    NSURL *URL = request.URL;
+    NSString *key = URL ? [self.cacheKeys objectForKey:URL] : nil;
+    if (key == nil) {
+        key = URL.absoluteString;
+        if (key != nil) {
+            [self.cacheKeys setObject:key forKey:URL];
+        }
+    }
     if (additionalIdentifier != nil) {
         key = [key stringByAppendingString:additionalIdentifier];
     }
@@ -40,9 +40,14 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
 @interface AFImageDownloadReceipt : NSObject
 
 /**
- The data task created by the `AFImageDownloader`.
+ The data task created by the `AFImageDownloader`. For a receipt vended by `enqueueImageForURLRequest:withReceiptID:success:failure:`, this is `nil` until the download is started on the synchronization queue, and stays `nil` if the image is served from the image cache.
 */
-@property (nonatomic, strong) NSURLSessionDataTask *task;
+@property (atomic, strong, nullable) NSURLSessionDataTask *task;
+
+/**
+ The absolute URL string of the request, used to match the receipt to its data task.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *URLIdentifier;
 
 /**
  The unique identifier for the success and failure blocks when duplicate requests are made.
@@ -50,7 +55,7 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
 @property (nonatomic, strong) NSUUID *receiptID;
 @end
 
-/** The `AFImageDownloader` class is responsible for downloading images in parallel on a prioritized queue. Incoming downloads are added to the front or back of the queue depending on the download prioritization. Each downloaded image is cached in the underlying `NSURLCache` as well as the in-memory image cache. By default, any download request with a cached image equivalent in the image cache will automatically be served the cached image representation.
+/** The `AFImageDownloader` class is responsible for downloading images in parallel on a prioritized queue. Incoming downloads are added to the front or back of the queue depending on the download prioritization. Each downloaded image is cached in the underlying `NSURLCache` as well as the in-memory image cache. By default, any download request with a cached image equivalent in the image cache will automatically be served the cached image representation. The requests of the same URL share one data task, except that a request whose cache policy skips the local cache never shares the task of a request which may be served from the cache.
  */
 @interface AFImageDownloader : NSObject
 
@@ -69,6 +74,28 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
  */
 @property (nonatomic, assign) AFImageDownloadPrioritization downloadPrioritizaton;
 
+/**
+ The maximum length of an image response in bytes, `10 MB` by default, `0` for no limit. A response whose `expectedContentLength` is longer is cancelled as soon as it arrives, and a download which receives more bytes is cancelled then; both fail with `NSURLErrorDataLengthExceedsMaximum`. A successful response whose content type is not accepted by the response serializer is cancelled the same way.
+
+ The checks are installed as the data task response and data blocks of the `sessionManager`, and only apply to the data tasks created by the downloader. The other tasks of the session manager, e.g. its preconnects, are not checked.
+ */
+@property (nonatomic, assign) long long maximumImageContentLength;
+
+/**
+ The time to live of the failed requests which will fail again on a retry, e.g. `404 Not Found` or a response which is not an image. Until it expires, a request of the same URL fails immediately with the same response and error, without being sent. `600` seconds by default, `0` disables the negative cache.
+ */
+@property (nonatomic, assign) NSTimeInterval failedRequestTimeToLive;
+
+/**
+ The time to live of the failed requests which may succeed on a retry, e.g. `503 Service Unavailable`, `429 Too Many Requests` or a timeout. At most `failedRequestTimeToLive`. `30` seconds by default. The cancelled requests and the requests failed while offline are never cached.
+ */
+@property (nonatomic, assign) NSTimeInterval transientFailureTimeToLive;
+
+/**
+ The count of the requests failed from the negative cache without being sent.
+ */
+@property (nonatomic, assign, readonly) NSUInteger avoidedRequestCount;
+
 /**
  The shared default instance of `AFImageDownloader` initialized with default values.
  */
@@ -114,7 +141,7 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
  @param success A block to be executed when the image data task finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the image created from the response data of request. If the image was returned from cache, the response parameter will be `nil`.
  @param failure A block object to be executed when the image data task finishes unsuccessfully, or that finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the error object describing the network or parsing error that occurred.
 
- @return The image download receipt for the data task if available. `nil` if the image is stored in the cache.
+ @return The image download receipt for the data task if available. `nil` if the image is stored in the cache, or the URL failed recently and the failure is still in the negative cache.
  cache and the URL request cache policy allows the cache to be used.
  */
 - (nullable AFImageDownloadReceipt *)downloadImageForURLRequest:(NSURLRequest *)request
@@ -133,7 +160,7 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
  @param success A block to be executed when the image data task finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the image created from the response data of request. If the image was returned from cache, the response parameter will be `nil`.
  @param failure A block object to be executed when the image data task finishes unsuccessfully, or that finishes successfully. This block has no return value and takes three arguments: the request sent from the client, the response received from the server, and the error object describing the network or parsing error that occurred.
 
- @return The image download receipt for the data task if available. `nil` if the image is stored in the cache.
+ @return The image download receipt for the data task if available. `nil` if the image is stored in the cache, or the URL failed recently and the failure is still in the negative cache.
  cache and the URL request cache policy allows the cache to be used.
  */
 - (nullable AFImageDownloadReceipt *)downloadImageForURLRequest:(NSURLRequest *)request
@@ -141,17 +168,82 @@ typedef NS_ENUM(NSInteger, AFImageDownloadPrioritization) {
                                                         success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
                                                         failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure;
 
+/**
+ Enqueues a data task for the specified URL request without waiting for the synchronization queue, e.g. from the main thread while scrolling.
+
+ The cache lookup, the merging with a pending task and the creation of the data task all happen asynchronously, so the success block may be called with a cached image and a `nil` response. The receipt can be cancelled immediately.
+
+ @param request The URL request.
+ @param receiptID The identifier to use for the download receipt that will be created for this request. This must be a unique identifier that does not represent any other request.
+ @param success A block to be executed when the image data task finishes successfully, or the image is found in the cache.
+ @param failure A block object to be executed when the image data task finishes unsuccessfully.
+
+ @return The image download receipt for the request.
+ */
+- (AFImageDownloadReceipt *)enqueueImageForURLRequest:(NSURLRequest *)request
+                                        withReceiptID:(NSUUID *)receiptID
+                                              success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
+                                              failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure;
+
+/**
+ Returns a GET request for the image at the specified URL, accepting `image/*`. The requests are reused per URL, so repeated calls for the same URL do not build a new request.
+
+ @param url The URL of the image.
+
+ @return The image request.
+ */
++ (NSURLRequest *)imageRequestWithURL:(NSURL *)url;
+
+/**
+ Removes all failed requests from the negative cache, e.g. when the network is reachable again.
+ */
+- (void)removeAllFailedRequests;
+
 /**
  Cancels the data task in the receipt by removing the corresponding success and failure blocks and cancelling the data task if necessary.
 
- If the data task is pending in the queue, it will be cancelled if no other success and failure blocks are registered with the data task. If the data task is currently executing or is already completed, the success and failure blocks are removed and will not be called when the task finishes.
+ If the data task is pending in the queue, it will be cancelled if no other success and failure blocks are registered with the data task. If the data task is currently executing or is already completed, the success and failure blocks are removed and will not be called when the task finishes. The cancellation is performed asynchronously on the synchronization queue.
 
  @param imageDownloadReceipt The image download receipt to cancel.
  */
 - (void)cancelTaskForImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt;
 
+/**
+ Calls the block on the main queue with the data task of the receipt, once the request of a receipt vended by `enqueueImageForURLRequest:withReceiptID:success:failure:` has been started on the synchronization queue. The task is `nil` if the image was served from the image cache, or the request failed from the negative cache.
+
+ @param imageDownloadReceipt The image download receipt.
+ @param completion The block called with the data task of the receipt.
+ */
+- (void)getTaskForImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt completion:(void (^)(NSURLSessionDataTask * _Nullable task))completion;
+
+@end
+
+#ifdef DEBUG
+
+@interface AFImageDownloader (Debugging)
+
+/**
+ The count of the responses rejected by the size limit or the content type whose task has not completed yet. It is `0` once all the download tasks have completed.
+ */
+@property (nonatomic, assign, readonly) NSUInteger pendingRejectionCount;
+
+/**
+ The count of the download tasks started by the downloader that have not completed yet. The other tasks of the session manager, e.g. the preconnects, are not counted.
+ */
+@property (nonatomic, assign, readonly) NSUInteger pendingDownloadTaskCount;
+
+/**
+ Checks the image size limits against the stand-in server of `Harness/ECImageStandInServer.py`, with a downloader of its own: the image is downloaded, the oversized, chunked and HTML fixtures are rejected early, the HEAD preconnect of the same session is not, and nothing is left pending.
+
+ @param server The URL of the stand-in server, e.g. `http://127.0.0.1:8765`.
+ @param completion A block called on the main queue with one line per check.
+ */
++ (void)checkImageLimitsWithServer:(NSURL *)server completion:(void (^)(NSString *report))completion;
+
 @end
 
 #endif
 
+#endif
+
 NS_ASSUME_NONNULL_END
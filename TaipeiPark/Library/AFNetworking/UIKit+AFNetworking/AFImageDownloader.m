@@ -81,12 +81,166 @@
 
 @end
 
+@interface AFImageDownloadReceipt ()
+@property (nonatomic, copy, readwrite) NSString *URLIdentifier;
+@property (nonatomic, copy) NSString *mergedTaskKey;
+@end
+
+// The key of the merged task of the request. A request which skips the local cache, e.g. for an original
+// whose cached copy was replaced, never shares the task of a request which may be served from the cache.
+static inline NSString * AFImageDownloaderMergedTaskKey(NSURLRequest *request) {
+    NSString *URLIdentifier = request.URL.absoluteString;
+    switch (request.cachePolicy) {
+        case NSURLRequestUseProtocolCachePolicy:
+        case NSURLRequestReturnCacheDataElseLoad:
+        case NSURLRequestReturnCacheDataDontLoad:
+            return URLIdentifier;
+        default:
+            // A space never appears in an absolute URL string
+            return URLIdentifier ? [@"reload " stringByAppendingString:URLIdentifier] : nil;
+    }
+}
+
+static const NSUInteger AFImageDownloaderFailureFilterBits = 8192;
+static const NSUInteger AFImageDownloaderFailureFilterHashes = 3;
+static const NSUInteger AFImageDownloaderMaximumRecentFailures = 256;
+
+@interface AFImageDownloaderFailure : NSObject
+@property (nonatomic, strong) NSHTTPURLResponse *response;
+@property (nonatomic, strong) NSError *error;
+@property (nonatomic, assign) CFAbsoluteTime expirationTime;
+@end
+
+@implementation AFImageDownloaderFailure
+@end
+
+/**
+ The recently failed URLs. A bloom filter of two generations answers the common question, whether a URL has not failed, without touching the map; the generations are rotated after the longest time to live, so a URL stays in the filter until its failure expires. A URL in the filter is looked up in the map of the exact recent failures, which holds their responses and expiration times. Only used on the synchronization queue.
+ */
+@interface AFImageDownloaderFailureCache : NSObject {
+    uint8_t _filters[2][AFImageDownloaderFailureFilterBits / 8];
+}
+@property (nonatomic, strong) NSMutableDictionary <NSString*, AFImageDownloaderFailure*> *failures;
+@property (nonatomic, assign) NSUInteger currentGeneration;
+@property (nonatomic, assign) CFAbsoluteTime generationStartTime;
+@property (nonatomic, assign) NSTimeInterval generationInterval;
+@end
+
+@implementation AFImageDownloaderFailureCache
+
+- (instancetype)init {
+    if (self = [super init]) {
+        self.failures = [[NSMutableDictionary alloc] init];
+        self.generationStartTime = CFAbsoluteTimeGetCurrent();
+    }
+    return self;
+}
+
+static inline uint64_t AFImageDownloaderFailureHash(NSString *URLIdentifier) {
+    uint64_t hash = (uint64_t)URLIdentifier.hash;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+static inline uint32_t AFImageDownloaderFailureBit(uint64_t hash, NSUInteger index) {
+    uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+    return (h1 + (uint32_t)index * h2) % AFImageDownloaderFailureFilterBits;
+}
+
+- (BOOL)filter:(const uint8_t *)filter containsHash:(uint64_t)hash {
+    for (NSUInteger i = 0; i < AFImageDownloaderFailureFilterHashes; i++) {
+        uint32_t bit = AFImageDownloaderFailureBit(hash, i);
+        if ((filter[bit >> 3] & (1 << (bit & 7))) == 0) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+- (void)rotateGenerationsIfNecessary {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    if (now - self.generationStartTime < self.generationInterval) {
+        return;
+    }
+
+    // The older generation only holds expired failures now
+    self.currentGeneration ^= 1;
+    self.generationStartTime = now;
+    memset(_filters[self.currentGeneration], 0, sizeof(_filters[0]));
+
+    for (NSString *URLIdentifier in [self.failures allKeys]) {
+        if (self.failures[URLIdentifier].expirationTime <= now) {
+            [self.failures removeObjectForKey:URLIdentifier];
+        }
+    }
+}
+
+- (nullable AFImageDownloaderFailure *)failureForURLIdentifier:(NSString *)URLIdentifier {
+    if (self.failures.count == 0) {
+        return nil;
+    }
+
+    [self rotateGenerationsIfNecessary];
+
+    uint64_t hash = AFImageDownloaderFailureHash(URLIdentifier);
+    if (![self filter:_filters[0] containsHash:hash] && ![self filter:_filters[1] containsHash:hash]) {
+        return nil;
+    }
+
+    AFImageDownloaderFailure *failure = self.failures[URLIdentifier];
+    if (failure != nil && failure.expirationTime <= CFAbsoluteTimeGetCurrent()) {
+        [self.failures removeObjectForKey:URLIdentifier];
+        failure = nil;
+    }
+    return failure;
+}
+
+- (void)addFailure:(AFImageDownloaderFailure *)failure forURLIdentifier:(NSString *)URLIdentifier timeToLive:(NSTimeInterval)timeToLive {
+    self.generationInterval = MAX(self.generationInterval, timeToLive);
+    [self rotateGenerationsIfNecessary];
+
+    if (self.failures.count >= AFImageDownloaderMaximumRecentFailures && self.failures[URLIdentifier] == nil) {
+        __block NSString *oldestURLIdentifier = nil;
+        __block CFAbsoluteTime oldestExpirationTime = DBL_MAX;
+        [self.failures enumerateKeysAndObjectsUsingBlock:^(NSString *key, AFImageDownloaderFailure *recentFailure, __unused BOOL *stop) {
+            if (recentFailure.expirationTime < oldestExpirationTime) {
+                oldestExpirationTime = recentFailure.expirationTime;
+                oldestURLIdentifier = key;
+            }
+        }];
+        [self.failures removeObjectForKey:oldestURLIdentifier];
+    }
+
+    uint64_t hash = AFImageDownloaderFailureHash(URLIdentifier);
+    uint8_t *filter = _filters[self.currentGeneration];
+    for (NSUInteger i = 0; i < AFImageDownloaderFailureFilterHashes; i++) {
+        uint32_t bit = AFImageDownloaderFailureBit(hash, i);
+        filter[bit >> 3] |= (uint8_t)(1 << (bit & 7));
+    }
+
+    failure.expirationTime = CFAbsoluteTimeGetCurrent() + timeToLive;
+    self.failures[URLIdentifier] = failure;
+}
+
+- (void)removeAllFailures {
+    [self.failures removeAllObjects];
+    memset(_filters, 0, sizeof(_filters));
+}
+
+@end
+
 @implementation AFImageDownloadReceipt
 
 - (instancetype)initWithReceiptID:(NSUUID *)receiptID task:(NSURLSessionDataTask *)task {
     if (self = [self init]) {
         self.receiptID = receiptID;
         self.task = task;
+        self.URLIdentifier = task.originalRequest.URL.absoluteString;
+        self.mergedTaskKey = AFImageDownloaderMergedTaskKey(task.originalRequest);
     }
     return self;
 }
@@ -104,6 +258,12 @@
 @property (nonatomic, strong) NSMutableArray *queuedMergedTasks;
 @property (nonatomic, strong) NSMutableDictionary *mergedTasks;
 
+@property (nonatomic, strong) AFImageDownloaderFailureCache *failureCache;
+@property (nonatomic, strong) NSLock *downloadTaskLock;
+@property (nonatomic, strong) NSMutableIndexSet *downloadTaskIdentifiers;
+@property (nonatomic, strong) NSMutableDictionary <NSNumber*, NSError*> *rejectedResponseErrors;
+@property (nonatomic, assign, readwrite) NSUInteger avoidedRequestCount;
+
 @end
 
 
@@ -147,6 +307,10 @@
                 maximumActiveDownloads:(NSInteger)maximumActiveDownloads
                             imageCache:(id <AFImageRequestCache>)imageCache {
     if (self = [super init]) {
+        self.maximumImageContentLength = 10 * 1024 * 1024;
+        self.downloadTaskLock = [[NSLock alloc] init];
+        self.downloadTaskIdentifiers = [[NSMutableIndexSet alloc] init];
+        self.rejectedResponseErrors = [[NSMutableDictionary alloc] init];
         self.sessionManager = sessionManager;
 
         self.downloadPrioritizaton = downloadPrioritization;
@@ -157,6 +321,10 @@
         self.mergedTasks = [[NSMutableDictionary alloc] init];
         self.activeRequestCount = 0;
 
+        self.failureCache = [[AFImageDownloaderFailureCache alloc] init];
+        self.failedRequestTimeToLive = 600.0;
+        self.transientFailureTimeToLive = 30.0;
+
         NSString *name = [NSString stringWithFormat:@"com.alamofire.imagedownloader.synchronizationqueue-%@", [[NSUUID UUID] UUIDString]];
         self.synchronizationQueue = dispatch_queue_create([name cStringUsingEncoding:NSASCIIStringEncoding], DISPATCH_QUEUE_SERIAL);
 
@@ -167,6 +335,88 @@
     return self;
 }
 
+- (void)setSessionManager:(AFHTTPSessionManager *)sessionManager {
+    _sessionManager = sessionManager;
+
+    // Reject the oversized images and the responses which are not images as soon as possible, before
+    // their bodies are downloaded and decoded. The other tasks of the session, e.g. the preconnects, are left alone.
+    __weak __typeof__(self) weakSelf = self;
+    [sessionManager setDataTaskDidReceiveResponseBlock:^NSURLSessionResponseDisposition(NSURLSession * _Nonnull session, NSURLSessionDataTask * _Nonnull dataTask, NSURLResponse * _Nonnull response) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        NSError *error = [strongSelf errorForRejectedResponse:response];
+        if (error == nil || ![strongSelf safelyRejectDownloadTask:dataTask error:error]) {
+            return NSURLSessionResponseAllow;
+        }
+        return NSURLSessionResponseCancel;
+    }];
+    [sessionManager setDataTaskDidReceiveDataBlock:^(NSURLSession * _Nonnull session, NSURLSessionDataTask * _Nonnull dataTask, NSData * _Nonnull data) {
+        __strong __typeof__(weakSelf) strongSelf = weakSelf;
+        long long maximumLength = strongSelf.maximumImageContentLength;
+        if (maximumLength > 0 && dataTask.countOfBytesReceived > maximumLength && dataTask.state == NSURLSessionTaskStateRunning) {
+            // The response had no length, or a wrong one
+            if ([strongSelf safelyRejectDownloadTask:dataTask error:[strongSelf oversizedErrorForURL:dataTask.originalRequest.URL length:dataTask.countOfBytesReceived]]) {
+                [dataTask cancel];
+            }
+        }
+    }];
+}
+
+- (NSError *)oversizedErrorForURL:(NSURL *)URL length:(long long)length {
+    NSString *failureReason = [NSString stringWithFormat:@"Image of %lld bytes exceeds the maximum of %lld bytes: %@", length, self.maximumImageContentLength, URL.absoluteString];
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:failureReason forKey:NSLocalizedFailureReasonErrorKey];
+    if (URL) {
+        userInfo[NSURLErrorFailingURLErrorKey] = URL;
+    }
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorDataLengthExceedsMaximum userInfo:userInfo];
+}
+
+- (nullable NSError *)errorForRejectedResponse:(NSURLResponse *)response {
+    long long maximumLength = self.maximumImageContentLength;
+    if (maximumLength > 0 && response.expectedContentLength > maximumLength) {
+        return [self oversizedErrorForURL:response.URL length:response.expectedContentLength];
+    }
+
+    // Only the successful responses, the others are left to the status code validation of the serializer
+    NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse *)response statusCode] : 0;
+    NSSet *acceptableContentTypes = self.sessionManager.responseSerializer.acceptableContentTypes;
+    if (statusCode >= 200 && statusCode < 300 && response.MIMEType && acceptableContentTypes && ![acceptableContentTypes containsObject:response.MIMEType]) {
+        NSString *failureReason = [NSString stringWithFormat:@"Request failed: unacceptable content-type: %@", response.MIMEType];
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:failureReason forKey:NSLocalizedFailureReasonErrorKey];
+        userInfo[AFNetworkingOperationFailingURLResponseErrorKey] = response;
+        if (response.URL) {
+            userInfo[NSURLErrorFailingURLErrorKey] = response.URL;
+        }
+        return [NSError errorWithDomain:AFURLResponseSerializationErrorDomain code:NSURLErrorCannotDecodeContentData userInfo:userInfo];
+    }
+    return nil;
+}
+
+// The task blocks run on the delegate queue of the session, so the identifiers are guarded by a lock instead of the synchronization queue
+- (void)safelyAddDownloadTaskIdentifier:(NSUInteger)taskIdentifier {
+    [self.downloadTaskLock lock];
+    [self.downloadTaskIdentifiers addIndex:taskIdentifier];
+    [self.downloadTaskLock unlock];
+}
+
+- (BOOL)safelyRejectDownloadTask:(NSURLSessionTask *)task error:(NSError *)error {
+    [self.downloadTaskLock lock];
+    BOOL isDownloadTask = [self.downloadTaskIdentifiers containsIndex:task.taskIdentifier];
+    if (isDownloadTask) {
+        self.rejectedResponseErrors[@(task.taskIdentifier)] = error;
+    }
+    [self.downloadTaskLock unlock];
+    return isDownloadTask;
+}
+
+- (nullable NSError *)safelyRemoveDownloadTaskIdentifier:(NSUInteger)taskIdentifier {
+    [self.downloadTaskLock lock];
+    NSError *error = self.rejectedResponseErrors[@(taskIdentifier)];
+    [self.rejectedResponseErrors removeObjectForKey:@(taskIdentifier)];
+    [self.downloadTaskIdentifiers removeIndex:taskIdentifier];
+    [self.downloadTaskLock unlock];
+    return error;
+}
+
 + (instancetype)defaultInstance {
     static AFImageDownloader *sharedInstance = nil;
     static dispatch_once_t onceToken;
@@ -176,6 +426,26 @@
     return sharedInstance;
 }
 
++ (NSURLRequest *)imageRequestWithURL:(NSURL *)url {
+    static NSCache *imageRequests = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        imageRequests = [[NSCache alloc] init];
+        imageRequests.countLimit = 256;
+    });
+
+    NSURLRequest *request = url ? [imageRequests objectForKey:url] : nil;
+    if (request == nil) {
+        NSMutableURLRequest *mutableRequest = [NSMutableURLRequest requestWithURL:url];
+        [mutableRequest addValue:@"image/*" forHTTPHeaderField:@"Accept"];
+        request = [mutableRequest copy];
+        if (url) {
+            [imageRequests setObject:request forKey:url];
+        }
+    }
+    return request;
+}
+
 - (nullable AFImageDownloadReceipt *)downloadImageForURLRequest:(NSURLRequest *)request
                                                         success:(void (^)(NSURLRequest * _Nonnull, NSHTTPURLResponse * _Nullable, UIImage * _Nonnull))success
                                                         failure:(void (^)(NSURLRequest * _Nonnull, NSHTTPURLResponse * _Nullable, NSError * _Nonnull))failure {
@@ -188,116 +458,161 @@
                                                         failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
     __block NSURLSessionDataTask *task = nil;
     dispatch_sync(self.synchronizationQueue, ^{
-        NSString *URLIdentifier = request.URL.absoluteString;
-        if (URLIdentifier == nil) {
-            if (failure) {
-                NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadURL userInfo:nil];
-                dispatch_async(dispatch_get_main_queue(), ^{
-                    failure(request, nil, error);
-                });
-            }
-            return;
-        }
+        task = [self startDownloadForURLRequest:request withReceiptID:receiptID success:success failure:failure];
+    });
+    if (task) {
+        return [[AFImageDownloadReceipt alloc] initWithReceiptID:receiptID task:task];
+    } else {
+        return nil;
+    }
+}
+
+- (AFImageDownloadReceipt *)enqueueImageForURLRequest:(NSURLRequest *)request
+                                        withReceiptID:(NSUUID *)receiptID
+                                              success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
+                                              failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
+    AFImageDownloadReceipt *receipt = [[AFImageDownloadReceipt alloc] initWithReceiptID:receiptID task:nil];
+    receipt.URLIdentifier = request.URL.absoluteString;
+    receipt.mergedTaskKey = AFImageDownloaderMergedTaskKey(request);
+
+    // The synchronization queue is serial, so a cancel of this receipt always runs after its task is set
+    dispatch_async(self.synchronizationQueue, ^{
+        receipt.task = [self startDownloadForURLRequest:request withReceiptID:receiptID success:success failure:failure];
+    });
+    return receipt;
+}
 
-        // 1) Append the success and failure blocks to a pre-existing request if it already exists
-        AFImageDownloaderMergedTask *existingMergedTask = self.mergedTasks[URLIdentifier];
-        if (existingMergedTask != nil) {
-            AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID success:success failure:failure];
-            [existingMergedTask addResponseHandler:handler];
-            task = existingMergedTask.task;
-            return;
+//This method should only be called from safely within the synchronizationQueue
+- (nullable NSURLSessionDataTask *)startDownloadForURLRequest:(NSURLRequest *)request
+                                                withReceiptID:(NSUUID *)receiptID
+                                                      success:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse  * _Nullable response, UIImage *responseObject))success
+                                                      failure:(nullable void (^)(NSURLRequest *request, NSHTTPURLResponse * _Nullable response, NSError *error))failure {
+    NSString *URLIdentifier = request.URL.absoluteString;
+    if (URLIdentifier == nil) {
+        if (failure) {
+            NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorBadURL userInfo:nil];
+            dispatch_async(dispatch_get_main_queue(), ^{
+                failure(request, nil, error);
+            });
         }
+        return nil;
+    }
 
-        // 2) Attempt to load the image from the image cache if the cache policy allows it
-        switch (request.cachePolicy) {
-            case NSURLRequestUseProtocolCachePolicy:
-            case NSURLRequestReturnCacheDataElseLoad:
-            case NSURLRequestReturnCacheDataDontLoad: {
-                UIImage *cachedImage = [self.imageCache imageforRequest:request withAdditionalIdentifier:nil];
-                if (cachedImage != nil) {
-                    if (success) {
-                        dispatch_async(dispatch_get_main_queue(), ^{
-                            success(request, nil, cachedImage);
-                        });
-                    }
-                    return;
+    // 1) Append the success and failure blocks to a pre-existing request if it already exists
+    NSString *mergedTaskKey = AFImageDownloaderMergedTaskKey(request);
+    AFImageDownloaderMergedTask *existingMergedTask = self.mergedTasks[mergedTaskKey];
+    if (existingMergedTask != nil) {
+        AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID success:success failure:failure];
+        [existingMergedTask addResponseHandler:handler];
+        return existingMergedTask.task;
+    }
+
+    // 2) Attempt to load the image from the image cache if the cache policy allows it
+    switch (request.cachePolicy) {
+        case NSURLRequestUseProtocolCachePolicy:
+        case NSURLRequestReturnCacheDataElseLoad:
+        case NSURLRequestReturnCacheDataDontLoad: {
+            UIImage *cachedImage = [self.imageCache imageforRequest:request withAdditionalIdentifier:nil];
+            if (cachedImage != nil) {
+                if (success) {
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        success(request, nil, cachedImage);
+                    });
                 }
-                break;
+                return nil;
             }
-            default:
-                break;
+
+            // Fail the URLs which failed recently without sending them again, e.g. the 404 thumbnails scrolled back into view
+            AFImageDownloaderFailure *cachedFailure = [self.failureCache failureForURLIdentifier:URLIdentifier];
+            if (cachedFailure != nil) {
+                self.avoidedRequestCount += 1;
+                if (failure) {
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        failure(request, cachedFailure.response, cachedFailure.error);
+                    });
+                }
+                return nil;
+            }
+            break;
         }
+        default:
+            break;
+    }
 
-        // 3) Create the request and set up authentication, validation and response serialization
-        NSUUID *mergedTaskIdentifier = [NSUUID UUID];
-        NSURLSessionDataTask *createdTask;
-        __weak __typeof__(self) weakSelf = self;
-
-        createdTask = [self.sessionManager
-                       dataTaskWithRequest:request
-                       completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
-                           dispatch_async(self.responseQueue, ^{
-                               __strong __typeof__(weakSelf) strongSelf = weakSelf;
-                               AFImageDownloaderMergedTask *mergedTask = self.mergedTasks[URLIdentifier];
-                               if ([mergedTask.identifier isEqual:mergedTaskIdentifier]) {
-                                   mergedTask = [strongSelf safelyRemoveMergedTaskWithURLIdentifier:URLIdentifier];
-                                   if (error) {
-                                       for (AFImageDownloaderResponseHandler *handler in mergedTask.responseHandlers) {
-                                           if (handler.failureBlock) {
-                                               dispatch_async(dispatch_get_main_queue(), ^{
-                                                   handler.failureBlock(request, (NSHTTPURLResponse*)response, error);
-                                               });
-                                           }
+    // 3) Create the request and set up authentication, validation and response serialization
+    NSUUID *mergedTaskIdentifier = [NSUUID UUID];
+    NSURLSessionDataTask *createdTask;
+    __block NSUInteger createdTaskIdentifier = 0;
+    __weak __typeof__(self) weakSelf = self;
+
+    createdTask = [self.sessionManager
+                   dataTaskWithRequest:request
+                   completionHandler:^(NSURLResponse * _Nonnull response, id  _Nullable responseObject, NSError * _Nullable error) {
+                       dispatch_async(self.responseQueue, ^{
+                           __strong __typeof__(weakSelf) strongSelf = weakSelf;
+                           // Forget the task whether or not it is still merged, e.g. after a cancel, so no rejection is left behind
+                           NSError *rejectedError = [strongSelf safelyRemoveDownloadTaskIdentifier:createdTaskIdentifier];
+                           AFImageDownloaderMergedTask *mergedTask = self.mergedTasks[mergedTaskKey];
+                           if ([mergedTask.identifier isEqual:mergedTaskIdentifier]) {
+                               mergedTask = [strongSelf safelyRemoveMergedTaskWithURLIdentifier:mergedTaskKey];
+                               if (error) {
+                                   // The cancelled tasks of the rejected responses fail with the reason
+                                   NSError *failureError = rejectedError ?: error;
+                                   [strongSelf safelyAddFailureWithURLIdentifier:URLIdentifier response:(NSHTTPURLResponse*)response error:failureError];
+                                   for (AFImageDownloaderResponseHandler *handler in mergedTask.responseHandlers) {
+                                       if (handler.failureBlock) {
+                                           dispatch_async(dispatch_get_main_queue(), ^{
+                                               handler.failureBlock(request, (NSHTTPURLResponse*)response, failureError);
+                                           });
                                        }
-                                   } else {
-                                       [strongSelf.imageCache addImage:responseObject forRequest:request withAdditionalIdentifier:nil];
-
-                                       for (AFImageDownloaderResponseHandler *handler in mergedTask.responseHandlers) {
-                                           if (handler.successBlock) {
-                                               dispatch_async(dispatch_get_main_queue(), ^{
-                                                   handler.successBlock(request, (NSHTTPURLResponse*)response, responseObject);
-                                               });
-                                           }
+                                   }
+                               } else {
+                                   [strongSelf.imageCache addImage:responseObject forRequest:request withAdditionalIdentifier:nil];
+
+                                   for (AFImageDownloaderResponseHandler *handler in mergedTask.responseHandlers) {
+                                       if (handler.successBlock) {
+                                           dispatch_async(dispatch_get_main_queue(), ^{
+                                               handler.successBlock(request, (NSHTTPURLResponse*)response, responseObject);
+                                           });
                                        }
-                                       
                                    }
+                                   
                                }
-                               [strongSelf safelyDecrementActiveTaskCount];
-                               [strongSelf safelyStartNextTaskIfNecessary];
-                           });
-                       }];
-
-        // 4) Store the response handler for use when the request completes
-        AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID
-                                                                                                   success:success
-                                                                                                   failure:failure];
-        AFImageDownloaderMergedTask *mergedTask = [[AFImageDownloaderMergedTask alloc]
-                                                   initWithURLIdentifier:URLIdentifier
-                                                   identifier:mergedTaskIdentifier
-                                                   task:createdTask];
-        [mergedTask addResponseHandler:handler];
-        self.mergedTasks[URLIdentifier] = mergedTask;
-
-        // 5) Either start the request or enqueue it depending on the current active request count
-        if ([self isActiveRequestCountBelowMaximumLimit]) {
-            [self startMergedTask:mergedTask];
-        } else {
-            [self enqueueMergedTask:mergedTask];
-        }
-
-        task = mergedTask.task;
-    });
-    if (task) {
-        return [[AFImageDownloadReceipt alloc] initWithReceiptID:receiptID task:task];
+                           }
+                           [strongSelf safelyDecrementActiveTaskCount];
+                           [strongSelf safelyStartNextTaskIfNecessary];
+                       });
+                   }];
+    // The task is resumed below, so it is known as an image download before any of its blocks run
+    createdTaskIdentifier = createdTask.taskIdentifier;
+    [self safelyAddDownloadTaskIdentifier:createdTaskIdentifier];
+
+    // 4) Store the response handler for use when the request completes
+    AFImageDownloaderResponseHandler *handler = [[AFImageDownloaderResponseHandler alloc] initWithUUID:receiptID
+                                                                                               success:success
+                                                                                               failure:failure];
+    AFImageDownloaderMergedTask *mergedTask = [[AFImageDownloaderMergedTask alloc]
+                                               initWithURLIdentifier:mergedTaskKey
+                                               identifier:mergedTaskIdentifier
+                                               task:createdTask];
+    [mergedTask addResponseHandler:handler];
+    self.mergedTasks[mergedTaskKey] = mergedTask;
+
+    // 5) Either start the request or enqueue it depending on the current active request count
+    if ([self isActiveRequestCountBelowMaximumLimit]) {
+        [self startMergedTask:mergedTask];
     } else {
-        return nil;
+        [self enqueueMergedTask:mergedTask];
     }
+
+    return mergedTask.task;
 }
 
 - (void)cancelTaskForImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt {
-    dispatch_sync(self.synchronizationQueue, ^{
-        NSString *URLIdentifier = imageDownloadReceipt.task.originalRequest.URL.absoluteString;
-        AFImageDownloaderMergedTask *mergedTask = self.mergedTasks[URLIdentifier];
+    // The failure block is called asynchronously anyway, so the caller never waits for the queue
+    dispatch_async(self.synchronizationQueue, ^{
+        NSString *URLIdentifier = imageDownloadReceipt.URLIdentifier;
+        AFImageDownloaderMergedTask *mergedTask = self.mergedTasks[imageDownloadReceipt.mergedTaskKey];
         NSUInteger index = [mergedTask.responseHandlers indexOfObjectPassingTest:^BOOL(AFImageDownloaderResponseHandler * _Nonnull handler, __unused NSUInteger idx, __unused BOOL * _Nonnull stop) {
             return handler.uuid == imageDownloadReceipt.receiptID;
         }];
@@ -305,7 +620,7 @@
         if (index != NSNotFound) {
             AFImageDownloaderResponseHandler *handler = mergedTask.responseHandlers[index];
             [mergedTask removeResponseHandler:handler];
-            NSString *failureReason = [NSString stringWithFormat:@"ImageDownloader cancelled URL request: %@",imageDownloadReceipt.task.originalRequest.URL.absoluteString];
+            NSString *failureReason = [NSString stringWithFormat:@"ImageDownloader cancelled URL request: %@",URLIdentifier];
             NSDictionary *userInfo = @{NSLocalizedFailureReasonErrorKey:failureReason};
             NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:userInfo];
             if (handler.failureBlock) {
@@ -317,11 +632,21 @@
 
         if (mergedTask.responseHandlers.count == 0 && mergedTask.task.state == NSURLSessionTaskStateSuspended) {
             [mergedTask.task cancel];
-            [self removeMergedTaskWithURLIdentifier:URLIdentifier];
+            [self removeMergedTaskWithURLIdentifier:imageDownloadReceipt.mergedTaskKey];
         }
     });
 }
 
+- (void)getTaskForImageDownloadReceipt:(AFImageDownloadReceipt *)imageDownloadReceipt completion:(void (^)(NSURLSessionDataTask * _Nullable task))completion {
+    // The synchronization queue is serial, so the task of the receipt is already set when this block runs
+    dispatch_async(self.synchronizationQueue, ^{
+        NSURLSessionDataTask *task = imageDownloadReceipt.task;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completion(task);
+        });
+    });
+}
+
 - (AFImageDownloaderMergedTask*)safelyRemoveMergedTaskWithURLIdentifier:(NSString *)URLIdentifier {
     __block AFImageDownloaderMergedTask *mergedTask = nil;
     dispatch_sync(self.synchronizationQueue, ^{
@@ -337,6 +662,55 @@
     return mergedTask;
 }
 
+- (NSTimeInterval)timeToLiveForFailedResponse:(nullable NSHTTPURLResponse *)response error:(NSError *)error {
+    if ([error.domain isEqualToString:NSURLErrorDomain]) {
+        switch (error.code) {
+            case NSURLErrorCancelled:
+            case NSURLErrorNotConnectedToInternet:
+            case NSURLErrorNetworkConnectionLost:
+                // Retried as soon as they are requested again, e.g. when the network is back
+                return 0;
+            case NSURLErrorBadURL:
+            case NSURLErrorUnsupportedURL:
+            case NSURLErrorDataLengthExceedsMaximum:
+                return self.failedRequestTimeToLive;
+            default:
+                break;
+        }
+    }
+
+    NSInteger statusCode = [response isKindOfClass:[NSHTTPURLResponse class]] ? response.statusCode : 0;
+    if (statusCode >= 400 && statusCode < 500) {
+        // The client errors stay until the URL is fixed, except the ones asking to retry later
+        return (statusCode == 408 || statusCode == 429) ? self.transientFailureTimeToLive : self.failedRequestTimeToLive;
+    }
+    if (statusCode >= 200 && statusCode < 300) {
+        // The response is not an image
+        return self.failedRequestTimeToLive;
+    }
+    return self.transientFailureTimeToLive;
+}
+
+- (void)safelyAddFailureWithURLIdentifier:(NSString *)URLIdentifier response:(nullable NSHTTPURLResponse *)response error:(NSError *)error {
+    NSTimeInterval timeToLive = MIN([self timeToLiveForFailedResponse:response error:error], self.failedRequestTimeToLive);
+    if (timeToLive <= 0) {
+        return;
+    }
+
+    AFImageDownloaderFailure *failure = [[AFImageDownloaderFailure alloc] init];
+    failure.response = response;
+    failure.error = error;
+    dispatch_sync(self.synchronizationQueue, ^{
+        [self.failureCache addFailure:failure forURLIdentifier:URLIdentifier timeToLive:timeToLive];
+    });
+}
+
+- (void)removeAllFailedRequests {
+    dispatch_async(self.synchronizationQueue, ^{
+        [self.failureCache removeAllFailures];
+    });
+}
+
 - (void)safelyDecrementActiveTaskCount {
     dispatch_sync(self.synchronizationQueue, ^{
         if (self.activeRequestCount > 0) {
@@ -388,4 +762,101 @@
 
 @end
 
+#ifdef DEBUG
+
+@implementation AFImageDownloader (Debugging)
+
+- (NSUInteger)pendingRejectionCount {
+    [self.downloadTaskLock lock];
+    NSUInteger count = self.rejectedResponseErrors.count;
+    [self.downloadTaskLock unlock];
+    return count;
+}
+
+- (NSUInteger)pendingDownloadTaskCount {
+    [self.downloadTaskLock lock];
+    NSUInteger count = self.downloadTaskIdentifiers.count;
+    [self.downloadTaskLock unlock];
+    return count;
+}
+
++ (void)checkImageLimitsWithServer:(NSURL *)server completion:(void (^)(NSString *report))completion {
+    // A downloader of its own, so neither the image cache nor the negative cache of the app is touched.
+    AFImageDownloader *downloader = [[AFImageDownloader alloc] init];
+    NSMutableString *report = [NSMutableString string];
+    NSURLSession *session = [NSURLSession sharedSession];
+    dispatch_group_t group = dispatch_group_create();
+    long long maximumLength = downloader.maximumImageContentLength;
+    __block NSUInteger failures = 0;
+
+    // Called on the main queue only.
+    void (^check)(BOOL, NSString *) = ^(BOOL passed, NSString *name) {
+        failures += passed ? 0 : 1;
+        [report appendFormat:@"%@ %@\n", passed ? @"OK    " : @"FAILED", name];
+    };
+
+    void (^download)(NSString *, NSString *, NSInteger) = ^(NSString *path, NSString *domain, NSInteger code) {
+        NSURLRequest *request = [NSURLRequest requestWithURL:[server URLByAppendingPathComponent:path] cachePolicy:NSURLRequestReloadIgnoringLocalCacheData timeoutInterval:30];
+
+        dispatch_group_enter(group);
+        [downloader enqueueImageForURLRequest:request withReceiptID:[NSUUID UUID] success:^(NSURLRequest *urlRequest, NSHTTPURLResponse *response, UIImage *image) {
+            check(domain == nil, [NSString stringWithFormat:@"%@ downloaded", path]);
+            dispatch_group_leave(group);
+        } failure:^(NSURLRequest *urlRequest, NSHTTPURLResponse *response, NSError *error) {
+            check([error.domain isEqualToString:domain] && error.code == code, [NSString stringWithFormat:@"%@ failed with %@ %ld", path, error.domain, (long)error.code]);
+            dispatch_group_leave(group);
+        }];
+    };
+
+    [[session dataTaskWithURL:[server URLByAppendingPathComponent:@"reset"] completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (error) {
+                completion([NSString stringWithFormat:@"FAILED stand-in server not reachable at %@: %@\n", server, error.localizedDescription]);
+                return;
+            }
+
+            download(@"small.png", nil, 0);
+            download(@"oversized.jpg", NSURLErrorDomain, NSURLErrorDataLengthExceedsMaximum);
+            download(@"chunked.jpg", NSURLErrorDomain, NSURLErrorDataLengthExceedsMaximum);
+            download(@"page.jpg", AFURLResponseSerializationErrorDomain, NSURLErrorCannotDecodeContentData);
+
+            // The preconnect of an HTML page shares the session, and must not be rejected as an image.
+            __block NSArray *tasks = nil;
+
+            dispatch_group_enter(group);
+            tasks = [downloader.sessionManager preconnectToURLs:@[server] completion:^(NSArray<NSURL *> *connectedURLs) {
+                check(connectedURLs.count == 1 && ((NSURLSessionTask *)tasks.firstObject).error == nil, @"HEAD preconnect not rejected");
+                dispatch_group_leave(group);
+            }];
+
+            dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+                NSUInteger rejectionCount = downloader.pendingRejectionCount;
+                NSUInteger taskCount = downloader.pendingDownloadTaskCount;
+
+                check(rejectionCount == 0 && taskCount == 0, [NSString stringWithFormat:@"%lu rejections and %lu tasks left", (unsigned long)rejectionCount, (unsigned long)taskCount]);
+
+                // The server stops sending once the task is cancelled, the kernel buffers aside.
+                [[session dataTaskWithURL:[server URLByAppendingPathComponent:@"stats"] completionHandler:^(NSData *statsData, NSURLResponse *statsResponse, NSError *statsError) {
+                    NSDictionary *stats = statsData ? [NSJSONSerialization JSONObjectWithData:statsData options:0 error:NULL] : nil;
+
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        for (NSString *path in @[@"/oversized.jpg", @"/chunked.jpg"]) {
+                            long long sent = [stats[path][@"bytes"] longLongValue];
+
+                            check(stats != nil && sent < 2 * maximumLength, [NSString stringWithFormat:@"%@ stopped after %.1f MB, the limit is %.1f MB", path, sent / 1048576.0, maximumLength / 1048576.0]);
+                        }
+
+                        [report appendFormat:@"%lu failed", (unsigned long)failures];
+                        completion(report);
+                    });
+                }] resume];
+            });
+        });
+    }] resume];
+}
+
+@end
+
+#endif
+
 #endif
@@ -125,10 +125,7 @@ static const char * af_backgroundImageDownloadReceiptKeyForState(UIControlState
                  withURL:(NSURL *)url
         placeholderImage:(UIImage *)placeholderImage
 {
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
-    [request addValue:@"image/*" forHTTPHeaderField:@"Accept"];
-
-    [self setImageForState:state withURLRequest:request placeholderImage:placeholderImage success:nil failure:nil];
+    [self setImageForState:state withURLRequest:[AFImageDownloader imageRequestWithURL:url] placeholderImage:placeholderImage success:nil failure:nil];
 }
 
 - (void)setImageForState:(UIControlState)state
@@ -164,7 +161,7 @@ static const char * af_backgroundImageDownloadReceiptKeyForState(UIControlState
         NSUUID *downloadID = [NSUUID UUID];
         AFImageDownloadReceipt *receipt;
         receipt = [downloader
-                   downloadImageForURLRequest:urlRequest
+                   enqueueImageForURLRequest:urlRequest
                    withReceiptID:downloadID
                    success:^(NSURLRequest * _Nonnull request, NSHTTPURLResponse * _Nullable response, UIImage * _Nonnull responseObject) {
                        __strong __typeof(weakSelf)strongSelf = weakSelf;
@@ -204,10 +201,7 @@ static const char * af_backgroundImageDownloadReceiptKeyForState(UIControlState
                            withURL:(NSURL *)url
                   placeholderImage:(nullable UIImage *)placeholderImage
 {
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
-    [request addValue:@"image/*" forHTTPHeaderField:@"Accept"];
-
-    [self setBackgroundImageForState:state withURLRequest:request placeholderImage:placeholderImage success:nil failure:nil];
+    [self setBackgroundImageForState:state withURLRequest:[AFImageDownloader imageRequestWithURL:url] placeholderImage:placeholderImage success:nil failure:nil];
 }
 
 - (void)setBackgroundImageForState:(UIControlState)state
@@ -243,7 +237,7 @@ static const char * af_backgroundImageDownloadReceiptKeyForState(UIControlState
         NSUUID *downloadID = [NSUUID UUID];
         AFImageDownloadReceipt *receipt;
         receipt = [downloader
-                   downloadImageForURLRequest:urlRequest
+                   enqueueImageForURLRequest:urlRequest
                    withReceiptID:downloadID
                    success:^(NSURLRequest * _Nonnull request, NSHTTPURLResponse * _Nullable response, UIImage * _Nonnull responseObject) {
                        __strong __typeof(weakSelf)strongSelf = weakSelf;
@@ -291,12 +285,12 @@ static const char * af_backgroundImageDownloadReceiptKeyForState(UIControlState
 
 - (BOOL)isActiveTaskURLEqualToURLRequest:(NSURLRequest *)urlRequest forState:(UIControlState)state {
     AFImageDownloadReceipt *receipt = [self af_imageDownloadReceiptForState:state];
-    return [receipt.task.originalRequest.URL.absoluteString isEqualToString:urlRequest.URL.absoluteString];
+    return [receipt.URLIdentifier isEqualToString:urlRequest.URL.absoluteString];
 }
 
 - (BOOL)isActiveBackgroundTaskURLEqualToURLRequest:(NSURLRequest *)urlRequest forState:(UIControlState)state {
     AFImageDownloadReceipt *receipt = [self af_backgroundImageDownloadReceiptForState:state];
-    return [receipt.task.originalRequest.URL.absoluteString isEqualToString:urlRequest.URL.absoluteString];
+    return [receipt.URLIdentifier isEqualToString:urlRequest.URL.absoluteString];
 }
 
 
@@ -68,10 +68,7 @@
 - (void)setImageWithURL:(NSURL *)url
        placeholderImage:(UIImage *)placeholderImage
 {
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url];
-    [request addValue:@"image/*" forHTTPHeaderField:@"Accept"];
-
-    [self setImageWithURLRequest:request placeholderImage:placeholderImage success:nil failure:nil];
+    [self setImageWithURLRequest:[AFImageDownloader imageRequestWithURL:url] placeholderImage:placeholderImage success:nil failure:nil];
 }
 
 - (void)setImageWithURLRequest:(NSURLRequest *)urlRequest
@@ -95,8 +92,17 @@
     AFImageDownloader *downloader = [[self class] sharedImageDownloader];
     id <AFImageRequestCache> imageCache = downloader.imageCache;
 
-    //Use the image from the image cache if it exists
-    UIImage *cachedImage = [imageCache imageforRequest:urlRequest withAdditionalIdentifier:nil];
+    //Use the image from the image cache if it exists and the cache policy allows it, like the downloader, the lookup never waits for the writes to the cache
+    UIImage *cachedImage = nil;
+    switch (urlRequest.cachePolicy) {
+        case NSURLRequestUseProtocolCachePolicy:
+        case NSURLRequestReturnCacheDataElseLoad:
+        case NSURLRequestReturnCacheDataDontLoad:
+            cachedImage = [imageCache imageforRequest:urlRequest withAdditionalIdentifier:nil];
+            break;
+        default:
+            break;
+    }
     if (cachedImage) {
         if (success) {
             success(urlRequest, nil, cachedImage);
@@ -112,8 +118,9 @@
         __weak __typeof(self)weakSelf = self;
         NSUUID *downloadID = [NSUUID UUID];
         AFImageDownloadReceipt *receipt;
+        //Enqueue the download without waiting for the downloader, so a busy downloader never stalls the main thread
         receipt = [downloader
-                   downloadImageForURLRequest:urlRequest
+                   enqueueImageForURLRequest:urlRequest
                    withReceiptID:downloadID
                    success:^(NSURLRequest * _Nonnull request, NSHTTPURLResponse * _Nullable response, UIImage * _Nonnull responseObject) {
                        __strong __typeof(weakSelf)strongSelf = weakSelf;
@@ -153,7 +160,7 @@
 }
 
 - (BOOL)isActiveTaskURLEqualToURLRequest:(NSURLRequest *)urlRequest {
-    return [self.af_activeImageDownloadReceipt.task.originalRequest.URL.absoluteString isEqualToString:urlRequest.URL.absoluteString];
+    return [self.af_activeImageDownloadReceipt.URLIdentifier isEqualToString:urlRequest.URL.absoluteString];
 }
 
 @end
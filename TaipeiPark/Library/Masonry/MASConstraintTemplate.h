@@ -0,0 +1,67 @@
+//
+//  MASConstraintTemplate.h
+//  Masonry
+//
+//  Created by Edmund Chen on 19/10/26.
+//
+
+#import "MASUtilities.h"
+#import "MASConstraintMaker.h"
+
+/**
+ *  A constraint block recorded once and replayed against other views of the same shape, e.g. the subviews
+ *  of reusable cells. The replay creates the MASLayoutConstraints directly from the recorded values and
+ *  activates them in one batch, without running the DSL again.
+ *
+ *  The views in the block are recorded by their role: the view itself, its superview, or an index into
+ *  the related views. The replayed constraints are not tracked by masonry, so mas_updateConstraints and
+ *  mas_remakeConstraints do not see them; keep the returned constraints to change or deactivate them.
+ */
+@interface MASConstraintTemplate : NSObject
+
+/**
+ *	The count of the recorded constraints
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ *	Runs the block as mas_makeConstraints on the view, which installs its constraints, and records them.
+ *
+ *	@param	view            the first view to install the constraints on
+ *	@param	relatedViews    the views other than the view and its superview referenced by the block, can be nil
+ *	@param	block           the constraints to record
+ *
+ *	@return	the template of the constraints
+ */
++ (instancetype)templateWithView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews constraints:(void(^)(MASConstraintMaker *make))block;
+
+/**
+ *	Creates the recorded constraints for the view, inactive, so the constraints of several templates can
+ *  be activated in one batch with +[NSLayoutConstraint activateConstraints:].
+ *
+ *	@param	view            the view in the same hierarchy as the recorded one
+ *	@param	relatedViews    the views in the roles of the recorded related views
+ *
+ *	@return	an array of MASLayoutConstraints
+ */
+- (NSArray *)constraintsForView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews;
+
+/**
+ *	Creates and activates the recorded constraints for the view in one batch.
+ *
+ *	@return	an array of the activated MASLayoutConstraints
+ */
+- (NSArray *)installOnView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews;
+
+#ifdef DEBUG
+
+/**
+ *	Measures the title of an info cell, three edges and a scaled width, built by the DSL against the replay.
+ *
+ *	@return	the report of the time per view of each way
+ */
++ (NSString *)benchmarkWithIterations:(NSUInteger)iterations;
+
+#endif
+
+@end
@@ -0,0 +1,183 @@
+//
+//  MASConstraintTemplate.m
+//  Masonry
+//
+//  Created by Edmund Chen on 19/10/26.
+//
+
+#import "MASConstraintTemplate.h"
+#import "MASViewConstraint.h"
+#import "MASLayoutConstraint.h"
+#import "View+MASAdditions.h"
+
+// the roles of the second item, the related views are indexed from 0
+static const NSInteger MASTemplateItemNone = -3;
+static const NSInteger MASTemplateItemView = -2;
+static const NSInteger MASTemplateItemSuperview = -1;
+
+typedef struct {
+    NSLayoutAttribute firstAttribute;
+    NSLayoutRelation relation;
+    NSInteger secondItem;
+    NSLayoutAttribute secondAttribute;
+    CGFloat multiplier;
+    CGFloat constant;
+    MASLayoutPriority priority;
+} MASConstraintRecord;
+
+@implementation MASConstraintTemplate {
+    MASConstraintRecord *_records;
+    NSArray *_keys;     // the mas_key of each record, NSNull if none
+}
+
+- (void)dealloc {
+    free(_records);
+}
+
+#pragma mark - Record
+
++ (instancetype)templateWithView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews constraints:(void(^)(MASConstraintMaker *make))block {
+    NSSet *existingConstraints = [NSSet setWithArray:[MASViewConstraint installedConstraintsForView:view]];
+    [view mas_makeConstraints:block];
+
+    NSMutableArray *viewConstraints = [NSMutableArray array];
+    for (MASViewConstraint *viewConstraint in [MASViewConstraint installedConstraintsForView:view]) {
+        if (![existingConstraints containsObject:viewConstraint] && viewConstraint.layoutConstraint) {
+            [viewConstraints addObject:viewConstraint];
+        }
+    }
+
+    MASConstraintTemplate *constraintTemplate = [[MASConstraintTemplate alloc] init];
+    constraintTemplate->_records = calloc(viewConstraints.count ?: 1, sizeof(MASConstraintRecord));
+
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:viewConstraints.count];
+    for (MASViewConstraint *viewConstraint in viewConstraints) {
+        MASLayoutConstraint *layoutConstraint = viewConstraint.layoutConstraint;
+        MASConstraintRecord *record = constraintTemplate->_records + constraintTemplate->_count++;
+        id secondItem = layoutConstraint.secondItem;
+
+        NSAssert(layoutConstraint.firstItem == view, @"the first item of %@ is not the recorded view", layoutConstraint);
+
+        record->firstAttribute = layoutConstraint.firstAttribute;
+        record->relation = layoutConstraint.relation;
+        record->secondAttribute = layoutConstraint.secondAttribute;
+        record->multiplier = layoutConstraint.multiplier;
+        record->constant = layoutConstraint.constant;
+        record->priority = layoutConstraint.priority;
+
+        if (!secondItem) {
+            record->secondItem = MASTemplateItemNone;
+        } else if (secondItem == view) {
+            record->secondItem = MASTemplateItemView;
+        } else if (secondItem == view.superview) {
+            record->secondItem = MASTemplateItemSuperview;
+        } else {
+            NSUInteger index = [relatedViews indexOfObjectIdenticalTo:secondItem];
+            NSAssert(index != NSNotFound, @"%@ is not one of the related views of the template", secondItem);
+            record->secondItem = (index != NSNotFound) ? (NSInteger)index : MASTemplateItemNone;
+        }
+
+        [keys addObject:layoutConstraint.mas_key ?: NSNull.null];
+    }
+    constraintTemplate->_keys = keys;
+
+    return constraintTemplate;
+}
+
+#pragma mark - Replay
+
+- (NSArray *)constraintsForView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews {
+    view.translatesAutoresizingMaskIntoConstraints = NO;
+
+    NSMutableArray *constraints = [NSMutableArray arrayWithCapacity:self.count];
+    MAS_VIEW *superview = view.superview;
+
+    for (NSUInteger i = 0; i < self.count; i++) {
+        const MASConstraintRecord *record = _records + i;
+        id secondItem = nil;
+
+        if (record->secondItem == MASTemplateItemView) {
+            secondItem = view;
+        } else if (record->secondItem == MASTemplateItemSuperview) {
+            secondItem = superview;
+            NSAssert(superview, @"%@ has no superview for the template", view);
+        } else if (record->secondItem >= 0) {
+            secondItem = relatedViews[record->secondItem];
+        }
+
+        MASLayoutConstraint *layoutConstraint
+            = [MASLayoutConstraint constraintWithItem:view
+                                            attribute:record->firstAttribute
+                                            relatedBy:record->relation
+                                               toItem:secondItem
+                                            attribute:record->secondAttribute
+                                           multiplier:record->multiplier
+                                             constant:record->constant];
+        layoutConstraint.priority = record->priority;
+
+        id key = _keys[i];
+        if (key != NSNull.null) {
+            layoutConstraint.mas_key = key;
+        }
+        [constraints addObject:layoutConstraint];
+    }
+    return constraints;
+}
+
+- (NSArray *)installOnView:(MAS_VIEW *)view relatedViews:(NSArray *)relatedViews {
+    NSArray *constraints = [self constraintsForView:view relatedViews:relatedViews];
+
+    if ([NSLayoutConstraint respondsToSelector:@selector(activateConstraints:)]) {
+        [NSLayoutConstraint activateConstraints:constraints];
+    } else {
+        for (MASLayoutConstraint *layoutConstraint in constraints) {
+            MAS_VIEW *installedView = layoutConstraint.secondItem ? [view mas_closestCommonSuperview:layoutConstraint.secondItem] : view;
+            [installedView addConstraint:layoutConstraint];
+        }
+    }
+    return constraints;
+}
+
+#pragma mark - Benchmark
+
+#ifdef DEBUG
+
++ (NSString *)benchmarkWithIterations:(NSUInteger)iterations {
+    MAS_VIEW *container = [[MAS_VIEW alloc] initWithFrame:CGRectMake(0, 0, 320, 44)];
+    void (^block)(MASConstraintMaker *) = ^(MASConstraintMaker *make) {
+        make.left.equalTo(container).offset(15);
+        make.top.equalTo(container).offset(10);
+        make.bottom.equalTo(container).offset(-10);
+        make.width.equalTo(container).multipliedBy(0.4);
+    };
+
+    MAS_VIEW *first = [[MAS_VIEW alloc] init];
+    [container addSubview:first];
+    MASConstraintTemplate *constraintTemplate = [MASConstraintTemplate templateWithView:first relatedViews:nil constraints:block];
+    [first removeFromSuperview];
+
+    CFAbsoluteTime dslTime = 0, templateTime = 0;
+    for (NSUInteger i = 0; i < iterations; i++) {
+        MAS_VIEW *view = [[MAS_VIEW alloc] init];
+        [container addSubview:view];
+        CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+        [view mas_makeConstraints:block];
+        dslTime += CFAbsoluteTimeGetCurrent() - start;
+        [view removeFromSuperview];
+
+        view = [[MAS_VIEW alloc] init];
+        [container addSubview:view];
+        start = CFAbsoluteTimeGetCurrent();
+        [constraintTemplate installOnView:view relatedViews:nil];
+        templateTime += CFAbsoluteTimeGetCurrent() - start;
+        [view removeFromSuperview];
+    }
+
+    NSUInteger count = MAX(iterations, 1);
+    return [NSString stringWithFormat:@"%lu views of %lu constraints: DSL %.2f us, template %.2f us per view",
+            (unsigned long)iterations, (unsigned long)constraintTemplate.count, dslTime * 1e6 / count, templateTime * 1e6 / count];
+}
+
+#endif
+
+@end
@@ -27,6 +27,11 @@
  */
 @property (nonatomic, strong, readonly) MASViewAttribute *secondViewAttribute;
 
+/**
+ *	The NSLayoutConstraint created by install, nil until it has been installed
+ */
+@property (nonatomic, weak, readonly) MASLayoutConstraint *layoutConstraint;
+
 /**
  *	initialises the MASViewConstraint with the first part of the equation
  *
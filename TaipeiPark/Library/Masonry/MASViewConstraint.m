@@ -35,6 +35,104 @@ static char kInstalledConstraintsKey;
 @end
 
 
+/**
+ *  The key of a layout constraint apart from its constant, the only property updated in place.
+ *  The items are compared by identity and never messaged, so the key does not retain them.
+ */
+@interface MASLayoutConstraintKey : NSObject <NSCopying>
+
+- (id)initWithLayoutConstraint:(NSLayoutConstraint *)layoutConstraint;
+
+@end
+
+@implementation MASLayoutConstraintKey {
+    __unsafe_unretained id _firstItem;
+    __unsafe_unretained id _secondItem;
+    NSLayoutAttribute _firstAttribute;
+    NSLayoutAttribute _secondAttribute;
+    NSLayoutRelation _relation;
+    CGFloat _multiplier;
+    MASLayoutPriority _priority;
+    NSUInteger _hash;
+}
+
+- (id)initWithLayoutConstraint:(NSLayoutConstraint *)layoutConstraint {
+    self = [super init];
+    if (!self) return nil;
+
+    _firstItem = layoutConstraint.firstItem;
+    _secondItem = layoutConstraint.secondItem;
+    _firstAttribute = layoutConstraint.firstAttribute;
+    _secondAttribute = layoutConstraint.secondAttribute;
+    _relation = layoutConstraint.relation;
+    _multiplier = layoutConstraint.multiplier;
+    _priority = layoutConstraint.priority;
+
+    // The multiplier may be negative, e.g. multipliedBy(-1), so its bits are hashed rather than a scaled cast.
+    // Adding 0 turns -0 into 0, the two are equal.
+    double multiplier = (double)_multiplier + 0.0;
+    uint64_t multiplierBits;
+    memcpy(&multiplierBits, &multiplier, sizeof(multiplierBits));
+
+    NSUInteger hash = (NSUInteger)_firstItem ^ ((NSUInteger)_secondItem << 7);
+    hash = hash * 31 + (NSUInteger)_firstAttribute;
+    hash = hash * 31 + (NSUInteger)_secondAttribute;
+    hash = hash * 31 + (NSUInteger)(_relation + 1);
+    hash = hash * 31 + (NSUInteger)(multiplierBits ^ (multiplierBits >> 32));
+    _hash = hash * 31 + (NSUInteger)_priority;
+
+    return self;
+}
+
+- (id)copyWithZone:(NSZone __unused *)zone {
+    return self;
+}
+
+- (NSUInteger)hash {
+    return _hash;
+}
+
+- (BOOL)isEqual:(MASLayoutConstraintKey *)key {
+    if (key == self) return YES;
+    if (![key isKindOfClass:MASLayoutConstraintKey.class]) return NO;
+    return key->_firstItem == _firstItem
+        && key->_secondItem == _secondItem
+        && key->_firstAttribute == _firstAttribute
+        && key->_secondAttribute == _secondAttribute
+        && key->_relation == _relation
+        && key->_multiplier == _multiplier
+        && key->_priority == _priority;
+}
+
+@end
+
+
+@interface MAS_VIEW (MASConstraintIndex)
+
+/**
+ *  The latest constraint installed by Masonry on the view for each MASLayoutConstraintKey.
+ *  The constraints are held by the view, the index only references them weakly.
+ */
+@property (nonatomic, readonly) NSMapTable *mas_constraintIndex;
+
+@end
+
+@implementation MAS_VIEW (MASConstraintIndex)
+
+static char kConstraintIndexKey;
+
+- (NSMapTable *)mas_constraintIndex {
+    NSMapTable *index = objc_getAssociatedObject(self, &kConstraintIndexKey);
+    if (!index) {
+        index = [NSMapTable strongToWeakObjectsMapTable];
+        objc_setAssociatedObject(self, &kConstraintIndexKey, index, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+    }
+    return index;
+}
+
+@end
+
+
 @interface MASViewConstraint ()
 
 @property (nonatomic, strong, readwrite) MASViewAttribute *secondViewAttribute;
@@ -291,6 +389,7 @@ static char kInstalledConstraintsKey;
             return;
         }
         self.layoutConstraint.active = YES;
+        [self indexLayoutConstraint];
         [self.firstViewAttribute.view.mas_installedConstraints addObject:self];
     } else {
         [self install];
@@ -359,6 +458,7 @@ static char kInstalledConstraintsKey;
     } else {
         [self.installedView addConstraint:layoutConstraint];
         self.layoutConstraint = layoutConstraint;
+        [self indexLayoutConstraint];
     }
     
     [firstLayoutItem.mas_installedConstraints addObject:self];
@@ -367,24 +467,45 @@ static char kInstalledConstraintsKey;
 - (MASLayoutConstraint *)layoutConstraintSimilarTo:(MASLayoutConstraint *)layoutConstraint {
     // check if any constraints are the same apart from the only mutable property constant
 
-    // go through constraints in reverse as we do not want to match auto-resizing or interface builder constraints
-    // and they are likely to be added first.
-    for (NSLayoutConstraint *existingConstraint in self.installedView.constraints.reverseObjectEnumerator) {
-        if (![existingConstraint isKindOfClass:MASLayoutConstraint.class]) continue;
-        if (existingConstraint.firstItem != layoutConstraint.firstItem) continue;
-        if (existingConstraint.secondItem != layoutConstraint.secondItem) continue;
-        if (existingConstraint.firstAttribute != layoutConstraint.firstAttribute) continue;
-        if (existingConstraint.secondAttribute != layoutConstraint.secondAttribute) continue;
-        if (existingConstraint.relation != layoutConstraint.relation) continue;
-        if (existingConstraint.multiplier != layoutConstraint.multiplier) continue;
-        if (existingConstraint.priority != layoutConstraint.priority) continue;
-
-        return (id)existingConstraint;
+    // look up the latest one installed by masonry, like a reverse scan of the constraints would find,
+    // instead of scanning all constraints of the view
+    MASLayoutConstraintKey *key = [[MASLayoutConstraintKey alloc] initWithLayoutConstraint:layoutConstraint];
+    MASLayoutConstraint *existingConstraint = [self.installedView.mas_constraintIndex objectForKey:key];
+    if (!existingConstraint) return nil;
+
+    // the index is not told about constraints removed outside of masonry, and the key of a released
+    // item may match a new item at the same address
+    BOOL installed = existingConstraint.firstItem == layoutConstraint.firstItem
+        && existingConstraint.secondItem == layoutConstraint.secondItem
+        && ([existingConstraint respondsToSelector:@selector(isActive)]
+            ? existingConstraint.isActive
+            : [self.installedView.constraints containsObject:existingConstraint]);
+    if (!installed) {
+        [self.installedView.mas_constraintIndex removeObjectForKey:key];
+        return nil;
+    }
+    return existingConstraint;
+}
+
+- (void)indexLayoutConstraint {
+    if (!self.layoutConstraint || !self.installedView) return;
+
+    MASLayoutConstraintKey *key = [[MASLayoutConstraintKey alloc] initWithLayoutConstraint:self.layoutConstraint];
+    [self.installedView.mas_constraintIndex setObject:self.layoutConstraint forKey:key];
+}
+
+- (void)unindexLayoutConstraint {
+    if (!self.layoutConstraint || !self.installedView) return;
+
+    MASLayoutConstraintKey *key = [[MASLayoutConstraintKey alloc] initWithLayoutConstraint:self.layoutConstraint];
+    NSMapTable *index = self.installedView.mas_constraintIndex;
+    if ([index objectForKey:key] == self.layoutConstraint) {
+        [index removeObjectForKey:key];
     }
-    return nil;
 }
 
 - (void)uninstall {
+    [self unindexLayoutConstraint];
     [self.installedView removeConstraint:self.layoutConstraint];
     self.layoutConstraint = nil;
     self.installedView = nil;
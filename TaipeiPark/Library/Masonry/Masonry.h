@@ -16,5 +16,6 @@
 #import "MASViewAttribute.h"
 #import "MASViewConstraint.h"
 #import "MASConstraintMaker.h"
+#import "MASConstraintTemplate.h"
 #import "MASLayoutConstraint.h"
 #import "NSLayoutConstraint+MASDebugAdditions.h"
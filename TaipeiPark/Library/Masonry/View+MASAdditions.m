@@ -99,8 +99,40 @@
 
 #pragma mark - heirachy
 
+static char kCommonSuperviewsKey;
+
+/**
+ *  Whether the view is still the closest common superview: it is an ancestor of both views and no view
+ *  below it is an ancestor of both. Only walks the paths up to the view, usually a step or two.
+ */
+static BOOL MASIsClosestCommonSuperview(MAS_VIEW *firstView, MAS_VIEW *secondView, MAS_VIEW *commonSuperview) {
+    enum { kMaxDepth = 32 };
+    __unsafe_unretained MAS_VIEW *firstPath[kMaxDepth];
+    NSUInteger count = 0;
+
+    for (MAS_VIEW *view = firstView; view != commonSuperview; view = view.superview) {
+        if (!view || count == kMaxDepth) return NO;
+        firstPath[count++] = view;
+    }
+    for (MAS_VIEW *view = secondView; view != commonSuperview; view = view.superview) {
+        if (!view) return NO;
+        for (NSUInteger i = 0; i < count; i++) {
+            if (firstPath[i] == view) return NO;
+        }
+    }
+    return YES;
+}
+
 - (instancetype)mas_closestCommonSuperview:(MAS_VIEW *)view {
-    MAS_VIEW *closestCommonSuperview = nil;
+    if (!view) return nil;
+
+    // memoized per view, and checked against the current hierarchy before it is used
+    NSMapTable *commonSuperviews = objc_getAssociatedObject(self, &kCommonSuperviewsKey);
+    MAS_VIEW *closestCommonSuperview = [commonSuperviews objectForKey:view];
+    if (closestCommonSuperview && MASIsClosestCommonSuperview(self, view, closestCommonSuperview)) {
+        return closestCommonSuperview;
+    }
+    closestCommonSuperview = nil;
 
     MAS_VIEW *secondViewSuperview = view;
     while (!closestCommonSuperview && secondViewSuperview) {
@@ -113,6 +145,14 @@
         }
         secondViewSuperview = secondViewSuperview.superview;
     }
+
+    if (closestCommonSuperview) {
+        if (!commonSuperviews) {
+            commonSuperviews = [NSMapTable weakToWeakObjectsMapTable];
+            objc_setAssociatedObject(self, &kCommonSuperviewsKey, commonSuperviews, OBJC_ASSOCIATION_RETAIN_NONATOMIC);
+        }
+        [commonSuperviews setObject:closestCommonSuperview forKey:view];
+    }
     return closestCommonSuperview;
 }
 
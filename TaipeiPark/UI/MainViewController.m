@@ -7,21 +7,149 @@
 #import "MainViewController.h"
 #import "AFNetworking.h"
 #import "ParkInfoViewController.h"
+#import "ECNetworkWarmUp.h"
+#import "ECDatasetSnapshot.h"
+#import "ECParkAttraction.h"
+#import "ECCollator.h"
+#import "ECPhoneticSearchIndex.h"
+#import "ECRelatedAttractions.h"
+#import "ECPrefetchEngine.h"
+#import "ECCellContent.h"
+#import "ECImagePreviews.h"
 
-@interface MainViewController ()
+// The matched attractions shown at most
+#define MAX_SEARCH_RESULTS 100
+
+#define DWELL_DELAY             0.4     // Seconds the list rests before its center rows are predicted
+#define DWELL_ROWS              3
+#define WITHDRAW_DELAY          0.3     // Seconds after the unhighlight, the selection follows in between
+#define FLING_VELOCITY          2500    // Points per second, the rows passed by are not predicted
+#define SLOW_RELEASE_VELOCITY   1.0     // Points per millisecond, the rows at the target are predicted early
+#define MAX_RELATED_PREFETCH    4       // The related thumbnails shown without scrolling
+
+// The list cells are rendered into bitmaps off the main thread
+#define ASYNC_CELL_DISPLAY      YES
+
+// ECSortedSections
+
+/**
+ *  The parks and their attractions sorted in one order, with the section index. Built off the main
+ *  thread and not changed after that, so switching the order only swaps the lists on the main thread.
+ */
+@interface ECSortedSections : NSObject
+
+@property (nonatomic, strong, readonly) NSArray *sections;          // Array of SectionEntry
+@property (nonatomic, strong, readonly) NSArray *indexTitles;       // The titles of the section index
+@property (nonatomic, strong, readonly) NSArray *indexSections;     // The section of each index title
+
+/**
+ * \brief	Sort copies of the sections and their attractions by the keys of the names.
+ * \param   keys        The dictionary of the name and its sort key of the collator.
+ */
+- (instancetype)init_With_Sections: (NSArray*) sections keys: (NSDictionary*) keys collator: (ECCollator*) collator;
+
+@end
+
+@implementation ECSortedSections
+
+- (instancetype)init_With_Sections: (NSArray*) sections keys: (NSDictionary*) keys collator: (ECCollator*) collator
+{
+    if (self = [super init])
+    {
+        NSMutableArray *entries = [[NSMutableArray alloc] initWithCapacity:sections.count];
+        NSMutableArray *sectionKeys = [[NSMutableArray alloc] initWithCapacity:sections.count];
+        
+        for (SectionEntry *section in sections)
+        {
+            SectionEntry *entry = [SectionEntry entry_With_Title:section.title];
+            NSMutableArray *rowKeys = [[NSMutableArray alloc] initWithCapacity:section.items.count];
+            
+            for (ECParkAttraction *attraction in section.items)
+                [rowKeys addObject:[keys objectForKey:attraction.name] ?: [NSData data]];
+            
+            entry.items = [[ECCollator sort_Objects:section.items keys:rowKeys] mutableCopy];
+            
+            [entries addObject:entry];
+            [sectionKeys addObject:[keys objectForKey:section.title] ?: [NSData data]];
+        }
+        
+        _sections = [ECCollator sort_Objects:entries keys:sectionKeys];
+        
+        // One index title per group of the sections, the first section of the group is shown
+        NSMutableArray *titles = [[NSMutableArray alloc] init];
+        NSMutableArray *indexSections = [[NSMutableArray alloc] init];
+        
+        [_sections enumerateObjectsUsingBlock:^(SectionEntry *entry, NSUInteger idx, BOOL *stop) {
+            NSString *title = [collator index_Title_For_String:entry.title];
+            
+            if (![titles containsObject:title])
+            {
+                [titles addObject:title];
+                [indexSections addObject:@(idx)];
+            }
+        }];
+        
+        _indexTitles = titles;
+        _indexSections = indexSections;
+    }
+    
+    return self;
+}
+
+@end
+
+
+// MainViewController
+
+@interface MainViewController () <UISearchBarDelegate>
 
 @end
 
 @implementation MainViewController
 {
-    NSMutableArray *_aryParkTitles;     // Used to group the park attractions
     BOOL _loaded;
+    
+    ECCollationOrder _order;
+    NSArray *_arySorted;                // The ECSortedSections per order, restored after the search
+    
+    NSArray *_aryAttractions;           // The attractions in the order of the search index
+    ECPhoneticSearchIndex *_searchIndex;
+    
+    // Built by perform_Update_Items, published together by update_Items_On_Main_Thread
+    NSArray *_pendingSorted;
+    NSArray *_pendingAttractions;
+    ECPhoneticSearchIndex *_pendingSearchIndex;
+    NSString *_searchText;
+    
+    CGFloat _lastOffsetY;               // Used to measure the scroll velocity
+    CFTimeInterval _lastScrollTime;
 }
 
 - (void)viewDidLoad
 {
     [super viewDidLoad];
     // Do any additional setup after loading the view, typically from a nib.
+    
+    // The detail rows are built off the main thread for the predicted attractions
+    CGFloat width = [UIScreen mainScreen].bounds.size.width;
+    
+    [ECPrefetchEngine sharedEngine].modelWarmer = ^(ECParkAttraction *attraction) {
+        [ParkInfoViewController prefetch_Rows_For_Attraction:attraction width:width];
+    };
+}
+
+- (void)viewDidAppear:(BOOL)animated
+{
+    [super viewDidAppear:animated];
+    
+    [self _schedule_Dwell];
+}
+
+- (void)viewWillDisappear:(BOOL)animated
+{
+    [super viewWillDisappear:animated];
+    
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(_on_Dwell) object:nil];
 }
 
 - (void)didReceiveMemoryWarning
@@ -40,6 +168,8 @@
         
         vc.indexAttraction = self.indexPathSel.row;
         vc.aryAttractions = entry.items;
+        
+        [[ECPrefetchEngine sharedEngine] did_Open_Key:[[entry.items objectAtIndex:self.indexPathSel.row] attraction_Key]];
     }
 }
 
@@ -48,6 +178,18 @@
 - (void)init_UI
 {
     [super init_UI];
+    
+    self.tableView.sectionIndexColor = CLR_MAJOR;
+    
+    // Search the attractions by their names, in Chinese, pinyin or Zhuyin
+    UISearchBar *searchBar = [[UISearchBar alloc] initWithFrame:CGRectMake(0, 0, self.view.frame.size.width, 44)];
+    
+    searchBar.placeholder = @"搜尋景點 (中文、拼音或注音)";
+    searchBar.autocapitalizationType = UITextAutocapitalizationTypeNone;
+    searchBar.autocorrectionType = UITextAutocorrectionTypeNo;
+    searchBar.delegate = self;
+    
+    self.tableView.tableHeaderView = searchBar;
 }
 
 - (void)init_Navigation_Bar
@@ -59,6 +201,9 @@
     self.navigationController.navigationBar.titleTextAttributes = @{NSForegroundColorAttributeName: [UIColor whiteColor]};
     self.navigationController.navigationBar.barTintColor = CLR_MAJOR;
     self.navigationController.navigationBar.tintColor = [UIColor colorWithRed:240.0/255.0 green:240.0/255.0 blue:240.0/255.0 alpha:1.0];
+    
+    // Switch the sort order of the parks and the attractions
+    self.navigationItem.leftBarButtonItem = [[UIBarButtonItem alloc] initWithTitle:[self _title_For_Order:_order] style:UIBarButtonItemStylePlain target:self action:@selector(onSortOrder)];
 }
 
 - (BOOL)should_Show_Back_Button
@@ -81,14 +226,13 @@
     dispatch_semaphore_t sep = dispatch_semaphore_create(0);
     __block NSArray *items = nil;
     
-    // Call API to get park informations
-    AFHTTPSessionManager *manager = [AFHTTPSessionManager manager];
+    // Call API to get park informations, use the shared manager to reuse the warmed connection.
+    AFHTTPSessionManager *manager = [ECNetworkWarmUp sharedInstance].apiManager;
     
-    [manager GET:@"http://data.taipei/opendata/datalist/apiAccess" parameters:@{@"scope": @"resourceAquire", @"rid": @"bf073841-c734-49bf-a97f-3757a6013812"} progress:nil success:^(NSURLSessionDataTask *task, id responseObject){
+    [manager GET:kECParkAPIURL parameters:@{@"scope": @"resourceAquire", @"rid": @"bf073841-c734-49bf-a97f-3757a6013812"} progress:nil success:^(NSURLSessionDataTask *task, id responseObject){
         
-        NSDictionary *response = (NSDictionary*)responseObject;
-        
-        items = [[response objectForKey:@"result"] objectForKey:@"results"];
+        // The array of ECParkAttraction, decoded by the response serializer
+        items = (NSArray*)responseObject;
 
         dispatch_semaphore_signal(sep);
     }failure:^(NSURLSessionDataTask *task, NSError *error){
@@ -99,88 +243,569 @@
     
     dispatch_semaphore_wait(sep, DISPATCH_TIME_FOREVER);
     
-    // Parse the items
-    _aryParkTitles = [[NSMutableArray alloc] init];
-    _aryItems = [[NSMutableArray alloc] init];
+    // Keep the snapshot for the warm-up of the next launch
+    if (items.count > 0)
+    {
+        NSMutableArray *aryDics = [[NSMutableArray alloc] initWithCapacity:items.count];
+        
+        for (ECParkAttraction *attraction in items)
+            [aryDics addObject:[attraction snapshot_Representation]];
+        
+        [[ECDatasetSnapshot sharedSnapshot] save_Items:aryDics];
+        
+        // Only the changed attractions are computed again, off the main thread
+        [[ECRelatedAttractions sharedInstance] update_With_Attractions:items];
+    }
+    
+    // Parse the items, into locals as the main thread still shows the former ones
+    NSMutableArray *parkTitles = [[NSMutableArray alloc] init];
+    NSMutableArray *sections = [[NSMutableArray alloc] init];
     
-    for (NSDictionary* dic in items)
+    for (ECParkAttraction *attraction in items)
     {
-        NSString *parkName = [dic objectForKey:@"ParkName"];
+        NSString *parkName = attraction.parkName;
         SectionEntry *entry = nil;
         
-        NSUInteger index = [_aryParkTitles indexOfObject:parkName];
+        NSUInteger index = [parkTitles indexOfObject:parkName];
         
         if (NSNotFound == index) // Create new section entry
         {
             entry = [SectionEntry entry_With_Title:parkName];
             
-            index = _aryItems.count;
-            [_aryItems addObject:entry];
-            [_aryParkTitles addObject:parkName];
+            index = sections.count;
+            [sections addObject:entry];
+            [parkTitles addObject:parkName];
         }
         else // Get the exist section entry;
         {
-            entry = [_aryItems objectAtIndex:index];
+            entry = [sections objectAtIndex:index];
         }
         
         // Add the item into the section entry
-        [entry.items addObject:dic];
+        [entry.items addObject:attraction];
+    }
+    
+    // Rank the characters of the names once, sorting by either order is memcmp of the keys after that.
+    // Both orders are sorted here, switching the order only swaps the lists on the main thread.
+    NSMutableArray *names = [parkTitles mutableCopy];
+    NSMutableArray *arySorted = [[NSMutableArray alloc] initWithCapacity:ECCollationOrderCount];
+    
+    for (ECParkAttraction *attraction in items)
+        [names addObject:attraction.name];
+    
+    for (ECCollationOrder order = 0; order < ECCollationOrderCount; order++)
+    {
+        ECCollator *collator = [[ECCollator alloc] init_With_Order:order strings:names];
+        NSMutableDictionary *keys = [[NSMutableDictionary alloc] initWithCapacity:names.count];
+        
+        for (NSString *name in names)
+        {
+            if (nil == [keys objectForKey:name])
+                [keys setObject:[collator sort_Key_For_String:name] forKey:name];
+        }
+        
+        [arySorted addObject:[[ECSortedSections alloc] init_With_Sections:sections keys:keys collator:collator]];
     }
+    
+    _pendingSorted = arySorted;
+    
+    // The phonetic index of the names, the search is under a millisecond after that
+    NSMutableArray *attractionNames = [[NSMutableArray alloc] initWithCapacity:items.count];
+    
+    for (ECParkAttraction *attraction in items)
+        [attractionNames addObject:attraction.name ?: @""];
+    
+    _pendingAttractions = items;
+    _pendingSearchIndex = [[ECPhoneticSearchIndex alloc] init_With_Strings:attractionNames];
 }
 
 - (void)update_Items_On_Main_Thread
 {
+    // The search results index into the attractions, so both are swapped with the lists at once
+    if (nil != _pendingSorted)
+    {
+        _arySorted = _pendingSorted;
+        _aryAttractions = _pendingAttractions;
+        _searchIndex = _pendingSearchIndex;
+        
+        _pendingSorted = nil;
+        _pendingAttractions = nil;
+        _pendingSearchIndex = nil;
+    }
+    
+    [self _apply_Search];
+    
     [super update_Items_On_Main_Thread];
     
     _loaded = YES;
+    
+    [self _schedule_Dwell];
+}
+
+#pragma mark - Sort
+
+- (NSString*)_title_For_Order: (ECCollationOrder) order
+{
+    return (ECCollationOrderZhuyin == order) ? @"注音" : @"筆畫";
+}
+
+/**
+ * \brief	The sorted sections of the current order, nil before the first update.
+ */
+- (ECSortedSections*)_sorted_Sections
+{
+    return ((NSUInteger)_order < _arySorted.count) ? [_arySorted objectAtIndex:_order] : nil;
+}
+
+- (void)onSortOrder
+{
+    _order = (ECCollationOrderStroke == _order) ? ECCollationOrderZhuyin : ECCollationOrderStroke;
+    
+    self.navigationItem.leftBarButtonItem.title = [self _title_For_Order:_order];
+    
+    if (nil == _arySorted)
+        return;
+    
+    [self _apply_Search];
+    [self.rowPrefetcher cancel_All];
+    [self.tableView reloadData];
+}
+
+#pragma mark - Search
+
+- (BOOL)_is_Searching
+{
+    return _searchText.length > 0;
+}
+
+/**
+ * \brief	Show the matched attractions in one section, or all sections if not searching.
+ */
+- (void)_apply_Search
+{
+    if (![self _is_Searching] || nil == _searchIndex)
+    {
+        _aryItems = [[self _sorted_Sections].sections mutableCopy];
+        return;
+    }
+    
+    SectionEntry *entry = [SectionEntry entry_With_Title:@"搜尋結果"];
+    
+    for (NSNumber *index in [_searchIndex search:_searchText maxResults:MAX_SEARCH_RESULTS])
+        [entry.items addObject:[_aryAttractions objectAtIndex:index.unsignedIntegerValue]];
+    
+    _aryItems = [NSMutableArray arrayWithObject:entry];
+}
+
+#pragma mark - Prefetch
+
+- (ECParkAttraction*)_attraction_At_IndexPath: (NSIndexPath*) indexPath
+{
+    if (indexPath.section >= self.aryItems.count)
+        return nil;
+    
+    SectionEntry *entry = [self.aryItems objectAtIndex:indexPath.section];
+    
+    return (indexPath.row < entry.items.count) ? [entry.items objectAtIndex:indexPath.row] : nil;
+}
+
+/**
+ * \brief	Predict the detail screen of the attraction: the hero image, the first related thumbnails and the rows.
+ */
+- (void)_predict_Attraction: (ECParkAttraction*) attraction signal: (ECPrefetchSignal) signal
+{
+    if (nil == attraction)
+        return;
+    
+    NSMutableArray *urls = [[NSMutableArray alloc] initWithCapacity:1 + MAX_RELATED_PREFETCH];
+    NSURL *url = [NSURL URLWithString:attraction.image];
+    NSUInteger relatedCount = 0;
+    
+    if (nil != url)
+        [urls addObject:url];
+    
+    // Counted apart from the hero image, which may be missing
+    for (ECParkAttraction *related in [[ECRelatedAttractions sharedInstance] related_Attractions_For:attraction])
+    {
+        if (relatedCount >= MAX_RELATED_PREFETCH)
+            break;
+        
+        if (nil != (url = [NSURL URLWithString:related.image]))
+        {
+            [urls addObject:url];
+            relatedCount++;
+        }
+    }
+    
+    [[ECPrefetchEngine sharedEngine] predict_Key:[attraction attraction_Key] object:attraction imageURLs:urls signal:signal];
+}
+
+/**
+ * \brief	Predict the rows nearest to the center of the rect, the other dwell predictions are cancelled.
+ */
+- (void)_predict_Rows_In_Rect: (CGRect) rect
+{
+    CGFloat center = CGRectGetMidY(rect);
+    UITableView *tableView = self.tableView;
+    
+    NSArray *indexPaths = [[tableView indexPathsForRowsInRect:rect] sortedArrayUsingComparator:^NSComparisonResult(NSIndexPath *a, NSIndexPath *b) {
+        CGFloat da = fabs(CGRectGetMidY([tableView rectForRowAtIndexPath:a]) - center);
+        CGFloat db = fabs(CGRectGetMidY([tableView rectForRowAtIndexPath:b]) - center);
+        
+        return (da < db) ? NSOrderedAscending : ((da > db) ? NSOrderedDescending : NSOrderedSame);
+    }];
+    
+    NSMutableSet *keys = [[NSMutableSet alloc] initWithCapacity:DWELL_ROWS];
+    
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
+        
+        if (keys.count >= DWELL_ROWS)
+            break;
+        
+        if (nil == attraction)
+            continue;
+        
+        [keys addObject:[attraction attraction_Key]];
+        [self _predict_Attraction:attraction signal:ECPrefetchSignalDwell];
+    }
+    
+    [[ECPrefetchEngine sharedEngine] cancel_Signal:ECPrefetchSignalDwell exceptKeys:keys];
+}
+
+- (void)_schedule_Dwell
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(_on_Dwell) object:nil];
+    [self performSelector:@selector(_on_Dwell) withObject:nil afterDelay:DWELL_DELAY];
+}
+
+- (void)_on_Dwell
+{
+    [self _predict_Rows_In_Rect:self.tableView.bounds];
+}
+
+- (void)_withdraw_Prediction: (NSString*) key
+{
+    [[ECPrefetchEngine sharedEngine] cancel_Key:key];
+}
+
+#pragma mark - Delegate of the UIScrollView
+
+- (void)scrollViewWillBeginDragging:(UIScrollView *)scrollView
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(_on_Dwell) object:nil];
+}
+
+- (void)scrollViewDidScroll:(UIScrollView *)scrollView
+{
+    CFTimeInterval now = CACurrentMediaTime();
+    CGFloat offsetY = scrollView.contentOffset.y;
+    
+    // The rows flung by will not be opened
+    if (now > _lastScrollTime && fabs(offsetY - _lastOffsetY) / (now - _lastScrollTime) > FLING_VELOCITY)
+        [[ECPrefetchEngine sharedEngine] cancel_Signal:ECPrefetchSignalDwell exceptKeys:nil];
+    
+    _lastOffsetY = offsetY;
+    _lastScrollTime = now;
+}
+
+- (void)scrollViewWillEndDragging:(UIScrollView *)scrollView withVelocity:(CGPoint)velocity targetContentOffset:(inout CGPoint *)targetContentOffset
+{
+    // A slow release settles soon, predict where it stops
+    if (0 != velocity.y && fabs(velocity.y) < SLOW_RELEASE_VELOCITY)
+    {
+        CGRect rect = scrollView.bounds;
+        
+        rect.origin.y = targetContentOffset->y;
+        [self _predict_Rows_In_Rect:rect];
+    }
+}
+
+- (void)scrollViewDidEndDragging:(UIScrollView *)scrollView willDecelerate:(BOOL)decelerate
+{
+    if (!decelerate)
+        [self _schedule_Dwell];
+}
+
+- (void)scrollViewDidEndDecelerating:(UIScrollView *)scrollView
+{
+    [self _schedule_Dwell];
+}
+
+#pragma mark - Delegate of the UISearchBar
+
+- (void)searchBar:(UISearchBar *)searchBar textDidChange:(NSString *)searchText
+{
+    _searchText = [searchText stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    
+    [self _apply_Search];
+    [self.rowPrefetcher cancel_All];
+    [self.tableView reloadData];
+}
+
+- (void)searchBarTextDidBeginEditing:(UISearchBar *)searchBar
+{
+    [searchBar setShowsCancelButton:YES animated:YES];
+}
+
+- (void)searchBarSearchButtonClicked:(UISearchBar *)searchBar
+{
+    [searchBar resignFirstResponder];
+}
+
+- (void)searchBarCancelButtonClicked:(UISearchBar *)searchBar
+{
+    searchBar.text = nil;
+    [searchBar setShowsCancelButton:NO animated:YES];
+    [searchBar resignFirstResponder];
+    
+    [self searchBar:searchBar textDidChange:@""];
 }
 
 #pragma mark - DataSource of the UITableView
 
+- (NSArray<NSString*>*)sectionIndexTitlesForTableView:(UITableView *)tableView
+{
+    return [self _is_Searching] ? nil : [self _sorted_Sections].indexTitles;
+}
+
+- (NSInteger)tableView:(UITableView *)tableView sectionForSectionIndexTitle:(NSString *)title atIndex:(NSInteger)index
+{
+    return [[[self _sorted_Sections].indexSections objectAtIndex:index] integerValue];
+}
+
 - (UITableViewCell*)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
     SectionEntry *entry = [self.aryItems objectAtIndex:indexPath.section];
-    NSDictionary *dic = [entry.items objectAtIndex:indexPath.row];
+    ECParkAttraction *attraction = [entry.items objectAtIndex:indexPath.row];
     
     ECTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"CellParkAttraction"];
     
+    cell.displaysAsynchronously = ASYNC_CELL_DISPLAY;
+    cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
+    
+    if (cell.displaysAsynchronously)
+    {
+        cell.accessibilityLabel = [NSString stringWithFormat:@"%@, %@", attraction.name, attraction.parkName];
+        
+        [cell display_Async_Content:^ECCellContent *(CGSize size) {
+            return [MainViewController _content_For_Attraction:attraction size:size];
+        }];
+        
+        return cell;
+    }
+    
     // Set the data for the cell
-    cell.labelTitle.text = [dic objectForKey:@"Name"];
-    cell.labelSubtitle.text = [dic objectForKey:@"ParkName"];
+    cell.labelTitle.text = attraction.name;
+    cell.labelSubtitle.text = attraction.parkName;
     
-    [cell.imgViewIcon setImageWithURL:[NSURL URLWithString:[dic objectForKey:@"Image" default:@""]] placeholderImage:[UIImage imageNamed:@"icon_default"]];
+    [cell.imgViewIcon setImageWithURL:[NSURL URLWithString:attraction.image] placeholderImage:[[ECImagePreviews sharedPreviews] placeholder_For_URL:attraction.image default_Image:[UIImage imageNamed:@"icon_default"]]];
     
-    cell.labelDetail1.text = [dic objectForKey:@"Introduction"];
+    cell.labelDetail1.text = attraction.introduction;
     cell.labelDetail1.numberOfLines = 0;
     
-    cell.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
-    
     return cell;
 }
 
+#pragma mark - Row Prefetch
+
+- (BOOL)should_Prefetch_Rows
+{
+    return YES;
+}
+
+- (NSArray<NSString*>*)prefetch_Image_URLs_At_IndexPath: (NSIndexPath*) indexPath
+{
+    NSString *imageURL = [self _attraction_At_IndexPath:indexPath].image;
+    
+    return (0 < imageURL.length) ? @[imageURL] : nil;
+}
+
+- (CGSize)prefetch_Image_Size_At_IndexPath: (NSIndexPath*) indexPath
+{
+    // The frame of the image in the prototype cell
+    return CGSizeMake(60, 60);
+}
+
+- (dispatch_block_t)prefetch_Layout_At_IndexPath: (NSIndexPath*) indexPath
+{
+    ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
+    CGFloat width = self.tableView.frame.size.width;
+    CGFloat contentWidth = [self _content_Width];
+    CGFloat separator = [self _separator_Height];
+    
+    if (nil == attraction)
+        return nil;
+    
+    // The row height first, then the content at the size of the content view
+    return ^{
+        CGFloat height = [MainViewController _row_Height_For_Attraction:attraction width:width];
+        
+        if (ASYNC_CELL_DISPLAY)
+            [MainViewController _content_For_Attraction:attraction size:CGSizeMake(contentWidth, height - separator)];
+    };
+}
+
+- (BOOL)is_Layout_Ready_At_IndexPath: (NSIndexPath*) indexPath
+{
+    ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
+    
+    if (nil == attraction)
+        return NO;
+    
+    NSArray *cached = [[MainViewController _row_Heights] objectForKey:attraction];
+    
+    if (nil == cached || [[cached firstObject] doubleValue] != self.tableView.frame.size.width)
+        return NO;
+    
+    if (!ASYNC_CELL_DISPLAY)
+        return YES;
+    
+    ECCellContent *content = [[MainViewController _cell_Contents] objectForKey:attraction];
+    CGSize size = CGSizeMake([self _content_Width], [[cached lastObject] doubleValue] - [self _separator_Height]);
+    
+    return CGSizeEqualToSize(content.size, size);
+}
+
+#pragma mark - Cell Contents
+
++ (NSCache*)_row_Heights
+{
+    static NSCache *cache = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 500;
+    });
+    
+    return cache;
+}
+
+/**
+ * \brief	The height of the attraction row, with the introduction measured once per width. Thread safe.
+ */
++ (CGFloat)_row_Height_For_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width
+{
+    NSCache *cache = [self _row_Heights];
+    NSArray *cached = [cache objectForKey:attraction];
+    
+    if (nil != cached && [[cached firstObject] doubleValue] == width)
+        return [[cached lastObject] doubleValue];
+    
+    CGRect rect = [attraction.introduction boundingRectWithSize:CGSizeMake(width - 90 - 35, CGFLOAT_MAX) options:NSStringDrawingUsesLineFragmentOrigin attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:12]} context:nil];
+    CGFloat height = 80 + ceil(rect.size.height) + 10;
+    
+    [cache setObject:@[@(width), @(height)] forKey:attraction];
+    
+    return height;
+}
+
+/**
+ * \brief	The width of the content view of the attraction cell, without the disclosure indicator.
+ */
+- (CGFloat)_content_Width
+{
+    UITableViewCell *cell = [self.tableView.visibleCells firstObject];
+    
+    return (nil != cell) ? cell.contentView.bounds.size.width : self.tableView.frame.size.width - 33;
+}
+
+/**
+ * \brief	The height of the separator, the content view is the row without it.
+ */
+- (CGFloat)_separator_Height
+{
+    return (UITableViewCellSeparatorStyleNone == self.tableView.separatorStyle) ? 0 : 1.0 / [UIScreen mainScreen].scale;
+}
+
++ (NSCache*)_cell_Contents
+{
+    static NSCache *cache = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 100;
+    });
+    
+    return cache;
+}
+
+/**
+ * \brief	The content of the attraction cell, the subviews of the prototype cell drawn at the same frames
+ *          and with the fonts of willDisplayCell. Kept per attraction, so the text layouts are measured once
+ *          per size. Thread safe.
+ */
++ (ECCellContent*)_content_For_Attraction: (ECParkAttraction*) attraction size: (CGSize) size
+{
+    NSCache *cache = [self _cell_Contents];
+    ECCellContent *content = [cache objectForKey:attraction];
+    
+    if (nil != content && CGSizeEqualToSize(content.size, size))
+        return content;
+    
+    content = [[ECCellContent alloc] init_With_Size:size];
+    
+    [content add_Image_URL:attraction.image placeholder:[[ECImagePreviews sharedPreviews] placeholder_For_URL:attraction.image default_Image:[UIImage imageNamed:@"icon_default"]] frame:CGRectMake(15, 10, 60, 60)];
+    [content add_Text:attraction.name font:[UIFont systemFontOfSize:17] color:[UIColor blackColor] frame:CGRectMake(90, 20, size.width - 110, 21) lines:1];
+    [content add_Text:attraction.parkName font:[UIFont systemFontOfSize:14] color:[UIColor grayColor] frame:CGRectMake(90, 40, size.width - 110, 20) lines:1];
+    [content add_Text:attraction.introduction font:[UIFont systemFontOfSize:12] color:[UIColor grayColor] frame:CGRectMake(90, 70, size.width - 92, size.height - 81) lines:0];
+    
+    [cache setObject:content forKey:attraction];
+    
+    return content;
+}
+
 #pragma mark - Delegate of the UITableView
 
+- (CGFloat)tableView:(UITableView *)tableView estimatedHeightForRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // Only the displayed rows are measured, so their introductions are materialized lazily
+    return 80 + 60 + 10;
+}
+
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath
 {
     SectionEntry *entry = [self.aryItems objectAtIndex:indexPath.section];
-    NSDictionary *dic = [entry.items objectAtIndex:indexPath.row];
+    ECParkAttraction *attraction = [entry.items objectAtIndex:indexPath.row];
     
-    CGFloat width = tableView.frame.size.width - 90 - 35;
+    return [MainViewController _row_Height_For_Attraction:attraction width:tableView.frame.size.width];
+}
+
+- (BOOL)tableView:(UITableView *)tableView shouldHighlightRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // Touch-down, the strongest signal before the selection
+    ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
     
-    UILabel *label = [[UILabel alloc] initWithFrame:CGRectMake(0, 0, width, 21)];
-    label.numberOfLines = 0;
-    label.text = [dic objectForKey:@"Introduction"];
-    label.font = [UIFont systemFontOfSize:12];
+    if (nil != attraction)
+    {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(_withdraw_Prediction:) object:[attraction attraction_Key]];
+        [self _predict_Attraction:attraction signal:ECPrefetchSignalHighlight];
+    }
     
-    [label sizeToFit];
+    return YES;
+}
+
+- (void)tableView:(UITableView *)tableView didUnhighlightRowAtIndexPath:(NSIndexPath *)indexPath
+{
+    // Withdrawn unless the selection follows, e.g. the touch turns into a scroll
+    ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
     
-    return 80 + label.frame.size.height + 10;
+    if (nil != attraction)
+        [self performSelector:@selector(_withdraw_Prediction:) withObject:[attraction attraction_Key] afterDelay:WITHDRAW_DELAY];
 }
 
 - (void)tableView:(UITableView *)tableView didSelectRowAtIndexPath:(NSIndexPath *)indexPath
 {
     [super tableView:tableView didSelectRowAtIndexPath:indexPath];
     
+    ECParkAttraction *attraction = [self _attraction_At_IndexPath:indexPath];
+    
+    if (nil != attraction)
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(_withdraw_Prediction:) object:[attraction attraction_Key]];
+    
     [self performSegueWithIdentifier:@"ToParkInfoView" sender:nil];
 }
 
@@ -6,9 +6,17 @@
 
 #import "ECBaseTableViewController.h"
 
+@class ECParkAttraction;
+
 @interface ParkInfoViewController : ECBaseTableViewController
 
-@property (nonatomic, strong) NSArray *aryAttractions;
+@property (nonatomic, strong) NSArray *aryAttractions;     // Array of ECParkAttraction
 @property (nonatomic, assign) NSUInteger indexAttraction;
 
+/**
+ * \brief	Measure the rows of the attraction ahead of the display, e.g. for a prefetch. Thread safe.
+ * \param   width       The width of the table view.
+ */
++ (void)prefetch_Rows_For_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width;
+
 @end
@@ -5,6 +5,10 @@
  */
 
 #import "ParkInfoViewController.h"
+#import "ECParkAttraction.h"
+#import "ECRelatedAttractions.h"
+#import "ECImagePreviews.h"
+#import "ECImageCompactor.h"
 
 
 // ECTableViewCell
@@ -42,17 +46,173 @@
 @end
 
 
+// ECDetailRow
+
+typedef NS_ENUM(NSInteger, ECDetailRowKind)
+{
+    ECDetailRowImage = 0,
+    ECDetailRowParkName,
+    ECDetailRowName,
+    ECDetailRowOpenTime,
+    ECDetailRowIntroduction,
+    ECDetailRowRelated
+};
+
+/**
+ *  A row of the detail, with the height measured for the width of the model.
+ */
+@interface ECDetailRow : NSObject
+
+@property (nonatomic, assign, readonly) ECDetailRowKind kind;
+@property (nonatomic, copy, readonly) NSString *title;
+@property (nonatomic, copy, readonly) NSString *value;      // The image URL of the image row
+@property (nonatomic, assign, readonly) CGFloat height;
+
+- (instancetype)init_With_Kind: (ECDetailRowKind) kind title: (NSString*) title value: (NSString*) value height: (CGFloat) height;
+
+/**
+ * \brief	Whether the cell of the row shows the same content as the other row of the same kind.
+ */
+- (BOOL)is_Same_Content: (ECDetailRow*) row;
+
+@end
+
+@implementation ECDetailRow
+
+- (instancetype)init_With_Kind: (ECDetailRowKind) kind title: (NSString*) title value: (NSString*) value height: (CGFloat) height
+{
+    if (self = [super init])
+    {
+        _kind = kind;
+        _title = [title copy];
+        _value = [value copy];
+        _height = height;
+    }
+    
+    return self;
+}
+
+- (BOOL)is_Same_Content: (ECDetailRow*) row
+{
+    return (_kind == row.kind && _height == row.height &&
+            (_title == row.title || [_title isEqualToString:row.title]) &&
+            (_value == row.value || [_value isEqualToString:row.value]));
+}
+
+@end
+
+
+// ECDetailViewModel
+
+/**
+ *  The rows of an attraction for a width, built once and cached. The related row is added by the view
+ *  controller, since the related attractions are published later and may fall back to its own list.
+ */
+@interface ECDetailViewModel : NSObject
+
+@property (nonatomic, assign, readonly) CGFloat width;
+@property (nonatomic, strong, readonly) NSArray *rows;     // Array of ECDetailRow
+
+/**
+ * \brief	Get the cached model of the attraction, or build it. Thread safe.
+ */
++ (ECDetailViewModel*)model_For_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width;
+
+@end
+
+@implementation ECDetailViewModel
+
++ (NSCache*)_models
+{
+    static NSCache *cache = nil;
+    static dispatch_once_t onceToken;
+    
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 32;
+    });
+    
+    return cache;
+}
+
++ (ECDetailViewModel*)model_For_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width
+{
+    NSCache *cache = [self _models];
+    ECDetailViewModel *model = [cache objectForKey:attraction];
+    
+    if (nil != model && model.width == width)
+        return model;
+    
+    model = [[ECDetailViewModel alloc] init_With_Attraction:attraction width:width];
+    [cache setObject:model forKey:attraction];
+    
+    return model;
+}
+
+- (instancetype)init_With_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width
+{
+    if (self = [super init])
+    {
+        NSMutableArray *rows = [[NSMutableArray alloc] init];
+        NSString *imageURL = attraction.image;
+        
+        if (0 < imageURL.length)
+        {
+            [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowImage title:nil value:imageURL height:width * 0.75]];
+        }
+        
+        [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowParkName title:@"公園名稱" value:attraction.parkName height:44]];
+        [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowName title:@"景點名稱" value:attraction.name height:44]];
+        [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowOpenTime title:@"開放時間" value:attraction.openTime height:44]];
+        
+        // The introduction is decompressed once here, and measured with the font of the cell
+        NSString *introduction = attraction.introduction;
+        CGRect rect = [introduction boundingRectWithSize:CGSizeMake(width - 30, CGFLOAT_MAX) options:NSStringDrawingUsesLineFragmentOrigin attributes:@{NSFontAttributeName: [UIFont systemFontOfSize:15]} context:nil];
+        
+        [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowIntroduction title:introduction value:nil height:MAX(44, ceil(rect.size.height) + 30)]];
+        
+        _width = width;
+        _rows = rows;
+    }
+    
+    return self;
+}
+
+@end
+
+
 // ParkInfoViewController
 
-@interface ParkInfoViewController ()
+@interface ParkInfoViewController () <UICollectionViewDataSourcePrefetching>
 
 @end
 
 @implementation ParkInfoViewController
+{
+    NSArray *_aryRelated;       // The related attractions of the current one
+    CGFloat _rowsWidth;         // The width of the rows in _aryItems
+    ECImagePrefetcher *_relatedPrefetcher;  // The thumbnails of the related attractions
+}
 
 - (void)viewDidLoad {
     [super viewDidLoad];
     // Do any additional setup after loading the view.
+    
+    _relatedPrefetcher = [[ECImagePrefetcher alloc] init];
+    
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_related_Attractions_Did_Update:) name:ECRelatedAttractionsDidUpdateNotification object:nil];
+}
+
+- (void)viewDidLayoutSubviews
+{
+    [super viewDidLayoutSubviews];
+    
+    // The heights are measured for the width, e.g. rotated
+    if (nil != _aryItems && _rowsWidth != self.tableView.frame.size.width)
+    {
+        [self perform_Update_Items];
+        [self.tableView reloadData];
+    }
 }
 
 - (void)didReceiveMemoryWarning {
@@ -76,33 +236,137 @@
 
 - (void)perform_Update_Items
 {
-    NSDictionary *dic = [self.aryAttractions objectAtIndex:self.indexAttraction];
+    _aryItems = [self _rows_For_Current_Attraction];
+}
+
+- (void)update_Items_On_Main_Thread
+{
+    [super update_Items_On_Main_Thread];
     
-    _aryItems = [[NSMutableArray alloc] init];
+    [self.tableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] atScrollPosition:UITableViewScrollPositionTop animated:YES];
+}
+
+#pragma mark - Rows
+
++ (void)prefetch_Rows_For_Attraction: (ECParkAttraction*) attraction width: (CGFloat) width
+{
+    [ECDetailViewModel model_For_Attraction:attraction width:width];
+}
+
+/**
+ * \brief	The rows of the cached model and the related row, also updates _aryRelated.
+ */
+- (NSMutableArray*)_rows_For_Current_Attraction
+{
+    ECParkAttraction *attraction = [self.aryAttractions objectAtIndex:self.indexAttraction];
+    CGFloat width = self.tableView.frame.size.width;
+    NSMutableArray *rows = [[ECDetailViewModel model_For_Attraction:attraction width:width].rows mutableCopy];
+    
+    _aryRelated = [self _related_Attractions_For:attraction];
+    _rowsWidth = width;
+    
+    if (0 < _aryRelated.count)
+    {
+        [rows addObject:[[ECDetailRow alloc] init_With_Kind:ECDetailRowRelated title:@"相關景點" value:nil height:170]];
+    }
+    
+    return rows;
+}
+
+/**
+ * \brief	Apply the new rows to the table view. The rows are unique by kind and in the order of the kinds,
+ *          so they are matched by kind, and only the added, removed and changed rows are updated.
+ *          The related row is kept and only its collection view is reloaded if the list is changed.
+ */
+- (void)_apply_Rows: (NSMutableArray*) rows relatedChanged: (BOOL) relatedChanged
+{
+    NSArray *oldRows = _aryItems;
+    NSMutableArray *deleted = [[NSMutableArray alloc] init];
+    NSMutableArray *inserted = [[NSMutableArray alloc] init];
+    NSMutableArray *reloaded = [[NSMutableArray alloc] init];
+    NSUInteger i = 0, j = 0;
+    
+    while (i < oldRows.count || j < rows.count)
+    {
+        ECDetailRow *oldRow = (i < oldRows.count) ? [oldRows objectAtIndex:i] : nil;
+        ECDetailRow *row = (j < rows.count) ? [rows objectAtIndex:j] : nil;
+        
+        if (nil != oldRow && (nil == row || oldRow.kind < row.kind))
+        {
+            [deleted addObject:[NSIndexPath indexPathForRow:i++ inSection:0]];
+        }
+        else if (nil == oldRow || row.kind < oldRow.kind)
+        {
+            [inserted addObject:[NSIndexPath indexPathForRow:j++ inSection:0]];
+        }
+        else
+        {
+            if (ECDetailRowRelated != row.kind && ![oldRow is_Same_Content:row])
+                [reloaded addObject:[NSIndexPath indexPathForRow:i inSection:0]];
+            
+            i++;
+            j++;
+        }
+    }
+    
+    // The visible related cell, before the rows are moved
+    ECTableViewCell *relatedCell = nil;
     
-    NSString *imageURL = [dic objectForKey:@"Image" default:@""];
+    if (relatedChanged && ECDetailRowRelated == [(ECDetailRow*)[oldRows lastObject] kind] && ECDetailRowRelated == [(ECDetailRow*)[rows lastObject] kind])
+        relatedCell = (ECTableViewCell*)[self.tableView cellForRowAtIndexPath:[NSIndexPath indexPathForRow:oldRows.count - 1 inSection:0]];
     
-    if (0 < imageURL.length)
+    _aryItems = rows;
+    
+    if (0 < deleted.count + inserted.count + reloaded.count)
     {
-        [_aryItems addObject:@{@"type": @(kECCellStyleCustom), @"identifier": @"CellImage", @"image": imageURL}];
+        [self.tableView beginUpdates];
+        [self.tableView deleteRowsAtIndexPaths:deleted withRowAnimation:UITableViewRowAnimationFade];
+        [self.tableView insertRowsAtIndexPaths:inserted withRowAnimation:UITableViewRowAnimationFade];
+        [self.tableView reloadRowsAtIndexPaths:reloaded withRowAnimation:UITableViewRowAnimationNone];
+        [self.tableView endUpdates];
     }
     
-    [_aryItems addObject:@{@"type": @(kECCellStyleInfo), @"title": @"公園名稱", @"value": [dic objectForKey:@"ParkName"]}];
-    [_aryItems addObject:@{@"type": @(kECCellStyleInfo), @"title": @"景點名稱", @"value": [dic objectForKey:@"Name"]}];
-    [_aryItems addObject:@{@"type": @(kECCellStyleInfo), @"title": @"開放時間", @"value": [dic objectForKey:@"OpenTime"]}];
-    [_aryItems addObject:@{@"type": @(kECCellStyleDefault), @"title": [dic objectForKey:@"Introduction"]}];
+    // The prefetches are keyed by the index paths of the old list
+    if (relatedChanged)
+        [_relatedPrefetcher cancel_All];
     
-    if (1 < self.aryAttractions.count)
+    if (nil != relatedCell)
     {
-        [_aryItems addObject:@{@"type": @(kECCellStyleCustom), @"identifier": @"CellOtherAttr", @"title": @"相關景點"}];
+        [relatedCell.collectionView reloadData];
+        [relatedCell.collectionView setContentOffset:CGPointZero animated:NO];
     }
 }
 
-- (void)update_Items_On_Main_Thread
+#pragma mark - Related Attractions
+
+/**
+ * \brief	The precomputed related attractions across the parks, or the other attractions of the same
+ *          park before the index is ready.
+ */
+- (NSArray*)_related_Attractions_For: (ECParkAttraction*) attraction
 {
-    [super update_Items_On_Main_Thread];
+    NSArray *related = [[ECRelatedAttractions sharedInstance] related_Attractions_For:attraction];
     
-    [self.tableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] atScrollPosition:UITableViewScrollPositionTop animated:YES];
+    if (nil != related)
+        return related;
+    
+    NSMutableArray *others = [self.aryAttractions mutableCopy];
+    
+    [others removeObjectIdenticalTo:attraction];
+    
+    return others;
+}
+
+- (void)_related_Attractions_Did_Update: (NSNotification*) notification
+{
+    if (nil == _aryItems)
+        return;
+    
+    // Only the rows are updated, the scroll position is kept
+    NSArray *oldRelated = _aryRelated;
+    NSMutableArray *rows = [self _rows_For_Current_Attraction];
+    
+    [self _apply_Rows:rows relatedChanged:![oldRelated isEqualToArray:_aryRelated]];
 }
 
 #pragma mark - DataSource of the UITableView
@@ -124,34 +388,41 @@
 
 - (UITableViewCell*)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    NSDictionary *dic = [self.aryItems objectAtIndex:indexPath.row];
-    NSInteger cellType = [[dic objectForKey:@"type"] integerValue];
+    ECDetailRow *row = [self.aryItems objectAtIndex:indexPath.row];
     ECTableViewCell *cell = nil;
     
-    if (kECCellStyleCustom == cellType)
+    switch (row.kind)
     {
-        cell = [tableView dequeueReusableCellWithIdentifier:[dic objectForKey:@"identifier"]];
-        
-        if ([[dic objectForKey:@"identifier"] isEqualToString:@"CellImage"])
-        {
-            [cell.imgViewIcon setImageWithURL:[NSURL URLWithString:[dic objectForKey:@"image" default:@""]] placeholderImage:[UIImage imageNamed:@"icon_default"]];
-        }
-        else
-        {
-            cell.labelTitle.text = [dic objectForKey:@"title"];
+        case ECDetailRowImage:
+            cell = [tableView dequeueReusableCellWithIdentifier:@"CellImage"];
+            // The original image, the cached copy may be compacted for the thumbnails
+            [cell.imgViewIcon setImageWithURLRequest:[[ECImageCompactor sharedCompactor] original_Request_URL:row.value] placeholderImage:[[ECImagePreviews sharedPreviews] placeholder_For_URL:row.value default_Image:[UIImage imageNamed:@"icon_default"]] success:nil failure:nil];
+            break;
+            
+        case ECDetailRowRelated:
+            cell = [tableView dequeueReusableCellWithIdentifier:@"CellOtherAttr"];
+            cell.labelTitle.text = row.title;
+            
+            if ([cell.collectionView respondsToSelector:@selector(setPrefetchDataSource:)])
+                cell.collectionView.prefetchDataSource = self;
+            
             [cell.collectionView reloadData];
-        }
-    }
-    else
-    {
-        cell = [ECTableViewCell tableView:tableView cellWithStyle:cellType];
-        
-        // Set the data for the cell
-        cell.labelTitle.text = [dic objectForKey:@"title"];
-        cell.labelTitle.numberOfLines = 0;
-        
-        if (cell.hasInfo)
-            cell.labelDetail1.text = [dic objectForKey:@"value"];
+            break;
+            
+        case ECDetailRowIntroduction:
+            cell = [ECTableViewCell tableView:tableView cellWithStyle:kECCellStyleDefault];
+            cell.labelTitle.text = row.title;
+            cell.labelTitle.numberOfLines = 0;
+            break;
+            
+        case ECDetailRowParkName:
+        case ECDetailRowName:
+        case ECDetailRowOpenTime:
+            cell = [ECTableViewCell tableView:tableView cellWithStyle:kECCellStyleInfo];
+            cell.labelTitle.text = row.title;
+            cell.labelTitle.numberOfLines = 0;
+            cell.labelDetail1.text = row.value;
+            break;
     }
 
     return cell;
@@ -161,31 +432,7 @@
 
 - (CGFloat)tableView:(UITableView *)tableView heightForRowAtIndexPath:(NSIndexPath *)indexPath
 {
-    NSDictionary *dic = [self.aryItems objectAtIndex:indexPath.row];
-    NSInteger cellType = [[dic objectForKey:@"type"] integerValue];
-    
-    if (kECCellStyleCustom == cellType)
-    {
-        if ([[dic objectForKey:@"identifier"] isEqualToString:@"CellImage"])    // Image
-            return tableView.frame.size.width * 0.75;
-        else    // Other Atrractions
-            return 170;
-    }
-    else if (kECCellStyleDefault == cellType) // Introduction
-    {
-        CGFloat width = tableView.frame.size.width - 30;
-        
-        UILabel *label = [[UILabel alloc] initWithFrame:CGRectMake(0, 0, width, 21)];
-        label.numberOfLines = 0;
-        label.text = [dic objectForKey:@"title"];
-        label.font = [UIFont systemFontOfSize:15];
-        
-        [label sizeToFit];
-        
-        return MAX(44, label.frame.size.height + 30);
-    }
-    
-    return 44;
+    return [(ECDetailRow*)[self.aryItems objectAtIndex:indexPath.row] height];
 }
 
 - (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
@@ -203,7 +450,7 @@
 
 - (NSInteger)collectionView:(UICollectionView *)view numberOfItemsInSection:(NSInteger)section
 {
-    return self.aryAttractions.count - 1;
+    return _aryRelated.count;
 }
 
 - (NSInteger)numberOfSectionsInCollectionView: (UICollectionView *)collectionView
@@ -215,27 +462,72 @@
 {
     ECCollectionViewCell *cell = [collectionView dequeueReusableCellWithReuseIdentifier:@"CellAttr" forIndexPath:indexPath];
     
-    // Get the other attraction items except the current attraction.
-    NSUInteger index = (self.indexAttraction <= indexPath.item) ? indexPath.item + 1 : indexPath.item;
-    NSDictionary *dic = [self.aryAttractions objectAtIndex:index];
+    ECParkAttraction *attraction = [_aryRelated objectAtIndex:indexPath.item];
     
-    [cell.imgPhoto setImageWithURL:[NSURL URLWithString:[dic objectForKey:@"Image" default:@""]] placeholderImage:[UIImage imageNamed:@"icon_default"]];
+    [cell.imgPhoto setImageWithURL:[NSURL URLWithString:attraction.image] placeholderImage:[[ECImagePreviews sharedPreviews] placeholder_For_URL:attraction.image default_Image:[UIImage imageNamed:@"icon_default"]]];
     
     cell.imgPhoto.clipsToBounds = YES;
-    cell.labelTitle.text = [dic objectForKey:@"Name"];
+    cell.labelTitle.text = attraction.name;
     cell.labelTitle.font = [UIFont systemFontOfSize:14];
     
     return cell;
 }
 
+#pragma mark - UICollectionView Prefetching
+
+- (void)collectionView:(UICollectionView *)collectionView prefetchItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        if (indexPath.item >= _aryRelated.count)
+            continue;
+        
+        NSString *imageURL = [(ECParkAttraction*)[_aryRelated objectAtIndex:indexPath.item] image];
+        
+        // The photo is scaled to fill, so the original is kept
+        if (0 < imageURL.length)
+            [_relatedPrefetcher prefetch_Key:indexPath imageURLs:@[imageURL] size:CGSizeZero layout:nil];
+    }
+}
+
+- (void)collectionView:(UICollectionView *)collectionView cancelPrefetchingForItemsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths)
+        [_relatedPrefetcher cancel_Key:indexPath];
+}
+
 #pragma mark - UICollectionViewDelegate
 
+- (void)collectionView:(UICollectionView *)collectionView willDisplayCell:(UICollectionViewCell *)cell forItemAtIndexPath:(NSIndexPath *)indexPath
+{
+    if (indexPath.item >= _aryRelated.count)
+        return;
+    
+    NSString *imageURL = [(ECParkAttraction*)[_aryRelated objectAtIndex:indexPath.item] image];
+    
+    [_relatedPrefetcher did_Display_Key:indexPath ready:(nil != [ECImagePrefetcher cached_Image_URL:imageURL size:CGSizeZero])];
+}
+
 - (void)collectionView:(UICollectionView *)collectionView didSelectItemAtIndexPath:(NSIndexPath *)indexPath
 {
-    NSUInteger index = (self.indexAttraction <= indexPath.item) ? indexPath.item + 1 : indexPath.item;
+    ECParkAttraction *attraction = [_aryRelated objectAtIndex:indexPath.item];
+    NSUInteger index = [self.aryAttractions indexOfObjectIdenticalTo:attraction];
+    
+    // An attraction of another park
+    if (NSNotFound == index)
+    {
+        self.aryAttractions = @[attraction];
+        index = 0;
+    }
+    
     self.indexAttraction = index;
     
-    [self onRefresh];
+    // The cached model of the attraction, only the changed rows are updated
+    NSArray *oldRelated = _aryRelated;
+    NSMutableArray *rows = [self _rows_For_Current_Attraction];
+    
+    [self _apply_Rows:rows relatedChanged:![oldRelated isEqualToArray:_aryRelated]];
+    [self.tableView scrollToRowAtIndexPath:[NSIndexPath indexPathForRow:0 inSection:0] atScrollPosition:UITableViewScrollPositionTop animated:YES];
 }
 
 #pragma mark – UICollectionViewDelegateFlowLayout
@@ -6,15 +6,19 @@
 
 #import "ECBaseViewController.h"
 #import "ECTableViewUtilities.h"
+#import "ECImagePrefetcher.h"
 
 /**
  *  The custom table view controller.
  */
-@interface ECBaseTableViewController : ECBaseViewController <UITableViewDataSource, UITableViewDelegate>
+@interface ECBaseTableViewController : ECBaseViewController <UITableViewDataSource, UITableViewDelegate, UITableViewDataSourcePrefetching>
 
 /// The customized table view
 @property(nonatomic, strong, readwrite) IBOutlet UITableView *tableView;
 
+/// The prefetches of the upcoming rows, used if should_Prefetch_Rows is YES.
+@property (nonatomic, strong, readonly) ECImagePrefetcher *rowPrefetcher;
+
 /// The selected indexPath.
 @property (nonatomic, strong) NSIndexPath* indexPathSel;
 
@@ -26,5 +30,32 @@
  */
 - (void)remove_TableView_Cell: (NSIndexPath*) indexPath withItems: (BOOL) removeItem;
 
+#pragma mark - Prefetch, override by the subclass
+
+/**
+ *  Whether the upcoming rows are prefetched by the table view, iOS 10 or later. Default is NO.
+ */
+- (BOOL)should_Prefetch_Rows;
+
+/**
+ *  The images of the row to download before it is displayed. Default is nil.
+ */
+- (NSArray<NSString*>*)prefetch_Image_URLs_At_IndexPath: (NSIndexPath*) indexPath;
+
+/**
+ *  The size of the images in the cell, the images are decoded again at the size. Default is CGSizeZero, the original size.
+ */
+- (CGSize)prefetch_Image_Size_At_IndexPath: (NSIndexPath*) indexPath;
+
+/**
+ *  The work to measure the row, run on a low priority queue. Capture the item, not the index path. Default is nil.
+ */
+- (dispatch_block_t)prefetch_Layout_At_IndexPath: (NSIndexPath*) indexPath;
+
+/**
+ *  Whether the layout of the row was ready when its cell is displayed. Default is YES.
+ */
+- (BOOL)is_Layout_Ready_At_IndexPath: (NSIndexPath*) indexPath;
+
 @end
 
@@ -20,6 +20,12 @@
 - (void)viewDidLoad {
     [super viewDidLoad];
     
+    if ([self should_Prefetch_Rows] && [self.tableView respondsToSelector:@selector(setPrefetchDataSource:)])
+    {
+        _rowPrefetcher = [[ECImagePrefetcher alloc] init];
+        self.tableView.prefetchDataSource = self;
+    }
+    
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(_keyboardDidHide:) name:UIKeyboardDidHideNotification object:nil];
 }
 
@@ -72,6 +78,8 @@
     
     if (self.tableView)
     {
+        // The index paths of the prefetches are changed
+        [self.rowPrefetcher cancel_All];
         [self.tableView reloadData];
     }
 }
@@ -122,10 +130,77 @@
     return self.aryItems.count;
 }
 
+#pragma mark - Prefetch
+
+- (BOOL)should_Prefetch_Rows
+{
+    return NO;
+}
+
+- (NSArray<NSString*>*)prefetch_Image_URLs_At_IndexPath: (NSIndexPath*) indexPath
+{
+    return nil;
+}
+
+- (CGSize)prefetch_Image_Size_At_IndexPath: (NSIndexPath*) indexPath
+{
+    return CGSizeZero;
+}
+
+- (dispatch_block_t)prefetch_Layout_At_IndexPath: (NSIndexPath*) indexPath
+{
+    return nil;
+}
+
+- (BOOL)is_Layout_Ready_At_IndexPath: (NSIndexPath*) indexPath
+{
+    return YES;
+}
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        [self.rowPrefetcher prefetch_Key:indexPath imageURLs:[self prefetch_Image_URLs_At_IndexPath:indexPath] size:[self prefetch_Image_Size_At_IndexPath:indexPath] layout:[self prefetch_Layout_At_IndexPath:indexPath]];
+    }
+}
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths
+{
+    for (NSIndexPath *indexPath in indexPaths)
+    {
+        [self.rowPrefetcher cancel_Key:indexPath];
+    }
+}
+
+/**
+ *  Record whether the images and the layout of the displayed row were all ready.
+ */
+- (void)_record_Prefetch_At_IndexPath: (NSIndexPath*) indexPath
+{
+    BOOL ready = [self is_Layout_Ready_At_IndexPath:indexPath];
+    CGSize size = [self prefetch_Image_Size_At_IndexPath:indexPath];
+    
+    for (NSString *imageURL in [self prefetch_Image_URLs_At_IndexPath:indexPath])
+    {
+        if (!ready)
+            break;
+        
+        ready = (nil != [ECImagePrefetcher cached_Image_URL:imageURL size:size]);
+    }
+    
+    [self.rowPrefetcher did_Display_Key:indexPath ready:ready];
+}
+
 #pragma mark - Delegate of the UITableView
 
 - (void)tableView:(UITableView *)tableView willDisplayCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath
 {
+    if (nil != self.rowPrefetcher)
+    {
+        [self _record_Prefetch_At_IndexPath:indexPath];
+    }
+    
     // Remove seperator inset
     if ([cell respondsToSelector:@selector(setSeparatorInset:)])
     {
@@ -0,0 +1,56 @@
+/**
+ * \file 	ECCellContent.h
+ * \brief	The contents of a cell drawn into one bitmap, for the asynchronous display of ECTableViewCell.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import <UIKit/UIKit.h>
+
+/**
+ *  The texts and the image of a cell for one size. The text layouts are measured when the texts are added,
+ *  so the rendering only draws. All methods are thread safe on different instances, the content is built and
+ *  rendered on a background queue.
+ */
+@interface ECCellContent : NSObject
+
+@property (nonatomic, assign, readonly) CGSize size;
+
+/// The background, drawn opaque if its alpha is 1. Default is nil, a transparent bitmap which keeps the selection of the cell visible.
+@property (nonatomic, strong) UIColor *backgroundColor;
+
+/// The URL of the image added by add_Image_URL:, nil if none.
+@property (nonatomic, copy, readonly) NSString *imageURL;
+
+/// The size of the image frame, e.g. to look up the image decoded at the size.
+@property (nonatomic, assign, readonly) CGSize imageSize;
+
+- (instancetype)init_With_Size: (CGSize) size;
+
+/**
+ * \brief	Add the text drawn in the frame, centered vertically like a UILabel.
+ * \param   lines       The maximum lines, 0 for no limit. The last visible line is truncated.
+ */
+- (void)add_Text: (NSString*) text font: (UIFont*) font color: (UIColor*) color frame: (CGRect) frame lines: (NSInteger) lines;
+
+/**
+ * \brief	Add the image drawn aspect fit in the frame. The placeholder is drawn until the image is loaded.
+ */
+- (void)add_Image_URL: (NSString*) imageURL placeholder: (UIImage*) placeholder frame: (CGRect) frame;
+
+/**
+ * \brief	Render the bitmap of the content.
+ * \param   image       The decoded image of imageURL, or nil to draw the placeholder.
+ */
+- (UIImage*)render_With_Image: (UIImage*) image scale: (CGFloat) scale;
+
+#ifdef DEBUG
+
+/**
+ * \brief	Build and render a list cell of sample texts and image at each width, without any view.
+ * \return	The report of the time per cell of each width.
+ */
++ (NSString*)benchmark_Widths: (NSArray*) widths iterations: (NSUInteger) iterations scale: (CGFloat) scale;
+
+#endif
+
+@end
@@ -0,0 +1,173 @@
+/**
+ * \file 	ECCellContent.m
+ * \brief	The contents of a cell drawn into one bitmap, for the asynchronous display of ECTableViewCell.
+ *  - 2026/10/19			edmundchen	File created.
+ */
+
+#import "ECCellContent.h"
+
+// ECCellText
+
+@interface ECCellText : NSObject
+
+@property (nonatomic, strong) NSAttributedString *text;
+@property (nonatomic, assign) CGRect rect;              // The measured rect in the frame
+
+@end
+
+@implementation ECCellText
+
+@end
+
+
+// ECCellContent
+
+@implementation ECCellContent
+{
+    NSMutableArray *_aryTexts;      // Array of ECCellText
+    UIImage *_placeholder;
+    CGRect _imageFrame;
+}
+
+- (instancetype)init_With_Size: (CGSize) size
+{
+    if (self = [super init])
+    {
+        _size = size;
+        _aryTexts = [[NSMutableArray alloc] init];
+    }
+    
+    return self;
+}
+
+- (void)add_Text: (NSString*) text font: (UIFont*) font color: (UIColor*) color frame: (CGRect) frame lines: (NSInteger) lines
+{
+    if (0 == text.length || CGRectIsEmpty(frame))
+        return;
+    
+    NSMutableParagraphStyle *style = [[NSMutableParagraphStyle alloc] init];
+    style.lineBreakMode = NSLineBreakByWordWrapping;
+    
+    ECCellText *cellText = [[ECCellText alloc] init];
+    cellText.text = [[NSAttributedString alloc] initWithString:text attributes:@{NSFontAttributeName: font, NSForegroundColorAttributeName: color ?: [UIColor blackColor], NSParagraphStyleAttributeName: style}];
+    
+    // Measure once, limited by the lines and the frame
+    CGFloat maxHeight = frame.size.height;
+    
+    if (0 < lines)
+        maxHeight = MIN(maxHeight, ceil(font.lineHeight * lines));
+    
+    CGRect rect = [cellText.text boundingRectWithSize:CGSizeMake(frame.size.width, CGFLOAT_MAX) options:NSStringDrawingUsesLineFragmentOrigin context:nil];
+    CGFloat height = MIN(maxHeight, ceil(rect.size.height));
+    
+    cellText.rect = CGRectMake(frame.origin.x, frame.origin.y + floor((frame.size.height - height) / 2), frame.size.width, height);
+    
+    [_aryTexts addObject:cellText];
+}
+
+- (CGSize)imageSize
+{
+    return _imageFrame.size;
+}
+
+- (void)add_Image_URL: (NSString*) imageURL placeholder: (UIImage*) placeholder frame: (CGRect) frame
+{
+    _imageURL = [imageURL copy];
+    _placeholder = placeholder;
+    _imageFrame = frame;
+}
+
+/**
+ * \brief	The rect of the image aspect fit in the frame.
+ */
+static CGRect _aspect_Fit_Rect(CGSize size, CGRect frame)
+{
+    if (0 >= size.width || 0 >= size.height)
+        return frame;
+    
+    CGFloat ratio = MIN(frame.size.width / size.width, frame.size.height / size.height);
+    CGSize fit = CGSizeMake(size.width * ratio, size.height * ratio);
+    
+    return CGRectMake(frame.origin.x + (frame.size.width - fit.width) / 2, frame.origin.y + (frame.size.height - fit.height) / 2, fit.width, fit.height);
+}
+
+- (UIImage*)render_With_Image: (UIImage*) image scale: (CGFloat) scale
+{
+    if (0 >= _size.width || 0 >= _size.height)
+        return nil;
+    
+    BOOL opaque = (nil != _backgroundColor && 1 <= CGColorGetAlpha(_backgroundColor.CGColor));
+    
+    UIGraphicsBeginImageContextWithOptions(_size, opaque, scale);
+    
+    if (nil != _backgroundColor)
+    {
+        [_backgroundColor setFill];
+        UIRectFill(CGRectMake(0, 0, _size.width, _size.height));
+    }
+    
+    UIImage *drawn = image ?: _placeholder;
+    
+    if (nil != drawn && !CGRectIsEmpty(_imageFrame))
+        [drawn drawInRect:_aspect_Fit_Rect(drawn.size, _imageFrame)];
+    
+    for (ECCellText *cellText in _aryTexts)
+    {
+        [cellText.text drawWithRect:cellText.rect options:NSStringDrawingUsesLineFragmentOrigin | NSStringDrawingTruncatesLastVisibleLine context:nil];
+    }
+    
+    UIImage *bitmap = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    return bitmap;
+}
+
+#pragma mark - Benchmark
+
+#ifdef DEBUG
+
++ (NSString*)benchmark_Widths: (NSArray*) widths iterations: (NSUInteger) iterations scale: (CGFloat) scale
+{
+    NSString *introduction = @"園區內種植多種台灣原生植物，設有步道、涼亭與生態池，四季皆有不同花卉可供觀賞，適合親子散步與自然觀察。假日常有導覽活動，介紹園內的植物與昆蟲生態。";
+    NSMutableString *report = [[NSMutableString alloc] init];
+    
+    // A decoded sample image, like the inflated images of the downloader
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(120, 90), YES, 1);
+    [[UIColor colorWithRed:0.3 green:0.6 blue:0.4 alpha:1] setFill];
+    UIRectFill(CGRectMake(0, 0, 120, 90));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    
+    for (NSNumber *width in widths)
+    {
+        CFAbsoluteTime buildTime = 0, renderTime = 0;
+        
+        for (NSUInteger i = 0; i < iterations; i++)
+        {
+            // The layout of the park list cell, see MainViewController
+            CGFloat contentWidth = width.doubleValue - 33;
+            CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+            ECCellContent *content = [[ECCellContent alloc] init_With_Size:CGSizeMake(contentWidth, 150)];
+            
+            [content add_Image_URL:@"http://localhost/sample.jpg" placeholder:nil frame:CGRectMake(15, 10, 60, 60)];
+            [content add_Text:@"臺北市立動物園" font:[UIFont systemFontOfSize:17] color:nil frame:CGRectMake(90, 20, contentWidth - 110, 21) lines:1];
+            [content add_Text:@"木柵動物園" font:[UIFont systemFontOfSize:14] color:[UIColor grayColor] frame:CGRectMake(90, 40, contentWidth - 110, 20) lines:1];
+            [content add_Text:introduction font:[UIFont systemFontOfSize:12] color:[UIColor grayColor] frame:CGRectMake(90, 70, contentWidth - 92, 69) lines:0];
+            
+            buildTime += CFAbsoluteTimeGetCurrent() - start;
+            start = CFAbsoluteTimeGetCurrent();
+            
+            [content render_With_Image:image scale:scale];
+            
+            renderTime += CFAbsoluteTimeGetCurrent() - start;
+        }
+        
+        [report appendFormat:@"width %.0f: layout %.3f ms, render %.3f ms per cell\n", width.doubleValue, buildTime * 1000 / MAX(1, iterations), renderTime * 1000 / MAX(1, iterations)];
+    }
+    
+    return report;
+}
+
+#endif
+
+@end
@@ -34,6 +34,7 @@
 #pragma mark - ECTableViewCell
 
 @class ECTableViewCell;
+@class ECCellContent;
 
 /**
  *  Define the standard cell style
@@ -88,6 +89,18 @@ typedef NS_ENUM(NSInteger, ECTableViewCellStyle)
     kECCellStyleDatePicker,
 };
 
+/**
+ *  Define how the cells of the ECTableViewCellStyle layout their subviews
+ */
+typedef NS_ENUM(NSInteger, ECTableViewCellLayoutMode)
+{
+    /// The subviews are laid out by the Masonry constraints.
+    kECCellLayoutAutoLayout,
+    
+    /// The subviews are laid out by the frames in layoutSubviews, solved once per style and size. No constraint is installed.
+    kECCellLayoutManual,
+};
+
 @protocol ECTableViewCellDelegate <NSObject>
 
 @optional
@@ -149,6 +162,9 @@ typedef NS_ENUM(NSInteger, ECTableViewCellStyle)
 /// The delegate of the ECTableViewCell
 @property (nonatomic, weak) id<ECTableViewCellDelegate> delegate;
 
+/// Show the contents of display_Async_Content: as one bitmap rendered on a background queue, the subviews of the content view are hidden. Default is NO.
+@property (nonatomic, assign) BOOL displaysAsynchronously;
+
 /**
  * \brief	Generate the custom tableview cell by specific style
  * \param   style   The cell style
@@ -158,6 +174,31 @@ typedef NS_ENUM(NSInteger, ECTableViewCellStyle)
 
 +(ECTableViewCell*) tableView: (UITableView*) tableView cellWithStyle: (enum ECTableViewCellStyle) style scale: (CGFloat) scale;
 
+/**
+ * \brief	Set the layout mode of the cells created after, the created cells keep their mode. Default is kECCellLayoutAutoLayout.
+ */
++ (void)Set_Layout_Mode: (ECTableViewCellLayoutMode) mode;
+
++ (ECTableViewCellLayoutMode)layout_Mode;
+
+#ifdef DEBUG
+
+/**
+ * \brief	Create and lay out the cells of each style in both layout modes, with the counters of the layout cost.
+ * \return	The report of the average time of the creation and of layoutSubviews of each mode.
+ */
++ (NSString*)benchmark_Layout_Iterations: (NSUInteger) iterations width: (CGFloat) width;
+
+#endif
+
+/**
+ * \brief	Display the content built for the size of the content view when displaysAsynchronously is YES.
+ *          The builder is called on a background queue, again if the size is changed. The image of the content is
+ *          loaded by the shared image downloader, whose images are decoded already. The renders for the earlier
+ *          content of a reused cell are dropped.
+ */
+- (void)display_Async_Content: (ECCellContent* (^)(CGSize size)) builder;
+
 /**
  *  Set the image icon to imgViewIcon property and adjust the UI layout if the cell is one of the ECTableViewCellStyle, except kECCellStyleCustom.
  */
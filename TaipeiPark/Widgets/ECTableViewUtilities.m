@@ -5,6 +5,9 @@
  */
 
 #import "ECTableViewUtilities.h"
+#import "ECCellContent.h"
+#import "ECImagePrefetcher.h"
+#import "AFImageDownloader.h"
 #import "Masonry.h"
 
 #pragma mark - SectionEntry
@@ -76,6 +79,49 @@
 
 @end
 
+/**
+ *  The frames of a cell style for a content size. The rects of the input styles are in the left view of the input.
+ */
+typedef struct ECCellLayoutSpec
+{
+    // The key
+    CGSize size;            // The size of the content view
+    CGFloat scale;
+    CGSize iconSize;
+    CGSize controlSize;     // The switch, or the left view of the input
+    
+    CGRect icon;
+    CGRect title;           // With a subtitle, the band of the title and the label is aligned to its bottom
+    CGRect subtitle;        // The band of the subtitle, the label is aligned to its top
+    CGRect detail;
+    CGRect control;         // The switch or the input
+} ECCellLayoutSpec;
+
+static ECTableViewCellLayoutMode _layoutMode = kECCellLayoutAutoLayout;
+
+// The last solved spec of each style, only used on the main thread
+static ECCellLayoutSpec _layoutSpecs[kECCellStyleDatePicker + 1];
+
+#ifdef DEBUG
+static NSUInteger _createdCount = 0;
+static CFTimeInterval _createdTime = 0;
+static NSUInteger _layoutCount = 0;
+static CFTimeInterval _layoutTime = 0;
+#endif
+
+/**
+ *  The token of an asynchronous display, cancelled when the cell displays another content.
+ */
+@interface ECRenderToken : NSObject
+
+@property (atomic, assign) BOOL cancelled;
+
+@end
+
+@implementation ECRenderToken
+
+@end
+
 @interface ECTableViewCell ()
 
 @property (nonatomic, assign) ECTableViewCellStyle style;
@@ -92,6 +138,15 @@
     
     UIImageView *_checkView;
     UIImageView *_indicatorView;
+    
+    BOOL _manualLayout;         // Laid out by the frames of the spec instead of the constraints
+    CGFloat _scale;             // The scale of the width of the title
+    CGSize _iconSize;           // The size of imgViewIcon, zero if no icon
+    
+    ECCellContent* (^_contentBuilder)(CGSize size);
+    CGSize _renderedSize;       // The size of the content view of the current render
+    ECRenderToken *_renderToken;
+    AFImageDownloadReceipt *_imageReceipt;
 }
 
 @synthesize labelTitle = _labelTitle;
@@ -126,29 +181,75 @@
     return [_dicCellStyles objectForKey:@(style)];
 }
 
+// The attributes are switches, since the manual layout reads them in every layoutSubviews
+
 - (BOOL)hasSubtitle
 {
-    return [@[@(kECCellStyleSubtitle), @(kECCellStyleSubtitleWithAction), @(kECCellStyleSubtitleWithInfoAndAction), @(kECCellStyleSubtitleWithSelection), @(kECCellStyleSubtitleWithInput), @(kECCellStyleSubtitleWithSecureInput)] containsObject:@(self.style)];
+    switch (self.style)
+    {
+        case kECCellStyleSubtitle:
+        case kECCellStyleSubtitleWithAction:
+        case kECCellStyleSubtitleWithInfoAndAction:
+        case kECCellStyleSubtitleWithSelection:
+        case kECCellStyleSubtitleWithInput:
+        case kECCellStyleSubtitleWithSecureInput:
+            return YES;
+        default:
+            return NO;
+    }
 }
 
 - (BOOL)hasInfo
 {
-    return [@[@(kECCellStyleSubtitleWithInfoAndAction), @(kECCellStyleInfo), @(kECCellStyleInfoWithAction)] containsObject:@(self.style)];
+    switch (self.style)
+    {
+        case kECCellStyleSubtitleWithInfoAndAction:
+        case kECCellStyleInfo:
+        case kECCellStyleInfoWithAction:
+            return YES;
+        default:
+            return NO;
+    }
 }
 
 - (BOOL)hasInput
 {
-    return [@[@(kECCellStyleSecureInput), @(kECCellStyleInput), @(kECCellStyleSubtitleWithInput), @(kECCellStyleSubtitleWithSecureInput)] containsObject:@(self.style)];
+    switch (self.style)
+    {
+        case kECCellStyleSecureInput:
+        case kECCellStyleInput:
+        case kECCellStyleSubtitleWithInput:
+        case kECCellStyleSubtitleWithSecureInput:
+            return YES;
+        default:
+            return NO;
+    }
 }
 
 - (BOOL)withAction
 {
-    return [@[@(kECCellStyleSubtitleWithAction), @(kECCellStyleSubtitleWithInfoAndAction), @(kECCellStyleAction), @(kECCellStyleInfoWithAction)] containsObject:@(self.style)];
+    switch (self.style)
+    {
+        case kECCellStyleSubtitleWithAction:
+        case kECCellStyleSubtitleWithInfoAndAction:
+        case kECCellStyleAction:
+        case kECCellStyleInfoWithAction:
+            return YES;
+        default:
+            return NO;
+    }
 }
 
 - (BOOL)withSelection
 {
-    return [@[@(kECCellStyleSelection), @(kECCellStyleSubtitleWithSelection)] containsObject:@(self.style)];
+    switch (self.style)
+    {
+        case kECCellStyleSelection:
+        case kECCellStyleSubtitleWithSelection:
+            return YES;
+        default:
+            return NO;
+    }
 }
 
 +(ECTableViewCell*) tableView: (UITableView*) tableView cellWithStyle: (enum ECTableViewCellStyle) style
@@ -170,6 +271,10 @@
     // Create a new cell if needed.
     if (nil == cell)
     {
+#ifdef DEBUG
+        CFTimeInterval start = CACurrentMediaTime();
+#endif
+        
         // Base value
         UIEdgeInsets padding = UIEdgeInsetsMake(10, 15, 10, 15);
         
@@ -180,7 +285,11 @@
         cell.backgroundColor = [UIColor clearColor];
         cell.selectionStyle = UITableViewCellSelectionStyleNone;
         
-        if (kECCellStyleDatePicker == cell.style)
+        if (kECCellLayoutManual == _layoutMode && kECCellStyleDatePicker != style)
+        {
+            [cell _setup_Manual_Layout:scale];
+        }
+        else if (kECCellStyleDatePicker == cell.style)
         {
             cell.datePicker = [[UIDatePicker alloc] initWithFrame:CGRectMake(0, 10, tableView.frame.size.width, 216)];
             cell.datePicker.date = [NSDate date];
@@ -352,11 +461,434 @@
                 }
             }
         }
+        
+#ifdef DEBUG
+        _createdTime += CACurrentMediaTime() - start;
+        
+        if (0 == ++_createdCount % 50)
+            [ECTableViewCell _log_Layout_Cost];
+#endif
     }
     
     return cell;
 }
 
++ (void)Set_Layout_Mode: (ECTableViewCellLayoutMode) mode
+{
+    _layoutMode = mode;
+}
+
++ (ECTableViewCellLayoutMode)layout_Mode
+{
+    return _layoutMode;
+}
+
+#ifdef DEBUG
++ (void)_log_Layout_Cost
+{
+    NSLog(@"[Cell] %@", [self _layout_Cost_Report]);
+}
+
++ (NSString*)_layout_Cost_Report
+{
+    return [NSString stringWithFormat:@"%@: %lu cells created in %.3f ms avg, %lu layouts in %.3f ms avg", (kECCellLayoutManual == _layoutMode) ? @"manual" : @"auto layout", (unsigned long)_createdCount, _createdTime * 1000 / MAX(1, _createdCount), (unsigned long)_layoutCount, _layoutTime * 1000 / MAX(1, _layoutCount)];
+}
+
++ (NSString*)benchmark_Layout_Iterations: (NSUInteger) iterations width: (CGFloat) width
+{
+    UITableView *tableView = [[UITableView alloc] initWithFrame:CGRectMake(0, 0, width, 600) style:UITableViewStylePlain];
+    ECTableViewCellLayoutMode modes[] = {kECCellLayoutAutoLayout, kECCellLayoutManual};
+    ECTableViewCellLayoutMode savedMode = _layoutMode;
+    NSUInteger savedCounts[] = {_createdCount, _layoutCount};
+    CFTimeInterval savedTimes[] = {_createdTime, _layoutTime};
+    NSMutableString *report = [[NSMutableString alloc] init];
+    
+    for (NSUInteger m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+    {
+        _layoutMode = modes[m];
+        _createdCount = _layoutCount = 0;
+        _createdTime = _layoutTime = 0;
+        
+        // The table view has no registered cell, each call creates a new one by the factory
+        for (NSUInteger i = 0; i < iterations; i++)
+        {
+            for (ECTableViewCellStyle style = kECCellStyleDefault; style < kECCellStyleDatePicker; style++)
+            {
+                ECTableViewCell *cell = [self tableView:tableView cellWithStyle:style];
+                
+                cell.labelTitle.text = @"臺北市立動物園";
+                cell.labelSubtitle.text = @"木柵動物園";
+                cell.labelDetail1.text = @"24H";
+                cell.frame = CGRectMake(0, 0, width, 60);
+                
+                [cell layoutIfNeeded];
+            }
+        }
+        
+        [report appendFormat:@"%@\n", [self _layout_Cost_Report]];
+    }
+    
+    _layoutMode = savedMode;
+    _createdCount = savedCounts[0];
+    _layoutCount = savedCounts[1];
+    _createdTime = savedTimes[0];
+    _layoutTime = savedTimes[1];
+    
+    return report;
+}
+#endif
+
+#pragma mark - Manual Layout
+
+/**
+ *  Create the same subviews as the constraints do, without the constraints.
+ */
+- (void)_setup_Manual_Layout: (CGFloat) scale
+{
+    _manualLayout = YES;
+    _scale = scale;
+    
+    if (self.hasInput)
+    {
+        // Setup the left view, its subviews are laid out with the cell
+        UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0, 0, (self.contentView.frame.size.width*scale), 0)];
+        
+        self.labelTitle = [[UILabel alloc] init];
+        [view addSubview:self.labelTitle];
+        
+        if (self.hasSubtitle)
+        {
+            self.labelSubtitle = [[UILabel alloc] init];
+            [view addSubview:self.labelSubtitle];
+        }
+        
+        // Setup the input
+        self.editInput = [[MyTextField alloc] init];
+        self.editInput.textAlignment = NSTextAlignmentRight;
+        self.editInput.leftView = view;
+        self.editInput.leftViewMode = UITextFieldViewModeAlways;
+        self.editInput.autocorrectionType = UITextAutocorrectionTypeNo;
+        
+        if (kECCellStyleSecureInput == self.style || kECCellStyleSubtitleWithSecureInput == self.style)
+            self.editInput.secureTextEntry = YES;
+        
+        [self.contentView addSubview:self.editInput];
+        return;
+    }
+    
+    self.labelTitle = [[UILabel alloc] init];
+    [self.contentView addSubview:self.labelTitle];
+    
+    if (kECCellStyleSwitch == self.style)
+    {
+        self.btnSwitch = [[UISwitch alloc] init];
+        [self.btnSwitch sizeToFit];
+        [self.contentView addSubview:self.btnSwitch];
+        return;
+    }
+    
+    if (self.hasSubtitle)
+    {
+        self.labelSubtitle = [[UILabel alloc] init];
+        [self.contentView addSubview:self.labelSubtitle];
+    }
+    
+    if (self.hasInfo)
+    {
+        self.labelDetail1 = [[UILabel alloc] init];
+        self.labelDetail1.textAlignment = NSTextAlignmentRight;
+        [self.contentView addSubview:self.labelDetail1];
+    }
+    
+    if (self.withAction || self.withSelection)
+    {
+        if (self.withAction)
+            self.accessoryType = UITableViewCellAccessoryDisclosureIndicator;
+        
+        self.selectionStyle = UITableViewCellSelectionStyleBlue;
+    }
+}
+
+/**
+ *  Solve the frames of the constraints above for the key of the spec.
+ */
+- (void)_solve_Layout_Spec: (ECCellLayoutSpec*) spec
+{
+    UIEdgeInsets padding = UIEdgeInsetsMake(10, 15, 10, 15);
+    CGFloat width = spec->size.width, height = spec->size.height, middle = height / 2;
+    CGFloat left = padding.left, right = width - padding.right;
+    
+    spec->icon = spec->title = spec->subtitle = spec->detail = spec->control = CGRectZero;
+    
+    if (self.hasInput)
+    {
+        CGFloat viewWidth = MAX(0, spec->controlSize.width - padding.right);
+        
+        spec->control = CGRectMake(padding.left, 0, width - padding.left - padding.right, height);
+        
+        // The icon is in the left view, centered in its height, except the subtitle styles which add it to the content view
+        if (self.hasSubtitle)
+            spec->icon = CGRectMake(padding.left, (height - spec->iconSize.height) / 2, spec->iconSize.width, spec->iconSize.height);
+        else
+            spec->icon = CGRectMake(0, (spec->controlSize.height - spec->iconSize.height) / 2, spec->iconSize.width, spec->iconSize.height);
+        
+        if (self.hasSubtitle)
+        {
+            spec->title = CGRectMake(0, 0, viewWidth, middle + 2);
+            spec->subtitle = CGRectMake(0, middle, viewWidth, height - middle);
+        }
+        else
+        {
+            spec->title = CGRectMake(0, padding.top, viewWidth, height - padding.top - padding.bottom);
+        }
+        
+        return;
+    }
+    
+    if (0 < spec->iconSize.width)
+    {
+        spec->icon = CGRectMake(padding.left, (height - spec->iconSize.height) / 2, spec->iconSize.width, spec->iconSize.height);
+        left = padding.left*2 + spec->iconSize.width;
+    }
+    
+    if (self.withAction || self.withSelection)
+        right = width - 5;
+    
+    if (kECCellStyleSwitch == self.style)
+    {
+        spec->title = CGRectMake(left, padding.top, MAX(0, width - 80 - left), height - padding.top - padding.bottom);
+        spec->control = CGRectMake(width - 80 + padding.left, (height - spec->controlSize.height) / 2, spec->controlSize.width, spec->controlSize.height);
+    }
+    else
+    {
+        // The title has the scaled width with the info, else fills to the right
+        CGFloat titleWidth = MAX(0, (self.hasInfo) ? width * spec->scale : right - left);
+        
+        if (self.hasSubtitle)
+        {
+            spec->title = CGRectMake(left, 0, titleWidth, middle);
+            spec->subtitle = CGRectMake(left, middle + 2, titleWidth, height - middle - 2);
+        }
+        else
+        {
+            spec->title = CGRectMake(left, padding.top, titleWidth, height - padding.top - padding.bottom);
+        }
+        
+        if (self.hasInfo)
+        {
+            CGFloat detailLeft = left + titleWidth + padding.left;
+            
+            spec->detail = CGRectMake(detailLeft, padding.top, MAX(0, right - detailLeft), height - padding.top - padding.bottom);
+        }
+    }
+}
+
+/**
+ *  Place the label in the band of the spec, at the bottom or the top of the band with its fitting height.
+ */
+static void _place_Label(UILabel *label, CGRect band, BOOL alignBottom)
+{
+    CGFloat height = MIN(band.size.height, [label sizeThatFits:CGSizeMake(band.size.width, CGFLOAT_MAX)].height);
+    
+    if (alignBottom)
+        band.origin.y += band.size.height - height;
+    
+    band.size.height = height;
+    label.frame = band;
+}
+
+- (void)layoutSubviews
+{
+#ifdef DEBUG
+    CFTimeInterval start = CACurrentMediaTime();
+#endif
+    
+    [super layoutSubviews];
+    
+    if (_displaysAsynchronously)
+    {
+        [self _start_Async_Display];
+    }
+    else if (_manualLayout)
+    {
+        ECCellLayoutSpec *spec = &_layoutSpecs[self.style];
+        CGSize size = self.contentView.bounds.size;
+        CGSize controlSize = (self.hasInput) ? self.editInput.leftView.frame.size : self.btnSwitch.frame.size;
+        
+        if (!CGSizeEqualToSize(spec->size, size) || spec->scale != _scale || !CGSizeEqualToSize(spec->iconSize, _iconSize) || !CGSizeEqualToSize(spec->controlSize, controlSize))
+        {
+            spec->size = size;
+            spec->scale = _scale;
+            spec->iconSize = _iconSize;
+            spec->controlSize = controlSize;
+            
+            [self _solve_Layout_Spec:spec];
+        }
+        
+        if (self.hasInput)
+            self.editInput.frame = spec->control;
+        else
+            self.btnSwitch.frame = spec->control;
+        
+        self.imgViewIcon.frame = spec->icon;
+        self.labelDetail1.frame = spec->detail;
+        
+        if (self.hasSubtitle)
+        {
+            _place_Label(self.labelTitle, spec->title, YES);
+            _place_Label(self.labelSubtitle, spec->subtitle, NO);
+        }
+        else
+        {
+            self.labelTitle.frame = spec->title;
+        }
+    }
+    
+#ifdef DEBUG
+    _layoutTime += CACurrentMediaTime() - start;
+    _layoutCount++;
+#endif
+}
+
+#pragma mark - Asynchronous Display
+
++ (dispatch_queue_t)_render_Queue
+{
+    return dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+}
+
+- (void)setDisplaysAsynchronously: (BOOL) displaysAsynchronously
+{
+    _displaysAsynchronously = displaysAsynchronously;
+    
+    for (UIView *view in self.contentView.subviews)
+        view.hidden = displaysAsynchronously;
+    
+    if (!displaysAsynchronously)
+    {
+        [self _cancel_Async_Display];
+        _contentBuilder = nil;
+        self.contentView.layer.contents = nil;
+    }
+}
+
+- (void)display_Async_Content: (ECCellContent* (^)(CGSize size)) builder
+{
+    [self _cancel_Async_Display];
+    
+    _contentBuilder = [builder copy];
+    _renderedSize = CGSizeZero;
+    self.contentView.layer.contents = nil;
+    
+    [self setNeedsLayout];
+}
+
+- (void)prepareForReuse
+{
+    [super prepareForReuse];
+    
+    if (_displaysAsynchronously)
+    {
+        [self _cancel_Async_Display];
+        self.contentView.layer.contents = nil;
+    }
+}
+
+- (void)_cancel_Async_Display
+{
+    _renderToken.cancelled = YES;
+    _renderToken = nil;
+    
+    if (nil != _imageReceipt)
+    {
+        [[UIImageView sharedImageDownloader] cancelTaskForImageDownloadReceipt:_imageReceipt];
+        _imageReceipt = nil;
+    }
+}
+
+/**
+ * \brief	Build and render the content for the current size on the render queue. Only the token is used off
+ *          the main thread, so the cell is never released there.
+ */
+- (void)_start_Async_Display
+{
+    CGSize size = self.contentView.bounds.size;
+    
+    if (nil == _contentBuilder || 0 >= size.width || 0 >= size.height || CGSizeEqualToSize(size, _renderedSize))
+        return;
+    
+    [self _cancel_Async_Display];
+    
+    ECRenderToken *token = [[ECRenderToken alloc] init];
+    ECCellContent* (^builder)(CGSize size) = _contentBuilder;
+    CGFloat scale = [UIScreen mainScreen].scale;
+    __weak ECTableViewCell *weakSelf = self;
+    
+    _renderToken = token;
+    _renderedSize = size;
+    
+    dispatch_async([ECTableViewCell _render_Queue], ^{
+        if (token.cancelled)
+            return;
+        
+        ECCellContent *content = builder(size);
+        NSURLRequest *request = (0 < content.imageURL.length) ? [NSURLRequest requestWithURL:[NSURL URLWithString:content.imageURL]] : nil;
+        UIImage *image = [ECImagePrefetcher cached_Image_URL:content.imageURL size:content.imageSize];
+        UIImage *bitmap = (token.cancelled) ? nil : [content render_With_Image:image scale:scale];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            ECTableViewCell *cell = weakSelf;
+            
+            if (nil == cell || token != cell->_renderToken)
+                return;
+            
+            cell.contentView.layer.contents = (__bridge id)bitmap.CGImage;
+            
+            if (nil != request && nil == image)
+                [cell _load_Image:request content:content token:token];
+        });
+    });
+}
+
+/**
+ * \brief	Download the image of the content, and render the content again with it.
+ */
+- (void)_load_Image: (NSURLRequest*) request content: (ECCellContent*) content token: (ECRenderToken*) token
+{
+    CGFloat scale = [UIScreen mainScreen].scale;
+    __weak ECTableViewCell *weakSelf = self;
+    
+    _imageReceipt = [[UIImageView sharedImageDownloader] enqueueImageForURLRequest:request withReceiptID:[NSUUID UUID] success:^(NSURLRequest *urlRequest, NSHTTPURLResponse *response, UIImage *image) {
+        ECTableViewCell *cell = weakSelf;
+        
+        if (nil == cell || token != cell->_renderToken)
+            return;
+        
+        cell->_imageReceipt = nil;
+        
+        dispatch_async([ECTableViewCell _render_Queue], ^{
+            if (token.cancelled)
+                return;
+            
+            UIImage *bitmap = [content render_With_Image:image scale:scale];
+            
+            dispatch_async(dispatch_get_main_queue(), ^{
+                ECTableViewCell *cell = weakSelf;
+                
+                if (nil != cell && token == cell->_renderToken)
+                    cell.contentView.layer.contents = (__bridge id)bitmap.CGImage;
+            });
+        });
+    } failure:^(NSURLRequest *urlRequest, NSHTTPURLResponse *response, NSError *error) {
+        ECTableViewCell *cell = weakSelf;
+        
+        if (nil != cell && token == cell->_renderToken)
+            cell->_imageReceipt = nil;
+    }];
+}
+
+#pragma mark - Image Icon
+
 - (void)Set_Image_Icon:(UIImage *)icon
 {
     [self Set_Image_Icon:icon withSize:icon.size];
@@ -366,6 +898,37 @@
 {
     UIEdgeInsets padding = UIEdgeInsetsMake(10, 15, 10, 15);
     
+    // Only the size is kept, the frames are solved in layoutSubviews
+    if (_manualLayout)
+    {
+        if (kECCellStyleDatePicker == self.style)
+            return;
+        
+        [self.imgViewIcon removeFromSuperview];
+        self.imgViewIcon = [[UIImageView alloc] initWithImage:icon];
+        _iconSize = size;
+        
+        if (kECCellStyleInput == self.style || kECCellStyleSecureInput == self.style)
+        {
+            self.labelTitle = nil;
+            self.labelSubtitle = nil;
+            
+            UIView *view = [[UIView alloc] initWithFrame:CGRectMake(0, 0, size.width + padding.left, size.height)];
+            [view addSubview:self.imgViewIcon];
+            
+            // Stays centered when the text field stretches the left view to its height
+            self.imgViewIcon.autoresizingMask = UIViewAutoresizingFlexibleTopMargin | UIViewAutoresizingFlexibleBottomMargin;
+            self.editInput.leftView = view;
+        }
+        else
+        {
+            [self.contentView addSubview:self.imgViewIcon];
+        }
+        
+        [self setNeedsLayout];
+        return;
+    }
+    
     switch (self.style)
     {
         case kECCellStyleInput: